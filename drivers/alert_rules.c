@@ -0,0 +1,427 @@
+#include "alert_rules.h"
+#include "fixed_point.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+#define LINE_MAX_LEN    256
+#define MAX_TOKENS      8
+
+static const char *channel_names[ALERT_CH_COUNT] = { "temp", "humi" };
+static const char *kind_labels[] = { "", " rise", " fall", " avg" };
+
+// ---- 고정 용량 링 (앞/뒤 양쪽에서 빼는 덱) ----
+
+static alert_point_t *ring_at(const alert_ring_t *r, uint32_t i) {
+    uint32_t pos = r->head + i;
+    if (pos >= r->cap) pos -= r->cap;
+    return &r->buf[pos];
+}
+
+static void ring_pop_front(alert_ring_t *r) {
+    if (++r->head == r->cap) r->head = 0;
+    r->len--;
+}
+
+// 가득 차면 가장 오래된 점을 버림 (측정이 최소 간격보다 잦을 때만, 창이 약간 짧아짐)
+static void ring_push_back(alert_ring_t *r, int64_t t_ms, int32_t value) {
+    alert_point_t *p;
+
+    if (r->len == r->cap) ring_pop_front(r);
+    p = ring_at(r, r->len++);
+    p->t_ms = t_ms;
+    p->value = value;
+}
+
+static void window_update(alert_window_t *w, int64_t now_ms, int32_t v) {
+    int64_t cutoff = now_ms - w->span_ms;
+
+    if (!w->primed) {
+        w->first_ms = now_ms;
+        w->primed = 1;
+    }
+
+    if (w->needs & ALERT_WIN_MIN) {
+        alert_ring_t *dq = &w->min_dq;
+        while (dq->len && ring_at(dq, dq->len - 1)->value >= v) dq->len--;
+        ring_push_back(dq, now_ms, v);
+        while (ring_at(dq, 0)->t_ms < cutoff) ring_pop_front(dq);
+    }
+
+    if (w->needs & ALERT_WIN_MAX) {
+        alert_ring_t *dq = &w->max_dq;
+        while (dq->len && ring_at(dq, dq->len - 1)->value <= v) dq->len--;
+        ring_push_back(dq, now_ms, v);
+        while (ring_at(dq, 0)->t_ms < cutoff) ring_pop_front(dq);
+    }
+
+    if (w->needs & ALERT_WIN_SUM) {
+        alert_ring_t *r = &w->samples;
+        if (r->len == r->cap) {
+            w->sum -= ring_at(r, 0)->value;
+            ring_pop_front(r);
+        }
+        ring_push_back(r, now_ms, v);
+        w->sum += v;
+        while (ring_at(r, 0)->t_ms < cutoff) {
+            w->sum -= ring_at(r, 0)->value;
+            ring_pop_front(r);
+        }
+    }
+}
+
+// ---- 규칙 문장 해석 ----
+
+static int rule_error(int lineno, const char *msg, const char *token) {
+    fprintf(stderr, "❌ 경보 규칙 %d행: %s%s%s\n", lineno, msg, token ? " - " : "", token ? token : "");
+    return -1;
+}
+
+// "70", "2.5", "-3.25", "65%" → centi
+static int parse_centi(const char *s, int32_t *out) {
+    int neg = 0, digits = 0, frac = 0;
+    int64_t v = 0;
+
+    if (*s == '-') {
+        neg = 1;
+        s++;
+    }
+    for (; isdigit((unsigned char)*s); s++, digits++) {
+        v = v * 10 + (*s - '0');
+        if (v > 1000000) return -1;
+    }
+    v *= FX_CENTI;
+    if (*s == '.') {
+        s++;
+        for (int scale = 10; isdigit((unsigned char)*s); s++, frac++) {
+            if (frac >= 2) return -1;
+            v += (*s - '0') * scale;
+            scale /= 10;
+        }
+    }
+    if (*s == '%' || *s == 'C') s++;
+    if (digits == 0 || *s != '\0') return -1;
+
+    *out = (int32_t)(neg ? -v : v);
+    return 0;
+}
+
+// "90s", "10m", "1h" → ms
+static int parse_duration(const char *s, int64_t *out) {
+    int64_t v = 0;
+    const char *p = s;
+
+    for (; isdigit((unsigned char)*p); p++) {
+        v = v * 10 + (*p - '0');
+        if (v > 10000000) return -1;
+    }
+    // 단위 한 글자로 끝나야 함 (단위가 없으면 p[1]은 문자열 밖)
+    if (p == s || *p == '\0' || p[1] != '\0') return -1;
+
+    switch (*p) {
+    case 's': v *= 1000; break;
+    case 'm': v *= 60000; break;
+    case 'h': v *= 3600000; break;
+    default:  return -1;
+    }
+    if (v <= 0) return -1;
+    *out = v;
+    return 0;
+}
+
+static int parse_cmp(const char *s, uint8_t *out) {
+    if (strcmp(s, ">") == 0)  *out = ALERT_CMP_GT;
+    else if (strcmp(s, ">=") == 0) *out = ALERT_CMP_GE;
+    else if (strcmp(s, "<") == 0)  *out = ALERT_CMP_LT;
+    else if (strcmp(s, "<=") == 0) *out = ALERT_CMP_LE;
+    else return -1;
+    return 0;
+}
+
+static int compare(uint8_t cmp, int32_t v, int32_t threshold) {
+    switch (cmp) {
+    case ALERT_CMP_GT: return v > threshold;
+    case ALERT_CMP_GE: return v >= threshold;
+    case ALERT_CMP_LT: return v < threshold;
+    case ALERT_CMP_LE: return v <= threshold;
+    }
+    return 0;
+}
+
+// 같은 채널/기간 창이 있으면 공유 (필요한 덱만 추가)
+static int find_window(alert_engine_t *eng, uint8_t channel, int64_t span_ms, uint8_t needs) {
+    alert_window_t *w;
+
+    for (int i = 0; i < eng->window_count; i++) {
+        w = &eng->windows[i];
+        if (w->channel == channel && w->span_ms == span_ms) {
+            w->needs |= needs;
+            return i;
+        }
+    }
+
+    if (eng->window_count == eng->windows_cap) {
+        int cap = eng->windows_cap ? eng->windows_cap * 2 : 16;
+        alert_window_t *grown = realloc(eng->windows, (size_t)cap * sizeof(*grown));
+        if (!grown) return -1;
+        eng->windows = grown;
+        eng->windows_cap = cap;
+    }
+
+    w = &eng->windows[eng->window_count];
+    memset(w, 0, sizeof(*w));
+    w->channel = channel;
+    w->span_ms = span_ms;
+    w->needs = needs;
+    return eng->window_count++;
+}
+
+static int compile_line(alert_engine_t *eng, const char *line, int lineno) {
+    char buf[LINE_MAX_LEN];
+    char *tok[MAX_TOKENS];
+    char *body, *colon, *save = NULL;
+    int ntok = 0;
+    alert_rule_t rule;
+    uint8_t needs = 0;
+
+    snprintf(buf, sizeof(buf), "%s", line);
+    if ((body = strchr(buf, '#')) != NULL) *body = '\0';
+
+    memset(&rule, 0, sizeof(rule));
+    rule.window = -1;
+    rule.since_ms = -1;
+
+    body = buf;
+    if ((colon = strchr(buf, ':')) != NULL) {
+        char *name = buf, *end = colon;
+        *colon = '\0';
+        body = colon + 1;
+        while (isspace((unsigned char)*name)) name++;
+        while (end > name && isspace((unsigned char)end[-1])) *--end = '\0';
+        if (*name == '\0' || strlen(name) >= ALERT_NAME_LEN) return rule_error(lineno, "이름 길이 오류", name);
+        memcpy(rule.name, name, strlen(name) + 1);
+    }
+
+    for (char *t = strtok_r(body, " \t\r\n", &save); t; t = strtok_r(NULL, " \t\r\n", &save)) {
+        if (ntok == MAX_TOKENS) return rule_error(lineno, "토큰이 너무 많음", t);
+        tok[ntok++] = t;
+    }
+    if (ntok == 0) {
+        return rule.name[0] ? rule_error(lineno, "조건 없음", rule.name) : 0;
+    }
+
+    if (strcmp(tok[0], "temp") == 0) rule.channel = ALERT_CH_TEMP;
+    else if (strcmp(tok[0], "humi") == 0) rule.channel = ALERT_CH_HUMI;
+    else return rule_error(lineno, "채널은 temp/humi", tok[0]);
+
+    // temp > 30 for 10m
+    if (ntok == 5 && parse_cmp(tok[1], &rule.cmp) == 0 && strcmp(tok[3], "for") == 0) {
+        rule.kind = ALERT_KIND_FOR;
+        if (parse_centi(tok[2], &rule.threshold) != 0) return rule_error(lineno, "값 오류", tok[2]);
+        if (parse_duration(tok[4], &rule.span_ms) != 0) return rule_error(lineno, "기간 오류", tok[4]);
+    // temp rises 3 within 15m
+    } else if (ntok == 5 && (strcmp(tok[1], "rises") == 0 || strcmp(tok[1], "falls") == 0) &&
+               strcmp(tok[3], "within") == 0) {
+        rule.kind = (tok[1][0] == 'r') ? ALERT_KIND_RISES : ALERT_KIND_FALLS;
+        needs = (rule.kind == ALERT_KIND_RISES) ? ALERT_WIN_MIN : ALERT_WIN_MAX;
+        if (parse_centi(tok[2], &rule.threshold) != 0 || rule.threshold <= 0) {
+            return rule_error(lineno, "변화폭 오류", tok[2]);
+        }
+        if (parse_duration(tok[4], &rule.span_ms) != 0) return rule_error(lineno, "기간 오류", tok[4]);
+    // humi avg > 65 over 1h
+    } else if (ntok == 6 && strcmp(tok[1], "avg") == 0 && parse_cmp(tok[2], &rule.cmp) == 0 &&
+               strcmp(tok[4], "over") == 0) {
+        rule.kind = ALERT_KIND_AVG;
+        needs = ALERT_WIN_SUM;
+        if (parse_centi(tok[3], &rule.threshold) != 0) return rule_error(lineno, "값 오류", tok[3]);
+        if (parse_duration(tok[5], &rule.span_ms) != 0) return rule_error(lineno, "기간 오류", tok[5]);
+    } else {
+        return rule_error(lineno, "문법 오류 (예: humi > 70 for 10m, temp rises 3 within 15m)", NULL);
+    }
+
+    if (needs) {
+        rule.window = find_window(eng, rule.channel, rule.span_ms, needs);
+        if (rule.window < 0) return rule_error(lineno, "메모리 부족", NULL);
+    }
+
+    if (eng->count == ALERT_MAX_RULES) return rule_error(lineno, "규칙이 너무 많음", NULL);
+    if (eng->count == eng->rules_cap) {
+        int cap = eng->rules_cap ? eng->rules_cap * 2 : 16;
+        alert_rule_t *grown = realloc(eng->rules, (size_t)cap * sizeof(*grown));
+        if (!grown) return rule_error(lineno, "메모리 부족", NULL);
+        eng->rules = grown;
+        eng->rules_cap = cap;
+    }
+    if (rule.name[0] == '\0') snprintf(rule.name, sizeof(rule.name), "rule%d", eng->count + 1);
+    eng->rules[eng->count++] = rule;
+    return 1;
+}
+
+// ---- 공개 함수 ----
+
+void alert_engine_init(alert_engine_t *eng) {
+    memset(eng, 0, sizeof(*eng));
+}
+
+void alert_engine_free(alert_engine_t *eng) {
+    free(eng->rules);
+    free(eng->windows);
+    free(eng->pool);
+    memset(eng, 0, sizeof(*eng));
+}
+
+int alert_engine_compile(alert_engine_t *eng, const char *text) {
+    char line[LINE_MAX_LEN];
+    int added = 0, lineno = 0;
+
+    while (*text) {
+        size_t len = strcspn(text, "\n");
+        int ret;
+
+        lineno++;
+        if (len >= sizeof(line)) return rule_error(lineno, "줄이 너무 김", NULL);
+        memcpy(line, text, len);
+        line[len] = '\0';
+        text += len + (text[len] == '\n');
+
+        if ((ret = compile_line(eng, line, lineno)) < 0) return -1;
+        added += ret;
+    }
+    return added;
+}
+
+int alert_engine_load(alert_engine_t *eng, const char *path) {
+    char line[LINE_MAX_LEN];
+    int added = 0, lineno = 0;
+    FILE *fp = fopen(path, "r");
+
+    if (!fp) {
+        perror("경보 규칙 파일 열기 실패");
+        return -1;
+    }
+
+    while (fgets(line, sizeof(line), fp)) {
+        int ret = compile_line(eng, line, ++lineno);
+        if (ret < 0) {
+            fclose(fp);
+            return -1;
+        }
+        added += ret;
+    }
+
+    fclose(fp);
+    return added;
+}
+
+int alert_engine_finalize(alert_engine_t *eng, int min_sample_ms) {
+    size_t total = 0, off = 0;
+
+    if (min_sample_ms <= 0) min_sample_ms = ALERT_MIN_SAMPLE_MS;
+
+    // 창마다 필요한 링 용량 합산 (기간 양 끝 포함 + 여유 1)
+    for (int i = 0; i < eng->window_count; i++) {
+        alert_window_t *w = &eng->windows[i];
+        uint32_t cap = (uint32_t)(w->span_ms / min_sample_ms) + 2;
+        int rings = !!(w->needs & ALERT_WIN_MIN) + !!(w->needs & ALERT_WIN_MAX) +
+                    !!(w->needs & ALERT_WIN_SUM);
+        w->min_dq.cap = w->max_dq.cap = w->samples.cap = cap;
+        total += (size_t)cap * (size_t)rings;
+    }
+
+    free(eng->pool);
+    eng->pool = total ? malloc(total * sizeof(alert_point_t)) : NULL;
+    if (total && !eng->pool) {
+        fprintf(stderr, "❌ 경보 규칙: 창 메모리 할당 실패 (%zu점)\n", total);
+        return -1;
+    }
+
+    for (int i = 0; i < eng->window_count; i++) {
+        alert_window_t *w = &eng->windows[i];
+        alert_ring_t *rings[3] = { &w->min_dq, &w->max_dq, &w->samples };
+        uint8_t flags[3] = { ALERT_WIN_MIN, ALERT_WIN_MAX, ALERT_WIN_SUM };
+
+        for (int r = 0; r < 3; r++) {
+            rings[r]->head = rings[r]->len = 0;
+            if (!(w->needs & flags[r])) {
+                rings[r]->buf = NULL;
+                rings[r]->cap = 0;
+                continue;
+            }
+            rings[r]->buf = eng->pool + off;
+            off += rings[r]->cap;
+        }
+        w->sum = 0;
+        w->primed = 0;
+    }
+    return 0;
+}
+
+int alert_engine_update(alert_engine_t *eng, int64_t now_ms, int temp_centi, int humi_centi,
+                        alert_event_t *out, int max_out) {
+    int32_t values[ALERT_CH_COUNT] = { temp_centi, humi_centi };
+    int produced = 0;
+
+    // 1) 공유 창 갱신 (서로 다른 채널/기간 수만큼)
+    for (int i = 0; i < eng->window_count; i++) {
+        alert_window_t *w = &eng->windows[i];
+        window_update(w, now_ms, values[w->channel]);
+    }
+    eng->samples++;
+
+    // 2) 규칙마다 O(1) 판정
+    for (int i = 0; i < eng->count; i++) {
+        alert_rule_t *r = &eng->rules[i];
+        int32_t v = values[r->channel];
+        const alert_window_t *w = r->window >= 0 ? &eng->windows[r->window] : NULL;
+        int fire = 0;
+
+        switch (r->kind) {
+        case ALERT_KIND_FOR:
+            if (compare(r->cmp, v, r->threshold)) {
+                if (r->since_ms < 0) r->since_ms = now_ms;
+                fire = (now_ms - r->since_ms >= r->span_ms);
+            } else {
+                r->since_ms = -1;
+            }
+            break;
+        case ALERT_KIND_RISES:
+            v -= ring_at(&w->min_dq, 0)->value;
+            fire = (v >= r->threshold);
+            break;
+        case ALERT_KIND_FALLS:
+            v = ring_at(&w->max_dq, 0)->value - v;
+            fire = (v >= r->threshold);
+            break;
+        case ALERT_KIND_AVG:
+            // 기간만큼 쌓이기 전에는 평균을 믿지 않음
+            v = (int32_t)(w->sum / (int64_t)w->samples.len);
+            fire = (now_ms - w->first_ms >= r->span_ms) && compare(r->cmp, v, r->threshold);
+            break;
+        }
+
+        if (fire == r->active) continue;
+        r->active = (uint8_t)fire;
+        eng->events++;
+
+        if (produced == max_out) {
+            eng->events_dropped++;
+            continue;
+        }
+        out[produced].t_ms = now_ms;
+        out[produced].value = v;
+        out[produced].rule = (uint16_t)i;
+        out[produced].active = (uint8_t)fire;
+        out[produced].reserved = 0;
+        produced++;
+    }
+    return produced;
+}
+
+int alert_format_event(const alert_engine_t *eng, const alert_event_t *ev, char *buf, size_t size) {
+    const alert_rule_t *r = &eng->rules[ev->rule];
+
+    return fx_format(buf, size, "%s %s %s%s %.1q",
+                     ev->active ? "ALERT" : "CLEAR", r->name,
+                     channel_names[r->channel], kind_labels[r->kind], ev->value);
+}
@@ -0,0 +1,74 @@
+#include "comfort_metrics.h"
+#include "comfort_tables.h"     // 빌드 시 scripts/gen_comfort_tables로 생성
+
+// 격자 위치: 칸 번호와 칸 안의 위치 (0 ~ STEP-1)
+typedef struct {
+    int ti, tf;
+    int hi, hf;
+} comfort_cell_t;
+
+static void locate(int temp_centi, int humi_centi, comfort_cell_t *c) {
+    if (temp_centi < COMFORT_TEMP_MIN_CENTI) temp_centi = COMFORT_TEMP_MIN_CENTI;
+    if (temp_centi > COMFORT_TEMP_MAX_CENTI) temp_centi = COMFORT_TEMP_MAX_CENTI;
+    if (humi_centi < COMFORT_HUMI_MIN_CENTI) humi_centi = COMFORT_HUMI_MIN_CENTI;
+    if (humi_centi > COMFORT_HUMI_MAX_CENTI) humi_centi = COMFORT_HUMI_MAX_CENTI;
+
+    temp_centi -= COMFORT_TEMP_MIN_CENTI;
+    humi_centi -= COMFORT_HUMI_MIN_CENTI;
+    c->ti = temp_centi / COMFORT_TEMP_STEP_CENTI;
+    c->tf = temp_centi % COMFORT_TEMP_STEP_CENTI;
+    c->hi = humi_centi / COMFORT_HUMI_STEP_CENTI;
+    c->hf = humi_centi % COMFORT_HUMI_STEP_CENTI;
+
+    // 상한 경계는 마지막 칸의 끝으로
+    if (c->ti == COMFORT_TEMP_POINTS - 1) {
+        c->ti--;
+        c->tf = COMFORT_TEMP_STEP_CENTI;
+    }
+    if (c->hi == COMFORT_HUMI_POINTS - 1) {
+        c->hi--;
+        c->hf = COMFORT_HUMI_STEP_CENTI;
+    }
+}
+
+// 쌍선형 보간 (정수, 반올림). 가중치 합이 STEP_T x STEP_H = 20000이라
+// |값| < 100000 범위에서 int로 넘치지 않습니다.
+static int interpolate(const short table[COMFORT_TEMP_POINTS][COMFORT_HUMI_POINTS],
+                       const comfort_cell_t *c) {
+    const int st = COMFORT_TEMP_STEP_CENTI, sh = COMFORT_HUMI_STEP_CENTI;
+    const short *r0 = table[c->ti];
+    const short *r1 = table[c->ti + 1];
+    int sum = r0[c->hi]     * (st - c->tf) * (sh - c->hf)
+            + r0[c->hi + 1] * (st - c->tf) * c->hf
+            + r1[c->hi]     * c->tf * (sh - c->hf)
+            + r1[c->hi + 1] * c->tf * c->hf;
+    const int den = st * sh;
+
+    return (int)(sum >= 0 ? (sum + den / 2) / den : -((-sum + den / 2) / den));
+}
+
+int comfort_dew_point(int temp_centi, int humi_centi) {
+    comfort_cell_t c;
+    locate(temp_centi, humi_centi, &c);
+    return interpolate(comfort_dew_point_table, &c);
+}
+
+int comfort_heat_index(int temp_centi, int humi_centi) {
+    comfort_cell_t c;
+    locate(temp_centi, humi_centi, &c);
+    return interpolate(comfort_heat_index_table, &c);
+}
+
+int comfort_abs_humidity(int temp_centi, int humi_centi) {
+    comfort_cell_t c;
+    locate(temp_centi, humi_centi, &c);
+    return interpolate(comfort_abs_humidity_table, &c);
+}
+
+void comfort_compute(int temp_centi, int humi_centi, comfort_metrics_t *out) {
+    comfort_cell_t c;
+    locate(temp_centi, humi_centi, &c);
+    out->dew_point_centi = interpolate(comfort_dew_point_table, &c);
+    out->heat_index_centi = interpolate(comfort_heat_index_table, &c);
+    out->abs_humidity_centi = interpolate(comfort_abs_humidity_table, &c);
+}
@@ -0,0 +1,100 @@
+#include "dht11_capture.h"
+#include "fixed_point.h"
+#include <string.h>
+
+void dht11_state_init(dht11_state_t *st) {
+    memset(st, 0, sizeof(*st));
+    st->last_valid_temp = FX_CENTI_FROM_INT(25);
+    st->last_valid_humi = FX_CENTI_FROM_INT(50);
+}
+
+int dht11_frame_check(dht11_state_t *st, const uint8_t data[5], int *temp_centi, int *humi_centi) {
+    uint8_t sum = (uint8_t)(data[0] + data[1] + data[2] + data[3]);
+    int temp, humi;
+
+    if (sum != data[4]) {
+        st->stats.checksum_errors++;
+        return -1;
+    }
+
+    // 정수부 + 소수부(0.1 단위) → centi 정수
+    temp = FX_CENTI_FROM_TENTHS(data[2], data[3] & 0x7F);
+    humi = FX_CENTI_FROM_TENTHS(data[0], data[1]);
+    if (data[3] & 0x80) temp = -temp;   // 영하 표시 비트
+
+    if (temp < DHT11_TEMP_MIN_CENTI || temp > DHT11_TEMP_MAX_CENTI ||
+        humi < DHT11_HUMI_MIN_CENTI || humi > DHT11_HUMI_MAX_CENTI) {
+        st->stats.range_errors++;
+        return -1;
+    }
+
+    *temp_centi = temp;
+    *humi_centi = humi;
+    return 0;
+}
+
+void dht11_state_accept(dht11_state_t *st, int temp_centi, int humi_centi) {
+    st->last_valid_temp = temp_centi;
+    st->last_valid_humi = humi_centi;
+    st->consecutive_errors = 0;
+    st->stats.reads_ok++;
+}
+
+int dht11_state_reject(dht11_state_t *st, int *temp_centi, int *humi_centi) {
+    st->consecutive_errors++;
+    st->stats.reads_failed++;
+    if (st->consecutive_errors >= DHT11_STALE_LIMIT) return 0;
+    *temp_centi = st->last_valid_temp;
+    *humi_centi = st->last_valid_humi;
+    return 1;
+}
+
+int dht11_count_highs(const dht11_edge_t *edges, int n) {
+    int highs = 0;
+
+    for (int i = 1; i < n; i++) {
+        if (edges[i - 1].rising && !edges[i].rising) highs++;
+    }
+    return highs;
+}
+
+int dht11_decode_edges(const dht11_edge_t *edges, int n, uint8_t data[5]) {
+    uint32_t widths[DHT11_MAX_EDGES / 2];
+    int highs = 0;
+
+    // HIGH 폭 = 상승 에지 → 다음 하강 에지 (마지막 상승은 유휴 복귀라 짝 없음)
+    for (int i = 1; i < n && highs < (int)(sizeof(widths) / sizeof(widths[0])); i++) {
+        // 같은 방향 에지가 연달아 오면 중간 에지를 놓친 것 (비트가 밀려 해독됨)
+        if (edges[i - 1].rising == edges[i].rising) return -1;
+        if (edges[i - 1].rising) {
+            widths[highs++] = (uint32_t)((edges[i].ns - edges[i - 1].ns) / 1000);
+        }
+    }
+    if (highs < 40) return -1;
+
+    memset(data, 0, 5);
+    for (int b = 0; b < 40; b++) {
+        uint32_t us = widths[highs - 40 + b];
+        if (us < DHT11_BIT_MIN_US || us > DHT11_BIT_MAX_US) return -1;
+        if (us > DHT11_BIT_ONE_US) data[b / 8] |= (uint8_t)(1u << (7 - b % 8));
+    }
+    return 0;
+}
+
+uint64_t dht11_stagger(const uint64_t *reserved, int n, uint64_t want, uint64_t window_ns) {
+    int moved = 1;
+
+    // 겹치는 예약이 있으면 그 구간 끝으로 밀고 처음부터 다시 확인 (센서 수가 작아 O(n²)로 충분)
+    while (moved) {
+        moved = 0;
+        for (int i = 0; i < n; i++) {
+            uint64_t r = reserved[i];
+            if (r == 0) continue;
+            if (want + window_ns > r && r + window_ns > want) {
+                want = r + window_ns;
+                moved = 1;
+            }
+        }
+    }
+    return want;
+}
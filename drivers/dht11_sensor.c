@@ -1,32 +1,28 @@
 #include "dht11_sensor.h"
 #include "gpio_driver.h"
+#include "fixed_point.h"
 #include <stdio.h>
-#include <math.h>
 
-static int dht11_pin = -1;
-static struct timespec last_read_time = {0};
-// 안정화를 위한 추가 변수들
-static float last_valid_temp = 25.0;    // 기본값
-static float last_valid_humi = 50.0;    // 기본값
-static int consecutive_errors = 0;
+// 기존 단일 센서 API가 쓰는 기본 인스턴스
+static dht11_t default_sensor = {
+    .pin = -1,
+    .state = { .last_valid_temp = FX_CENTI_FROM_INT(25), .last_valid_humi = FX_CENTI_FROM_INT(50) },
+};
 
 
-int dht11_init(int gpio_pin) {
-    dht11_pin = gpio_pin;
-    clock_gettime(CLOCK_MONOTONIC, &last_read_time); // 초기화 시점 기록
-    return gpio_set_mode(dht11_pin, GPIO_MODE_OUTPUT);
-}
-
-void dht11_cleanup(void) {
-    // 필요 시 GPIO 해제
+int dht11_open(dht11_t *dev, int gpio_pin) {
+    dev->pin = gpio_pin;
+    dht11_state_init(&dev->state);
+    clock_gettime(CLOCK_MONOTONIC, &dev->last_read_time); // 초기화 시점 기록
+    return gpio_set_mode(dev->pin, GPIO_MODE_OUTPUT);
 }
 
-int dht11_is_ready_to_read(void) {
+int dht11_ready(const dht11_t *dev) {
     struct timespec now;
     clock_gettime(CLOCK_MONOTONIC, &now);
 
-    long elapsed_us = (now.tv_sec - last_read_time.tv_sec) * 1000000L +
-                      (now.tv_nsec - last_read_time.tv_nsec) / 1000;
+    long elapsed_us = (now.tv_sec - dev->last_read_time.tv_sec) * 1000000L +
+                      (now.tv_nsec - dev->last_read_time.tv_nsec) / 1000;
 
     return (elapsed_us >= DHT11_MIN_INTERVAL);
 }
@@ -57,37 +53,43 @@ int dht11_validate_checksum(unsigned char data[5]) {
     return (sum == data[4]);
 }
 
-int dht11_read_data(dht11_data_t *result) {
+int dht11_read(dht11_t *dev, dht11_data_t *result) {
+    dht11_stats_t *stats = &dev->state.stats;
     unsigned char data[5] = {0};
     int retry_count = 0;
     int max_retries = 5;  // 최대 5번 재시도
-    
+    int pin = dev->pin;
+
     while (retry_count < max_retries) {
         // 재시도 간 대기 (짧게)
         if (retry_count > 0) {
+            stats->retries++;
             gpio_delay_us(500000); // 0.5초 대기
         }
-        
+
         // Start signal (더 안정적으로)
-        gpio_set_mode(dht11_pin, GPIO_MODE_OUTPUT);
-        gpio_write(dht11_pin, GPIO_LOW);
-        gpio_delay_us(20000);  // 20ms로 조정
-        gpio_write(dht11_pin, GPIO_HIGH);
+        gpio_set_mode(pin, GPIO_MODE_OUTPUT);
+        gpio_write(pin, GPIO_LOW);
+        gpio_delay_us(DHT11_START_LOW_US);  // 20ms로 조정
+        gpio_write(pin, GPIO_HIGH);
         gpio_delay_us(30);     // 30us로 조정
-        gpio_set_mode(dht11_pin, GPIO_MODE_INPUT);
+        gpio_set_mode(pin, GPIO_MODE_INPUT);
 
         // Sensor response
-        if (dht11_wait_for_state(dht11_pin, GPIO_LOW, DHT11_READ_TIMEOUT) != 0) {
+        if (dht11_wait_for_state(pin, GPIO_LOW, DHT11_READ_TIMEOUT) != 0) {
+            stats->timeout_errors++;
             retry_count++;
             continue;
         }
 
-        if (dht11_wait_for_state(dht11_pin, GPIO_HIGH, DHT11_READ_TIMEOUT) != 0) {
+        if (dht11_wait_for_state(pin, GPIO_HIGH, DHT11_READ_TIMEOUT) != 0) {
+            stats->timeout_errors++;
             retry_count++;
             continue;
         }
 
-        if (dht11_wait_for_state(dht11_pin, GPIO_LOW, DHT11_READ_TIMEOUT) != 0) {
+        if (dht11_wait_for_state(pin, GPIO_LOW, DHT11_READ_TIMEOUT) != 0) {
+            stats->timeout_errors++;
             retry_count++;
             continue;
         }
@@ -95,59 +97,89 @@ int dht11_read_data(dht11_data_t *result) {
         // Read 40 bits
         int read_success = 1;
         memset(data, 0, sizeof(data));
-        
+
         for (int i = 0; i < 40; i++) {
-            int bit = dht11_read_bit(dht11_pin);
+            int bit = dht11_read_bit(pin);
             if (bit < 0) {
                 read_success = 0;
                 break;
             }
             data[i / 8] |= bit << (7 - (i % 8));
         }
-        
+
         if (!read_success) {
+            stats->timeout_errors++;
             retry_count++;
             continue;
         }
 
-        // Checksum validation
-        if (!dht11_validate_checksum(data)) {
+        // 체크섬/범위 검증 (에지 이벤트 수집과 같은 규칙)
+        int new_temp, new_humi;
+        if (dht11_frame_check(&dev->state, data, &new_temp, &new_humi) != 0) {
             retry_count++;
             continue;
         }
-        
-        float new_temp = data[2] + data[3] * 0.1f;
-        float new_humi = data[0] + data[1] * 0.1f;
-        
-        // 값 검증 (합리적 범위 체크)
-        if (new_temp < -10 || new_temp > 60 || new_humi < 5 || new_humi > 95) {
-            retry_count++;
-            continue;
-        }
-        
+
         // 성공! 값 저장
-        result->temperature = new_temp;
-        result->humidity = new_humi;
+        result->temp_centi = new_temp;
+        result->humi_centi = new_humi;
         result->checksum_valid = 1;
         clock_gettime(CLOCK_MONOTONIC, &result->last_read);
-        last_read_time = result->last_read;
-        
+        dev->last_read_time = result->last_read;
+        dht11_state_accept(&dev->state, new_temp, new_humi);
+
         return 0;
     }
-    
+
     // 모든 재시도 실패 시 이전 값 사용
-    if (consecutive_errors < 3) {
-        result->temperature = last_valid_temp;
-        result->humidity = last_valid_humi;
+    if (dht11_state_reject(&dev->state, &result->temp_centi, &result->humi_centi)) {
         result->checksum_valid = 1;
     }
-    
+
     return -1;
 }
 
+// ---- 기본 센서 ----
+
+int dht11_init(int gpio_pin) {
+    return dht11_open(&default_sensor, gpio_pin);
+}
+
+void dht11_cleanup(void) {
+    // 필요 시 GPIO 해제
+}
+
+int dht11_is_ready_to_read(void) {
+    return dht11_ready(&default_sensor);
+}
+
+int dht11_read_data(dht11_data_t *result) {
+    return dht11_read(&default_sensor, result);
+}
+
+// 마지막 유효값(필터 상태) 조회/복원 - NVRAM 웜 스타트용
+void dht11_get_last_valid(int *temp_centi, int *humi_centi, int *errors) {
+    *temp_centi = default_sensor.state.last_valid_temp;
+    *humi_centi = default_sensor.state.last_valid_humi;
+    *errors = default_sensor.state.consecutive_errors;
+}
+
+void dht11_set_last_valid(int temp_centi, int humi_centi, int errors) {
+    default_sensor.state.last_valid_temp = temp_centi;
+    default_sensor.state.last_valid_humi = humi_centi;
+    default_sensor.state.consecutive_errors = errors;
+}
+
+void dht11_get_stats(dht11_stats_t *out) {
+    *out = default_sensor.state.stats;
+}
+
 void dht11_print_data(const dht11_data_t *data) {
-    printf("🌡️ 온도: %.1f°C, 💧 습도: %.1f%% [%s]\n",
-           data->temperature,
-           data->humidity,
-           data->checksum_valid ? "정상" : "오류");
+    char line[64];
+
+    fx_format(line, sizeof(line), "🌡️ 온도: %q°C, 💧 습도: %q%% [%s]",
+              data->temp_centi,
+              data->humi_centi,
+              data->checksum_valid ? "정상" : "오류");
+    puts(line);
 }
@@ -7,6 +7,7 @@
 #include "ds1307_rtc.h"
 
 static int i2c_fd = -1;
+static i2c_stats_t i2c_stats;       // 레지스터 접근 트랜잭션 통계
 
 int ds1307_init(void) {
     i2c_fd = open("/dev/i2c-1", O_RDWR);
@@ -32,31 +33,46 @@ void ds1307_cleanup(void) {
     }
 }
 
+// 레지스터 주소 쓰기 + 연속 읽기 = 트랜잭션 하나
+static int i2c_read_at(unsigned char reg, unsigned char *data, int len) {
+    uint64_t start = i2c_stats_now_ns();
+    int ok = write(i2c_fd, &reg, 1) == 1 && read(i2c_fd, data, len) == len;
+    i2c_stats_record(&i2c_stats, start, (size_t)len + 1, ok);
+    return ok ? 0 : -1;
+}
+
+// 레지스터 주소 + 데이터 쓰기 = 트랜잭션 하나
+static int i2c_write_at(unsigned char reg, const unsigned char *data, int len) {
+    unsigned char buf[len + 1];
+    uint64_t start;
+    int ok;
+
+    buf[0] = reg;
+    for (int i = 0; i < len; i++) {
+        buf[i + 1] = data[i];
+    }
+    start = i2c_stats_now_ns();
+    ok = write(i2c_fd, buf, len + 1) == len + 1;
+    i2c_stats_record(&i2c_stats, start, (size_t)len + 1, ok);
+    return ok ? 0 : -1;
+}
+
 static int ds1307_read_register(unsigned char reg) {
-    if (write(i2c_fd, &reg, 1) != 1) return -1;
     unsigned char val;
-    if (read(i2c_fd, &val, 1) != 1) return -1;
+    if (i2c_read_at(reg, &val, 1) != 0) return -1;
     return val;
 }
 
 static int ds1307_write_register(unsigned char reg, unsigned char data) {
-    unsigned char buf[2] = {reg, data};
-    return (write(i2c_fd, buf, 2) == 2) ? 0 : -1;
+    return i2c_write_at(reg, &data, 1);
 }
 
 static int ds1307_read_burst(unsigned char *data, int len) {
-    unsigned char reg = DS1307_REG_SECONDS;
-    if (write(i2c_fd, &reg, 1) != 1) return -1;
-    return (read(i2c_fd, data, len) == len) ? 0 : -1;
+    return i2c_read_at(DS1307_REG_SECONDS, data, len);
 }
 
 int ds1307_write_burst(const unsigned char *data, int len) {
-    unsigned char buf[len + 1];
-    buf[0] = DS1307_REG_SECONDS;
-    for (int i = 0; i < len; i++) {
-        buf[i + 1] = data[i];
-    }
-    return (write(i2c_fd, buf, len + 1) == len + 1) ? 0 : -1;
+    return i2c_write_at(DS1307_REG_SECONDS, data, len);
 }
 
 int ds1307_read_time(struct tm *time) {
@@ -114,3 +130,39 @@ int ds1307_stop_clock(void) {
     if (sec < 0) return -1;
     return ds1307_write_register(DS1307_REG_SECONDS, sec | DS1307_CLOCK_HALT);
 }
+
+// SQW/OUT 핀 구형파 출력 (rate = DS1307_SQW_*)
+// 1Hz 설정 시 초 레지스터가 넘어가는 순간과 하강 에지가 맞춰집니다
+// 제어 레지스터는 읽고 해당 비트만 바꿔 씀 (OUT 레벨 등 다른 설정 유지)
+int ds1307_enable_square_wave(int rate) {
+    if (rate < DS1307_SQW_1HZ || rate > DS1307_SQW_32KHZ) return -1;
+
+    int ctrl = ds1307_read_register(DS1307_REG_CONTROL);
+    if (ctrl < 0) return -1;
+    ctrl = (ctrl & ~DS1307_SQW_RATE_MASK) | DS1307_CTRL_SQWE | rate;
+    return ds1307_write_register(DS1307_REG_CONTROL, (unsigned char)ctrl);
+}
+
+int ds1307_disable_square_wave(void) {
+    int ctrl = ds1307_read_register(DS1307_REG_CONTROL);
+    if (ctrl < 0) return -1;
+    return ds1307_write_register(DS1307_REG_CONTROL, (unsigned char)(ctrl & ~DS1307_CTRL_SQWE));
+}
+
+// 배터리 백업 RAM 읽기/쓰기 (offset 0 = 레지스터 0x08)
+// 주소 포인터가 자동 증가하므로 한 번의 트랜잭션으로 처리합니다
+int ds1307_read_ram(int offset, unsigned char *data, int len) {
+    if (offset < 0 || len <= 0 || offset + len > DS1307_RAM_SIZE) return -1;
+
+    return i2c_read_at(DS1307_REG_RAM + offset, data, len);
+}
+
+int ds1307_write_ram(int offset, const unsigned char *data, int len) {
+    if (offset < 0 || len <= 0 || offset + len > DS1307_RAM_SIZE) return -1;
+
+    return i2c_write_at(DS1307_REG_RAM + offset, data, len);
+}
+
+void ds1307_get_i2c_stats(i2c_stats_t *out) {
+    *out = i2c_stats;
+}
@@ -0,0 +1,145 @@
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "env_snapshot.h"
+
+// seq는 GCC 원자 내장 함수로 접근 (C99 빌드라 stdatomic 대신)
+static inline uint32_t seq_load_acquire(const uint32_t *seq) {
+    return __atomic_load_n(seq, __ATOMIC_ACQUIRE);
+}
+
+int env_snapshot_publisher_open(env_snapshot_publisher_t *pub, const char *name) {
+    env_snapshot_shm_t *shm;
+    int fd;
+
+    pub->shm = NULL;
+    fd = shm_open(name, O_CREAT | O_RDWR, 0644);
+    if (fd < 0) {
+        perror("❌ 스냅샷 공유 메모리 생성 실패");
+        return -1;
+    }
+    if (ftruncate(fd, sizeof(env_snapshot_shm_t)) != 0) {
+        perror("❌ 스냅샷 공유 메모리 크기 설정 실패");
+        close(fd);
+        return -1;
+    }
+
+    shm = mmap(NULL, sizeof(*shm), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (shm == MAP_FAILED) {
+        perror("❌ 스냅샷 공유 메모리 mmap 실패");
+        return -1;
+    }
+
+    // 이전 실행이 남긴 세그먼트면 seq를 이어 써서 읽는 쪽이 바뀐 것을 알게 함.
+    // 쓰는 도중 죽어 홀수로 남았으면 짝수로 맞춤
+    if (shm->magic != ENV_SNAPSHOT_MAGIC || shm->version != ENV_SNAPSHOT_VERSION ||
+        shm->size != sizeof(*shm)) {
+        memset(shm, 0, sizeof(*shm));
+        shm->version = ENV_SNAPSHOT_VERSION;
+        shm->size = sizeof(*shm);
+        __atomic_store_n(&shm->magic, ENV_SNAPSHOT_MAGIC, __ATOMIC_RELEASE);
+    } else if (shm->seq & 1) {
+        __atomic_store_n(&shm->seq, shm->seq + 1, __ATOMIC_RELEASE);
+    }
+    shm->publisher_pid = (uint32_t)getpid();
+
+    pub->shm = shm;
+    return 0;
+}
+
+void env_snapshot_publish(env_snapshot_publisher_t *pub, const env_snapshot_t *snap) {
+    env_snapshot_shm_t *shm = pub->shm;
+    uint32_t seq = shm->seq;            // 쓰는 쪽은 하나뿐이라 일반 읽기로 충분
+    uint64_t count = shm->data.publish_count;
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    __atomic_store_n(&shm->seq, seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);    // 홀수 seq가 내용보다 먼저 보이게
+
+    shm->data = *snap;
+    shm->data.publish_count = count + 1;
+    shm->data.publish_mono_ns = (uint64_t)now.tv_sec * 1000000000ull + (uint64_t)now.tv_nsec;
+
+    __atomic_store_n(&shm->seq, seq + 2, __ATOMIC_RELEASE);
+}
+
+void env_snapshot_publisher_close(env_snapshot_publisher_t *pub) {
+    if (!pub->shm) return;
+    __atomic_store_n(&pub->shm->publisher_pid, 0, __ATOMIC_RELEASE);
+    munmap(pub->shm, sizeof(*pub->shm));
+    pub->shm = NULL;
+}
+
+int env_snapshot_reader_open(env_snapshot_reader_t *reader, const char *name) {
+    const env_snapshot_shm_t *shm;
+    struct stat st;
+    int fd;
+
+    reader->shm = NULL;
+    fd = shm_open(name, O_RDONLY, 0);
+    if (fd < 0) {
+        perror("❌ 스냅샷 공유 메모리 열기 실패");
+        return -1;
+    }
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(*shm)) {
+        fprintf(stderr, "❌ 스냅샷 공유 메모리 크기 불일치: %s\n", name);
+        close(fd);
+        return -1;
+    }
+
+    shm = mmap(NULL, sizeof(*shm), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (shm == MAP_FAILED) {
+        perror("❌ 스냅샷 공유 메모리 mmap 실패");
+        return -1;
+    }
+    if (__atomic_load_n(&shm->magic, __ATOMIC_ACQUIRE) != ENV_SNAPSHOT_MAGIC ||
+        shm->version != ENV_SNAPSHOT_VERSION || shm->size != sizeof(*shm)) {
+        fprintf(stderr, "❌ 스냅샷 형식 불일치: %s\n", name);
+        munmap((void *)shm, sizeof(*shm));
+        return -1;
+    }
+
+    reader->shm = shm;
+    return 0;
+}
+
+int env_snapshot_read(const env_snapshot_reader_t *reader, env_snapshot_t *out) {
+    const env_snapshot_shm_t *shm = reader->shm;
+
+    for (int i = 0; i < ENV_SNAPSHOT_MAX_RETRIES; i++) {
+        uint32_t before = seq_load_acquire(&shm->seq);
+        if (before & 1) continue;           // 쓰는 중
+
+        memcpy(out, &shm->data, sizeof(*out));
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);    // 복사가 seq 재확인보다 먼저
+
+        if (__atomic_load_n(&shm->seq, __ATOMIC_RELAXED) == before) {
+            if (out->publish_count == 0) {
+                errno = ENODATA;
+                return -1;
+            }
+            return 0;
+        }
+    }
+    errno = EAGAIN;
+    return -1;
+}
+
+uint32_t env_snapshot_publisher_pid(const env_snapshot_reader_t *reader) {
+    return __atomic_load_n(&reader->shm->publisher_pid, __ATOMIC_ACQUIRE);
+}
+
+void env_snapshot_reader_close(env_snapshot_reader_t *reader) {
+    if (!reader->shm) return;
+    munmap((void *)reader->shm, sizeof(*reader->shm));
+    reader->shm = NULL;
+}
@@ -0,0 +1,108 @@
+#include "environment_indicator.h"
+#include <time.h>
+
+static const env_config_t default_config = ENV_CONFIG_DEFAULT;
+
+static const env_config_t *config_of(const env_status_t *status) {
+    return status->config ? status->config : &default_config;
+}
+
+// 구간 판정 (shrink만큼 안쪽으로 좁힌 구간 기준)
+static env_level_t classify(const env_band_t *band, int value, int shrink) {
+    if (value >= band->good_min + shrink && value <= band->good_max - shrink) {
+        return ENV_GOOD;
+    }
+    if (value >= band->warn_min + shrink && value <= band->warn_max - shrink) {
+        return ENV_WARNING;
+    }
+    return ENV_DANGER;
+}
+
+// 히스테리시스: 나빠지는 쪽은 즉시, 좋아지는 쪽은 여유 구간을 넘어야 전환
+static env_level_t update_axis(const env_band_t *band, int value, env_level_t current) {
+    env_level_t raw = classify(band, value, 0);
+    env_level_t strict;
+
+    if (raw >= current) return raw;
+
+    strict = classify(band, value, band->hysteresis);
+    return strict < current ? strict : current;
+}
+
+int64_t environment_now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+void environment_set_config(env_status_t *status, const env_config_t *config) {
+    status->config = config;
+    status->initialized = 0;    // 새 기준으로 다음 샘플부터 다시 판정
+}
+
+void update_environment_status_at(env_status_t *status, int temp_centi, int humi_centi,
+                                  int64_t now_ms) {
+    const env_config_t *config = config_of(status);
+    env_level_t base;
+
+    if (!status->initialized) {
+        // 첫 샘플은 히스테리시스 없이 그대로 판정
+        status->temp_level = classify(&config->temp, temp_centi, 0);
+        status->humi_level = classify(&config->humi, humi_centi, 0);
+        status->initialized = 1;
+    } else {
+        status->temp_level = update_axis(&config->temp, temp_centi, status->temp_level);
+        status->humi_level = update_axis(&config->humi, humi_centi, status->humi_level);
+    }
+
+    base = status->temp_level > status->humi_level ? status->temp_level : status->humi_level;
+
+    // 주의 지속 시간 승격 (단조 시계 기준)
+    if (base == ENV_WARNING) {
+        if (!status->warning_active) {
+            status->warning_active = 1;
+            status->warning_since_ms = now_ms;
+        }
+        status->prolonged_warning = (now_ms - status->warning_since_ms >= config->escalation_ms);
+    } else {
+        status->warning_active = 0;
+        status->prolonged_warning = 0;
+    }
+
+    status->overall_level = status->prolonged_warning ? ENV_DANGER : base;
+}
+
+void update_environment_status(env_status_t *status, int temp_centi, int humi_centi) {
+    update_environment_status_at(status, temp_centi, humi_centi, environment_now_ms());
+}
+
+int environment_warning_elapsed_s(const env_status_t *status) {
+    int64_t elapsed;
+
+    if (!status->warning_active) return 0;
+    elapsed = (environment_now_ms() - status->warning_since_ms) / 1000;
+    return elapsed > 0 ? (int)elapsed : 0;
+}
+
+void environment_restore_warning(env_status_t *status, int elapsed_s) {
+    status->warning_active = 1;
+    status->warning_since_ms = environment_now_ms() - (int64_t)elapsed_s * 1000;
+}
+
+const char *get_level_icon(env_level_t level) {
+    switch (level) {
+    case ENV_GOOD:    return ":)";
+    case ENV_WARNING: return ":|";
+    case ENV_DANGER:  return ":(";
+    }
+    return "?";
+}
+
+const char *get_level_text(env_level_t level) {
+    switch (level) {
+    case ENV_GOOD:    return "GOOD";
+    case ENV_WARNING: return "WARNING";
+    case ENV_DANGER:  return "DANGER";
+    }
+    return "UNKNOWN";
+}
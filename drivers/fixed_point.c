@@ -0,0 +1,175 @@
+#include <limits.h>
+#include "fixed_point.h"
+
+// 출력 커서 (버퍼가 차도 길이는 계속 셈)
+typedef struct {
+    char *buf;
+    size_t size;
+    size_t len;
+} fx_out_t;
+
+static void fx_putc(fx_out_t *out, char c) {
+    if (out->len + 1 < out->size) {
+        out->buf[out->len] = c;
+    }
+    out->len++;
+}
+
+static void fx_pad(fx_out_t *out, char c, int count) {
+    while (count-- > 0) fx_putc(out, c);
+}
+
+// 부호 없는 정수를 뒤에서부터 십진 문자열로 (반환: 자릿수)
+static int fx_utoa(unsigned long value, char *tmp) {
+    int n = 0;
+    do {
+        tmp[n++] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value);
+    return n;
+}
+
+// 부호, 정수부, 소수부를 폭에 맞춰 출력
+static void fx_emit_number(fx_out_t *out, int negative, unsigned long whole,
+                           unsigned long frac, int decimals,
+                           int width, int zero_pad, int left) {
+    char digits[24];
+    int n = fx_utoa(whole, digits);
+    int total = n + negative + (decimals > 0 ? decimals + 1 : 0);
+    int pad = width > total ? width - total : 0;
+
+    if (!left && !zero_pad) fx_pad(out, ' ', pad);
+    if (negative) fx_putc(out, '-');
+    if (!left && zero_pad) fx_pad(out, '0', pad);
+    while (n > 0) fx_putc(out, digits[--n]);
+
+    if (decimals > 0) {
+        char fdigits[4];
+        int i;
+        fx_putc(out, '.');
+        for (i = decimals - 1; i >= 0; i--) {
+            fdigits[i] = (char)('0' + frac % 10);
+            frac /= 10;
+        }
+        for (i = 0; i < decimals; i++) fx_putc(out, fdigits[i]);
+    }
+
+    if (left) fx_pad(out, ' ', pad);
+}
+
+static const unsigned long fx_step[3] = { 100, 10, 1 };
+
+// 크기(부호 없는 값)를 decimals 자리로 반올림 - INT_MIN의 크기도 넘치지 않음
+static unsigned long fx_round_mag(unsigned long mag, int decimals) {
+    unsigned long s = fx_step[decimals];
+    return (mag + s / 2) / s * s;
+}
+
+int fx_round_centi(int centi, int decimals) {
+    unsigned long mag, limit;
+
+    if (decimals >= 2) return centi;
+    if (decimals < 0) decimals = 0;
+
+    mag = centi < 0 ? 0UL - (unsigned long)centi : (unsigned long)centi;
+    limit = centi < 0 ? 0UL - (unsigned long)INT_MIN : (unsigned long)INT_MAX;
+    mag = fx_round_mag(mag, decimals);
+    // int 범위 끝에서는 0 쪽으로 (반환값이 넘치지 않게)
+    if (mag > limit) mag -= fx_step[decimals];
+    return centi < 0 ? (int)(0UL - mag) : (int)mag;
+}
+
+int fx_vformat(char *buf, size_t size, const char *fmt, va_list ap) {
+    fx_out_t out = { buf, size, 0 };
+
+    while (*fmt) {
+        int width = 0, zero_pad = 0, left = 0, precision = -1;
+
+        if (*fmt != '%') {
+            fx_putc(&out, *fmt++);
+            continue;
+        }
+        fmt++;
+
+        // 플래그, 폭, 정밀도
+        for (;; fmt++) {
+            if (*fmt == '0') zero_pad = 1;
+            else if (*fmt == '-') left = 1;
+            else break;
+        }
+        while (*fmt >= '0' && *fmt <= '9') width = width * 10 + (*fmt++ - '0');
+        if (*fmt == '.') {
+            precision = 0;
+            fmt++;
+            while (*fmt >= '0' && *fmt <= '9') precision = precision * 10 + (*fmt++ - '0');
+        }
+
+        switch (*fmt) {
+        case 'd': {
+            int v = va_arg(ap, int);
+            unsigned long mag = v < 0 ? 0UL - (unsigned long)v : (unsigned long)v;
+            fx_emit_number(&out, v < 0, mag, 0, 0, width, zero_pad, left);
+            break;
+        }
+        case 'u':
+            fx_emit_number(&out, 0, va_arg(ap, unsigned int), 0, 0, width, zero_pad, left);
+            break;
+        case 'q': {
+            int decimals = precision < 0 ? 1 : (precision > 2 ? 2 : precision);
+            int v = va_arg(ap, int);
+            // int로 되돌리지 않고 크기째 반올림 (INT_MIN/INT_MAX도 정확히 표시)
+            unsigned long mag = fx_round_mag(v < 0 ? 0UL - (unsigned long)v : (unsigned long)v,
+                                             decimals);
+            unsigned long frac = mag % FX_CENTI;
+            if (decimals == 1) frac /= 10;
+            fx_emit_number(&out, v < 0 && mag != 0, mag / FX_CENTI, frac, decimals,
+                           width, zero_pad, left);
+            break;
+        }
+        case 'c': {
+            char c = (char)va_arg(ap, int);
+            if (!left) fx_pad(&out, ' ', width - 1);
+            fx_putc(&out, c);
+            if (left) fx_pad(&out, ' ', width - 1);
+            break;
+        }
+        case 's': {
+            const char *s = va_arg(ap, const char *);
+            int len = 0;
+            if (!s) s = "(null)";
+            while (s[len] && (precision < 0 || len < precision)) len++;
+            if (!left) fx_pad(&out, ' ', width - len);
+            for (int i = 0; i < len; i++) fx_putc(&out, s[i]);
+            if (left) fx_pad(&out, ' ', width - len);
+            break;
+        }
+        case '%':
+            fx_putc(&out, '%');
+            break;
+        case '\0':
+            fmt--;  // 끝에 홀로 남은 '%'는 무시
+            break;
+        default:
+            // 지원하지 않는 변환은 그대로 출력
+            fx_putc(&out, '%');
+            fx_putc(&out, *fmt);
+            break;
+        }
+        fmt++;
+    }
+
+    if (size > 0) {
+        buf[out.len < size ? out.len : size - 1] = '\0';
+    }
+    return (int)out.len;
+}
+
+int fx_format(char *buf, size_t size, const char *fmt, ...) {
+    va_list ap;
+    int len;
+
+    va_start(ap, fmt);
+    len = fx_vformat(buf, size, fmt, ap);
+    va_end(ap);
+    return len;
+}
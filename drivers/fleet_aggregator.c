@@ -0,0 +1,728 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include "fleet_aggregator.h"
+
+#define LISTEN_TAG          UINT32_MAX
+#define POLL_EVENTS         256
+#define MAX_SMALL_FRAME     (FLEET_IN_BUF - sizeof(node_frame_t))
+
+// ---- 노드 시계열 ----
+
+static inline fleet_block_t *block_at(const fleet_node_t *n, uint32_t i) {
+    return n->blocks[(n->block_head + i) % n->block_cap];
+}
+
+static void open_block_reset(fleet_node_t *n) {
+    sample_encoder_init(&n->enc, n->open_data, sizeof(n->open_data));
+    history_agg_reset(&n->open_agg);
+    n->open_first = 0;
+}
+
+// 채우던 블록을 실제 길이만큼 복사해 링에 넣음 (가득 차면 가장 오래된 블록 재사용)
+static void seal_block(fleet_aggregator_t *agg, fleet_node_t *n) {
+    size_t len = sample_encoder_finish(&n->enc);
+    fleet_block_t *blk = malloc(sizeof(*blk) + len);
+
+    if (!blk) {
+        // 메모리 부족: 이 블록은 버리고 계속 받음
+        n->stored -= n->enc.count;
+        open_block_reset(n);
+        return;
+    }
+    blk->first_time = n->open_first;
+    blk->last_time = n->latest.time;
+    blk->count = n->enc.count;
+    blk->len = (uint16_t)len;
+    blk->agg = n->open_agg;
+    memcpy(blk->data, n->open_data, len);
+    agg->stats.store_bytes += sizeof(*blk) + len;
+
+    if (n->block_count == n->block_cap && n->block_cap < FLEET_NODE_MAX_BLOCKS) {
+        // 링을 두 배로 (순서대로 펴서 옮김)
+        uint32_t cap = n->block_cap ? n->block_cap * 2 : 4;
+        fleet_block_t **grown = malloc(cap * sizeof(*grown));
+        if (grown) {
+            for (uint32_t i = 0; i < n->block_count; i++) grown[i] = block_at(n, i);
+            free(n->blocks);
+            n->blocks = grown;
+            n->block_head = 0;
+            agg->stats.store_bytes += (cap - n->block_cap) * sizeof(*grown);
+            n->block_cap = cap;
+        }
+    }
+    if (n->block_count == n->block_cap) {
+        if (n->block_cap == 0) {
+            agg->stats.store_bytes -= sizeof(*blk) + len;
+            n->stored -= blk->count;
+            free(blk);
+            open_block_reset(n);
+            return;
+        }
+        fleet_block_t *old = n->blocks[n->block_head];
+        n->stored -= old->count;
+        agg->stats.store_bytes -= sizeof(*old) + old->len;
+        free(old);
+        n->block_head = (n->block_head + 1) % n->block_cap;
+        n->block_count--;
+    }
+    n->blocks[(n->block_head + n->block_count) % n->block_cap] = blk;
+    n->block_count++;
+    open_block_reset(n);
+}
+
+static void ingest(fleet_aggregator_t *agg, fleet_node_t *n, const sensor_sample_t *s) {
+    int64_t ms = sample_time_ms(s);
+
+    // 재접속 후 다시 온 샘플, 시계가 뒤로 간 샘플은 버림
+    if (ms <= n->last_ms) {
+        agg->stats.samples_dropped++;
+        return;
+    }
+    if (sample_encoder_add(&n->enc, s) != 0) {
+        seal_block(agg, n);
+        sample_encoder_add(&n->enc, s);
+    }
+    if (n->enc.count == 1) n->open_first = s->time;
+    history_agg_add(&n->open_agg, s);
+    n->last_ms = ms;
+    n->latest = *s;
+    n->stored++;
+    agg->stats.samples++;
+}
+
+// 마지막 샘플이 from 이후인 첫 블록 번호 (이분 탐색)
+static uint32_t first_block_from(const fleet_node_t *n, uint32_t from) {
+    uint32_t lo = 0, hi = n->block_count;
+
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if (block_at(n, mid)->last_time < from) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+static int decode_range(const uint8_t *data, size_t len, uint16_t count,
+                        int64_t from_ms, int64_t to_ms,
+                        sensor_sample_t *out, size_t max, size_t *n) {
+    sample_decoder_t dec;
+    sensor_sample_t s;
+
+    sample_decoder_init(&dec, data, len, count);
+    while (*n < max && sample_decoder_next(&dec, &s) == 1) {
+        int64_t ms = sample_time_ms(&s);
+        if (ms >= to_ms) return 1;
+        if (ms >= from_ms) out[(*n)++] = s;
+    }
+    return 0;
+}
+
+static void decode_agg(const uint8_t *data, size_t len, uint16_t count,
+                       uint32_t from, uint32_t to, history_agg_t *out) {
+    sample_decoder_t dec;
+    sensor_sample_t s;
+
+    sample_decoder_init(&dec, data, len, count);
+    while (sample_decoder_next(&dec, &s) == 1) {
+        if (s.time >= to) return;
+        if (s.time >= from) history_agg_add(out, &s);
+    }
+}
+
+static size_t node_range(const fleet_node_t *n, int64_t from_ms, int64_t to_ms,
+                         sensor_sample_t *out, size_t max) {
+    size_t count = 0;
+    uint32_t from = from_ms > 0 ? (uint32_t)(from_ms / 1000) : 0;
+
+    for (uint32_t i = first_block_from(n, from); i < n->block_count && count < max; i++) {
+        const fleet_block_t *blk = block_at(n, i);
+        if ((int64_t)blk->first_time * 1000 >= to_ms) return count;
+        if (decode_range(blk->data, blk->len, blk->count, from_ms, to_ms, out, max, &count)) {
+            return count;
+        }
+    }
+
+    // 채우는 중인 블록 (남은 비트를 임시로 내보낸 사본으로 풀기)
+    if (count < max && n->enc.count > 0) {
+        sample_encoder_t tmp = n->enc;
+        size_t len = sample_encoder_finish(&tmp);
+        decode_range(n->open_data, len, tmp.count, from_ms, to_ms, out, max, &count);
+    }
+    return count;
+}
+
+// 구간에 완전히 들어가는 블록은 미리 붙여 둔 집계로, 걸친 블록만 풀어서 집계
+static void node_agg(const fleet_node_t *n, uint32_t from, uint32_t to, history_agg_t *out) {
+    history_agg_reset(out);
+
+    for (uint32_t i = first_block_from(n, from); i < n->block_count; i++) {
+        const fleet_block_t *blk = block_at(n, i);
+        if (blk->first_time >= to) return;
+        if (blk->first_time >= from && blk->last_time < to) {
+            history_agg_merge(out, &blk->agg);
+        } else {
+            decode_agg(blk->data, blk->len, blk->count, from, to, out);
+        }
+    }
+
+    if (n->enc.count == 0 || n->latest.time < from || n->open_first >= to) return;
+    if (n->open_first >= from && n->latest.time < to) {
+        history_agg_merge(out, &n->open_agg);
+    } else {
+        sample_encoder_t tmp = n->enc;
+        size_t len = sample_encoder_finish(&tmp);
+        decode_agg(n->open_data, len, tmp.count, from, to, out);
+    }
+}
+
+// ---- 노드 등록 (node_id 해시, 선형 탐사) ----
+
+static inline uint32_t hash_id(uint32_t id) {
+    // 낮은 비트로 표를 고르므로 윗비트까지 섞음
+    id ^= id >> 16;
+    id *= 0x45D9F3Bu;
+    id ^= id >> 16;
+    return id;
+}
+
+static int32_t find_index(const fleet_aggregator_t *agg, uint32_t node_id) {
+    uint32_t mask = agg->table_size - 1;
+
+    if (agg->table_size == 0) return -1;
+    for (uint32_t i = hash_id(node_id) & mask;; i = (i + 1) & mask) {
+        uint32_t e = agg->table[i];
+        if (e == 0) return -1;
+        if (agg->nodes[e - 1]->node_id == node_id) return (int32_t)(e - 1);
+    }
+}
+
+static void table_insert(uint32_t *table, uint32_t size, uint32_t node_id, uint32_t index) {
+    uint32_t mask = size - 1;
+    uint32_t i = hash_id(node_id) & mask;
+
+    while (table[i] != 0) i = (i + 1) & mask;
+    table[i] = index + 1;
+}
+
+static int32_t add_node(fleet_aggregator_t *agg, uint32_t node_id) {
+    fleet_node_t *n;
+
+    // 부하율 1/2 이하 유지
+    if ((agg->node_count + 1) * 2 > agg->table_size) {
+        uint32_t size = agg->table_size ? agg->table_size * 2 : 1024;
+        uint32_t *table = calloc(size, sizeof(*table));
+        if (!table) return -1;
+        for (uint32_t i = 0; i < agg->node_count; i++) {
+            table_insert(table, size, agg->nodes[i]->node_id, i);
+        }
+        free(agg->table);
+        agg->table = table;
+        agg->table_size = size;
+    }
+    if (agg->node_count == agg->node_cap) {
+        uint32_t cap = agg->node_cap ? agg->node_cap * 2 : 256;
+        fleet_node_t **nodes = realloc(agg->nodes, cap * sizeof(*nodes));
+        if (!nodes) return -1;
+        agg->nodes = nodes;
+        agg->node_cap = cap;
+    }
+
+    n = calloc(1, sizeof(*n));
+    if (!n) return -1;
+    n->node_id = node_id;
+    n->conn = -1;
+    n->last_ms = -1;
+    open_block_reset(n);
+    agg->stats.store_bytes += sizeof(*n);
+
+    agg->nodes[agg->node_count] = n;
+    table_insert(agg->table, agg->table_size, node_id, agg->node_count);
+    return (int32_t)agg->node_count++;
+}
+
+// ---- 연결 ----
+
+static int out_pending(const fleet_conn_t *c) {
+    return c->out_len > c->out_off;
+}
+
+static void close_conn(fleet_aggregator_t *agg, uint32_t slot) {
+    fleet_conn_t *c = agg->conns[slot];
+
+    epoll_ctl(agg->epoll_fd, EPOLL_CTL_DEL, c->fd, NULL);
+    close(c->fd);
+    if (c->node >= 0) {
+        agg->nodes[c->node]->conn = -1;
+        agg->stats.nodes_connected--;
+    }
+    free(c->out);
+    free(c);
+    agg->conns[slot] = NULL;
+    agg->free_slots[agg->free_count++] = slot;
+    agg->stats.clients--;
+}
+
+// 응답 자리 확보 (질의 연결만 사용하므로 필요할 때 늘림)
+static uint8_t *out_reserve(fleet_conn_t *c, uint32_t len) {
+    if (c->out_len + len > c->out_cap) {
+        uint32_t cap = c->out_cap ? c->out_cap : 256;
+        while (cap < c->out_len + len) cap *= 2;
+        uint8_t *out = realloc(c->out, cap);
+        if (!out) return NULL;
+        c->out = out;
+        c->out_cap = cap;
+    }
+    return c->out + c->out_len;
+}
+
+static int reply(fleet_conn_t *c, uint8_t type, uint8_t status, const void *payload, uint32_t len) {
+    node_frame_t hdr = { NODE_PROTOCOL_MAGIC, type, status, len };
+    uint8_t *p = out_reserve(c, sizeof(hdr) + len);
+
+    if (!p) return -1;
+    memcpy(p, &hdr, sizeof(hdr));
+    if (len) memcpy(p + sizeof(hdr), payload, len);
+    c->out_len += sizeof(hdr) + len;
+    return 0;
+}
+
+static int handle_hello(fleet_aggregator_t *agg, uint32_t slot, const uint8_t *payload, uint32_t len) {
+    fleet_conn_t *c = agg->conns[slot];
+    node_hello_t hello;
+    fleet_node_t *n;
+    int32_t index;
+
+    if (len != sizeof(hello) || c->node >= 0) return -1;
+    memcpy(&hello, payload, sizeof(hello));
+    if (hello.node_id == 0) return -1;
+
+    index = find_index(agg, hello.node_id);
+    if (index < 0) index = add_node(agg, hello.node_id);
+    if (index < 0) return -1;
+
+    n = agg->nodes[index];
+    // 재접속했는데 이전 연결이 아직 살아 있으면 (끊김을 못 알아챈 경우) 정리
+    if (n->conn >= 0) close_conn(agg, (uint32_t)n->conn);
+    memcpy(n->room, hello.room, NODE_ROOM_LEN);
+    n->room[NODE_ROOM_LEN - 1] = '\0';
+    n->conn = (int32_t)slot;
+    c->node = index;
+    agg->stats.nodes_connected++;
+    return 0;
+}
+
+static int handle_list(fleet_aggregator_t *agg, fleet_conn_t *c) {
+    uint32_t len = agg->node_count * (uint32_t)sizeof(fleet_node_info_t);
+    node_frame_t hdr = { NODE_PROTOCOL_MAGIC, FLEET_MSG_LIST, NODE_OK, len };
+    uint8_t *p = out_reserve(c, sizeof(hdr) + len);
+
+    if (!p) return -1;
+    memcpy(p, &hdr, sizeof(hdr));
+    p += sizeof(hdr);
+    for (uint32_t i = 0; i < agg->node_count; i++, p += sizeof(fleet_node_info_t)) {
+        const fleet_node_t *n = agg->nodes[i];
+        fleet_node_info_t info;
+
+        memset(&info, 0, sizeof(info));
+        info.node_id = n->node_id;
+        memcpy(info.room, n->room, NODE_ROOM_LEN);
+        info.connected = n->conn >= 0;
+        info.sample_count = n->stored;
+        info.latest = n->latest;
+        memcpy(p, &info, sizeof(info));
+    }
+    c->out_len += sizeof(hdr) + len;
+    return 0;
+}
+
+static int handle_range(fleet_aggregator_t *agg, fleet_conn_t *c, const uint8_t *payload, uint32_t len) {
+    fleet_range_req_t req;
+    int32_t index;
+    const fleet_node_t *n;
+    size_t max, count;
+    node_frame_t hdr = { NODE_PROTOCOL_MAGIC, FLEET_MSG_RANGE, NODE_OK, 0 };
+    uint8_t *p;
+
+    if (len != sizeof(req)) return reply(c, FLEET_MSG_RANGE, NODE_ERR_BAD_REQUEST, NULL, 0);
+    memcpy(&req, payload, sizeof(req));
+    index = find_index(agg, req.node_id);
+    if (index < 0) return reply(c, FLEET_MSG_RANGE, NODE_ERR_NO_NODE, NULL, 0);
+
+    // 보관 중인 샘플 수가 상한이므로 그만큼만 잡고 그 자리에 바로 복원
+    n = agg->nodes[index];
+    max = n->stored;
+    if (req.max && req.max < max) max = req.max;
+    p = out_reserve(c, sizeof(hdr) + (uint32_t)(max * sizeof(sensor_sample_t)));
+    if (!p) return -1;
+
+    // 복원한 뒤 실제 개수로 헤더를 채움
+    count = node_range(n, (int64_t)req.from * 1000, (int64_t)req.to * 1000,
+                       (sensor_sample_t *)(void *)(p + sizeof(hdr)), max);
+    hdr.len = (uint32_t)(count * sizeof(sensor_sample_t));
+    memcpy(p, &hdr, sizeof(hdr));
+    c->out_len += sizeof(hdr) + hdr.len;
+    return 0;
+}
+
+static int handle_summary(fleet_aggregator_t *agg, fleet_conn_t *c, const uint8_t *payload, uint32_t len) {
+    fleet_summary_req_t req;
+    fleet_summary_t sum;
+
+    if (len != sizeof(req)) return reply(c, FLEET_MSG_SUMMARY, NODE_ERR_BAD_REQUEST, NULL, 0);
+    memcpy(&req, payload, sizeof(req));
+    fleet_aggregator_summary(agg, req.from, req.to, &sum);
+    return reply(c, FLEET_MSG_SUMMARY, NODE_OK, &sum, sizeof(sum));
+}
+
+static int handle_message(fleet_aggregator_t *agg, uint32_t slot, uint8_t type,
+                          const uint8_t *payload, uint32_t len) {
+    fleet_conn_t *c = agg->conns[slot];
+    fleet_stats_t st;
+
+    switch (type) {
+    case NODE_MSG_HELLO:
+        return handle_hello(agg, slot, payload, len);
+    case FLEET_MSG_LIST:
+        return handle_list(agg, c);
+    case FLEET_MSG_RANGE:
+        return handle_range(agg, c, payload, len);
+    case FLEET_MSG_SUMMARY:
+        return handle_summary(agg, c, payload, len);
+    case FLEET_MSG_STATS:
+        fleet_aggregator_stats(agg, &st);
+        return reply(c, FLEET_MSG_STATS, NODE_OK, &st, sizeof(st));
+    default:
+        return reply(c, type, NODE_ERR_BAD_REQUEST, NULL, 0);
+    }
+}
+
+// 받아 둔 바이트 처리 (반환: 0 계속, -1 프로토콜 오류 → 연결 닫음)
+static int process_input(fleet_aggregator_t *agg, uint32_t slot) {
+    fleet_conn_t *c = agg->conns[slot];
+    uint32_t used = 0;
+
+    for (;;) {
+        uint32_t avail = c->in_len - used;
+        node_frame_t hdr;
+
+        if (c->frame_left > 0) {
+            // SAMPLES 페이로드는 온 만큼 샘플 단위로 바로 저장
+            uint32_t take = (avail < c->frame_left ? avail : c->frame_left);
+            take -= take % sizeof(sensor_sample_t);
+            if (take == 0) break;
+
+            fleet_node_t *n = agg->nodes[c->node];
+            for (uint32_t off = 0; off < take; off += sizeof(sensor_sample_t)) {
+                sensor_sample_t s;
+                memcpy(&s, c->in + used + off, sizeof(s));
+                ingest(agg, n, &s);
+            }
+            used += take;
+            c->frame_left -= take;
+            continue;
+        }
+
+        // 응답을 다 보내기 전에는 다음 요청을 처리하지 않음
+        if (out_pending(c) || avail < sizeof(hdr)) break;
+        memcpy(&hdr, c->in + used, sizeof(hdr));
+        if (hdr.magic != NODE_PROTOCOL_MAGIC) return -1;
+
+        if (hdr.type == NODE_MSG_SAMPLES) {
+            if (c->node < 0 || hdr.len % sizeof(sensor_sample_t) != 0) return -1;
+            c->frame_left = hdr.len;
+            used += sizeof(hdr);
+            agg->stats.frames++;
+            continue;
+        }
+
+        if (hdr.len > MAX_SMALL_FRAME) return -1;
+        if (avail < sizeof(hdr) + hdr.len) break;
+        if (handle_message(agg, slot, hdr.type, c->in + used + sizeof(hdr), hdr.len) != 0) return -1;
+        used += sizeof(hdr) + hdr.len;
+        agg->stats.frames++;
+    }
+
+    if (used) {
+        memmove(c->in, c->in + used, c->in_len - used);
+        c->in_len -= used;
+    }
+    return 0;
+}
+
+// 응답 보내기 (반환: 0 계속, -1 연결 오류)
+static int flush_out(fleet_conn_t *c) {
+    while (out_pending(c)) {
+        ssize_t n = send(c->fd, c->out + c->out_off, c->out_len - c->out_off,
+                         MSG_NOSIGNAL | MSG_DONTWAIT);
+        if (n < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) return 0;
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        c->out_off += (uint32_t)n;
+    }
+    // 다 보냈으면 응답 버퍼 반납 (노드 연결은 응답이 없어 할당하지 않음)
+    free(c->out);
+    c->out = NULL;
+    c->out_cap = c->out_off = c->out_len = 0;
+    return 0;
+}
+
+// 응답 대기 중이면 입력을 멈추고 EPOLLOUT만 (바뀔 때만 epoll_ctl)
+static void update_interest(fleet_aggregator_t *agg, uint32_t slot) {
+    fleet_conn_t *c = agg->conns[slot];
+    uint32_t want = EPOLLRDHUP;
+    struct epoll_event ev;
+
+    if (out_pending(c)) {
+        want |= EPOLLOUT;
+    } else if (c->in_len < FLEET_IN_BUF) {
+        want |= EPOLLIN;
+    }
+    if (want == c->events) return;
+
+    ev.events = want;
+    ev.data.u32 = slot;
+    epoll_ctl(agg->epoll_fd, EPOLL_CTL_MOD, c->fd, &ev);
+    c->events = want;
+}
+
+// 읽을 수 있는 만큼 읽고 처리 (반환: 0 계속, -1 닫아야 함)
+static int service(fleet_aggregator_t *agg, uint32_t slot) {
+    fleet_conn_t *c = agg->conns[slot];
+
+    for (;;) {
+        if (process_input(agg, slot) != 0) return -1;
+        if (flush_out(c) != 0) return -1;
+        if (out_pending(c) || c->in_len == FLEET_IN_BUF) break;
+
+        ssize_t n = read(c->fd, c->in + c->in_len, FLEET_IN_BUF - c->in_len);
+        if (n > 0) {
+            c->in_len += (uint32_t)n;
+            agg->stats.bytes_in += (uint64_t)n;
+            continue;
+        }
+        if (n == 0) return -1;                  // 상대가 닫음 (받은 것은 이미 처리)
+        if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+        if (errno == EINTR) continue;
+        return -1;
+    }
+    update_interest(agg, slot);
+    return 0;
+}
+
+static void accept_clients(fleet_aggregator_t *agg) {
+    for (;;) {
+        struct epoll_event ev;
+        fleet_conn_t *c;
+        uint32_t slot;
+        int fd = accept(agg->listen_fd, NULL, NULL);
+
+        if (fd < 0) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR &&
+                errno != ECONNABORTED) {
+                perror("⚠️ 집계 서버 accept 실패");
+            }
+            return;
+        }
+        fcntl(fd, F_SETFL, O_NONBLOCK);
+        fcntl(fd, F_SETFD, FD_CLOEXEC);
+        if (agg->free_count == 0 || !(c = malloc(sizeof(*c)))) {
+            close(fd);                          // 슬롯/메모리 없음: 바로 끊음
+            continue;
+        }
+
+        slot = agg->free_slots[--agg->free_count];
+        memset(c, 0, offsetof(fleet_conn_t, in));
+        c->fd = fd;
+        c->node = -1;
+        c->events = EPOLLIN | EPOLLRDHUP;
+        ev.events = c->events;
+        ev.data.u32 = slot;
+        if (epoll_ctl(agg->epoll_fd, EPOLL_CTL_ADD, fd, &ev) != 0) {
+            perror("⚠️ 집계 서버 epoll 등록 실패");
+            close(fd);
+            free(c);
+            agg->free_slots[agg->free_count++] = slot;
+            continue;
+        }
+        agg->conns[slot] = c;
+        agg->stats.clients++;
+    }
+}
+
+int fleet_aggregator_open(fleet_aggregator_t *agg, const char *bind_addr, uint16_t port,
+                          uint32_t max_conns) {
+    struct sockaddr_in addr;
+    struct epoll_event ev;
+    int one = 1;
+
+    memset(agg, 0, sizeof(*agg));
+    agg->listen_fd = -1;
+    agg->epoll_fd = -1;
+    agg->max_conns = max_conns ? max_conns : FLEET_DEFAULT_MAX_CONNS;
+    agg->conns = calloc(agg->max_conns, sizeof(*agg->conns));
+    agg->free_slots = malloc(agg->max_conns * sizeof(*agg->free_slots));
+    if (!agg->conns || !agg->free_slots) {
+        fprintf(stderr, "❌ 집계 서버 연결 표 할당 실패\n");
+        goto fail;
+    }
+    for (uint32_t i = 0; i < agg->max_conns; i++) {
+        agg->free_slots[i] = agg->max_conns - 1 - i;
+    }
+    agg->free_count = agg->max_conns;
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    if (bind_addr && inet_pton(AF_INET, bind_addr, &addr.sin_addr) != 1) {
+        fprintf(stderr, "❌ 잘못된 수신 주소: %s\n", bind_addr);
+        goto fail;
+    }
+
+    agg->listen_fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (agg->listen_fd < 0) {
+        perror("❌ 집계 소켓 생성 실패");
+        goto fail;
+    }
+    setsockopt(agg->listen_fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    if (bind(agg->listen_fd, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+        perror("❌ 집계 소켓 bind 실패");
+        goto fail;
+    }
+    if (listen(agg->listen_fd, 4096) != 0) {
+        perror("❌ 집계 소켓 listen 실패");
+        goto fail;
+    }
+
+    agg->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (agg->epoll_fd < 0) {
+        perror("❌ epoll 생성 실패");
+        goto fail;
+    }
+    ev.events = EPOLLIN;
+    ev.data.u32 = LISTEN_TAG;
+    if (epoll_ctl(agg->epoll_fd, EPOLL_CTL_ADD, agg->listen_fd, &ev) != 0) {
+        perror("❌ epoll 등록 실패");
+        goto fail;
+    }
+    return 0;
+
+fail:
+    fleet_aggregator_close(agg);
+    return -1;
+}
+
+void fleet_aggregator_close(fleet_aggregator_t *agg) {
+    if (agg->conns) {
+        for (uint32_t i = 0; i < agg->max_conns; i++) {
+            if (agg->conns[i]) close_conn(agg, i);
+        }
+    }
+    for (uint32_t i = 0; i < agg->node_count; i++) {
+        fleet_node_t *n = agg->nodes[i];
+        for (uint32_t b = 0; b < n->block_count; b++) free(block_at(n, b));
+        free(n->blocks);
+        free(n);
+    }
+    free(agg->nodes);
+    free(agg->table);
+    free(agg->conns);
+    free(agg->free_slots);
+    agg->nodes = NULL;
+    agg->table = NULL;
+    agg->conns = NULL;
+    agg->free_slots = NULL;
+    agg->node_count = agg->node_cap = agg->table_size = 0;
+
+    if (agg->epoll_fd >= 0) {
+        close(agg->epoll_fd);
+        agg->epoll_fd = -1;
+    }
+    if (agg->listen_fd >= 0) {
+        close(agg->listen_fd);
+        agg->listen_fd = -1;
+    }
+}
+
+int fleet_aggregator_poll(fleet_aggregator_t *agg, int timeout_ms) {
+    struct epoll_event events[POLL_EVENTS];
+    int n = epoll_wait(agg->epoll_fd, events, POLL_EVENTS, timeout_ms);
+
+    if (n < 0) return errno == EINTR ? 0 : -1;
+    for (int i = 0; i < n; i++) {
+        uint32_t slot = events[i].data.u32;
+
+        if (slot == LISTEN_TAG) {
+            accept_clients(agg);
+            continue;
+        }
+        // 같은 묶음에서 앞선 이벤트가 닫은 연결이면 건너뜀
+        if (!agg->conns[slot]) continue;
+        if ((events[i].events & EPOLLERR) || service(agg, slot) != 0) {
+            close_conn(agg, slot);
+        }
+    }
+    return n;
+}
+
+const fleet_node_t *fleet_aggregator_find(const fleet_aggregator_t *agg, uint32_t node_id) {
+    int32_t index = find_index(agg, node_id);
+    return index < 0 ? NULL : agg->nodes[index];
+}
+
+size_t fleet_aggregator_range(const fleet_aggregator_t *agg, uint32_t node_id,
+                              int64_t from_ms, int64_t to_ms, sensor_sample_t *out, size_t max) {
+    const fleet_node_t *n = fleet_aggregator_find(agg, node_id);
+    return n ? node_range(n, from_ms, to_ms, out, max) : 0;
+}
+
+void fleet_aggregator_summary(const fleet_aggregator_t *agg, uint32_t from, uint32_t to,
+                              fleet_summary_t *out) {
+    int64_t warmest = 0, coldest = 0;
+    history_agg_t total;
+
+    memset(out, 0, sizeof(*out));
+    history_agg_reset(&total);
+    out->nodes = agg->node_count;
+    out->nodes_connected = agg->stats.nodes_connected;
+
+    for (uint32_t i = 0; i < agg->node_count; i++) {
+        const fleet_node_t *n = agg->nodes[i];
+        history_agg_t a;
+
+        node_agg(n, from, to, &a);
+        if (a.count == 0) continue;
+        history_agg_merge(&total, &a);
+
+        // 노드 평균 (0.01°C 정수)으로 가장 따뜻한/추운 방 비교
+        int64_t mean = a.temp_sum / a.count;
+        if (out->nodes_reporting == 0 || mean > warmest) {
+            warmest = mean;
+            out->warmest_node = n->node_id;
+        }
+        if (out->nodes_reporting == 0 || mean < coldest) {
+            coldest = mean;
+            out->coldest_node = n->node_id;
+        }
+        out->nodes_reporting++;
+    }
+    out->agg = total;
+}
+
+void fleet_aggregator_stats(const fleet_aggregator_t *agg, fleet_stats_t *out) {
+    *out = agg->stats;
+    out->nodes = agg->node_count;
+}
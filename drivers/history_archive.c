@@ -0,0 +1,251 @@
+#include <stdio.h>
+#include <stddef.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "history_archive.h"
+#include "history_store.h"
+
+#define CRC_OFFSET  offsetof(archive_block_header_t, magic)
+
+static archive_block_header_t *block_at(const history_archive_t *archive, uint64_t seq) {
+    return (archive_block_header_t *)(archive->map +
+                                      ((seq - 1) % archive->blocks) * HISTORY_ARCHIVE_BLOCK_SIZE);
+}
+
+static int block_valid(const archive_block_header_t *blk) {
+    return blk->magic == HISTORY_ARCHIVE_MAGIC &&
+           blk->version == HISTORY_ARCHIVE_VERSION &&
+           blk->count > 0 &&
+           blk->len <= HISTORY_ARCHIVE_PAYLOAD &&
+           blk->crc == history_crc32((const uint8_t *)blk + CRC_OFFSET,
+                                     sizeof(*blk) - CRC_OFFSET + blk->len);
+}
+
+// 기대한 순번의 유효한 블록인지 (덮어쓰다 끊긴 슬롯 걸러냄)
+static const archive_block_header_t *block_get(const history_archive_t *archive, uint64_t seq) {
+    const archive_block_header_t *blk = block_at(archive, seq);
+    return (blk->seq == seq && block_valid(blk)) ? blk : NULL;
+}
+
+static uint64_t oldest_seq(const history_archive_t *archive) {
+    return archive->next_seq > archive->blocks ? archive->next_seq - archive->blocks : 1;
+}
+
+int history_archive_open(history_archive_t *archive, const char *path, uint32_t blocks) {
+    struct stat st;
+    uint64_t max_seq = 0;
+
+    memset(archive, 0, sizeof(*archive));
+    archive->fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (archive->fd < 0) {
+        perror("❌ 아카이브 파일 열기 실패");
+        return -1;
+    }
+
+    if (fstat(archive->fd, &st) != 0) {
+        perror("❌ 아카이브 파일 정보 조회 실패");
+        goto fail;
+    }
+
+    if (st.st_size == 0) {
+        if (blocks == 0) blocks = HISTORY_ARCHIVE_DEFAULT_BLOCKS;
+        archive->map_size = (size_t)blocks * HISTORY_ARCHIVE_BLOCK_SIZE;
+        if (posix_fallocate(archive->fd, 0, (off_t)archive->map_size) != 0 &&
+            ftruncate(archive->fd, (off_t)archive->map_size) != 0) {
+            perror("❌ 아카이브 파일 할당 실패");
+            goto fail;
+        }
+    } else {
+        archive->map_size = (size_t)st.st_size;
+    }
+    archive->blocks = (uint32_t)(archive->map_size / HISTORY_ARCHIVE_BLOCK_SIZE);
+    if (archive->blocks == 0) {
+        fprintf(stderr, "❌ 아카이브 파일 크기 오류: %s\n", path);
+        goto fail;
+    }
+
+    archive->map = mmap(NULL, archive->map_size, PROT_READ | PROT_WRITE, MAP_SHARED,
+                        archive->fd, 0);
+    if (archive->map == MAP_FAILED) {
+        archive->map = NULL;
+        perror("❌ 아카이브 파일 mmap 실패");
+        goto fail;
+    }
+
+    // 전역 헤더 없이 슬롯 헤더 중 가장 큰 순번을 찾음 (열 때 한 번)
+    for (uint32_t i = 0; i < archive->blocks; i++) {
+        const archive_block_header_t *blk =
+            (const archive_block_header_t *)(archive->map + (size_t)i * HISTORY_ARCHIVE_BLOCK_SIZE);
+        if (block_valid(blk) && blk->seq > max_seq &&
+            (blk->seq - 1) % archive->blocks == i) {
+            max_seq = blk->seq;
+        }
+    }
+    archive->next_seq = max_seq + 1;
+
+    sample_encoder_init(&archive->enc, archive->open_block, sizeof(archive->open_block));
+    return 0;
+
+fail:
+    history_archive_close(archive);
+    return -1;
+}
+
+void history_archive_close(history_archive_t *archive) {
+    if (archive->map) {
+        history_archive_seal(archive);
+        munmap(archive->map, archive->map_size);
+        archive->map = NULL;
+    }
+    if (archive->fd >= 0) {
+        close(archive->fd);
+        archive->fd = -1;
+    }
+}
+
+int history_archive_seal(history_archive_t *archive) {
+    archive_block_header_t *blk;
+    archive_block_header_t hdr;
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    size_t offset, start;
+    size_t len;
+    int ret = 0;
+
+    if (archive->enc.count == 0) return 0;
+
+    len = sample_encoder_finish(&archive->enc);
+    blk = block_at(archive, archive->next_seq);
+
+    memset(&hdr, 0, sizeof(hdr));
+    hdr.magic = HISTORY_ARCHIVE_MAGIC;
+    hdr.version = HISTORY_ARCHIVE_VERSION;
+    hdr.count = archive->enc.count;
+    memcpy(&hdr.first_time, archive->open_block, sizeof(hdr.first_time));
+    hdr.last_time = archive->enc.prev.time;
+    hdr.seq = archive->next_seq;
+    hdr.len = (uint16_t)len;
+
+    memcpy((uint8_t *)blk + sizeof(hdr), archive->open_block, len);
+    memcpy(blk, &hdr, sizeof(hdr));
+    blk->crc = history_crc32((const uint8_t *)blk + CRC_OFFSET, sizeof(hdr) - CRC_OFFSET + len);
+
+    // 블록이 든 페이지만 디스크에 반영
+    // 실패해도 블록은 이미 공유 매핑에 있으므로 (커널이 나중에 씀) 다음 블록으로 넘어감.
+    // 끝난 비트 스트림에 이어 쓰면 올바른 CRC를 가진 깨진 블록이 되기 때문
+    offset = (size_t)((uint8_t *)blk - archive->map);
+    start = offset & ~(page - 1);
+    if (msync(archive->map + start, offset + HISTORY_ARCHIVE_BLOCK_SIZE - start, MS_SYNC) != 0) {
+        perror("❌ 아카이브 msync 실패");
+        ret = -1;
+    }
+
+    archive->next_seq++;
+    sample_encoder_init(&archive->enc, archive->open_block, sizeof(archive->open_block));
+    return ret;
+}
+
+int history_archive_append(history_archive_t *archive, const sensor_sample_t *sample) {
+    int ret = 0;
+
+    if (sample_encoder_add(&archive->enc, sample) == 0) return 0;
+
+    // 블록이 찼거나 시각이 끊김 → 봉인 후 새 블록에서 시작
+    ret = history_archive_seal(archive);
+    sample_encoder_add(&archive->enc, sample);
+    return ret;
+}
+
+// 가장 최근 봉인 블록의 마지막 샘플 시각 (ms, 봉인 블록이 없으면 -1)
+static int64_t last_sealed_ms(const history_archive_t *archive) {
+    const archive_block_header_t *blk;
+    sample_decoder_t dec;
+    sensor_sample_t s;
+    int64_t last_ms = -1;
+
+    if (archive->next_seq <= 1) return -1;
+    blk = block_get(archive, archive->next_seq - 1);
+    if (!blk) return -1;
+
+    // 헤더에는 초 단위만 있으므로 블록을 끝까지 풀어 ms까지 맞춤
+    sample_decoder_init(&dec, (const uint8_t *)blk + sizeof(*blk), blk->len, blk->count);
+    while (sample_decoder_next(&dec, &s) == 1) last_ms = sample_time_ms(&s);
+    return last_ms;
+}
+
+int history_archive_backfill(history_archive_t *archive, const history_store_t *raw) {
+    int64_t last_ms = archive->enc.count > 0 ? archive->enc.prev_ms : last_sealed_ms(archive);
+    uint32_t n = history_store_count(raw);
+    int added = 0;
+    int ret = 0;
+
+    if (last_ms < 0) return 0;
+
+    for (uint32_t i = history_store_lower_bound(raw, last_ms + 1); i < n; i++) {
+        if (history_archive_append(archive, history_store_get(raw, i)) != 0) ret = -1;
+        added++;
+    }
+    return ret < 0 ? -1 : added;
+}
+
+uint32_t history_archive_block_count(const history_archive_t *archive) {
+    return (uint32_t)(archive->next_seq - oldest_seq(archive));
+}
+
+// 블록 하나를 풀며 [from_ms, to_ms) 샘플을 복사 (반환: to_ms에 도달하면 1)
+static int decode_range(const uint8_t *data, size_t len, uint16_t count,
+                        int64_t from_ms, int64_t to_ms,
+                        sensor_sample_t *out, size_t max, size_t *n) {
+    sample_decoder_t dec;
+    sensor_sample_t s;
+
+    sample_decoder_init(&dec, data, len, count);
+    while (*n < max && sample_decoder_next(&dec, &s) == 1) {
+        int64_t ms = sample_time_ms(&s);
+        if (ms >= to_ms) return 1;
+        if (ms >= from_ms) out[(*n)++] = s;
+    }
+    return 0;
+}
+
+size_t history_archive_query(const history_archive_t *archive, int64_t from_ms, int64_t to_ms,
+                             sensor_sample_t *out, size_t max) {
+    uint64_t lo = oldest_seq(archive), hi = archive->next_seq;
+    size_t n = 0;
+
+    // 마지막 샘플이 from_ms 이후인 첫 블록 (이분 탐색, 무효 슬롯은 가장 오래된 것으로 취급)
+    while (lo < hi) {
+        uint64_t mid = lo + (hi - lo) / 2;
+        const archive_block_header_t *blk = block_get(archive, mid);
+        if (!blk || (int64_t)blk->last_time * 1000 + 999 < from_ms) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    for (uint64_t seq = lo; seq < archive->next_seq && n < max; seq++) {
+        const archive_block_header_t *blk = block_get(archive, seq);
+        if (!blk) continue;
+        if ((int64_t)blk->first_time * 1000 >= to_ms) return n;
+        if (decode_range((const uint8_t *)blk + sizeof(*blk), blk->len, blk->count,
+                         from_ms, to_ms, out, max, &n)) {
+            return n;
+        }
+    }
+
+    // 봉인 전 블록 (버퍼째 복사한 사본에 남은 비트를 내보내 풀기 - 원본 블록은 그대로)
+    if (n < max && archive->enc.count > 0) {
+        uint8_t block[HISTORY_ARCHIVE_PAYLOAD];
+        sample_encoder_t tmp = archive->enc;
+        size_t len;
+
+        memcpy(block, archive->open_block, archive->enc.len);
+        tmp.buf = block;
+        len = sample_encoder_finish(&tmp);
+        decode_range(block, len, tmp.count, from_ms, to_ms, out, max, &n);
+    }
+    return n;
+}
@@ -0,0 +1,165 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "history_index.h"
+
+// 물리 슬롯 [a, b) 직접 집계
+static void scan_slots(const history_store_t *store, uint32_t a, uint32_t b,
+                       history_agg_t *out) {
+    for (uint32_t i = a; i < b; i++) {
+        history_agg_add(out, &store->records[i]);
+    }
+}
+
+// 블록 잎 다시 계산 (조상은 갱신하지 않음)
+static void rebuild_leaf(history_index_t *idx, const history_store_t *store, uint32_t block) {
+    uint32_t a = block * HISTORY_INDEX_BLOCK;
+    uint32_t b = a + HISTORY_INDEX_BLOCK;
+    history_agg_t *leaf = &idx->tree[idx->blocks + block];
+
+    if (b > idx->capacity) b = idx->capacity;
+    history_agg_reset(leaf);
+    scan_slots(store, a, b, leaf);
+}
+
+static void update_parents(history_index_t *idx, uint32_t block) {
+    for (uint32_t p = (idx->blocks + block) >> 1; p >= 1; p >>= 1) {
+        idx->tree[p] = idx->tree[2 * p];
+        history_agg_merge(&idx->tree[p], &idx->tree[2 * p + 1]);
+    }
+}
+
+static void build(history_index_t *idx, const history_store_t *store) {
+    for (uint32_t b = 0; b < idx->blocks; b++) {
+        rebuild_leaf(idx, store, b);
+    }
+    for (uint32_t p = idx->blocks - 1; p >= 1; p--) {
+        idx->tree[p] = idx->tree[2 * p];
+        history_agg_merge(&idx->tree[p], &idx->tree[2 * p + 1]);
+    }
+    idx->head = store->hdr.head;
+    idx->count = store->hdr.count;
+    idx->appended = store->appended;
+}
+
+int history_index_init(history_index_t *idx, const history_store_t *store) {
+    memset(idx, 0, sizeof(*idx));
+    idx->capacity = store->hdr.capacity;
+    idx->blocks = (idx->capacity + HISTORY_INDEX_BLOCK - 1) / HISTORY_INDEX_BLOCK;
+
+    // 잎이 1개여도 루트(1)가 따로 있도록 최소 2잎
+    if (idx->blocks < 2) idx->blocks = 2;
+    idx->tree = malloc((size_t)idx->blocks * 2 * sizeof(history_agg_t));
+    if (!idx->tree) {
+        perror("❌ 이력 색인 메모리 할당 실패");
+        return -1;
+    }
+    history_agg_reset(&idx->tree[0]);
+    build(idx, store);
+    return 0;
+}
+
+void history_index_free(history_index_t *idx) {
+    free(idx->tree);
+    idx->tree = NULL;
+}
+
+void history_index_sync(history_index_t *idx, const history_store_t *store) {
+    uint32_t cap = idx->capacity;
+    uint32_t added, slot, last_block = UINT32_MAX;
+
+    if (store->hdr.capacity != cap || store->hdr.count < idx->count ||
+        store->appended - idx->appended >= cap) {
+        // 다른 링이거나 비워짐, 또는 한 바퀴 넘게 밀려 head 차이로는 알 수 없음
+        history_index_free(idx);
+        history_index_init(idx, store);
+        return;
+    }
+
+    added = (store->hdr.head + cap - idx->head) % cap;
+    if (added == 0 && store->hdr.count == idx->count) return;
+    if (added == 0) added = cap;        // 정확히 한 바퀴
+
+    // 새 슬롯이 걸친 블록마다 잎 1회 + 조상 갱신 (연속 슬롯은 같은 블록을 공유)
+    slot = idx->head;
+    for (uint32_t i = 0; i < added; i++) {
+        uint32_t block = slot / HISTORY_INDEX_BLOCK;
+        if (block != last_block) {
+            rebuild_leaf(idx, store, block);
+            update_parents(idx, block);
+            last_block = block;
+        }
+        slot = (slot + 1 == cap) ? 0 : slot + 1;
+    }
+
+    idx->head = store->hdr.head;
+    idx->count = store->hdr.count;
+    idx->appended = store->appended;
+}
+
+// 물리 슬롯 [a, b) 집계: 양끝 걸친 블록은 직접, 가운데 온전한 블록은 트리로
+static void query_slots(const history_index_t *idx, const history_store_t *store,
+                        uint32_t a, uint32_t b, history_agg_t *out) {
+    uint32_t first_block = (a + HISTORY_INDEX_BLOCK - 1) / HISTORY_INDEX_BLOCK;
+    uint32_t end_block = b / HISTORY_INDEX_BLOCK;
+    uint32_t l, r;
+
+    // 마지막 블록이 링 끝에서 잘린 경우 b == capacity면 온전한 블록으로 취급
+    if (b == idx->capacity) end_block = idx->blocks;
+
+    if (first_block >= end_block) {
+        scan_slots(store, a, b, out);
+        return;
+    }
+
+    scan_slots(store, a, first_block * HISTORY_INDEX_BLOCK, out);
+    if (end_block < idx->blocks) {
+        scan_slots(store, end_block * HISTORY_INDEX_BLOCK, b, out);
+    }
+
+    for (l = first_block + idx->blocks, r = end_block + idx->blocks; l < r; l >>= 1, r >>= 1) {
+        if (l & 1) history_agg_merge(out, &idx->tree[l++]);
+        if (r & 1) history_agg_merge(out, &idx->tree[--r]);
+    }
+}
+
+uint32_t history_index_range(const history_index_t *idx, const history_store_t *store,
+                             uint32_t first, uint32_t last, history_agg_t *out) {
+    uint32_t cap = idx->capacity;
+    uint32_t tail, start, len;
+
+    history_agg_reset(out);
+    if (last > idx->count) last = idx->count;
+    if (first >= last) return 0;
+
+    tail = (idx->head + cap - idx->count) % cap;
+    start = (tail + first) % cap;
+    len = last - first;
+
+    if (start + len <= cap) {
+        query_slots(idx, store, start, start + len, out);
+    } else {
+        query_slots(idx, store, start, cap, out);
+        query_slots(idx, store, 0, start + len - cap, out);
+    }
+    return out->count;
+}
+
+uint32_t history_index_query(const history_index_t *idx, const history_store_t *store,
+                             int64_t from_ms, int64_t to_ms, history_agg_t *out) {
+    uint32_t first = history_store_lower_bound(store, from_ms);
+    uint32_t last = history_store_lower_bound(store, to_ms);
+    return history_index_range(idx, store, first, last, out);
+}
+
+int history_agg_temp_mean(const history_agg_t *agg) {
+    int64_t half;
+    if (agg->count == 0) return 0;
+    half = agg->count / 2;
+    return (int)((agg->temp_sum + (agg->temp_sum < 0 ? -half : half)) / (int64_t)agg->count);
+}
+
+int history_agg_humi_mean(const history_agg_t *agg) {
+    if (agg->count == 0) return 0;
+    return (int)((agg->humi_sum + agg->count / 2) / agg->count);
+}
@@ -0,0 +1,392 @@
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "history_rollup.h"
+
+static const uint32_t level_seconds[ROLLUP_LEVELS] = { 60, 3600, 86400 };
+static const uint32_t level_capacity[ROLLUP_LEVELS] = {
+    ROLLUP_MINUTE_BUCKETS, ROLLUP_HOUR_BUCKETS, ROLLUP_DAY_BUCKETS
+};
+
+static size_t page_size(void) {
+    static size_t size = 0;
+    if (!size) size = (size_t)sysconf(_SC_PAGESIZE);
+    return size;
+}
+
+static size_t file_size(void) {
+    size_t size = page_size();
+    for (int l = 0; l < ROLLUP_LEVELS; l++) {
+        size += (size_t)level_capacity[l] * sizeof(rollup_bucket_t);
+    }
+    return size;
+}
+
+static int header_valid(const rollup_header_t *hdr) {
+    if (hdr->magic != HISTORY_ROLLUP_MAGIC || hdr->version != HISTORY_ROLLUP_VERSION ||
+        hdr->levels != ROLLUP_LEVELS) {
+        return 0;
+    }
+    for (int l = 0; l < ROLLUP_LEVELS; l++) {
+        if (hdr->level[l].seconds != level_seconds[l] ||
+            hdr->level[l].capacity != level_capacity[l] ||
+            hdr->level[l].head >= level_capacity[l] ||
+            hdr->level[l].count > level_capacity[l]) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static void init_header(rollup_header_t *hdr) {
+    memset(hdr, 0, sizeof(*hdr));
+    hdr->magic = HISTORY_ROLLUP_MAGIC;
+    hdr->version = HISTORY_ROLLUP_VERSION;
+    hdr->levels = ROLLUP_LEVELS;
+    for (int l = 0; l < ROLLUP_LEVELS; l++) {
+        hdr->level[l].seconds = level_seconds[l];
+        hdr->level[l].capacity = level_capacity[l];
+    }
+}
+
+static int sync_all(history_rollup_t *rollup) {
+    if (msync(rollup->map, rollup->map_size, MS_SYNC) != 0) {
+        perror("❌ 요약 msync 실패");
+        return -1;
+    }
+    return 0;
+}
+
+// 가장 최근 구간 (없으면 NULL)
+static rollup_bucket_t *last_bucket(const history_rollup_t *rollup, int level) {
+    const rollup_level_info_t *lv = &rollup->hdr->level[level];
+    if (lv->count == 0) return NULL;
+    return &rollup->buckets[level][(lv->head + lv->capacity - 1) % lv->capacity];
+}
+
+static void bucket_start(rollup_bucket_t *b, uint32_t start, const sensor_sample_t *s) {
+    b->start = start;
+    b->count = 1;
+    b->temp_sum = s->temp_centi;
+    b->humi_sum = s->humi_centi;
+    b->temp_min = b->temp_max = s->temp_centi;
+    b->humi_min = b->humi_max = s->humi_centi;
+}
+
+static void add_to_level(history_rollup_t *rollup, int level, const sensor_sample_t *s) {
+    rollup_level_info_t *lv = &rollup->hdr->level[level];
+    uint32_t start = s->time - s->time % lv->seconds;
+    rollup_bucket_t *b = last_bucket(rollup, level);
+
+    // 같은 구간이거나 시각이 역행하면 (RTC 재동기 등) 현재 구간에 합침
+    if (b && start <= b->start) {
+        b->count++;
+        b->temp_sum += s->temp_centi;
+        b->humi_sum += s->humi_centi;
+        if (s->temp_centi < b->temp_min) b->temp_min = s->temp_centi;
+        if (s->temp_centi > b->temp_max) b->temp_max = s->temp_centi;
+        if (s->humi_centi < b->humi_min) b->humi_min = s->humi_centi;
+        if (s->humi_centi > b->humi_max) b->humi_max = s->humi_centi;
+        return;
+    }
+
+    // 새 구간 (빈 시간대는 구간을 만들지 않음 - 조회가 시작 시각으로 구분)
+    bucket_start(&rollup->buckets[level][lv->head], start, s);
+    lv->head = (lv->head + 1) % lv->capacity;
+    if (lv->count < lv->capacity) lv->count++;
+}
+
+// raw가 덮는 시간대의 구간을 버리고 raw에서 다시 만듦
+static void rebuild_from_raw(history_rollup_t *rollup, const history_store_t *raw) {
+    uint32_t n = history_store_count(raw);
+    uint32_t cutoff[ROLLUP_LEVELS];
+    uint32_t oldest, first_cutoff = UINT32_MAX;
+    uint32_t replayed = 0;
+
+    if (n == 0) return;
+    oldest = history_store_get(raw, 0)->time;
+
+    for (int l = 0; l < ROLLUP_LEVELS; l++) {
+        rollup_level_info_t *lv = &rollup->hdr->level[l];
+        rollup_bucket_t *b;
+
+        // raw에 샘플이 온전히 남아 있는 첫 구간부터 다시 만듦
+        cutoff[l] = (oldest + lv->seconds - 1) / lv->seconds * lv->seconds;
+        if (cutoff[l] < first_cutoff) first_cutoff = cutoff[l];
+
+        // 디스크에 반영되지 못한 구간(0이나 이전 순환의 값)은 바로 앞 구간보다
+        // 시작 시각이 늦지 않으므로 함께 버림
+        while ((b = last_bucket(rollup, l)) != NULL) {
+            const rollup_bucket_t *older = lv->count > 1 ?
+                history_rollup_get(rollup, l, lv->count - 2) : NULL;
+            if (b->start < cutoff[l] && b->count > 0 && (!older || b->start > older->start)) {
+                break;
+            }
+            lv->head = (lv->head + lv->capacity - 1) % lv->capacity;
+            lv->count--;
+        }
+    }
+
+    for (uint32_t i = history_store_lower_bound(raw, (int64_t)first_cutoff * 1000); i < n; i++) {
+        const sensor_sample_t *s = history_store_get(raw, i);
+        if (!(s->flags & SAMPLE_FLAG_VALID)) continue;
+        for (int l = 0; l < ROLLUP_LEVELS; l++) {
+            if (s->time >= cutoff[l]) add_to_level(rollup, l, s);
+        }
+        replayed++;
+    }
+    printf("ℹ️ 원본 이력에서 요약 재구성: 샘플 %u개\n", replayed);
+}
+
+int history_rollup_open(history_rollup_t *rollup, const char *path,
+                        const history_store_t *raw) {
+    struct stat st;
+    int fresh = 0;
+    uint8_t *p;
+
+    memset(rollup, 0, sizeof(*rollup));
+    rollup->fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (rollup->fd < 0) {
+        perror("❌ 요약 파일 열기 실패");
+        return -1;
+    }
+
+    if (fstat(rollup->fd, &st) != 0) {
+        perror("❌ 요약 파일 정보 조회 실패");
+        goto fail;
+    }
+
+    rollup->map_size = file_size();
+    if ((size_t)st.st_size != rollup->map_size) {
+        // 새 파일이거나 단계 구성이 바뀜: 전체 크기를 미리 할당하고 새로 시작
+        if (ftruncate(rollup->fd, 0) != 0 ||
+            (posix_fallocate(rollup->fd, 0, (off_t)rollup->map_size) != 0 &&
+             ftruncate(rollup->fd, (off_t)rollup->map_size) != 0)) {
+            perror("❌ 요약 파일 할당 실패");
+            goto fail;
+        }
+        fresh = 1;
+    }
+
+    rollup->map = mmap(NULL, rollup->map_size, PROT_READ | PROT_WRITE, MAP_SHARED,
+                       rollup->fd, 0);
+    if (rollup->map == MAP_FAILED) {
+        rollup->map = NULL;
+        perror("❌ 요약 파일 mmap 실패");
+        goto fail;
+    }
+
+    rollup->hdr = (rollup_header_t *)rollup->map;
+    p = rollup->map + page_size();
+    for (int l = 0; l < ROLLUP_LEVELS; l++) {
+        rollup->buckets[l] = (rollup_bucket_t *)p;
+        p += (size_t)level_capacity[l] * sizeof(rollup_bucket_t);
+    }
+
+    if (!fresh && !header_valid(rollup->hdr)) {
+        fprintf(stderr, "⚠️ 요약 헤더 손상 - 새로 만듭니다: %s\n", path);
+        fresh = 1;
+    }
+    if (fresh) init_header(rollup->hdr);
+
+    // 새로 만들었거나 정상 종료 표시가 없으면 raw가 덮는 구간을 재구성
+    if ((fresh || !rollup->hdr->clean) && raw) {
+        rebuild_from_raw(rollup, raw);
+    }
+
+    // 열려 있는 동안은 비정상 종료로 간주되도록 표시를 먼저 지움
+    rollup->hdr->clean = 0;
+    if (sync_all(rollup) != 0) goto fail;
+    return 0;
+
+fail:
+    history_rollup_close(rollup);
+    return -1;
+}
+
+void history_rollup_close(history_rollup_t *rollup) {
+    if (rollup->map) {
+        // 구간 먼저, 그 다음 정상 종료 표시
+        if (sync_all(rollup) == 0) {
+            rollup->hdr->clean = 1;
+            sync_all(rollup);
+        }
+        munmap(rollup->map, rollup->map_size);
+        rollup->map = NULL;
+    }
+    if (rollup->fd >= 0) {
+        close(rollup->fd);
+        rollup->fd = -1;
+    }
+}
+
+void history_rollup_add(history_rollup_t *rollup, const sensor_sample_t *sample) {
+    if (!(sample->flags & SAMPLE_FLAG_VALID)) return;
+    for (int l = 0; l < ROLLUP_LEVELS; l++) {
+        add_to_level(rollup, l, sample);
+    }
+}
+
+uint32_t history_rollup_seconds(rollup_level_t level) {
+    return level < ROLLUP_LEVELS ? level_seconds[level] : 0;
+}
+
+uint32_t history_rollup_count(const history_rollup_t *rollup, rollup_level_t level) {
+    return level < ROLLUP_LEVELS ? rollup->hdr->level[level].count : 0;
+}
+
+const rollup_bucket_t *history_rollup_get(const history_rollup_t *rollup,
+                                          rollup_level_t level, uint32_t i) {
+    const rollup_level_info_t *lv;
+
+    if (level >= ROLLUP_LEVELS) return NULL;
+    lv = &rollup->hdr->level[level];
+    if (i >= lv->count) return NULL;
+    return &rollup->buckets[level][(lv->head + lv->capacity - lv->count + i) % lv->capacity];
+}
+
+// 시작 시각이 from 이상인 첫 구간 위치 (이분 탐색)
+static uint32_t bucket_lower_bound(const history_rollup_t *rollup, int level, uint32_t from) {
+    uint32_t lo = 0, hi = rollup->hdr->level[level].count;
+
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if (history_rollup_get(rollup, level, mid)->start < from) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+// 단계별 가장 오래된 데이터 시각 (raw = -1, 데이터 없으면 UINT32_MAX)
+static uint32_t oldest_time(const history_rollup_t *rollup, const history_store_t *raw,
+                            int level) {
+    if (level < 0) {
+        return history_store_count(raw) ? history_store_get(raw, 0)->time : UINT32_MAX;
+    }
+    return rollup->hdr->level[level].count ? history_rollup_get(rollup, level, 0)->start
+                                           : UINT32_MAX;
+}
+
+static int pick_level(const history_rollup_t *rollup, const history_store_t *raw,
+                      uint32_t from, uint32_t column_s) {
+    int level = raw ? -1 : ROLLUP_MINUTE;
+
+    for (int l = 0; l < ROLLUP_LEVELS; l++) {
+        if (level_seconds[l] <= column_s) level = l;
+    }
+
+    // from까지 거슬러 가지 못하면, 구간 하나 이상 더 오래된 데이터를 가진
+    // 거친 단계로 넘어감 (막 설치한 장치가 1일 단계로 떨어지지 않도록)
+    while (level < ROLLUP_LEVELS - 1) {
+        uint32_t have = oldest_time(rollup, raw, level);
+        uint32_t next = oldest_time(rollup, raw, level + 1);
+
+        if (have <= from || next == UINT32_MAX ||
+            (uint64_t)next + level_seconds[level + 1] > have) {
+            break;
+        }
+        level++;
+    }
+    return level;
+}
+
+// 열 누적 (열 순서로만 들어오므로 합계는 현재 열 하나만 유지)
+typedef struct {
+    rollup_point_t *out;
+    int column;
+    int64_t temp_sum;
+    int64_t humi_sum;
+} column_acc_t;
+
+static void column_flush(column_acc_t *acc) {
+    rollup_point_t *pt;
+
+    if (acc->column < 0) return;
+    pt = &acc->out[acc->column];
+    if (pt->count > 0) {
+        int64_t half = pt->count / 2;
+        pt->temp_mean = (int16_t)((acc->temp_sum + (acc->temp_sum < 0 ? -half : half)) /
+                                  (int64_t)pt->count);
+        pt->humi_mean = (uint16_t)((acc->humi_sum + half) / (int64_t)pt->count);
+    }
+    acc->temp_sum = 0;
+    acc->humi_sum = 0;
+}
+
+static void column_add(column_acc_t *acc, int column, uint32_t count,
+                       int64_t temp_sum, int64_t humi_sum,
+                       int temp_min, int temp_max, int humi_min, int humi_max) {
+    rollup_point_t *pt = &acc->out[column];
+
+    if (column != acc->column) {
+        column_flush(acc);
+        acc->column = column;
+    }
+    if (pt->count == 0) {
+        pt->temp_min = (int16_t)temp_min;
+        pt->temp_max = (int16_t)temp_max;
+        pt->humi_min = (uint16_t)humi_min;
+        pt->humi_max = (uint16_t)humi_max;
+    } else {
+        if (temp_min < pt->temp_min) pt->temp_min = (int16_t)temp_min;
+        if (temp_max > pt->temp_max) pt->temp_max = (int16_t)temp_max;
+        if (humi_min < pt->humi_min) pt->humi_min = (uint16_t)humi_min;
+        if (humi_max > pt->humi_max) pt->humi_max = (uint16_t)humi_max;
+    }
+    pt->count += count;
+    acc->temp_sum += temp_sum;
+    acc->humi_sum += humi_sum;
+}
+
+static int column_of(uint32_t t, uint32_t from, uint32_t to, unsigned width) {
+    if (t <= from) return 0;
+    return (int)((uint64_t)(t - from) * width / (to - from));
+}
+
+int history_rollup_query(const history_rollup_t *rollup, const history_store_t *raw,
+                         uint32_t from, uint32_t to, rollup_point_t *out, unsigned width) {
+    column_acc_t acc = { out, -1, 0, 0 };
+    int level;
+
+    if (width == 0 || to <= from) return -1;
+
+    memset(out, 0, (size_t)width * sizeof(*out));
+    for (unsigned i = 0; i < width; i++) {
+        out[i].start = from + (uint32_t)((uint64_t)(to - from) * i / width);
+    }
+
+    level = pick_level(rollup, raw, from, (to - from) / width);
+
+    if (level < 0) {
+        uint32_t n = history_store_count(raw);
+        for (uint32_t i = history_store_lower_bound(raw, (int64_t)from * 1000); i < n; i++) {
+            const sensor_sample_t *s = history_store_get(raw, i);
+            if (s->time >= to) break;
+            if (!(s->flags & SAMPLE_FLAG_VALID)) continue;
+            column_add(&acc, column_of(s->time, from, to, width), 1,
+                       s->temp_centi, s->humi_centi,
+                       s->temp_centi, s->temp_centi, s->humi_centi, s->humi_centi);
+        }
+        column_flush(&acc);
+        return 0;
+    }
+
+    // from이 걸친 구간도 포함 (구간 시작이 from보다 이르면 첫 열로)
+    uint32_t n = rollup->hdr->level[level].count;
+    for (uint32_t i = bucket_lower_bound(rollup, level, from - from % level_seconds[level]);
+         i < n; i++) {
+        const rollup_bucket_t *b = history_rollup_get(rollup, level, i);
+        if (b->start >= to) break;
+        column_add(&acc, column_of(b->start, from, to, width), b->count,
+                   b->temp_sum, b->humi_sum,
+                   b->temp_min, b->temp_max, b->humi_min, b->humi_max);
+    }
+    column_flush(&acc);
+    return (int)level_seconds[level];
+}
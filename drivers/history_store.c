@@ -0,0 +1,338 @@
+#include <stdio.h>
+#include <stddef.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "history_store.h"
+
+#define HISTORY_SLOT_COUNT 2
+
+static size_t page_size(void) {
+    static size_t size = 0;
+    if (!size) size = (size_t)sysconf(_SC_PAGESIZE);
+    return size;
+}
+
+// CRC-32 (IEEE 802.3, 반사형). 헤더/12바이트 샘플/블록 봉인에만 쓰므로 테이블 없이 계산
+uint32_t history_crc32(const void *buf, size_t len) {
+    const uint8_t *data = buf;
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < len; i++) {
+        crc ^= data[i];
+        for (int b = 0; b < 8; b++) {
+            crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1)));
+        }
+    }
+    return ~crc;
+}
+
+static history_header_t *slot_header(const history_store_t *store, int slot) {
+    return (history_header_t *)(store->map + (size_t)slot * page_size());
+}
+
+static int header_valid(const history_header_t *hdr) {
+    return hdr->magic == HISTORY_STORE_MAGIC &&
+           hdr->version == HISTORY_STORE_VERSION &&
+           hdr->record_size == sizeof(sensor_sample_t) &&
+           hdr->capacity > 0 &&
+           hdr->head < hdr->capacity &&
+           hdr->count <= hdr->capacity &&
+           hdr->crc == history_crc32(hdr, offsetof(history_header_t, crc));
+}
+
+#define HISTORY_SLOT_BYTES (sizeof(sensor_sample_t) + sizeof(uint32_t))   // 샘플 + CRC
+
+static size_t file_size_for(uint32_t capacity) {
+    return HISTORY_SLOT_COUNT * page_size() + (size_t)capacity * HISTORY_SLOT_BYTES;
+}
+
+// 맵의 [offset, offset + len) 구간을 디스크에 반영 (페이지 단위로 정렬)
+static int sync_range(history_store_t *store, size_t offset, size_t len) {
+    size_t start = offset & ~(page_size() - 1);
+
+    if (len == 0) return 0;
+    if (msync(store->map + start, offset + len - start, MS_SYNC) != 0) {
+        perror("❌ 이력 msync 실패");
+        return -1;
+    }
+    return 0;
+}
+
+static size_t record_offset(uint32_t index) {
+    return HISTORY_SLOT_COUNT * page_size() + (size_t)index * sizeof(sensor_sample_t);
+}
+
+static size_t crc_offset(const history_store_t *store, uint32_t index) {
+    return record_offset(store->hdr.capacity) + (size_t)index * sizeof(uint32_t);
+}
+
+// 링 슬롯 [first, first + n)의 샘플과 CRC를 디스크에 반영
+static int sync_slots(history_store_t *store, uint32_t first, uint32_t n) {
+    if (sync_range(store, record_offset(first), (size_t)n * sizeof(sensor_sample_t)) != 0) {
+        return -1;
+    }
+    return sync_range(store, crc_offset(store, first), (size_t)n * sizeof(uint32_t));
+}
+
+static uint32_t record_crc(const sensor_sample_t *rec) {
+    return history_crc32(rec, sizeof(*rec));
+}
+
+static int write_header(history_store_t *store) {
+    history_header_t *slot = slot_header(store, store->next_slot);
+
+    store->hdr.seq++;
+    store->hdr.crc = history_crc32(&store->hdr,
+                                   offsetof(history_header_t, crc));
+    memcpy(slot, &store->hdr, sizeof(store->hdr));
+    if (sync_range(store, (size_t)store->next_slot * page_size(), sizeof(store->hdr)) != 0) {
+        return -1;
+    }
+    store->next_slot = (store->next_slot + 1) % HISTORY_SLOT_COUNT;
+    return 0;
+}
+
+static uint32_t tail_index(const history_store_t *store) {
+    return (store->hdr.head + store->hdr.capacity - store->hdr.count) % store->hdr.capacity;
+}
+
+// 마지막 커밋 이후에 추가됐지만 헤더에 반영되지 못한 샘플 복구:
+// head부터 CRC가 맞고 시각이 이어지는(직전 샘플 이후인) 기록만 받아들이고,
+// 쓰다 끊긴 기록(샘플/CRC 중 한쪽만 디스크에 남음)을 만나면 거기서 자름
+static uint32_t recover_tail(history_store_t *store) {
+    history_header_t *hdr = &store->hdr;
+    int64_t last_ms = -1;
+    uint32_t recovered = 0;
+
+    if (hdr->count > 0) {
+        uint32_t last = (hdr->head + hdr->capacity - 1) % hdr->capacity;
+        last_ms = sample_time_ms(&store->records[last]);
+    }
+
+    while (recovered < hdr->capacity) {
+        const sensor_sample_t *rec = &store->records[hdr->head];
+        if (store->crcs[hdr->head] != record_crc(rec)) break;
+        if (rec->time == 0 || sample_time_ms(rec) < last_ms) break;
+
+        last_ms = sample_time_ms(rec);
+        hdr->head = (hdr->head + 1) % hdr->capacity;
+        if (hdr->count < hdr->capacity) hdr->count++;
+        recovered++;
+    }
+    return recovered;
+}
+
+int history_store_open(history_store_t *store, const char *path, uint32_t capacity) {
+    struct stat st;
+    int fresh = 0;
+
+    memset(store, 0, sizeof(*store));
+    store->fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (store->fd < 0) {
+        perror("❌ 이력 파일 열기 실패");
+        return -1;
+    }
+
+    if (fstat(store->fd, &st) != 0) {
+        perror("❌ 이력 파일 정보 조회 실패");
+        goto fail;
+    }
+
+    // 헤더 두 페이지 + 샘플 하나도 안 되는 파일은 매핑하면 범위 밖 접근 → 새로 만듦
+    if (st.st_size > 0 && (size_t)st.st_size < file_size_for(1)) {
+        fprintf(stderr, "⚠️ 이력 파일이 잘림 (%lld바이트) - 새로 만듭니다: %s\n",
+                (long long)st.st_size, path);
+        if (ftruncate(store->fd, 0) != 0) {
+            perror("❌ 이력 파일 자르기 실패");
+            goto fail;
+        }
+        st.st_size = 0;
+    }
+
+    if (st.st_size == 0) {
+        // 새 파일: 전체 크기를 미리 할당해 이후 쓰기가 블록 할당 없이 진행되게 함
+        if (capacity == 0) capacity = HISTORY_STORE_DEFAULT_CAPACITY;
+        store->map_size = file_size_for(capacity);
+        if (posix_fallocate(store->fd, 0, (off_t)store->map_size) != 0 &&
+            ftruncate(store->fd, (off_t)store->map_size) != 0) {
+            perror("❌ 이력 파일 할당 실패");
+            goto fail;
+        }
+        fresh = 1;
+    } else {
+        store->map_size = (size_t)st.st_size;
+    }
+
+    store->map = mmap(NULL, store->map_size, PROT_READ | PROT_WRITE, MAP_SHARED, store->fd, 0);
+    if (store->map == MAP_FAILED) {
+        store->map = NULL;
+        perror("❌ 이력 파일 mmap 실패");
+        goto fail;
+    }
+    store->records = (sensor_sample_t *)(store->map + HISTORY_SLOT_COUNT * page_size());
+
+    if (!fresh) {
+        int best = -1;
+        for (int i = 0; i < HISTORY_SLOT_COUNT; i++) {
+            const history_header_t *hdr = slot_header(store, i);
+            if (!header_valid(hdr) || file_size_for(hdr->capacity) > store->map_size) continue;
+            if (best < 0 || hdr->seq > slot_header(store, best)->seq) best = i;
+        }
+
+        if (best < 0) {
+            fprintf(stderr, "⚠️ 이력 헤더 손상 - 저장소를 비웁니다: %s\n", path);
+            capacity = (uint32_t)((store->map_size - HISTORY_SLOT_COUNT * page_size()) /
+                                  HISTORY_SLOT_BYTES);
+            memset(store->records, 0, (size_t)capacity * HISTORY_SLOT_BYTES);
+            fresh = 1;
+        } else {
+            store->hdr = *slot_header(store, best);
+            store->next_slot = (best + 1) % HISTORY_SLOT_COUNT;
+        }
+    }
+
+    if (fresh) {
+        store->hdr.magic = HISTORY_STORE_MAGIC;
+        store->hdr.version = HISTORY_STORE_VERSION;
+        store->hdr.record_size = sizeof(sensor_sample_t);
+        store->hdr.capacity = capacity;
+        if (write_header(store) != 0) goto fail;
+    }
+
+    store->crcs = (uint32_t *)(store->map + record_offset(store->hdr.capacity));
+    store->committed_head = store->hdr.head;
+    clock_gettime(CLOCK_MONOTONIC_COARSE, &store->last_commit);
+
+    if (!fresh) {
+        uint32_t recovered = recover_tail(store);
+        if (recovered > 0) {
+            printf("ℹ️ 커밋 안 된 이력 샘플 %u개 복구\n", recovered);
+            store->pending = recovered;
+            if (history_store_commit(store) != 0) goto fail;
+        }
+    }
+
+    return 0;
+
+fail:
+    history_store_close(store);
+    return -1;
+}
+
+void history_store_close(history_store_t *store) {
+    if (store->map) {
+        history_store_commit(store);
+        munmap(store->map, store->map_size);
+        store->map = NULL;
+    }
+    if (store->fd >= 0) {
+        close(store->fd);
+        store->fd = -1;
+    }
+}
+
+int history_store_commit(history_store_t *store) {
+    uint32_t from = store->committed_head;
+    uint32_t to = store->hdr.head;
+    struct timespec now;
+
+    if (store->pending == 0) return 0;
+
+    // 1) 새 샘플(과 CRC)이 들어간 데이터 페이지 먼저 (링 끝을 넘으면 두 구간)
+    if (store->pending >= store->hdr.capacity) {
+        if (sync_slots(store, 0, store->hdr.capacity) != 0) return -1;
+    } else if (from < to) {
+        if (sync_slots(store, from, to - from) != 0) return -1;
+    } else {
+        if (sync_slots(store, from, store->hdr.capacity - from) != 0 ||
+            sync_slots(store, 0, to) != 0) {
+            return -1;
+        }
+    }
+
+    // 2) 그 다음 헤더 (데이터가 디스크에 있을 때만 헤더가 가리키도록)
+    if (write_header(store) != 0) return -1;
+
+    store->committed_head = store->hdr.head;
+    store->pending = 0;
+    clock_gettime(CLOCK_MONOTONIC_COARSE, &now);
+    store->last_commit = now;
+    return 0;
+}
+
+int history_store_append(history_store_t *store, const sensor_sample_t *sample) {
+    history_header_t *hdr = &store->hdr;
+    sensor_sample_t *rec = &store->records[hdr->head];
+    struct timespec now;
+
+    *rec = *sample;
+
+    // 시각 역행(RTC 재동기 등)은 직전 시각으로 맞춰 이분 탐색 전제를 유지
+    if (hdr->count > 0) {
+        const sensor_sample_t *prev =
+            &store->records[(hdr->head + hdr->capacity - 1) % hdr->capacity];
+        if (sample_time_ms(rec) < sample_time_ms(prev)) {
+            rec->time = prev->time;
+            rec->time_ms = prev->time_ms;
+        }
+    }
+    store->crcs[hdr->head] = record_crc(rec);
+
+    hdr->head = (hdr->head + 1) % hdr->capacity;
+    if (hdr->count < hdr->capacity) hdr->count++;
+    store->pending++;
+    store->appended++;
+
+    if (store->pending >= HISTORY_STORE_BATCH_SAMPLES) {
+        return history_store_commit(store);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC_COARSE, &now);
+    if (now.tv_sec - store->last_commit.tv_sec >= HISTORY_STORE_BATCH_INTERVAL_S) {
+        return history_store_commit(store);
+    }
+    return 0;
+}
+
+uint32_t history_store_count(const history_store_t *store) {
+    return store->hdr.count;
+}
+
+const sensor_sample_t *history_store_get(const history_store_t *store, uint32_t i) {
+    if (i >= store->hdr.count) return NULL;
+    return &store->records[(tail_index(store) + i) % store->hdr.capacity];
+}
+
+uint32_t history_store_lower_bound(const history_store_t *store, int64_t from_ms) {
+    uint32_t lo = 0, hi = store->hdr.count;
+    uint32_t tail = tail_index(store);
+    uint32_t cap = store->hdr.capacity;
+
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if (sample_time_ms(&store->records[(tail + mid) % cap]) < from_ms) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+size_t history_store_query(const history_store_t *store, int64_t from_ms, int64_t to_ms,
+                           sensor_sample_t *out, size_t max) {
+    uint32_t i = history_store_lower_bound(store, from_ms);
+    uint32_t tail = tail_index(store);
+    uint32_t cap = store->hdr.capacity;
+    size_t n = 0;
+
+    while (i < store->hdr.count && n < max) {
+        const sensor_sample_t *rec = &store->records[(tail + i) % cap];
+        if (sample_time_ms(rec) >= to_ms) break;
+        out[n++] = *rec;
+        i++;
+    }
+    return n;
+}
@@ -0,0 +1,674 @@
+#include <stdio.h>
+#include <string.h>
+#include <strings.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include "metrics_server.h"
+
+#define LISTEN_TAG          UINT32_MAX
+#define WAKE_TAG            (UINT32_MAX - 1)
+#define POLL_EVENTS         16
+#define HEADER_RESERVE      192     // 응답 헤더 자리 (본문은 그 뒤에 바로 렌더링)
+#define REOPEN_INTERVAL_NS  10000000000ull  // 스냅샷 다시 열기 간격
+
+static const char *const level_kinds[3] = { "temperature", "humidity", "overall" };
+static const char *const i2c_devices[2] = { "ds1307", "oled" };
+
+static uint64_t mono_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+// ---- 렌더링 (할당 없음, 넘치면 ovf만 세움) ----
+
+typedef struct {
+    char *p;
+    char *end;
+    int ovf;
+} mw_t;
+
+static void put_mem(mw_t *w, const char *s, size_t len) {
+    if (w->ovf || (size_t)(w->end - w->p) < len) {
+        w->ovf = 1;
+        return;
+    }
+    memcpy(w->p, s, len);
+    w->p += len;
+}
+
+static void put_str(mw_t *w, const char *s) {
+    put_mem(w, s, strlen(s));
+}
+
+static void put_u64(mw_t *w, uint64_t v) {
+    char tmp[20];
+    int n = 0;
+
+    do {
+        tmp[sizeof(tmp) - 1 - n++] = (char)('0' + v % 10);
+        v /= 10;
+    } while (v);
+    put_mem(w, tmp + sizeof(tmp) - n, (size_t)n);
+}
+
+// 소수부 (앞자리 0 유지, 끝자리 0 제거, 전부 0이면 생략)
+static void put_frac(mw_t *w, uint64_t frac, int digits) {
+    char tmp[12];
+    int n = digits;
+
+    for (int i = digits - 1; i >= 0; i--) {
+        tmp[i] = (char)('0' + frac % 10);
+        frac /= 10;
+    }
+    while (n > 0 && tmp[n - 1] == '0') n--;
+    if (n == 0) return;
+    put_mem(w, ".", 1);
+    put_mem(w, tmp, (size_t)n);
+}
+
+// 0.01 단위 정수 → 10진 (예: -1234 → -12.34)
+static void put_centi(mw_t *w, int32_t v) {
+    uint32_t a = v < 0 ? (uint32_t)-(int64_t)v : (uint32_t)v;
+
+    if (v < 0) put_mem(w, "-", 1);
+    put_u64(w, a / 100);
+    put_frac(w, a % 100, 2);
+}
+
+// ns → 초
+static void put_ns_seconds(mw_t *w, uint64_t ns) {
+    put_u64(w, ns / 1000000000ull);
+    put_frac(w, ns % 1000000000ull, 9);
+}
+
+static void put_us_seconds(mw_t *w, uint32_t us) {
+    put_u64(w, us / 1000000u);
+    put_frac(w, us % 1000000u, 6);
+}
+
+static void put_header(mw_t *w, const char *name, const char *type, const char *help) {
+    put_str(w, "# TYPE smart_env_");
+    put_str(w, name);
+    put_mem(w, " ", 1);
+    put_str(w, type);
+    put_str(w, "\n# HELP smart_env_");
+    put_str(w, name);
+    put_mem(w, " ", 1);
+    put_str(w, help);
+    put_mem(w, "\n", 1);
+}
+
+// "smart_env_<name><suffix>{room="..."" 까지 (닫는 }는 호출자가)
+static void put_series(mw_t *w, const char *name, const char *suffix, const char *room) {
+    put_str(w, "smart_env_");
+    put_str(w, name);
+    put_str(w, suffix);
+    put_str(w, "{room=\"");
+    put_str(w, room);
+    put_mem(w, "\"", 1);
+}
+
+static void put_gauge_u64(mw_t *w, const char *name, const char *help, const char *room,
+                          uint64_t v) {
+    put_header(w, name, "gauge", help);
+    put_series(w, name, "", room);
+    put_str(w, "} ");
+    put_u64(w, v);
+    put_mem(w, "\n", 1);
+}
+
+// 카운터는 한 줄짜리 (<name>_total)
+static void put_counter(mw_t *w, const char *name, const char *help, const char *room,
+                        uint64_t v) {
+    put_header(w, name, "counter", help);
+    put_series(w, name, "_total", room);
+    put_str(w, "} ");
+    put_u64(w, v);
+    put_mem(w, "\n", 1);
+}
+
+static void put_i2c(mw_t *w, const char *room, const i2c_stats_t *st[2]) {
+    static const struct {
+        const char *name;
+        const char *help;
+        size_t off;
+    } counters[] = {
+        { "i2c_transactions", "I2C transactions issued.", offsetof(i2c_stats_t, transactions) },
+        { "i2c_errors", "I2C transactions that failed.", offsetof(i2c_stats_t, errors) },
+        { "i2c_bytes", "Bytes moved by successful I2C transactions.", offsetof(i2c_stats_t, bytes) },
+    };
+
+    for (size_t k = 0; k < sizeof(counters) / sizeof(counters[0]); k++) {
+        put_header(w, counters[k].name, "counter", counters[k].help);
+        for (int d = 0; d < 2; d++) {
+            uint64_t v;
+            memcpy(&v, (const char *)st[d] + counters[k].off, sizeof(v));
+            put_str(w, "smart_env_");
+            put_str(w, counters[k].name);
+            put_str(w, "_total{room=\"");
+            put_str(w, room);
+            put_str(w, "\",device=\"");
+            put_str(w, i2c_devices[d]);
+            put_str(w, "\"} ");
+            put_u64(w, v);
+            put_mem(w, "\n", 1);
+        }
+    }
+
+    put_header(w, "i2c_latency_seconds", "histogram", "I2C transaction latency per driver call.");
+    for (int d = 0; d < 2; d++) {
+        uint64_t cum = 0;
+
+        for (int b = 0; b <= I2C_HIST_BUCKETS; b++) {
+            cum += st[d]->buckets[b];
+            put_str(w, "smart_env_i2c_latency_seconds_bucket{room=\"");
+            put_str(w, room);
+            put_str(w, "\",device=\"");
+            put_str(w, i2c_devices[d]);
+            put_str(w, "\",le=\"");
+            if (b < I2C_HIST_BUCKETS) {
+                put_us_seconds(w, i2c_hist_bounds_us[b]);
+            } else {
+                put_str(w, "+Inf");
+            }
+            put_str(w, "\"} ");
+            put_u64(w, cum);
+            put_mem(w, "\n", 1);
+        }
+        put_str(w, "smart_env_i2c_latency_seconds_count{room=\"");
+        put_str(w, room);
+        put_str(w, "\",device=\"");
+        put_str(w, i2c_devices[d]);
+        put_str(w, "\"} ");
+        put_u64(w, cum);
+        put_str(w, "\nsmart_env_i2c_latency_seconds_sum{room=\"");
+        put_str(w, room);
+        put_str(w, "\",device=\"");
+        put_str(w, i2c_devices[d]);
+        put_str(w, "\"} ");
+        put_ns_seconds(w, st[d]->latency_sum_ns);
+        put_mem(w, "\n", 1);
+    }
+}
+
+size_t metrics_render(char *buf, size_t cap, const env_snapshot_t *snap, const char *room,
+                      uint64_t scrapes) {
+    mw_t w = { buf, buf + cap, 0 };
+
+    put_gauge_u64(&w, "up", "1 if a publisher snapshot could be read.", room, snap ? 1 : 0);
+
+    if (snap) {
+        const sensor_sample_t *s = &snap->sample;
+        const uint8_t levels[3] = { snap->temp_level, snap->humi_level, snap->overall_level };
+        uint64_t now = mono_ns();
+        uint64_t age = now > snap->publish_mono_ns ? now - snap->publish_mono_ns : 0;
+        const i2c_stats_t *i2c[2] = { &snap->rtc_i2c, &snap->oled_i2c };
+
+        put_header(&w, "temperature_celsius", "gauge", "Last temperature reading.");
+        put_series(&w, "temperature_celsius", "", room);
+        put_str(&w, "} ");
+        put_centi(&w, s->temp_centi);
+        put_mem(&w, "\n", 1);
+
+        put_header(&w, "humidity_percent", "gauge", "Last relative humidity reading.");
+        put_series(&w, "humidity_percent", "", room);
+        put_str(&w, "} ");
+        put_centi(&w, s->humi_centi);
+        put_mem(&w, "\n", 1);
+
+        put_header(&w, "sample_timestamp_seconds", "gauge", "Wall-clock time of the last sample.");
+        put_series(&w, "sample_timestamp_seconds", "", room);
+        put_str(&w, "} ");
+        put_u64(&w, s->time);
+        put_frac(&w, s->time_ms, 3);
+        put_mem(&w, "\n", 1);
+
+        put_gauge_u64(&w, "sample_stale",
+                      "1 if the last sample repeats an older value after a sensor error.",
+                      room, (s->flags & SAMPLE_FLAG_STALE) ? 1 : 0);
+
+        put_header(&w, "sample_interval_seconds", "gauge", "Current sensor sampling interval.");
+        put_series(&w, "sample_interval_seconds", "", room);
+        put_str(&w, "} ");
+        put_ns_seconds(&w, (uint64_t)snap->sample_interval_ms * 1000000ull);
+        put_mem(&w, "\n", 1);
+
+        put_header(&w, "sample_effective_interval_seconds", "gauge",
+                   "Moving average of the actual time between sensor reads.");
+        put_series(&w, "sample_effective_interval_seconds", "", room);
+        put_str(&w, "} ");
+        put_ns_seconds(&w, (uint64_t)snap->sample_avg_interval_ms * 1000000ull);
+        put_mem(&w, "\n", 1);
+
+        put_header(&w, "snapshot_age_seconds", "gauge", "Time since the snapshot was published.");
+        put_series(&w, "snapshot_age_seconds", "", room);
+        put_str(&w, "} ");
+        put_ns_seconds(&w, age);
+        put_mem(&w, "\n", 1);
+
+        put_header(&w, "level", "gauge", "Environment level (0 good, 1 warning, 2 danger).");
+        for (int k = 0; k < 3; k++) {
+            put_series(&w, "level", "", room);
+            put_str(&w, ",kind=\"");
+            put_str(&w, level_kinds[k]);
+            put_str(&w, "\"} ");
+            put_u64(&w, levels[k]);
+            put_mem(&w, "\n", 1);
+        }
+
+        put_gauge_u64(&w, "prolonged_warning", "1 while a warning has lasted too long.",
+                      room, snap->prolonged_warning);
+        put_gauge_u64(&w, "warning_elapsed_seconds", "Time spent in the current warning state.",
+                      room, snap->warning_elapsed_s);
+
+        put_header(&w, "sensor_reads", "counter", "DHT11 read attempts by result.");
+        put_series(&w, "sensor_reads", "_total", room);
+        put_str(&w, ",result=\"ok\"} ");
+        put_u64(&w, snap->reads_ok);
+        put_mem(&w, "\n", 1);
+        put_series(&w, "sensor_reads", "_total", room);
+        put_str(&w, ",result=\"failed\"} ");
+        put_u64(&w, snap->reads_failed);
+        put_mem(&w, "\n", 1);
+
+        put_counter(&w, "sensor_retries", "DHT11 read retries.", room, snap->retries);
+
+        put_header(&w, "sensor_errors", "counter", "DHT11 errors by kind.");
+        put_series(&w, "sensor_errors", "_total", room);
+        put_str(&w, ",kind=\"timeout\"} ");
+        put_u64(&w, snap->timeout_errors);
+        put_mem(&w, "\n", 1);
+        put_series(&w, "sensor_errors", "_total", room);
+        put_str(&w, ",kind=\"checksum\"} ");
+        put_u64(&w, snap->checksum_errors);
+        put_mem(&w, "\n", 1);
+        put_series(&w, "sensor_errors", "_total", room);
+        put_str(&w, ",kind=\"range\"} ");
+        put_u64(&w, snap->range_errors);
+        put_mem(&w, "\n", 1);
+
+        put_gauge_u64(&w, "sensor_consecutive_errors", "Failed reads since the last good one.",
+                      room, snap->consecutive_errors);
+
+        put_i2c(&w, room, i2c);
+
+        put_counter(&w, "snapshot_publishes", "Snapshots published by the monitor.",
+                    room, snap->publish_count);
+    }
+
+    put_counter(&w, "exporter_scrapes", "Scrapes served by this exporter.", room, scrapes);
+    put_str(&w, "# EOF\n");
+
+    return w.ovf ? 0 : (size_t)(w.p - buf);
+}
+
+// ---- HTTP ----
+
+// 레이블 값 이스케이프 (\ " 개행), 넘치면 자름
+static void escape_label(char *dst, size_t cap, const char *src) {
+    size_t n = 0;
+
+    for (; *src; src++) {
+        const char *rep = NULL;
+        char one[2] = { *src, 0 };
+
+        if (*src == '\\') rep = "\\\\";
+        else if (*src == '"') rep = "\\\"";
+        else if (*src == '\n') rep = "\\n";
+        else rep = one;
+        if (n + strlen(rep) >= cap) break;
+        memcpy(dst + n, rep, strlen(rep));
+        n += strlen(rep);
+    }
+    dst[n] = '\0';
+}
+
+// 게시자가 아직 없으면 가끔만 다시 열어 봄 (실패 메시지 반복 방지)
+static int read_snapshot(metrics_server_t *ms, env_snapshot_t *out) {
+    if (!ms->reader.shm) {
+        uint64_t now = mono_ns();
+        if (now - ms->last_open_ns < REOPEN_INTERVAL_NS) return -1;
+        ms->last_open_ns = now;
+        if (env_snapshot_reader_open(&ms->reader, ms->snapshot_name) != 0) return -1;
+    }
+    if (env_snapshot_publisher_pid(&ms->reader) == 0) return -1;
+    return env_snapshot_read(&ms->reader, out);
+}
+
+// 응답 조립: 본문은 out[HEADER_RESERVE..]에 바로 렌더링하고 헤더를 그 앞에 붙임
+static void respond(metrics_server_t *ms, metrics_conn_t *c, int status, const char *body_text) {
+    char hdr[HEADER_RESERVE];
+    const char *reason, *type;
+    char *body = c->out + HEADER_RESERVE;
+    size_t body_len;
+    int hlen;
+
+    if (status == 200) {
+        env_snapshot_t snap;
+        int have = read_snapshot(ms, &snap) == 0;
+
+        ms->scrapes++;
+        body_len = metrics_render(body, METRICS_RESPONSE_BUF - HEADER_RESERVE,
+                                  have ? &snap : NULL, ms->room, ms->scrapes);
+        if (body_len == 0) {
+            ms->scrape_errors++;
+            status = 500;
+            body_text = "render buffer too small\n";
+        }
+    }
+    if (status == 200) {
+        reason = "OK";
+        type = "application/openmetrics-text; version=1.0.0; charset=utf-8";
+    } else {
+        reason = status == 404 ? "Not Found" : status == 405 ? "Method Not Allowed"
+               : status == 400 ? "Bad Request" : "Internal Server Error";
+        type = "text/plain; charset=utf-8";
+        body_len = strlen(body_text);
+        memcpy(body, body_text, body_len);
+    }
+
+    hlen = snprintf(hdr, sizeof(hdr),
+                    "HTTP/1.1 %d %s\r\nContent-Type: %s\r\nContent-Length: %zu\r\n%s\r\n",
+                    status, reason, type, body_len,
+                    c->close_after ? "Connection: close\r\n" : "");
+    memcpy(body - hlen, hdr, (size_t)hlen);
+    c->out_off = HEADER_RESERVE - (uint32_t)hlen;
+    c->out_len = HEADER_RESERVE + (uint32_t)body_len;
+}
+
+// 헤더 줄 중 name과 일치하는 값에 token이 있는지 (대소문자 무시)
+static int header_has(const char *head, const char *end, const char *name, const char *token) {
+    size_t nlen = strlen(name), tlen = strlen(token);
+
+    for (const char *line = head; line < end; ) {
+        const char *eol = memchr(line, '\n', (size_t)(end - line));
+        if (!eol) eol = end;
+        if ((size_t)(eol - line) > nlen && strncasecmp(line, name, nlen) == 0 && line[nlen] == ':') {
+            for (const char *p = line + nlen + 1; p + tlen <= eol; p++) {
+                if (strncasecmp(p, token, tlen) == 0) return 1;
+            }
+        }
+        line = eol + 1;
+    }
+    return 0;
+}
+
+// 완성된 요청 하나 처리. 반환: 소비한 바이트 (0 = 아직 덜 받음, -1 = 잘못된 요청)
+static int handle_request(metrics_server_t *ms, metrics_conn_t *c) {
+    char *end, *sp1, *sp2, *eol;
+    size_t len;
+
+    c->in[c->in_len] = '\0';
+    end = strstr(c->in, "\r\n\r\n");
+    if (!end) return c->in_len >= METRICS_REQUEST_BUF - 1 ? -1 : 0;
+    len = (size_t)(end - c->in) + 4;
+
+    eol = strstr(c->in, "\r\n");
+    sp1 = memchr(c->in, ' ', (size_t)(eol - c->in));
+    sp2 = sp1 ? memchr(sp1 + 1, ' ', (size_t)(eol - sp1 - 1)) : NULL;
+    if (!sp2) {
+        c->close_after = 1;
+        respond(ms, c, 400, "bad request\n");
+        return (int)len;
+    }
+
+    // HTTP/1.0은 keep-alive를 따로 요청하지 않으면 닫음
+    if (strncmp(sp2 + 1, "HTTP/1.0", 8) == 0) {
+        c->close_after = !header_has(eol + 2, end + 2, "Connection", "keep-alive");
+    } else {
+        c->close_after = header_has(eol + 2, end + 2, "Connection", "close");
+    }
+
+    if ((size_t)(sp1 - c->in) != 3 || strncmp(c->in, "GET", 3) != 0) {
+        respond(ms, c, 405, "only GET is supported\n");
+    } else if ((sp2 - sp1 - 1 == 8 && strncmp(sp1 + 1, "/metrics", 8) == 0) ||
+               (sp2 - sp1 - 1 > 8 && strncmp(sp1 + 1, "/metrics?", 9) == 0)) {
+        respond(ms, c, 200, NULL);
+    } else {
+        respond(ms, c, 404, "try /metrics\n");
+    }
+    return (int)len;
+}
+
+static void close_conn(metrics_server_t *ms, metrics_conn_t *c) {
+    epoll_ctl(ms->epoll_fd, EPOLL_CTL_DEL, c->fd, NULL);
+    close(c->fd);
+    c->fd = -1;
+}
+
+static void set_interest(metrics_server_t *ms, metrics_conn_t *c, uint32_t events) {
+    struct epoll_event ev;
+
+    ev.events = events | (c->peer_closed ? 0 : EPOLLRDHUP);
+    ev.data.u32 = (uint32_t)(c - ms->conns);
+    epoll_ctl(ms->epoll_fd, EPOLL_CTL_MOD, c->fd, &ev);
+}
+
+// 보낼 수 있는 만큼 보내고, 다 보냈으면 밀린 요청을 이어서 처리
+// 반환: -1 연결을 닫아야 함
+static int service(metrics_server_t *ms, metrics_conn_t *c) {
+    for (;;) {
+        while (c->out_off < c->out_len) {
+            ssize_t n = send(c->fd, c->out + c->out_off, c->out_len - c->out_off,
+                             MSG_NOSIGNAL | MSG_DONTWAIT);
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                    set_interest(ms, c, EPOLLOUT);
+                    return 0;
+                }
+                return -1;
+            }
+            c->out_off += (uint32_t)n;
+        }
+        c->out_off = c->out_len = 0;
+        if (c->close_after) return -1;
+
+        int used = handle_request(ms, c);
+        if (used < 0) return -1;
+        if (used == 0) break;
+        memmove(c->in, c->in + used, c->in_len - (uint32_t)used);
+        c->in_len -= (uint32_t)used;
+    }
+    if (c->peer_closed) return -1;             // 더 올 요청 없음
+    set_interest(ms, c, EPOLLIN);
+    return 0;
+}
+
+static int read_conn(metrics_conn_t *c) {
+    while (c->in_len < METRICS_REQUEST_BUF - 1) {
+        ssize_t n = read(c->fd, c->in + c->in_len, METRICS_REQUEST_BUF - 1 - c->in_len);
+        if (n > 0) {
+            c->in_len += (uint32_t)n;
+            continue;
+        }
+        if (n == 0) return -1;
+        if (errno == EAGAIN || errno == EWOULDBLOCK) return 0;
+        if (errno == EINTR) continue;
+        return -1;
+    }
+    return 0;
+}
+
+static void accept_clients(metrics_server_t *ms) {
+    for (;;) {
+        struct epoll_event ev;
+        metrics_conn_t *c = NULL;
+        int fd = accept(ms->listen_fd, NULL, NULL);
+
+        if (fd < 0) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                perror("⚠️ 메트릭 서버 accept 실패");
+            }
+            return;
+        }
+        fcntl(fd, F_SETFL, O_NONBLOCK);
+        fcntl(fd, F_SETFD, FD_CLOEXEC);
+        for (int i = 0; i < METRICS_SERVER_MAX_CLIENTS; i++) {
+            if (ms->conns[i].fd < 0) {
+                c = &ms->conns[i];
+                break;
+            }
+        }
+        if (!c) {
+            close(fd);                          // 슬롯 없음: 바로 끊음
+            continue;
+        }
+
+        c->fd = fd;
+        c->in_len = c->out_off = c->out_len = 0;
+        c->close_after = 0;
+        c->peer_closed = 0;
+        ev.events = EPOLLIN | EPOLLRDHUP;
+        ev.data.u32 = (uint32_t)(c - ms->conns);
+        if (epoll_ctl(ms->epoll_fd, EPOLL_CTL_ADD, fd, &ev) != 0) {
+            perror("⚠️ 메트릭 서버 epoll 등록 실패");
+            close(fd);
+            c->fd = -1;
+        }
+    }
+}
+
+static void *server_thread(void *arg) {
+    metrics_server_t *ms = arg;
+    struct epoll_event events[POLL_EVENTS];
+
+    for (;;) {
+        int n = epoll_wait(ms->epoll_fd, events, POLL_EVENTS, -1);
+
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            perror("⚠️ 메트릭 서버 epoll_wait 실패");
+            break;
+        }
+        for (int i = 0; i < n; i++) {
+            metrics_conn_t *c;
+
+            if (events[i].data.u32 == WAKE_TAG) return NULL;
+            if (events[i].data.u32 == LISTEN_TAG) {
+                accept_clients(ms);
+                continue;
+            }
+
+            c = &ms->conns[events[i].data.u32];
+            if (c->fd < 0) continue;
+            if (events[i].events & EPOLLERR) {
+                close_conn(ms, c);
+                continue;
+            }
+            // 상대가 쓰기를 닫았어도 받아 둔 요청에는 응답
+            if (!c->peer_closed && (events[i].events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP)) &&
+                read_conn(c) < 0) {
+                c->peer_closed = 1;
+            }
+            if (service(ms, c) < 0) close_conn(ms, c);
+        }
+    }
+    return NULL;
+}
+
+int metrics_server_start(metrics_server_t *ms, const char *bind_addr, uint16_t port,
+                         const char *snapshot_name, const char *room) {
+    struct sockaddr_in addr;
+    struct epoll_event ev;
+    int one = 1;
+
+    memset(ms, 0, sizeof(*ms));
+    ms->listen_fd = -1;
+    ms->epoll_fd = -1;
+    ms->wake_fd = -1;
+    ms->last_open_ns = mono_ns();
+    for (int i = 0; i < METRICS_SERVER_MAX_CLIENTS; i++) ms->conns[i].fd = -1;
+    snprintf(ms->snapshot_name, sizeof(ms->snapshot_name), "%s",
+             snapshot_name ? snapshot_name : ENV_SNAPSHOT_NAME);
+    escape_label(ms->room, sizeof(ms->room), room ? room : "");
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    if (inet_pton(AF_INET, bind_addr ? bind_addr : METRICS_SERVER_DEFAULT_ADDR,
+                  &addr.sin_addr) != 1) {
+        fprintf(stderr, "❌ 잘못된 메트릭 수신 주소: %s\n", bind_addr);
+        return -1;
+    }
+
+    ms->listen_fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (ms->listen_fd < 0) {
+        perror("❌ 메트릭 소켓 생성 실패");
+        goto fail;
+    }
+    setsockopt(ms->listen_fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    if (bind(ms->listen_fd, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+        perror("❌ 메트릭 소켓 bind 실패");
+        goto fail;
+    }
+    if (listen(ms->listen_fd, 16) != 0) {
+        perror("❌ 메트릭 소켓 listen 실패");
+        goto fail;
+    }
+
+    ms->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    ms->wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (ms->epoll_fd < 0 || ms->wake_fd < 0) {
+        perror("❌ 메트릭 서버 epoll/eventfd 생성 실패");
+        goto fail;
+    }
+    ev.events = EPOLLIN;
+    ev.data.u32 = LISTEN_TAG;
+    if (epoll_ctl(ms->epoll_fd, EPOLL_CTL_ADD, ms->listen_fd, &ev) != 0) goto fail_epoll;
+    ev.data.u32 = WAKE_TAG;
+    if (epoll_ctl(ms->epoll_fd, EPOLL_CTL_ADD, ms->wake_fd, &ev) != 0) goto fail_epoll;
+
+    // 게시자가 먼저 떠 있으면 바로 연결 (아니면 첫 수집 때)
+    if (env_snapshot_reader_open(&ms->reader, ms->snapshot_name) != 0) {
+        fprintf(stderr, "⚠️ 스냅샷이 아직 없음 - 수집 때 다시 시도\n");
+    }
+
+    if (pthread_create(&ms->thread, NULL, server_thread, ms) != 0) {
+        fprintf(stderr, "❌ 메트릭 서버 스레드 생성 실패\n");
+        goto fail;
+    }
+    ms->started = 1;
+    return 0;
+
+fail_epoll:
+    perror("❌ 메트릭 서버 epoll 등록 실패");
+fail:
+    metrics_server_stop(ms);
+    return -1;
+}
+
+void metrics_server_stop(metrics_server_t *ms) {
+    if (ms->started) {
+        uint64_t one = 1;
+        if (write(ms->wake_fd, &one, sizeof(one)) != sizeof(one)) {
+            perror("⚠️ 메트릭 서버 종료 알림 실패");
+        }
+        pthread_join(ms->thread, NULL);
+        ms->started = 0;
+    }
+    for (int i = 0; i < METRICS_SERVER_MAX_CLIENTS; i++) {
+        if (ms->conns[i].fd >= 0) close_conn(ms, &ms->conns[i]);
+    }
+    env_snapshot_reader_close(&ms->reader);
+    if (ms->wake_fd >= 0) {
+        close(ms->wake_fd);
+        ms->wake_fd = -1;
+    }
+    if (ms->epoll_fd >= 0) {
+        close(ms->epoll_fd);
+        ms->epoll_fd = -1;
+    }
+    if (ms->listen_fd >= 0) {
+        close(ms->listen_fd);
+        ms->listen_fd = -1;
+    }
+}
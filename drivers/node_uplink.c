@@ -0,0 +1,213 @@
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <poll.h>
+#include <time.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include "node_uplink.h"
+
+static int64_t mono_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+static void out_frame(node_uplink_t *u, uint8_t type, const void *payload, uint32_t len) {
+    node_frame_t hdr = { NODE_PROTOCOL_MAGIC, type, NODE_OK, len };
+    memcpy(u->out + u->out_len, &hdr, sizeof(hdr));
+    u->out_len += sizeof(hdr);
+    memcpy(u->out + u->out_len, payload, len);
+    u->out_len += len;
+}
+
+// 연결을 끊고 재접속 예약 (보내던 프레임의 샘플은 큐에 남아 다시 보냄)
+static void drop_connection(node_uplink_t *u) {
+    if (u->fd >= 0) close(u->fd);
+    u->fd = -1;
+    u->state = NODE_UPLINK_DOWN;
+    u->out_off = u->out_len = 0;
+    u->inflight = 0;
+    u->next_retry_ms = mono_ms() + u->retry_ms;
+    u->retry_ms *= 2;
+    if (u->retry_ms > NODE_UPLINK_RETRY_MAX_MS) u->retry_ms = NODE_UPLINK_RETRY_MAX_MS;
+}
+
+static void start_connect(node_uplink_t *u) {
+    u->fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (u->fd < 0) {
+        drop_connection(u);
+        return;
+    }
+    if (connect(u->fd, (struct sockaddr *)&u->addr, sizeof(u->addr)) == 0) {
+        u->state = NODE_UPLINK_UP;
+    } else if (errno == EINPROGRESS) {
+        u->state = NODE_UPLINK_CONNECTING;
+    } else {
+        drop_connection(u);
+    }
+}
+
+// 논블로킹 connect 완료 확인 (반환: 1 연결됨, 0 아직, -1 실패)
+static int check_connect(node_uplink_t *u) {
+    struct pollfd pfd = { u->fd, POLLOUT, 0 };
+    int err = 0;
+    socklen_t len = sizeof(err);
+
+    if (poll(&pfd, 1, 0) <= 0) return 0;
+    if (getsockopt(u->fd, SOL_SOCKET, SO_ERROR, &err, &len) != 0 || err != 0) return -1;
+    return 1;
+}
+
+static void on_connected(node_uplink_t *u) {
+    int one = 1;
+
+    // 샘플은 드물게 작게 가므로 Nagle로 묶지 않음
+    setsockopt(u->fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    u->state = NODE_UPLINK_UP;
+    u->connects++;
+    u->out_off = u->out_len = 0;
+    u->inflight = 0;
+    out_frame(u, NODE_MSG_HELLO, &u->hello, sizeof(u->hello));
+}
+
+// 큐 앞쪽 샘플로 SAMPLES 프레임 구성 (링 끝에서 두 번 복사)
+static void fill_batch(node_uplink_t *u) {
+    uint32_t n = u->count < NODE_MAX_BATCH ? u->count : NODE_MAX_BATCH;
+    uint32_t first = NODE_UPLINK_QUEUE - u->head;
+    node_frame_t hdr = { NODE_PROTOCOL_MAGIC, NODE_MSG_SAMPLES, NODE_OK,
+                         n * (uint32_t)sizeof(sensor_sample_t) };
+
+    if (first > n) first = n;
+    memcpy(u->out + u->out_len, &hdr, sizeof(hdr));
+    u->out_len += sizeof(hdr);
+    memcpy(u->out + u->out_len, &u->queue[u->head], first * sizeof(sensor_sample_t));
+    u->out_len += first * (uint32_t)sizeof(sensor_sample_t);
+    memcpy(u->out + u->out_len, &u->queue[0], (n - first) * sizeof(sensor_sample_t));
+    u->out_len += (n - first) * (uint32_t)sizeof(sensor_sample_t);
+    u->inflight = n;
+}
+
+// 서버는 노드에게 보내는 것이 없으므로 읽을 것이 있으면 버리고, 닫힘만 확인
+static int check_peer(node_uplink_t *u) {
+    uint8_t buf[64];
+
+    for (;;) {
+        ssize_t n = recv(u->fd, buf, sizeof(buf), MSG_DONTWAIT);
+        if (n > 0) continue;
+        if (n == 0) return -1;
+        return (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) ? 0 : -1;
+    }
+}
+
+static int send_pending(node_uplink_t *u) {
+    for (;;) {
+        if (u->out_off == u->out_len) {
+            // 다 보낸 프레임의 샘플을 큐에서 뺌
+            if (u->out_len) u->retry_ms = NODE_UPLINK_RETRY_MIN_MS;   // 실제로 보내지는 연결
+            u->head = (u->head + u->inflight) % NODE_UPLINK_QUEUE;
+            u->count -= u->inflight;
+            u->samples_sent += u->inflight;
+            u->inflight = 0;
+            u->out_off = u->out_len = 0;
+            if (u->count == 0) return 0;
+            fill_batch(u);
+        }
+
+        ssize_t n = send(u->fd, u->out + u->out_off, u->out_len - u->out_off,
+                         MSG_NOSIGNAL | MSG_DONTWAIT);
+        if (n < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) return 0;
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        u->out_off += (uint32_t)n;
+    }
+}
+
+int node_uplink_open(node_uplink_t *u, const char *host, uint16_t port,
+                     uint32_t node_id, const char *room) {
+    struct addrinfo hints, *res = NULL;
+    int err;
+
+    memset(u, 0, sizeof(*u));
+    u->fd = -1;
+    u->state = NODE_UPLINK_DOWN;
+    u->retry_ms = NODE_UPLINK_RETRY_MIN_MS;
+    u->hello.node_id = node_id;
+    strncpy(u->hello.room, room, NODE_ROOM_LEN - 1);
+
+    if (node_id == 0) {
+        fprintf(stderr, "❌ 노드 ID는 0이 될 수 없습니다\n");
+        return -1;
+    }
+
+    // 이름 해석은 시작할 때 한 번만 (poll 경로에서 DNS로 막히지 않도록)
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+    err = getaddrinfo(host, NULL, &hints, &res);
+    if (err != 0 || !res) {
+        fprintf(stderr, "❌ 집계 서버 주소 해석 실패: %s (%s)\n", host, gai_strerror(err));
+        return -1;
+    }
+    memcpy(&u->addr, res->ai_addr, sizeof(u->addr));
+    u->addr.sin_port = htons(port);
+    freeaddrinfo(res);
+    return 0;
+}
+
+void node_uplink_close(node_uplink_t *u) {
+    if (u->fd >= 0) {
+        // 종료 직전 남은 프레임을 한 번 더 밀어 봄 (기다리지 않음)
+        if (u->state == NODE_UPLINK_UP) send_pending(u);
+        close(u->fd);
+        u->fd = -1;
+    }
+    u->state = NODE_UPLINK_DOWN;
+}
+
+void node_uplink_append(node_uplink_t *u, const sensor_sample_t *sample) {
+    if (u->count == NODE_UPLINK_QUEUE) {
+        if (u->inflight > 0) {
+            // 가장 오래된 샘플이 전송 중이면 새 샘플을 버림
+            u->samples_dropped++;
+            return;
+        }
+        u->head = (u->head + 1) % NODE_UPLINK_QUEUE;
+        u->count--;
+        u->samples_dropped++;
+    }
+    u->queue[(u->head + u->count) % NODE_UPLINK_QUEUE] = *sample;
+    u->count++;
+}
+
+int node_uplink_poll(node_uplink_t *u) {
+    switch (u->state) {
+    case NODE_UPLINK_DOWN:
+        if (mono_ms() < u->next_retry_ms) break;
+        start_connect(u);
+        if (u->state != NODE_UPLINK_UP) break;
+        on_connected(u);
+        /* fall through */
+    case NODE_UPLINK_CONNECTING:
+        if (u->state == NODE_UPLINK_CONNECTING) {
+            int r = check_connect(u);
+            if (r == 0) break;
+            if (r < 0) {
+                drop_connection(u);
+                break;
+            }
+            on_connected(u);
+        }
+        /* fall through */
+    case NODE_UPLINK_UP:
+        if (check_peer(u) != 0 || send_pending(u) != 0) drop_connection(u);
+        break;
+    }
+    return u->state;
+}
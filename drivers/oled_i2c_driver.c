@@ -5,23 +5,78 @@
 #include <linux/device.h>
 #include <linux/fs.h>
 #include <linux/cdev.h>
+#include <linux/fb.h>
+#include <linux/idr.h>
+#include <linux/kref.h>
+#include <linux/mutex.h>
+#include <linux/slab.h>
 #include <linux/uaccess.h>
+#include <linux/vmalloc.h>
 #include "../include/oled_ioctl.h"
 #include "../include/oled_ssd1306_commands.h"
 
 MODULE_LICENSE("GPL");
 MODULE_AUTHOR("Smart Environment Monitor Team");
 MODULE_DESCRIPTION("OLED SSD1306 I2C Device Driver");
-MODULE_VERSION("1.0");
+MODULE_VERSION("1.1");
 
-#define DEVICE_NAME   "oled_display"
-#define CLASS_NAME    "smart_env"
+#define DEVICE_NAME       "oled_display"
+#define CLASS_NAME        "smart_env"
+#define OLED_MAX_DEVICES  4     /* 0x3C/0x3D on up to two buses */
+#define OLED_ALL_PAGES    ((1U << SSD1306_PAGES) - 1)
 
-static dev_t             dev_number;
+/* fbdev: 1bpp, 16 bytes per line, flushed at most every 50 ms */
+#define OLED_FB_LINE      (SSD1306_WIDTH / 8)
+#define OLED_FB_SIZE      (OLED_FB_LINE * SSD1306_HEIGHT)
+#define OLED_FB_DELAY     (HZ / 20)
+
+static bool fbdev;
+module_param(fbdev, bool, 0444);
+MODULE_PARM_DESC(fbdev, "Also register each panel as a 1bpp framebuffer with deferred I/O");
+
+/*
+ * Per-panel state. One instance is allocated for every bound SSD1306 and
+ * lives until the I2C binding, the last open file and the framebuffer
+ * (registration and every open /dev/fbN) drop their reference, so a
+ * remove() racing with an in-flight write() or fb access only ever sees
+ * client == NULL under the lock, never freed memory.
+ */
+struct oled_device {
+    struct i2c_client *client;  /* NULL once the panel is unbound */
+    struct cdev       *cdev;
+    struct device     *dev;
+    dev_t              devt;
+    int                minor;
+    struct mutex       lock;    /* serialises renders on this panel */
+    struct kref        kref;
+    bool               removed; /* set in remove() under lock; fb paths go quiet */
+
+    /* page-format images: what we want shown and what the panel holds */
+    u8                 frame[SSD1306_PAGES][SSD1306_WIDTH];
+    u8                 shadow[SSD1306_PAGES][SSD1306_WIDTH];
+    unsigned int       shadow_valid;    /* bitmask of pages known to match */
+
+    /* text-cell model of what write()/OLED_IOC_TEXT last put on each row */
+    char               cells[SSD1306_PAGES][SSD1306_TEXT_COLS];
+    unsigned int       cells_valid;     /* rows whose cells match the glass */
+
+    /* hardware scroll state, re-armed after writes into the scrolled pages */
+    struct oled_scroll scroll;
+    bool               scrolling;
+
+    /* optional framebuffer (fbdev=1) */
+    struct fb_info         *info;
+    struct fb_deferred_io   fbdefio;
+    int                     fb_users; /* open /dev/fbN files; the fb owns the frame while > 0 */
+};
+
+static dev_t             oled_base_dev;
 static struct class     *oled_class;
-static struct device    *oled_device;
-static struct cdev       oled_cdev;
-static struct i2c_client *oled_client;
+static DEFINE_IDA(oled_minor_ida);
+
+/* minor -> device lookup for open(); guarded by oled_table_lock */
+static struct oled_device *oled_table[OLED_MAX_DEVICES];
+static DEFINE_MUTEX(oled_table_lock);
 
 /* File operations prototypes */
 static int      oled_open(struct inode *inode, struct file *file);
@@ -50,29 +105,591 @@ static const struct i2c_device_id oled_id[] = {
 };
 MODULE_DEVICE_TABLE(i2c, oled_id);
 
+/* kref release: last user of the panel is gone */
+static void oled_free(struct kref *kref)
+{
+    struct oled_device *oled = container_of(kref, struct oled_device, kref);
+
+    kfree(oled);
+}
+
+static bool oled_page_dirty(struct oled_device *oled, int page)
+{
+    if (!(oled->shadow_valid & BIT(page)))
+        return true;
+    return memcmp(oled->frame[page], oled->shadow[page], SSD1306_WIDTH) != 0;
+}
+
+/* Pages whose GDDRAM the active scroll is shifting */
+static unsigned int oled_scroll_pages(const struct oled_scroll *sc)
+{
+    if (sc->mode == OLED_SCROLL_DIAG_RIGHT || sc->mode == OLED_SCROLL_DIAG_LEFT)
+        return OLED_ALL_PAGES;      /* vertical component moves every row */
+    return GENMASK(sc->end_page, sc->start_page);
+}
+
+static int oled_scroll_apply(struct oled_device *oled)
+{
+    const struct oled_scroll *sc = &oled->scroll;
+    int ret;
+
+    if (sc->mode == OLED_SCROLL_DIAG_RIGHT ||
+        sc->mode == OLED_SCROLL_DIAG_LEFT) {
+        u8 rows = sc->scroll_rows ? sc->scroll_rows : SSD1306_HEIGHT;
+
+        ret = ssd1306_set_vertical_area(oled->client, sc->fixed_rows, rows);
+        if (ret < 0)
+            return ret;
+    }
+
+    return ssd1306_start_scroll(oled->client, sc->mode, sc->start_page,
+                                sc->end_page, sc->interval,
+                                sc->vertical_offset);
+}
+
+/*
+ * Push the pages in @page_mask of oled->frame that differ from what the
+ * panel already shows. Only the changed column span of each page goes
+ * over the bus. Caller holds oled->lock with a live client.
+ *
+ * GDDRAM under an active scroll has been shifted by the controller, so a
+ * write there stops the scroll, rewrites the whole scrolled area and
+ * re-arms it. Pages outside the scroll range are written in place.
+ */
+static int oled_flush_frame(struct oled_device *oled, unsigned int page_mask)
+{
+    int page, first, last, ret;
+    bool rearm = false;
+
+    if (oled->scrolling) {
+        unsigned int scrolled = oled_scroll_pages(&oled->scroll);
+
+        for (page = 0; page < SSD1306_PAGES; page++) {
+            if ((page_mask & scrolled & BIT(page)) &&
+                oled_page_dirty(oled, page)) {
+                ret = ssd1306_stop_scroll(oled->client);
+                if (ret < 0)
+                    return ret;
+                oled->scrolling = false;
+                oled->shadow_valid &= ~scrolled;
+                page_mask |= scrolled;
+                rearm = true;
+                break;
+            }
+        }
+    }
+
+    for (page = 0; page < SSD1306_PAGES; page++) {
+        const u8 *next = oled->frame[page];
+        u8 *glass = oled->shadow[page];
+
+        if (!(page_mask & BIT(page)))
+            continue;
+
+        first = 0;
+        last  = SSD1306_WIDTH - 1;
+        if (oled->shadow_valid & BIT(page)) {
+            while (first < SSD1306_WIDTH && next[first] == glass[first])
+                first++;
+            if (first == SSD1306_WIDTH)
+                continue;
+            while (next[last] == glass[last])
+                last--;
+        }
+
+        ret = ssd1306_write_window(oled->client, page, first,
+                                   &next[first], last - first + 1);
+        if (ret < 0) {
+            oled->shadow_valid &= ~BIT(page);
+            return ret;
+        }
+
+        memcpy(&glass[first], &next[first], last - first + 1);
+        oled->shadow_valid |= BIT(page);
+    }
+
+    if (rearm) {
+        ret = oled_scroll_apply(oled);
+        if (ret < 0)
+            return ret;
+        oled->scrolling = true;
+    }
+
+    return 0;
+}
+
+/*
+ * Update text row @row from cell @col with @len characters.
+ *
+ * When the row's cells are known to be on the glass, only runs of changed
+ * glyphs are rasterised and each run is sent as its own column window
+ * (6 bytes per glyph), e.g. one digit of HH:MM:SS per second. Runs split by
+ * a single unchanged glyph are merged, since a window costs more than 6
+ * bytes of setup. Otherwise the row is drawn into the frame and flushed.
+ * Caller holds oled->lock with a live client.
+ */
+static int oled_text_update(struct oled_device *oled, int row, int col,
+                            const char *text, int len)
+{
+    char *cur = oled->cells[row];
+    int i, start, run, x, ret;
+    bool fast;
+
+    fast = (oled->cells_valid & BIT(row)) &&
+           (oled->shadow_valid & BIT(row)) &&
+           !(oled->scrolling &&
+             (oled_scroll_pages(&oled->scroll) & BIT(row)));
+
+    if (!fast) {
+        bool whole_row = (col == 0 && len == SSD1306_TEXT_COLS);
+
+        if (whole_row)
+            memset(oled->frame[row], 0, SSD1306_WIDTH);
+        ssd1306_fb_draw_text(oled->frame, col * SSD1306_GLYPH_WIDTH, row * 8,
+                             text, len);
+        ret = oled_flush_frame(oled, BIT(row));
+        if (ret < 0 || !whole_row) {
+            oled->cells_valid &= ~BIT(row);
+            return ret;
+        }
+        memcpy(cur, text, len);
+        oled->cells_valid |= BIT(row);
+        return 0;
+    }
+
+    i = 0;
+    while (i < len) {
+        if (text[i] == cur[col + i]) {
+            i++;
+            continue;
+        }
+
+        /* extend over single unchanged glyphs, stop at two in a row */
+        start = i;
+        while (i < len &&
+               (text[i] != cur[col + i] ||
+                (i + 1 < len && text[i + 1] != cur[col + i + 1])))
+            i++;
+
+        run = i - start;
+        x = (col + start) * SSD1306_GLYPH_WIDTH;
+        ssd1306_fb_draw_text(oled->frame, x, row * 8, &text[start], run);
+        ret = ssd1306_write_window(oled->client, row, x, &oled->frame[row][x],
+                                   run * SSD1306_GLYPH_WIDTH);
+        if (ret < 0) {
+            oled->cells_valid  &= ~BIT(row);
+            oled->shadow_valid &= ~BIT(row);
+            return ret;
+        }
+
+        memcpy(&oled->shadow[row][x], &oled->frame[row][x],
+               run * SSD1306_GLYPH_WIDTH);
+        memcpy(&cur[col + start], &text[start], run);
+    }
+
+    return 0;
+}
+
+/* write() path: lay the text out into 21x8 cells and update each row */
+static int oled_text_render(struct oled_device *oled, const char *text)
+{
+    char rows[SSD1306_PAGES][SSD1306_TEXT_COLS];
+    int row, ret;
+
+    ssd1306_text_layout(text, rows);
+
+    for (row = 0; row < SSD1306_PAGES; row++) {
+        ret = oled_text_update(oled, row, 0, rows[row], SSD1306_TEXT_COLS);
+        if (ret < 0)
+            return ret;
+    }
+
+    return 0;
+}
+
+/* Convert the 1bpp row-major fbdev memory into page-format columns */
+static void oled_fb_to_frame(struct oled_device *oled, const u8 *vmem,
+                             unsigned int page_mask)
+{
+    int page, x, bit;
+
+    for (page = 0; page < SSD1306_PAGES; page++) {
+        if (!(page_mask & BIT(page)))
+            continue;
+
+        for (x = 0; x < SSD1306_WIDTH; x++) {
+            const u8 *src = &vmem[page * 8 * OLED_FB_LINE + x / 8];
+            u8 col = 0;
+
+            for (bit = 0; bit < 8; bit++) {
+                if ((src[bit * OLED_FB_LINE] >> (x % 8)) & 1)
+                    col |= BIT(bit);
+            }
+            oled->frame[page][x] = col;
+        }
+    }
+}
+
+/* Inverse of oled_fb_to_frame(): seed the fb memory with what is on the glass */
+static void oled_frame_to_fb(const struct oled_device *oled, u8 *vmem)
+{
+    int page, x, bit;
+
+    memset(vmem, 0, OLED_FB_SIZE);
+    for (page = 0; page < SSD1306_PAGES; page++) {
+        for (x = 0; x < SSD1306_WIDTH; x++) {
+            u8 col = oled->frame[page][x];
+
+            for (bit = 0; bit < 8; bit++) {
+                if (col & BIT(bit))
+                    vmem[(page * 8 + bit) * OLED_FB_LINE + x / 8] |=
+                        BIT(x % 8);
+            }
+        }
+    }
+}
+
+/*
+ * Deferred I/O worker: runs once per OLED_FB_DELAY after the first touch,
+ * so any number of mmap stores and fb draws in that period cost a single
+ * flush of the pages that actually changed.
+ */
+static void oled_fb_deferred_io(struct fb_info *info,
+                                struct list_head *pagereflist)
+{
+    struct oled_device *oled = info->par;
+    struct fb_deferred_io_pageref *pageref;
+    unsigned int page_mask = 0;
+
+    list_for_each_entry(pageref, pagereflist, list) {
+        unsigned long start = pageref->offset;
+        unsigned long end   = min_t(unsigned long, start + PAGE_SIZE,
+                                    OLED_FB_SIZE);
+        int first_page, last_page;
+
+        if (start >= OLED_FB_SIZE)
+            continue;
+
+        first_page = start / (OLED_FB_LINE * 8);
+        last_page  = (end - 1) / (OLED_FB_LINE * 8);
+        page_mask |= GENMASK(last_page, first_page);
+    }
+
+    /* write()/draw calls schedule the work without page references */
+    if (!page_mask)
+        page_mask = OLED_ALL_PAGES;
+
+    /* a flush still queued after the last fb user closed must not draw */
+    mutex_lock(&oled->lock);
+    if (!oled->removed && oled->client && oled->fb_users) {
+        oled_fb_to_frame(oled, info->screen_buffer, page_mask);
+        oled->cells_valid &= ~page_mask;
+        if (oled_flush_frame(oled, page_mask) < 0)
+            pr_err("smart_env: fb flush failed\n");
+    }
+    mutex_unlock(&oled->lock);
+}
+
+static void oled_fb_schedule(struct fb_info *info)
+{
+    struct oled_device *oled = info->par;
+
+    if (!READ_ONCE(oled->removed))
+        schedule_delayed_work(&info->deferred_work, info->fbdefio->delay);
+}
+
+/*
+ * The fb memory and oled->frame are separate copies of the screen, so
+ * only one side may draw at a time: while any /dev/fbN (or fbcon) is
+ * open the framebuffer owns the panel and the char device's drawing
+ * calls fail with -EBUSY. The first open starts the fb from the frame,
+ * so an fb client sees what is on the glass.
+ *
+ * Every open /dev/fbN also pins the panel, like oled_open() does.
+ */
+static int oled_fb_open(struct fb_info *info, int user)
+{
+    struct oled_device *oled = info->par;
+
+    mutex_lock(&oled->lock);
+    if (oled->fb_users++ == 0) {
+        /* a running hardware scroll would keep moving the fb's pixels */
+        if (oled->scrolling && oled->client &&
+            ssd1306_stop_scroll(oled->client) == 0) {
+            oled->scrolling = false;
+            oled->shadow_valid &= ~oled_scroll_pages(&oled->scroll);
+        }
+        oled_frame_to_fb(oled, info->screen_buffer);
+    }
+    mutex_unlock(&oled->lock);
+
+    kref_get(&oled->kref);
+    return 0;
+}
+
+static int oled_fb_release(struct fb_info *info, int user)
+{
+    struct oled_device *oled = info->par;
+
+    mutex_lock(&oled->lock);
+    oled->fb_users--;
+    mutex_unlock(&oled->lock);
+
+    kref_put(&oled->kref, oled_free);
+    return 0;
+}
+
+/*
+ * Called by fbdev once the framebuffer is unregistered and its last open
+ * file is closed; only then may the fb_info and its memory go away.
+ */
+static void oled_fb_destroy(struct fb_info *info)
+{
+    struct oled_device *oled = info->par;
+
+    fb_deferred_io_cleanup(info);
+    vfree(info->screen_buffer);
+    framebuffer_release(info);
+    kref_put(&oled->kref, oled_free);
+}
+
+static ssize_t oled_fb_write(struct fb_info *info, const char __user *buf,
+                             size_t count, loff_t *ppos)
+{
+    ssize_t ret = fb_sys_write(info, buf, count, ppos);
+
+    if (ret > 0)
+        oled_fb_schedule(info);
+    return ret;
+}
+
+static void oled_fb_fillrect(struct fb_info *info,
+                             const struct fb_fillrect *rect)
+{
+    sys_fillrect(info, rect);
+    oled_fb_schedule(info);
+}
+
+static void oled_fb_copyarea(struct fb_info *info,
+                             const struct fb_copyarea *area)
+{
+    sys_copyarea(info, area);
+    oled_fb_schedule(info);
+}
+
+static void oled_fb_imageblit(struct fb_info *info,
+                              const struct fb_image *image)
+{
+    sys_imageblit(info, image);
+    oled_fb_schedule(info);
+}
+
+static const struct fb_ops oled_fb_ops = {
+    .owner        = THIS_MODULE,
+    .fb_open      = oled_fb_open,
+    .fb_release   = oled_fb_release,
+    .fb_destroy   = oled_fb_destroy,
+    .fb_read      = fb_sys_read,
+    .fb_write     = oled_fb_write,
+    .fb_fillrect  = oled_fb_fillrect,
+    .fb_copyarea  = oled_fb_copyarea,
+    .fb_imageblit = oled_fb_imageblit,
+    .fb_mmap      = fb_deferred_io_mmap,
+};
+
+static const struct fb_fix_screeninfo oled_fb_fix = {
+    .id          = "ssd1306",
+    .type        = FB_TYPE_PACKED_PIXELS,
+    .visual      = FB_VISUAL_MONO10,
+    .line_length = OLED_FB_LINE,
+    .smem_len    = OLED_FB_SIZE,
+    .accel       = FB_ACCEL_NONE,
+};
+
+static const struct fb_var_screeninfo oled_fb_var = {
+    .xres           = SSD1306_WIDTH,
+    .yres           = SSD1306_HEIGHT,
+    .xres_virtual   = SSD1306_WIDTH,
+    .yres_virtual   = SSD1306_HEIGHT,
+    .bits_per_pixel = 1,
+    .red            = { .length = 1 },
+    .green          = { .length = 1 },
+    .blue           = { .length = 1 },
+};
+
+/* Register /dev/fbN for this panel */
+static int oled_fb_register(struct oled_device *oled)
+{
+    struct fb_info *info;
+    void *vmem;
+    int ret;
+
+    info = framebuffer_alloc(0, &oled->client->dev);
+    if (!info)
+        return -ENOMEM;
+
+    vmem = vzalloc(OLED_FB_SIZE);
+    if (!vmem) {
+        ret = -ENOMEM;
+        goto err_release;
+    }
+
+    info->fbops         = &oled_fb_ops;
+    info->fix           = oled_fb_fix;
+    info->var           = oled_fb_var;
+    info->screen_buffer = vmem;
+    info->par           = oled;
+
+    oled->fbdefio.delay       = OLED_FB_DELAY;
+    oled->fbdefio.deferred_io = oled_fb_deferred_io;
+    info->fbdefio = &oled->fbdefio;
+
+    ret = fb_deferred_io_init(info);
+    if (ret)
+        goto err_vfree;
+
+    /* the registration's reference, dropped in oled_fb_destroy() */
+    kref_get(&oled->kref);
+    ret = register_framebuffer(info);
+    if (ret) {
+        pr_err("smart_env: register_framebuffer failed (%d)\n", ret);
+        kref_put(&oled->kref, oled_free);
+        goto err_defio;
+    }
+
+    oled->info = info;
+    pr_info("smart_env: fb%d registered for /dev/%s%d\n",
+            info->node, DEVICE_NAME, oled->minor);
+    return 0;
+
+err_defio:
+    fb_deferred_io_cleanup(info);
+err_vfree:
+    vfree(vmem);
+err_release:
+    framebuffer_release(info);
+    return ret;
+}
+
+static void oled_fb_unregister(struct oled_device *oled)
+{
+    struct fb_info *info = oled->info;
+
+    if (!info)
+        return;
+
+    /* frees through oled_fb_destroy() when the last /dev/fbN user closes */
+    unregister_framebuffer(info);
+    oled->info = NULL;
+}
+
 /* Probe: called when the device is matched */
 static int oled_probe(struct i2c_client *client)
 {
+    struct oled_device *oled;
     int ret;
 
     pr_info("smart_env: OLED I2C device at 0x%02x\n", client->addr);
-    oled_client = client;
+
+    oled = kzalloc(sizeof(*oled), GFP_KERNEL);
+    if (!oled)
+        return -ENOMEM;
+
+    mutex_init(&oled->lock);
+    kref_init(&oled->kref);
+    oled->client = client;
 
     ret = ssd1306_init_display(client);
     if (ret) {
         pr_err("smart_env: display init failed (%d)\n", ret);
-        return ret;
+        goto err_free;
     }
 
-    pr_info("smart_env: OLED initialized\n");
+    /* 1) pick a free minor: /dev/oled_display0..N */
+    ret = ida_alloc_max(&oled_minor_ida, OLED_MAX_DEVICES - 1, GFP_KERNEL);
+    if (ret < 0) {
+        pr_err("smart_env: no free minor for 0x%02x\n", client->addr);
+        goto err_free;
+    }
+    oled->minor = ret;
+    oled->devt  = MKDEV(MAJOR(oled_base_dev), oled->minor);
+
+    /* 2) char device, allocated separately so its lifetime is its own */
+    oled->cdev = cdev_alloc();
+    if (!oled->cdev) {
+        ret = -ENOMEM;
+        goto err_ida;
+    }
+    oled->cdev->ops   = &oled_fops;
+    oled->cdev->owner = THIS_MODULE;
+
+    mutex_lock(&oled_table_lock);
+    oled_table[oled->minor] = oled;
+    mutex_unlock(&oled_table_lock);
+
+    ret = cdev_add(oled->cdev, oled->devt, 1);
+    if (ret) {
+        pr_err("smart_env: cdev_add failed\n");
+        kobject_put(&oled->cdev->kobj);
+        goto err_table;
+    }
+
+    /* 3) device node */
+    oled->dev = device_create(oled_class, &client->dev, oled->devt, oled,
+                              DEVICE_NAME "%d", oled->minor);
+    if (IS_ERR(oled->dev)) {
+        ret = PTR_ERR(oled->dev);
+        pr_err("smart_env: device_create failed\n");
+        cdev_del(oled->cdev);
+        goto err_table;
+    }
+
+    /* 4) optional framebuffer; the char device works without it */
+    if (fbdev && oled_fb_register(oled))
+        pr_warn("smart_env: continuing without framebuffer\n");
+
+    i2c_set_clientdata(client, oled);
+
+    pr_info("smart_env: OLED initialized, /dev/%s%d\n",
+            DEVICE_NAME, oled->minor);
     return 0;
+
+err_table:
+    mutex_lock(&oled_table_lock);
+    oled_table[oled->minor] = NULL;
+    mutex_unlock(&oled_table_lock);
+err_ida:
+    ida_free(&oled_minor_ida, oled->minor);
+err_free:
+    kfree(oled);
+    return ret;
 }
 
 /* Remove: called on driver detach */
 static void oled_remove(struct i2c_client *client)
 {
-    pr_info("smart_env: OLED I2C device removed\n");
-    oled_client = NULL;
+    struct oled_device *oled = i2c_get_clientdata(client);
+
+    /* no new opens past this point */
+    mutex_lock(&oled_table_lock);
+    oled_table[oled->minor] = NULL;
+    mutex_unlock(&oled_table_lock);
+
+    /* wait for an in-flight render, then detach the client */
+    mutex_lock(&oled->lock);
+    oled->removed = true;
+    oled->client = NULL;
+    mutex_unlock(&oled->lock);
+
+    oled_fb_unregister(oled);
+    device_destroy(oled_class, oled->devt);
+    cdev_del(oled->cdev);
+
+    ida_free(&oled_minor_ida, oled->minor);
+    pr_info("smart_env: OLED I2C device removed (/dev/%s%d)\n",
+            DEVICE_NAME, oled->minor);
+
+    kref_put(&oled->kref, oled_free);
 }
 
 /* I2C driver structure */
@@ -86,27 +703,47 @@ static struct i2c_driver oled_driver = {
     .id_table = oled_id,
 };
 
-/* open(): nothing special */
+/* open(): look up the panel by minor and take a reference */
 static int oled_open(struct inode *inode, struct file *file)
 {
-    pr_info("smart_env: OLED device opened\n");
+    unsigned int minor = iminor(inode);
+    struct oled_device *oled = NULL;
+
+    if (minor >= OLED_MAX_DEVICES)
+        return -ENODEV;
+
+    mutex_lock(&oled_table_lock);
+    oled = oled_table[minor];
+    if (oled)
+        kref_get(&oled->kref);
+    mutex_unlock(&oled_table_lock);
+
+    if (!oled)
+        return -ENODEV;
+
+    file->private_data = oled;
+    pr_info("smart_env: OLED device %u opened\n", minor);
     return 0;
 }
 
-/* release(): nothing special */
+/* release(): drop the reference taken in open() */
 static int oled_release(struct inode *inode, struct file *file)
 {
-    pr_info("smart_env: OLED device closed\n");
+    struct oled_device *oled = file->private_data;
+
+    pr_info("smart_env: OLED device %u closed\n", iminor(inode));
+    kref_put(&oled->kref, oled_free);
     return 0;
 }
 
-/* write(): auto-clear + auto-wrap render */
+/* write(): auto-wrapped text screen, only changed glyphs are sent */
 static ssize_t oled_write(struct file *file,
                           const char __user *buffer,
                           size_t len,
                           loff_t *offset)
 {
-    char kernel_buffer[128];
+    struct oled_device *oled = file->private_data;
+    char kernel_buffer[SSD1306_PAGES * (SSD1306_TEXT_COLS + 1) + 1];
     int ret;
 
     if (len >= sizeof(kernel_buffer))
@@ -116,135 +753,350 @@ static ssize_t oled_write(struct file *file,
         return -EFAULT;
     kernel_buffer[len] = '\0';
 
-    if (!oled_client)
+    if (mutex_lock_interruptible(&oled->lock))
+        return -ERESTARTSYS;
+
+    if (!oled->client) {
+        mutex_unlock(&oled->lock);
         return -ENODEV;
+    }
+    if (oled->fb_users) {
+        mutex_unlock(&oled->lock);
+        return -EBUSY;
+    }
+
+    ret = oled_text_render(oled, kernel_buffer);
+    mutex_unlock(&oled->lock);
 
-    ret = ssd1306_render_auto_wrapped(oled_client, kernel_buffer);
     if (ret < 0) {
         pr_err("smart_env: render failed (%d)\n", ret);
         return ret;
     }
 
-    pr_info("smart_env: OLED text rendered\n");
+    pr_debug("smart_env: OLED text rendered\n");
     return len;
 }
 
+/*
+ * OLED_IOC_SUBMIT: run a display list into the frame and flush once.
+ * The whole list is validated before anything is drawn, so a malformed
+ * list leaves the panel untouched. Caller holds oled->lock.
+ */
+static int oled_submit(struct oled_device *oled, void __user *uarg)
+{
+    struct oled_display_list dl;
+    struct oled_op op;
+    u8 *ops;
+    size_t pos;
+    int contrast = -1, invert = -1;
+    int ret;
+
+    if (copy_from_user(&dl, uarg, sizeof(dl)))
+        return -EFAULT;
+    if (dl.len == 0 || dl.len > OLED_DL_MAX_BYTES || dl.reserved)
+        return -EINVAL;
+
+    ops = memdup_user(u64_to_user_ptr(dl.ops), dl.len);
+    if (IS_ERR(ops))
+        return PTR_ERR(ops);
+
+    /* pass 1: validate */
+    for (pos = 0; pos < dl.len; pos += sizeof(op) + op.len) {
+        if (dl.len - pos < sizeof(op)) {
+            ret = -EINVAL;
+            goto out;
+        }
+        memcpy(&op, ops + pos, sizeof(op));
+        if (op.len > dl.len - pos - sizeof(op)) {
+            ret = -EINVAL;
+            goto out;
+        }
+        if (op.opcode == OLED_OP_BLIT &&
+            op.len < op.w * DIV_ROUND_UP(op.h, 8)) {
+            ret = -EINVAL;
+            goto out;
+        }
+        if (op.opcode < OLED_OP_CLEAR || op.opcode > OLED_OP_INVERT) {
+            ret = -EINVAL;
+            goto out;
+        }
+    }
+
+    /* pass 2: draw into the frame; text cells no longer describe it */
+    oled->cells_valid = 0;
+    for (pos = 0; pos < dl.len; pos += sizeof(op) + op.len) {
+        const u8 *payload = ops + pos + sizeof(op);
+
+        memcpy(&op, ops + pos, sizeof(op));
+        switch (op.opcode) {
+        case OLED_OP_CLEAR:
+            ssd1306_fb_fill_rect(oled->frame, op.x, op.y, op.w, op.h,
+                                 op.arg);
+            break;
+        case OLED_OP_TEXT:
+            ssd1306_fb_draw_text(oled->frame, op.x, op.y,
+                                 (const char *)payload, op.len);
+            break;
+        case OLED_OP_BLIT:
+            ssd1306_fb_blit(oled->frame, op.x, op.y, op.w, op.h, payload);
+            break;
+        case OLED_OP_CONTRAST:
+            contrast = op.arg;
+            break;
+        case OLED_OP_INVERT:
+            invert = op.arg;
+            break;
+        }
+    }
+
+    /* one burst for every page that changed */
+    ret = oled_flush_frame(oled, OLED_ALL_PAGES);
+    if (ret < 0)
+        goto out;
+
+    if (contrast >= 0) {
+        ret = ssd1306_set_contrast(oled->client, contrast);
+        if (ret < 0)
+            goto out;
+    }
+    if (invert >= 0)
+        ret = ssd1306_set_invert(oled->client, invert);
+
+out:
+    kfree(ops);
+    return ret < 0 ? ret : 0;
+}
+
+/* OLED_IOC_SCROLL: validate, flush pending drawing, then arm the scroll */
+static int oled_scroll_start(struct oled_device *oled, void __user *uarg)
+{
+    struct oled_scroll sc;
+    int ret;
+
+    if (copy_from_user(&sc, uarg, sizeof(sc)))
+        return -EFAULT;
+
+    if (sc.reserved || sc.start_page >= SSD1306_PAGES ||
+        sc.end_page >= SSD1306_PAGES || sc.end_page < sc.start_page ||
+        sc.interval > 7)
+        return -EINVAL;
+
+    switch (sc.mode) {
+    case OLED_SCROLL_RIGHT:
+    case OLED_SCROLL_LEFT:
+        break;
+    case OLED_SCROLL_DIAG_RIGHT:
+    case OLED_SCROLL_DIAG_LEFT:
+        if (sc.vertical_offset == 0 || sc.vertical_offset >= SSD1306_HEIGHT ||
+            sc.fixed_rows + sc.scroll_rows > SSD1306_HEIGHT)
+            return -EINVAL;
+        break;
+    default:
+        return -EINVAL;
+    }
+
+    /* settle the old scroll area before the controller starts moving it */
+    if (oled->scrolling) {
+        ret = ssd1306_stop_scroll(oled->client);
+        if (ret < 0)
+            return ret;
+        oled->scrolling = false;
+        oled->shadow_valid &= ~oled_scroll_pages(&oled->scroll);
+    }
+
+    ret = oled_flush_frame(oled, OLED_ALL_PAGES);
+    if (ret < 0)
+        return ret;
+
+    oled->scroll = sc;
+    ret = oled_scroll_apply(oled);
+    if (ret < 0)
+        return ret;
+
+    oled->scrolling = true;
+    return 0;
+}
+
+/* OLED_IOC_TEXT: rewrite part of one text row, changed glyphs only */
+static int oled_text_at(struct oled_device *oled, void __user *uarg)
+{
+    struct oled_text t;
+
+    if (copy_from_user(&t, uarg, sizeof(t)))
+        return -EFAULT;
+
+    if (t.reserved || t.row >= SSD1306_PAGES || t.len == 0 ||
+        t.len > OLED_TEXT_COLS || t.col + t.len > SSD1306_TEXT_COLS)
+        return -EINVAL;
+
+    return oled_text_update(oled, t.row, t.col, t.text, t.len);
+}
+
+/* commands that draw into the frame; refused while /dev/fbN owns it */
+static bool oled_ioc_draws(unsigned int cmd)
+{
+    switch (cmd) {
+    case OLED_IOC_CLEAR:
+    case OLED_IOC_SUBMIT:
+    case OLED_IOC_SCROLL:
+    case OLED_IOC_SCROLL_STOP:
+    case OLED_IOC_TEXT:
+        return true;
+    default:
+        return false;
+    }
+}
+
 /* ioctl(): control commands */
 static long oled_ioctl(struct file *file,
                        unsigned int cmd,
                        unsigned long arg)
 {
+    struct oled_device *oled = file->private_data;
+    struct i2c_client *client;
     int ret = 0;
 
-    if (!oled_client)
-        return -ENODEV;
     if (_IOC_TYPE(cmd) != OLED_IOC_MAGIC ||
         _IOC_NR(cmd) > OLED_IOC_MAXNR)
         return -ENOTTY;
 
+    if (mutex_lock_interruptible(&oled->lock))
+        return -ERESTARTSYS;
+
+    client = oled->client;
+    if (!client) {
+        ret = -ENODEV;
+        goto out;
+    }
+    if (oled->fb_users && oled_ioc_draws(cmd)) {
+        ret = -EBUSY;
+        goto out;
+    }
+
     switch (cmd) {
     case OLED_IOC_INIT:
         pr_info("smart_env: IOCTL INIT\n");
-        ret = ssd1306_init_display(oled_client);
+        ret = ssd1306_init_display(client);
+        oled->shadow_valid = 0;
+        oled->cells_valid = 0;
+        oled->scrolling = false;
         break;
 
     case OLED_IOC_CLEAR:
-        pr_info("smart_env: IOCTL CLEAR\n");
-        ret = ssd1306_clear_display(oled_client);
+        pr_debug("smart_env: IOCTL CLEAR\n");
+        memset(oled->frame, 0, sizeof(oled->frame));
+        ret = oled_flush_frame(oled, OLED_ALL_PAGES);
+        if (ret < 0)
+            break;
+        memset(oled->cells, ' ', sizeof(oled->cells));
+        oled->cells_valid = OLED_ALL_PAGES;
         break;
 
     case OLED_IOC_ON:
         pr_info("smart_env: IOCTL ON\n");
-        ret = ssd1306_display_on(oled_client);
+        ret = ssd1306_display_on(client);
         break;
 
     case OLED_IOC_OFF:
         pr_info("smart_env: IOCTL OFF\n");
-        ret = ssd1306_display_off(oled_client);
+        ret = ssd1306_display_off(client);
         break;
 
     case OLED_IOC_CONTRAST:
         pr_info("smart_env: IOCTL CONTRAST %lu\n", arg);
-        if (arg > 255)
-            return -EINVAL;
-        ret = ssd1306_set_contrast(oled_client, (u8)arg);
+        if (arg > 255) {
+            ret = -EINVAL;
+            break;
+        }
+        ret = ssd1306_set_contrast(client, (u8)arg);
+        break;
+
+    case OLED_IOC_SUBMIT:
+        ret = oled_submit(oled, (void __user *)arg);
+        break;
+
+    case OLED_IOC_SCROLL:
+        ret = oled_scroll_start(oled, (void __user *)arg);
+        break;
+
+    case OLED_IOC_SCROLL_STOP:
+        if (!oled->scrolling)
+            break;
+        ret = ssd1306_stop_scroll(client);
+        if (ret < 0)
+            break;
+        /* stopped GDDRAM is left shifted; restore it from the frame */
+        oled->scrolling = false;
+        oled->shadow_valid &= ~oled_scroll_pages(&oled->scroll);
+        ret = oled_flush_frame(oled, OLED_ALL_PAGES);
+        break;
+
+    case OLED_IOC_TEXT:
+        ret = oled_text_at(oled, (void __user *)arg);
+        break;
+
+    case OLED_IOC_START_LINE:
+        if (arg >= SSD1306_HEIGHT) {
+            ret = -EINVAL;
+            break;
+        }
+        ret = ssd1306_set_start_line(client, (u8)arg);
         break;
 
     default:
-        return -ENOTTY;
+        ret = -ENOTTY;
+        break;
     }
 
-    return ret;
+out:
+    mutex_unlock(&oled->lock);
+    return ret < 0 ? ret : 0;
 }
 
-/* Module init: register char device and I2C driver */
+/* Module init: reserve minors, create class and register I2C driver */
 static int __init oled_driver_init(void)
 {
     int ret;
 
     pr_info("smart_env: init OLED driver\n");
 
-    /* 1) allocate device number */
-    ret = alloc_chrdev_region(&dev_number, 0, 1, DEVICE_NAME);
+    /* 1) reserve a minor range, one per possible panel */
+    ret = alloc_chrdev_region(&oled_base_dev, 0, OLED_MAX_DEVICES,
+                              DEVICE_NAME);
     if (ret) {
         pr_err("smart_env: alloc_chrdev_region failed\n");
         return ret;
     }
 
-    /* 2) create device class */
+    /* 2) create device class; nodes are created per panel in probe() */
     oled_class = class_create(CLASS_NAME);
     if (IS_ERR(oled_class)) {
-        unregister_chrdev_region(dev_number, 1);
+        unregister_chrdev_region(oled_base_dev, OLED_MAX_DEVICES);
         pr_err("smart_env: class_create failed\n");
         return PTR_ERR(oled_class);
     }
 
-    /* 3) create device node */
-    oled_device = device_create(oled_class, NULL,
-                               dev_number, NULL,
-                               DEVICE_NAME);
-    if (IS_ERR(oled_device)) {
-        class_destroy(oled_class);
-        unregister_chrdev_region(dev_number, 1);
-        pr_err("smart_env: device_create failed\n");
-        return PTR_ERR(oled_device);
-    }
-
-    /* 4) initialize and add cdev */
-    cdev_init(&oled_cdev, &oled_fops);
-    oled_cdev.owner = THIS_MODULE;
-    ret = cdev_add(&oled_cdev, dev_number, 1);
-    if (ret) {
-        device_destroy(oled_class, dev_number);
-        class_destroy(oled_class);
-        unregister_chrdev_region(dev_number, 1);
-        pr_err("smart_env: cdev_add failed\n");
-        return ret;
-    }
-
-    /* 5) register I2C driver */
+    /* 3) register I2C driver */
     ret = i2c_add_driver(&oled_driver);
     if (ret) {
-        cdev_del(&oled_cdev);
-        device_destroy(oled_class, dev_number);
         class_destroy(oled_class);
-        unregister_chrdev_region(dev_number, 1);
+        unregister_chrdev_region(oled_base_dev, OLED_MAX_DEVICES);
         pr_err("smart_env: i2c_add_driver failed\n");
         return ret;
     }
 
-    pr_info("smart_env: OLED driver ready, /dev/%s\n", DEVICE_NAME);
+    pr_info("smart_env: OLED driver ready, /dev/%s0..%d\n",
+            DEVICE_NAME, OLED_MAX_DEVICES - 1);
     return 0;
 }
 
-/* Module exit: unregister I2C driver and char device */
+/* Module exit: unregister I2C driver and char device region */
 static void __exit oled_driver_exit(void)
 {
     i2c_del_driver(&oled_driver);
-    cdev_del(&oled_cdev);
-    device_destroy(oled_class, dev_number);
     class_destroy(oled_class);
-    unregister_chrdev_region(dev_number, 1);
+    unregister_chrdev_region(oled_base_dev, OLED_MAX_DEVICES);
+    ida_destroy(&oled_minor_ida);
     pr_info("smart_env: OLED driver removed\n");
 }
 
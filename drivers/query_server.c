@@ -0,0 +1,557 @@
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include "query_server.h"
+
+#define LISTEN_TAG          UINT32_MAX
+#define POLL_EVENTS         64
+#define MAX_RESPONSE        (sizeof(qs_response_t) + sizeof(qs_status_t))
+
+static int64_t mono_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+static uint32_t out_space(const qs_conn_t *c) {
+    return QUERY_SERVER_OUT_BUF - (c->out_len - c->out_off);
+}
+
+// 응답 헤더 + 페이로드를 대기열에 추가 (호출 전에 out_space 확인)
+static void out_append(qs_conn_t *c, const qs_response_t *hdr, const void *payload, uint32_t len) {
+    if (c->out_off > 0 && c->out_len + sizeof(*hdr) + len > QUERY_SERVER_OUT_BUF) {
+        memmove(c->out, c->out + c->out_off, c->out_len - c->out_off);
+        c->out_len -= c->out_off;
+        c->out_off = 0;
+    }
+    memcpy(c->out + c->out_len, hdr, sizeof(*hdr));
+    c->out_len += sizeof(*hdr);
+    if (len) {
+        memcpy(c->out + c->out_len, payload, len);
+        c->out_len += len;
+    }
+}
+
+static void reply(qs_conn_t *c, uint8_t op, uint8_t status, uint32_t count,
+                  const void *payload, uint32_t len) {
+    qs_response_t hdr = { op, status, 0, count, len };
+    out_append(c, &hdr, payload, len);
+}
+
+static int has_output(const qs_conn_t *c) {
+    return c->out_len > c->out_off || c->range_left > 0;
+}
+
+// 요청을 더 받을 수 있는지: 범위 전송 중이 아니고 응답 자리가 있을 때만
+static int can_take_request(const qs_conn_t *c) {
+    return c->range_left == 0 && out_space(c) >= MAX_RESPONSE;
+}
+
+static void close_conn(query_server_t *srv, qs_conn_t *c) {
+    epoll_ctl(srv->epoll_fd, EPOLL_CTL_DEL, c->fd, NULL);
+    close(c->fd);
+    if (c->subscribed) srv->subscribers--;
+    srv->clients--;
+    memset(c, 0, sizeof(*c));
+    c->fd = -1;
+    srv->free_slots[srv->free_count++] = (uint16_t)(c - srv->conns);
+}
+
+// 입력이 막혔으면 EPOLLIN을 빼고, 보낼 것이 있으면 EPOLLOUT을 넣음 (바뀔 때만 epoll_ctl)
+static void update_interest(query_server_t *srv, qs_conn_t *c) {
+    uint32_t want = EPOLLRDHUP;
+    struct epoll_event ev;
+
+    if (c->in_len < QUERY_SERVER_IN_BUF) want |= EPOLLIN;
+    if (has_output(c)) want |= EPOLLOUT;
+    if (want == c->events) return;
+
+    ev.events = want;
+    ev.data.u32 = (uint32_t)(c - srv->conns);
+    epoll_ctl(srv->epoll_fd, EPOLL_CTL_MOD, c->fd, &ev);
+    c->events = want;
+}
+
+static void queue_push(query_server_t *srv, qs_conn_t *c) {
+    reply(c, QS_OP_PUSH, QS_OK, 1, &srv->latest.sample, sizeof(srv->latest.sample));
+    c->push_pending = 0;
+    srv->pushes_sent++;
+}
+
+static int alert_pending(const query_server_t *srv, const qs_conn_t *c) {
+    return c->subscribed && c->alert_seq != srv->alert_seq;
+}
+
+// 밀린 경보 하나를 대기열에 (링보다 더 밀렸으면 남은 가장 오래된 것부터)
+static void queue_alert(query_server_t *srv, qs_conn_t *c) {
+    uint32_t behind = srv->alert_seq - c->alert_seq;
+
+    if (behind > QUERY_SERVER_ALERT_RING) {
+        srv->alerts_skipped += behind - QUERY_SERVER_ALERT_RING;
+        c->alert_seq = srv->alert_seq - QUERY_SERVER_ALERT_RING;
+    }
+    reply(c, QS_OP_ALERT, QS_OK, 1, &srv->alerts[c->alert_seq % QUERY_SERVER_ALERT_RING],
+          sizeof(qs_alert_t));
+    c->alert_seq++;
+    srv->alerts_sent++;
+}
+
+// 가장 오래된 샘플의 추가 번호 (연 뒤 추가 수 - 보관 수, 이전 실행분은 음수)
+static int64_t oldest_seq(const history_store_t *h) {
+    return (int64_t)h->appended - (int64_t)h->hdr.count;
+}
+
+static void handle_range(query_server_t *srv, qs_conn_t *c, const qs_request_t *req) {
+    const history_store_t *h = srv->history;
+    uint32_t first, last, count;
+
+    if (!h || req->arg1 <= req->arg0) {
+        reply(c, QS_OP_RANGE, h ? QS_ERR_BAD_REQUEST : QS_ERR_NO_DATA, 0, NULL, 0);
+        return;
+    }
+
+    first = history_store_lower_bound(h, (int64_t)req->arg0 * 1000);
+    last = history_store_lower_bound(h, (int64_t)req->arg1 * 1000);
+    count = last - first;
+    if (req->arg2 && count > req->arg2) count = req->arg2;
+
+    // 헤더만 대기열에 넣고 페이로드 길이는 뒤따를 링 구간 길이로
+    qs_response_t hdr = { QS_OP_RANGE, QS_OK, 0, count, count * (uint32_t)sizeof(sensor_sample_t) };
+    out_append(c, &hdr, NULL, 0);
+    if (count) {
+        // 샘플은 복사하지 않고 링 슬롯 위치만 기억 (flush가 sendmsg로 바로 보냄)
+        c->range_slot = (uint32_t)(history_store_get(h, first) - h->records);
+        c->range_left = count;
+        c->range_byte = 0;
+        c->range_seq = oldest_seq(h) + first;
+    }
+}
+
+static void handle_summary(query_server_t *srv, qs_conn_t *c, const qs_request_t *req) {
+    const history_store_t *h = srv->history;
+    history_agg_t agg;
+    qs_summary_t sum;
+
+    if (!h || req->arg1 <= req->arg0) {
+        reply(c, QS_OP_SUMMARY, h ? QS_ERR_BAD_REQUEST : QS_ERR_NO_DATA, 0, NULL, 0);
+        return;
+    }
+
+    // 색인은 쓰는 클라이언트가 있을 때만 만듦 (기본 용량에서 약 400KB)
+    if (!srv->index_ready) {
+        if (history_index_init(&srv->index, h) != 0) {
+            reply(c, QS_OP_SUMMARY, QS_ERR_NO_DATA, 0, NULL, 0);
+            return;
+        }
+        srv->index_ready = 1;
+    } else {
+        history_index_sync(&srv->index, h);
+    }
+
+    memset(&sum, 0, sizeof(sum));
+    if (history_index_query(&srv->index, h, (int64_t)req->arg0 * 1000,
+                            (int64_t)req->arg1 * 1000, &agg) > 0) {
+        sum.count = agg.count;
+        sum.temp_min = agg.temp_min;
+        sum.temp_max = agg.temp_max;
+        sum.temp_mean = (int16_t)history_agg_temp_mean(&agg);
+        sum.humi_min = agg.humi_min;
+        sum.humi_max = agg.humi_max;
+        sum.humi_mean = (uint16_t)history_agg_humi_mean(&agg);
+    }
+    reply(c, QS_OP_SUMMARY, QS_OK, 1, &sum, sizeof(sum));
+}
+
+static void handle_status(query_server_t *srv, qs_conn_t *c) {
+    qs_status_t st;
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    memset(&st, 0, sizeof(st));
+    st.clients = srv->clients;
+    st.subscribers = srv->subscribers;
+    st.history_count = srv->history ? history_store_count(srv->history) : 0;
+    st.uptime_s = (uint32_t)(now.tv_sec - srv->started.tv_sec);
+    st.temp_level = srv->latest.temp_level;
+    st.humi_level = srv->latest.humi_level;
+    st.overall_level = srv->latest.overall_level;
+    st.prolonged_warning = srv->latest.prolonged_warning;
+    st.warning_elapsed_s = srv->latest.warning_elapsed_s;
+    st.reads_ok = srv->latest.reads_ok;
+    st.reads_failed = srv->latest.reads_failed;
+    st.pushes_sent = srv->pushes_sent;
+    st.pushes_coalesced = srv->pushes_coalesced;
+    reply(c, QS_OP_STATUS, QS_OK, 1, &st, sizeof(st));
+}
+
+static void handle_request(query_server_t *srv, qs_conn_t *c, const qs_request_t *req) {
+    switch (req->op) {
+    case QS_OP_LATEST:
+        if (srv->have_latest) {
+            reply(c, QS_OP_LATEST, QS_OK, 1, &srv->latest.sample, sizeof(srv->latest.sample));
+        } else {
+            reply(c, QS_OP_LATEST, QS_ERR_NO_DATA, 0, NULL, 0);
+        }
+        break;
+    case QS_OP_RANGE:
+        handle_range(srv, c, req);
+        break;
+    case QS_OP_STATUS:
+        handle_status(srv, c);
+        break;
+    case QS_OP_SUMMARY:
+        handle_summary(srv, c, req);
+        break;
+    case QS_OP_SUBSCRIBE:
+        if (!c->subscribed) srv->subscribers++;
+        c->subscribed = 1;
+        c->every_n = req->arg0 ? req->arg0 : 1;
+        c->min_interval_ms = req->arg1;
+        c->skip = 0;
+        c->last_push_ms = 0;
+        c->alert_seq = srv->alert_seq;     // 구독 이후 경보만
+        reply(c, QS_OP_SUBSCRIBE, QS_OK, 0, NULL, 0);
+        break;
+    case QS_OP_UNSUBSCRIBE:
+        if (c->subscribed) srv->subscribers--;
+        c->subscribed = 0;
+        c->push_pending = 0;
+        reply(c, QS_OP_UNSUBSCRIBE, QS_OK, 0, NULL, 0);
+        break;
+    default:
+        reply(c, req->op, QS_ERR_BAD_REQUEST, 0, NULL, 0);
+        break;
+    }
+}
+
+// 받아 둔 요청을 응답 자리가 있는 만큼 처리
+static void process_requests(query_server_t *srv, qs_conn_t *c) {
+    uint32_t used = 0;
+
+    while (c->in_len - used >= sizeof(qs_request_t) && can_take_request(c)) {
+        qs_request_t req;
+        memcpy(&req, c->in + used, sizeof(req));
+        used += sizeof(req);
+        handle_request(srv, c, &req);
+    }
+    if (used) {
+        memmove(c->in, c->in + used, c->in_len - used);
+        c->in_len -= used;
+    }
+}
+
+// 대기열 + 범위 구간을 sendmsg 한 번으로 보냄
+// 반환: 1 이번에 내놓은 것을 다 보냄, 0 소켓 버퍼 참, -1 연결 오류
+static int flush_once(query_server_t *srv, qs_conn_t *c) {
+    const history_store_t *h = srv->history;
+    struct iovec iov[3];
+    struct msghdr msg;
+    int n = 0;
+    size_t range_bytes = 0;
+    ssize_t sent;
+
+    if (c->out_len > c->out_off) {
+        iov[n].iov_base = c->out + c->out_off;
+        iov[n].iov_len = c->out_len - c->out_off;
+        n++;
+    }
+    if (c->range_left > 0) {
+        uint32_t cap = h->hdr.capacity;
+        size_t total, first_len;
+
+        // 느린 클라이언트가 읽는 동안 추가가 남은 샘플을 덮어썼으면
+        // (헤더의 개수는 이미 보냈으므로) 섞인 데이터를 보내지 않고 연결을 끊음
+        if (c->range_seq < oldest_seq(h)) {
+            fprintf(stderr, "⚠️ 질의 서버: 범위 전송 중 이력 링이 덮어써져 연결 종료\n");
+            srv->ranges_aborted++;
+            return -1;
+        }
+        total = (size_t)c->range_left * sizeof(sensor_sample_t) - c->range_byte;
+        first_len = (size_t)(cap - c->range_slot) * sizeof(sensor_sample_t) - c->range_byte;
+
+        if (total > QUERY_SERVER_WRITE_CHUNK) total = QUERY_SERVER_WRITE_CHUNK;
+        if (first_len > total) first_len = total;
+        iov[n].iov_base = (uint8_t *)&h->records[c->range_slot] + c->range_byte;
+        iov[n].iov_len = first_len;
+        n++;
+        if (total > first_len) {
+            // 링 끝을 넘으면 앞쪽에서 이어서
+            iov[n].iov_base = (void *)h->records;
+            iov[n].iov_len = total - first_len;
+            n++;
+        }
+        range_bytes = total;
+    }
+    if (n == 0) return 1;
+
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = iov;
+    msg.msg_iovlen = (size_t)n;
+    sent = sendmsg(c->fd, &msg, MSG_NOSIGNAL | MSG_DONTWAIT);
+    if (sent < 0) {
+        return (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) ? 0 : -1;
+    }
+
+    // 보낸 만큼 대기열 → 범위 순으로 소비
+    uint32_t from_out = c->out_len - c->out_off;
+    if ((size_t)sent < from_out) {
+        c->out_off += (uint32_t)sent;
+        return 0;
+    }
+    c->out_off = c->out_len = 0;
+    sent -= from_out;
+
+    if (range_bytes) {
+        uint32_t cap = h->hdr.capacity;
+        size_t pos = c->range_byte + (size_t)sent;
+        uint32_t done = (uint32_t)(pos / sizeof(sensor_sample_t));
+
+        c->range_byte = (uint32_t)(pos % sizeof(sensor_sample_t));
+        c->range_left -= done;
+        c->range_slot = (c->range_slot + done) % cap;
+        c->range_seq += done;
+        if ((size_t)sent < range_bytes) return 0;
+    }
+    return 1;
+}
+
+// 보낼 수 있는 만큼 보내고, 자리가 나면 밀린 요청/PUSH 처리 (기다리지 않음)
+static int service(query_server_t *srv, qs_conn_t *c) {
+    for (;;) {
+        int r;
+
+        process_requests(srv, c);
+        if (c->push_pending && c->range_left == 0 &&
+            out_space(c) >= sizeof(qs_response_t) + sizeof(sensor_sample_t)) {
+            queue_push(srv, c);
+        }
+        // 범위 페이로드 사이에 끼면 안 되므로 범위 전송이 끝난 뒤에만
+        while (alert_pending(srv, c) && c->range_left == 0 &&
+               out_space(c) >= sizeof(qs_response_t) + sizeof(qs_alert_t)) {
+            queue_alert(srv, c);
+        }
+
+        r = flush_once(srv, c);
+        if (r < 0) return -1;
+        if (r == 0) break;
+
+        // 남은 범위/요청/PUSH가 없으면 끝
+        if (!has_output(c) && c->in_len < sizeof(qs_request_t) && !c->push_pending &&
+            !alert_pending(srv, c)) break;
+    }
+    update_interest(srv, c);
+    return 0;
+}
+
+static int read_conn(qs_conn_t *c) {
+    while (c->in_len < QUERY_SERVER_IN_BUF) {
+        ssize_t n = read(c->fd, c->in + c->in_len, QUERY_SERVER_IN_BUF - c->in_len);
+        if (n > 0) {
+            c->in_len += (uint32_t)n;
+            continue;
+        }
+        if (n == 0) return -1;                  // 상대가 닫음
+        if (errno == EAGAIN || errno == EWOULDBLOCK) return 0;
+        if (errno == EINTR) continue;
+        return -1;
+    }
+    return 0;
+}
+
+static void accept_clients(query_server_t *srv) {
+    for (;;) {
+        struct epoll_event ev;
+        qs_conn_t *c;
+        uint16_t slot;
+        int fd = accept(srv->listen_fd, NULL, NULL);
+
+        if (fd < 0) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                perror("⚠️ 질의 서버 accept 실패");
+            }
+            return;
+        }
+        fcntl(fd, F_SETFL, O_NONBLOCK);
+        fcntl(fd, F_SETFD, FD_CLOEXEC);
+        if (srv->free_count == 0) {
+            close(fd);                          // 슬롯 없음: 바로 끊음
+            continue;
+        }
+
+        slot = srv->free_slots[--srv->free_count];
+        c = &srv->conns[slot];
+        memset(c, 0, sizeof(*c));
+        c->fd = fd;
+        c->events = EPOLLIN | EPOLLRDHUP;
+        ev.events = c->events;
+        ev.data.u32 = slot;
+        if (epoll_ctl(srv->epoll_fd, EPOLL_CTL_ADD, fd, &ev) != 0) {
+            perror("⚠️ 질의 서버 epoll 등록 실패");
+            close(fd);
+            c->fd = -1;
+            srv->free_slots[srv->free_count++] = slot;
+            continue;
+        }
+        srv->clients++;
+    }
+}
+
+int query_server_open(query_server_t *srv, const char *path, const history_store_t *history) {
+    struct sockaddr_un addr;
+    struct epoll_event ev;
+
+    memset(srv, 0, sizeof(*srv));
+    srv->listen_fd = -1;
+    srv->epoll_fd = -1;
+    srv->history = history;
+    clock_gettime(CLOCK_MONOTONIC, &srv->started);
+    for (int i = 0; i < QUERY_SERVER_MAX_CLIENTS; i++) {
+        srv->conns[i].fd = -1;
+        srv->free_slots[i] = (uint16_t)(QUERY_SERVER_MAX_CLIENTS - 1 - i);
+    }
+    srv->free_count = QUERY_SERVER_MAX_CLIENTS;
+
+    if (strlen(path) >= sizeof(addr.sun_path)) {
+        fprintf(stderr, "❌ 소켓 경로가 너무 깁니다: %s\n", path);
+        return -1;
+    }
+    strcpy(srv->path, path);
+
+    srv->listen_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (srv->listen_fd < 0) {
+        perror("❌ 질의 소켓 생성 실패");
+        return -1;
+    }
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, path);
+    unlink(path);
+    if (bind(srv->listen_fd, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+        perror("❌ 질의 소켓 bind 실패");
+        goto fail;
+    }
+    chmod(path, 0666);      // 로컬 사용자 누구나 읽기 질의 가능
+    if (listen(srv->listen_fd, 128) != 0) {
+        perror("❌ 질의 소켓 listen 실패");
+        goto fail;
+    }
+
+    srv->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (srv->epoll_fd < 0) {
+        perror("❌ epoll 생성 실패");
+        goto fail;
+    }
+    ev.events = EPOLLIN;
+    ev.data.u32 = LISTEN_TAG;
+    if (epoll_ctl(srv->epoll_fd, EPOLL_CTL_ADD, srv->listen_fd, &ev) != 0) {
+        perror("❌ epoll 등록 실패");
+        goto fail;
+    }
+    return 0;
+
+fail:
+    query_server_close(srv);
+    return -1;
+}
+
+void query_server_close(query_server_t *srv) {
+    for (int i = 0; i < QUERY_SERVER_MAX_CLIENTS; i++) {
+        if (srv->conns[i].fd >= 0) close_conn(srv, &srv->conns[i]);
+    }
+    if (srv->epoll_fd >= 0) {
+        close(srv->epoll_fd);
+        srv->epoll_fd = -1;
+    }
+    if (srv->listen_fd >= 0) {
+        close(srv->listen_fd);
+        srv->listen_fd = -1;
+        unlink(srv->path);
+    }
+    if (srv->index_ready) {
+        history_index_free(&srv->index);
+        srv->index_ready = 0;
+    }
+}
+
+int query_server_poll(query_server_t *srv, int timeout_ms) {
+    struct epoll_event events[POLL_EVENTS];
+    int n = epoll_wait(srv->epoll_fd, events, POLL_EVENTS, timeout_ms);
+
+    if (n < 0) {
+        if (errno == EINTR) return 0;
+        perror("⚠️ 질의 서버 epoll_wait 실패");
+        return -1;
+    }
+
+    for (int i = 0; i < n; i++) {
+        qs_conn_t *c;
+
+        if (events[i].data.u32 == LISTEN_TAG) {
+            accept_clients(srv);
+            continue;
+        }
+
+        c = &srv->conns[events[i].data.u32];
+        if (c->fd < 0) continue;    // 이번 묶음에서 이미 닫힘
+
+        if (events[i].events & EPOLLERR) {
+            close_conn(srv, c);
+            continue;
+        }
+        if ((events[i].events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP)) && read_conn(c) < 0) {
+            close_conn(srv, c);
+            continue;
+        }
+        if (service(srv, c) < 0) close_conn(srv, c);
+    }
+    return n;
+}
+
+void query_server_update(query_server_t *srv, const env_snapshot_t *snap) {
+    int new_sample = !srv->have_latest ||
+                     memcmp(&snap->sample, &srv->latest.sample, sizeof(snap->sample)) != 0;
+    int64_t now;
+
+    srv->latest = *snap;
+    srv->have_latest = 1;
+    if (!new_sample || srv->subscribers == 0) return;
+
+    now = mono_ms();
+    for (int i = 0; i < QUERY_SERVER_MAX_CLIENTS; i++) {
+        qs_conn_t *c = &srv->conns[i];
+
+        if (c->fd < 0 || !c->subscribed) continue;
+
+        // 서버 측 솎아내기: N개마다 1개, 최소 간격
+        if (++c->skip < c->every_n) continue;
+        if (c->last_push_ms && now - c->last_push_ms < (int64_t)c->min_interval_ms) continue;
+        c->skip = 0;
+        c->last_push_ms = now;
+
+        // 범위 전송 중이거나 대기열이 찼으면 최신 값 하나로 합침
+        if (c->push_pending) srv->pushes_coalesced++;
+        c->push_pending = 1;
+        if (service(srv, c) < 0) close_conn(srv, c);
+    }
+}
+
+void query_server_alert(query_server_t *srv, const qs_alert_t *alert) {
+    srv->alerts[srv->alert_seq % QUERY_SERVER_ALERT_RING] = *alert;
+    srv->alert_seq++;
+    if (srv->subscribers == 0) return;
+
+    for (int i = 0; i < QUERY_SERVER_MAX_CLIENTS; i++) {
+        qs_conn_t *c = &srv->conns[i];
+
+        if (c->fd < 0 || !c->subscribed) continue;
+        if (service(srv, c) < 0) close_conn(srv, c);
+    }
+}
@@ -0,0 +1,142 @@
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include "rtc_tick.h"
+#include "ds1307_rtc.h"
+#include "gpio_driver.h"
+
+static int days_in_month(int mon, int year) {
+    static const int days[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    int y = year + 1900;
+
+    if (mon == 1 && ((y % 4 == 0 && y % 100 != 0) || y % 400 == 0)) return 29;
+    return days[mon];
+}
+
+void rtc_tick_advance(struct tm *tm) {
+    if (++tm->tm_sec < 60) return;
+    tm->tm_sec = 0;
+    if (++tm->tm_min < 60) return;
+    tm->tm_min = 0;
+    if (++tm->tm_hour < 24) return;
+    tm->tm_hour = 0;
+    tm->tm_wday = (tm->tm_wday + 1) % 7;
+    if (++tm->tm_mday <= days_in_month(tm->tm_mon, tm->tm_year)) return;
+    tm->tm_mday = 1;
+    if (++tm->tm_mon < 12) return;
+    tm->tm_mon = 0;
+    tm->tm_year++;
+}
+
+static long long monotonic_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+int rtc_tick_init(rtc_tick_t *tick, int sqw_pin) {
+    memset(tick, 0, sizeof(*tick));
+
+    if (!gpio_chip) {
+        fprintf(stderr, "RTC 틱: GPIO 칩이 초기화되지 않음\n");
+        return -1;
+    }
+
+    if (ds1307_enable_square_wave(DS1307_SQW_1HZ) != 0) {
+        fprintf(stderr, "RTC 틱: SQW 1Hz 설정 실패\n");
+        return -1;
+    }
+
+    tick->line = gpiod_chip_get_line(gpio_chip, sqw_pin);
+    if (!tick->line) {
+        perror("RTC 틱: SQW 라인 가져오기 실패");
+        ds1307_disable_square_wave();
+        return -1;
+    }
+
+    // SQW는 오픈 드레인이므로 내부 풀업도 함께 요청
+    if (gpiod_line_request_falling_edge_events_flags(tick->line, "ds1307_sqw",
+            GPIOD_LINE_REQUEST_FLAG_BIAS_PULL_UP) < 0) {
+        perror("RTC 틱: SQW 에지 이벤트 요청 실패");
+        tick->line = NULL;
+        ds1307_disable_square_wave();
+        return -1;
+    }
+
+    // 시작할 때 한 번만 RTC를 읽고 이후로는 틱으로 증가.
+    // 에지 요청과 읽기 사이(또는 읽은 직후)에 에지가 들어왔으면 그 에지는
+    // 읽은 값에 이미 반영됐을 수 있으므로 비우고 다시 읽음 (한 초 앞서지 않게)
+    for (int tries = 0; ; tries++) {
+        struct timespec no_wait = {0, 0};
+        struct gpiod_line_event events[4];
+        int ret;
+
+        if (ds1307_read_time(&tick->now) != 0) {
+            fprintf(stderr, "RTC 틱: 초기 시각 읽기 실패\n");
+            rtc_tick_cleanup(tick);
+            return -1;
+        }
+
+        ret = gpiod_line_event_wait(tick->line, &no_wait);
+        if (ret == 0 || tries == 2) break;
+        if (ret < 0 || gpiod_line_event_read_multiple(tick->line, events, 4) < 0) {
+            perror("RTC 틱: SQW 에지 비우기 실패");
+            rtc_tick_cleanup(tick);
+            return -1;
+        }
+    }
+
+    tick->last_edge_ms = monotonic_ms();
+    return 0;
+}
+
+void rtc_tick_cleanup(rtc_tick_t *tick) {
+    if (tick->line) {
+        gpiod_line_release(tick->line);
+        tick->line = NULL;
+    }
+    ds1307_disable_square_wave();
+}
+
+int rtc_tick_wait(rtc_tick_t *tick, int timeout_ms) {
+    struct timespec timeout = {
+        .tv_sec = timeout_ms / 1000,
+        .tv_nsec = (timeout_ms % 1000) * 1000000L,
+    };
+    struct gpiod_line_event events[4];
+    int ret, n;
+
+    ret = gpiod_line_event_wait(tick->line, &timeout);
+    if (ret < 0) return ret;
+    if (ret == 0) {
+        // 배선이 없으면 요청은 성공해도 에지가 오지 않음
+        if (monotonic_ms() - tick->last_edge_ms > RTC_TICK_WATCHDOG_MS) {
+            fprintf(stderr, "RTC 틱: %d ms 동안 SQW 에지 없음\n", RTC_TICK_WATCHDOG_MS);
+            errno = ETIMEDOUT;
+            return -1;
+        }
+        return 0;
+    }
+
+    // 늦게 깨어났다면 쌓인 에지를 모두 반영
+    n = gpiod_line_event_read_multiple(tick->line, events, 4);
+    if (n < 0) return -1;
+
+    for (int i = 0; i < n; i++) {
+        rtc_tick_advance(&tick->now);
+    }
+    tick->last_edge_ms = monotonic_ms();
+    tick->ticks += n;
+    tick->ticks_since_sync += n;
+
+    // 주기적으로 RTC와 맞춤 (에지 누락, 수동 시각 변경 대비)
+    if (tick->ticks_since_sync >= RTC_TICK_RESYNC_TICKS) {
+        struct tm rtc_now;
+        if (ds1307_read_time(&rtc_now) == 0) {
+            tick->now = rtc_now;
+        }
+        tick->ticks_since_sync = 0;
+    }
+
+    return n;
+}
@@ -0,0 +1,228 @@
+#include <string.h>
+#include "sample_codec.h"
+
+static inline uint32_t zigzag(int32_t v) {
+    return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31);
+}
+
+static inline int32_t unzigzag(uint32_t v) {
+    return (int32_t)(v >> 1) ^ -(int32_t)(v & 1);
+}
+
+// ---- 비트 쓰기 ----
+
+static inline void put_bits(sample_encoder_t *enc, uint32_t value, unsigned width) {
+    enc->acc = (enc->acc << width) | (width < 32 ? value & ((1u << width) - 1) : value);
+    enc->nbits += width;
+    while (enc->nbits >= 8) {
+        enc->nbits -= 8;
+        enc->buf[enc->len++] = (uint8_t)(enc->acc >> enc->nbits);
+    }
+}
+
+static void put_time(sample_encoder_t *enc, int64_t dod) {
+    uint32_t z;
+
+    if (dod == 0) {
+        put_bits(enc, 0x0, 1);
+        return;
+    }
+    z = zigzag((int32_t)dod);
+    if (z < (1u << 7)) {
+        put_bits(enc, 0x2, 2);
+        put_bits(enc, z, 7);
+    } else if (z < (1u << 9)) {
+        put_bits(enc, 0x6, 3);
+        put_bits(enc, z, 9);
+    } else if (z < (1u << 12)) {
+        put_bits(enc, 0xE, 4);
+        put_bits(enc, z, 12);
+    } else {
+        put_bits(enc, 0xF, 4);
+        put_bits(enc, z, 32);
+    }
+}
+
+static void put_value(sample_encoder_t *enc, int32_t delta) {
+    uint32_t z;
+
+    if (delta == 0) {
+        put_bits(enc, 0x0, 1);
+        return;
+    }
+    z = zigzag(delta);
+    if (z < (1u << 4)) {
+        put_bits(enc, 0x2, 2);
+        put_bits(enc, z, 4);
+    } else if (z < (1u << 8)) {
+        put_bits(enc, 0x6, 3);
+        put_bits(enc, z, 8);
+    } else if (z < (1u << 12)) {
+        put_bits(enc, 0xE, 4);
+        put_bits(enc, z, 12);
+    } else {
+        put_bits(enc, 0xF, 4);
+        put_bits(enc, z, 17);
+    }
+}
+
+void sample_encoder_init(sample_encoder_t *enc, uint8_t *buf, size_t cap) {
+    memset(enc, 0, sizeof(*enc));
+    enc->buf = buf;
+    enc->cap = cap;
+}
+
+int sample_encoder_add(sample_encoder_t *enc, const sensor_sample_t *sample) {
+    int64_t ms = sample_time_ms(sample);
+
+    if (enc->count == 0) {
+        if (enc->cap < SAMPLE_CODEC_HEADER_BYTES) return -1;
+        memcpy(enc->buf, sample, SAMPLE_CODEC_HEADER_BYTES);
+        enc->len = SAMPLE_CODEC_HEADER_BYTES;
+    } else {
+        int64_t delta = ms - enc->prev_ms;
+
+        // 최악의 경우에도 들어갈 자리가 있어야 함 (부분 바이트 포함).
+        // 시각 역행이나 32비트를 넘는 간격(약 24일)은 새 블록에서 시작
+        if (enc->count == UINT16_MAX ||
+            (enc->len + 1) * 8 + SAMPLE_CODEC_MAX_BITS > enc->cap * 8 ||
+            delta < 0 || delta - enc->prev_delta_ms > INT32_MAX ||
+            delta - enc->prev_delta_ms < INT32_MIN) {
+            return -1;
+        }
+
+        put_time(enc, delta - enc->prev_delta_ms);
+        put_value(enc, (int32_t)sample->temp_centi - enc->prev.temp_centi);
+        put_value(enc, (int32_t)sample->humi_centi - enc->prev.humi_centi);
+        if (sample->flags == enc->prev.flags) {
+            put_bits(enc, 0x0, 1);
+        } else {
+            put_bits(enc, 0x1, 1);
+            put_bits(enc, sample->flags, 16);
+        }
+        enc->prev_delta_ms = delta;
+    }
+
+    enc->prev = *sample;
+    enc->prev_ms = ms;
+    enc->count++;
+    return 0;
+}
+
+size_t sample_encoder_finish(sample_encoder_t *enc) {
+    if (enc->nbits > 0) {
+        enc->buf[enc->len++] = (uint8_t)(enc->acc << (8 - enc->nbits));
+        enc->nbits = 0;
+    }
+    return enc->len;
+}
+
+// ---- 비트 읽기 ----
+
+// 디코더 상태 중 비트 읽기 부분은 지역 변수로 복사해 씀 (출력 쓰기와의
+// 별칭 가능성 때문에 구조체 필드를 매번 다시 읽지 않도록)
+typedef struct {
+    const uint8_t *buf;
+    size_t len;
+    size_t pos;
+    uint64_t window;
+    unsigned nbits;
+} bit_reader_t;
+
+// 창에 최소 57비트가 차도록 채움 (블록 끝 이후는 0)
+static inline void refill(bit_reader_t *br) {
+    if (br->pos + 8 <= br->len) {
+        // 빠른 경로: 8바이트를 한 번에 빅엔디언으로 읽어 빈 자리만큼 붙임
+        const uint8_t *p = br->buf + br->pos;
+        uint64_t word = ((uint64_t)p[0] << 56) | ((uint64_t)p[1] << 48) |
+                        ((uint64_t)p[2] << 40) | ((uint64_t)p[3] << 32) |
+                        ((uint64_t)p[4] << 24) | ((uint64_t)p[5] << 16) |
+                        ((uint64_t)p[6] << 8)  |  (uint64_t)p[7];
+        br->window |= word >> br->nbits;
+        br->pos += (63 - br->nbits) >> 3;
+        br->nbits |= 56;
+        return;
+    }
+    while (br->nbits <= 56) {
+        uint64_t byte = br->pos < br->len ? br->buf[br->pos] : 0;
+        br->pos++;
+        br->window |= byte << (56 - br->nbits);
+        br->nbits += 8;
+    }
+}
+
+// width비트 읽기 (0~32, 폭 0이면 0을 돌려줌)
+static inline uint32_t get_bits(bit_reader_t *br, unsigned width) {
+    uint32_t v;
+    if (br->nbits < width) refill(br);
+    v = (uint32_t)((br->window >> 1) >> (63 - width));
+    br->window <<= width;
+    br->nbits -= width;
+    return v;
+}
+
+// 앞에서부터 이어지는 1비트 개수 (최대 max개, 0을 만나면 그 0도 소비)
+static inline unsigned get_prefix(bit_reader_t *br, unsigned max) {
+    unsigned n, used;
+    if (br->nbits < max) refill(br);
+    n = (unsigned)__builtin_clzll(~br->window | (1ULL << (63 - max)));
+    used = n < max ? n + 1 : max;
+    br->window <<= used;
+    br->nbits -= used;
+    return n;
+}
+
+// 접두사 길이 → 필드 폭 표 (0 = 변화 없음). 폭 0도 같은 식으로 읽어
+// 값 분포가 불규칙해도 분기 예측 실패가 없게 함
+static inline int64_t get_time(bit_reader_t *br) {
+    static const unsigned width[5] = { 0, 7, 9, 12, 32 };
+    return unzigzag(get_bits(br, width[get_prefix(br, 4)]));
+}
+
+static inline int32_t get_value(bit_reader_t *br) {
+    static const unsigned width[5] = { 0, 4, 8, 12, 17 };
+    return unzigzag(get_bits(br, width[get_prefix(br, 4)]));
+}
+
+void sample_decoder_init(sample_decoder_t *dec, const uint8_t *buf, size_t len, uint16_t count) {
+    memset(dec, 0, sizeof(*dec));
+    dec->buf = buf;
+    dec->len = len;
+    dec->remaining = count;
+}
+
+int sample_decoder_next(sample_decoder_t *dec, sensor_sample_t *out) {
+    if (dec->remaining == 0) return 0;
+
+    if (dec->pos == 0) {
+        if (dec->len < SAMPLE_CODEC_HEADER_BYTES) return -1;
+        memcpy(&dec->prev, dec->buf, SAMPLE_CODEC_HEADER_BYTES);
+        dec->prev_ms = sample_time_ms(&dec->prev);
+        dec->pos = SAMPLE_CODEC_HEADER_BYTES;
+    } else {
+        bit_reader_t br = { dec->buf, dec->len, dec->pos, dec->window, dec->nbits };
+        sensor_sample_t s = dec->prev;
+        int64_t delta = dec->prev_delta_ms + get_time(&br);
+        int64_t ms = dec->prev_ms + delta;
+
+        s.temp_centi = (int16_t)(s.temp_centi + get_value(&br));
+        s.humi_centi = (uint16_t)(s.humi_centi + get_value(&br));
+        if (get_bits(&br, 1)) {
+            s.flags = (uint16_t)get_bits(&br, 16);
+        }
+        if (br.pos > br.len + 8) return -1;  // 스트림 끝을 넘어 읽음
+
+        s.time = (uint32_t)(ms / 1000);
+        s.time_ms = (uint16_t)(ms % 1000);
+        dec->pos = br.pos;
+        dec->window = br.window;
+        dec->nbits = br.nbits;
+        dec->prev_delta_ms = delta;
+        dec->prev_ms = ms;
+        dec->prev = s;
+    }
+
+    dec->remaining--;
+    *out = dec->prev;
+    return 1;
+}
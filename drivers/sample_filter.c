@@ -0,0 +1,141 @@
+#include "sample_filter.h"
+#include <string.h>
+
+static const sample_filter_config_t default_filter = SAMPLE_FILTER_CONFIG_DEFAULT;
+
+#define STEP_OUTLIER   0x1
+#define STEP_SLEW      0x2
+
+static int window_size(const sample_filter_config_t *c) {
+    if (c->window < 1) return 1;
+    if (c->window > SAMPLE_FILTER_MAX_WINDOW) return SAMPLE_FILTER_MAX_WINDOW;
+    return c->window;
+}
+
+// 가장 오래된 값을 정렬 배열에서 빼고 새 값을 끼움 (창이 작아 선형 이동이 가장 빠름)
+static void window_push(sample_filter_channel_t *ch, int window, int32_t x) {
+    int i;
+
+    if (ch->count == window) {
+        int32_t old = ch->ring[ch->head];
+        for (i = 0; ch->sorted[i] != old; i++) {}
+        memmove(&ch->sorted[i], &ch->sorted[i + 1], (size_t)(ch->count - i - 1) * sizeof(int32_t));
+        ch->count--;
+    }
+
+    for (i = ch->count; i > 0 && ch->sorted[i - 1] > x; i--) {
+        ch->sorted[i] = ch->sorted[i - 1];
+    }
+    ch->sorted[i] = x;
+    ch->count++;
+
+    ch->ring[ch->head] = x;
+    ch->head = (ch->head + 1) % window;
+}
+
+int32_t sample_filter_median(const sample_filter_channel_t *ch) {
+    return ch->count ? ch->sorted[ch->count / 2] : 0;
+}
+
+static int32_t q8_round(int32_t q8) {
+    return q8 >= 0 ? (q8 + 128) / 256 : -((-q8 + 128) / 256);
+}
+
+static int channel_step(sample_filter_channel_t *ch, int window, int outlier, int tau_ms,
+                        int slew_per_min, int32_t x, int64_t dt_ms, int first) {
+    int32_t v = x, target, med;
+    int flags = 0;
+
+    window_push(ch, window, x);
+
+    // 1) 이상치: 창이 어느 정도 찼을 때만 (처음 한두 개는 비교 대상이 없음)
+    med = sample_filter_median(ch);
+    if (outlier > 0 && ch->count >= 3 && (x - med > outlier || med - x > outlier)) {
+        v = med;
+        flags |= STEP_OUTLIER;
+    }
+
+    if (first) {
+        ch->ema_q8 = v * 256;
+        ch->out = v;
+        return flags;
+    }
+
+    // 2) 지수 평활: α = dt / (tau + dt), Q16
+    if (tau_ms > 0) {
+        int64_t alpha_q16 = (dt_ms * 65536) / (tau_ms + dt_ms);
+        ch->ema_q8 += (int32_t)((((int64_t)v * 256 - ch->ema_q8) * alpha_q16) / 65536);
+    } else {
+        ch->ema_q8 = v * 256;
+    }
+    target = q8_round(ch->ema_q8);
+
+    // 3) 변화율 제한 (경과 시간만큼 허용)
+    if (slew_per_min > 0) {
+        int64_t max_step = (int64_t)slew_per_min * dt_ms / 60000;
+        if (target > ch->out + max_step) {
+            target = ch->out + (int32_t)max_step;
+            flags |= STEP_SLEW;
+        } else if (target < ch->out - max_step) {
+            target = ch->out - (int32_t)max_step;
+            flags |= STEP_SLEW;
+        }
+    }
+    ch->out = target;
+    return flags;
+}
+
+void sample_filter_init(sample_filter_t *f, const sample_filter_config_t *config) {
+    memset(f, 0, sizeof(*f));
+    f->config = config;
+}
+
+void sample_filter_seed(sample_filter_t *f, int32_t temp_centi, int32_t humi_centi, int64_t at_ms) {
+    f->temp.ema_q8 = temp_centi * 256;
+    f->temp.out = temp_centi;
+    f->humi.ema_q8 = humi_centi * 256;
+    f->humi.out = humi_centi;
+    f->last_ms = at_ms;
+    f->primed = 1;
+}
+
+sample_quality_t sample_filter_update(sample_filter_t *f, sensor_sample_t *sample, int64_t now_ms) {
+    const sample_filter_config_t *c = f->config ? f->config : &default_filter;
+    int window = window_size(c);
+    int64_t dt_ms = 0;
+    int first = !f->primed;
+    int ft, fh;
+
+    if (!(sample->flags & SAMPLE_FLAG_VALID)) {
+        f->stats.bad++;
+        if (f->primed) {
+            sample->temp_centi = sample_clamp_temp(f->temp.out);
+            sample->humi_centi = sample_clamp_humi(f->humi.out);
+            sample->flags |= SAMPLE_FLAG_FILTERED;
+        }
+        return SAMPLE_QUALITY_BAD;
+    }
+
+    if (!first && now_ms > f->last_ms) dt_ms = now_ms - f->last_ms;
+
+    ft = channel_step(&f->temp, window, c->outlier_temp_centi, c->tau_ms,
+                      c->slew_temp_centi_min, sample->temp_centi, dt_ms, first);
+    fh = channel_step(&f->humi, window, c->outlier_humi_centi, c->tau_ms,
+                      c->slew_humi_centi_min, sample->humi_centi, dt_ms, first);
+    f->primed = 1;
+    f->last_ms = now_ms;
+
+    f->stats.samples++;
+    f->stats.outliers += (uint32_t)(((ft & STEP_OUTLIER) != 0) + ((fh & STEP_OUTLIER) != 0));
+    f->stats.slew_limited += (uint32_t)(((ft & STEP_SLEW) != 0) + ((fh & STEP_SLEW) != 0));
+
+    sample->temp_centi = sample_clamp_temp(f->temp.out);
+    sample->humi_centi = sample_clamp_humi(f->humi.out);
+    sample->flags |= SAMPLE_FLAG_FILTERED;
+
+    if (ft | fh) {
+        sample->flags |= SAMPLE_FLAG_SUSPECT;
+        return SAMPLE_QUALITY_SUSPECT;
+    }
+    return SAMPLE_QUALITY_GOOD;
+}
@@ -0,0 +1,106 @@
+#include "sample_scheduler.h"
+#include <string.h>
+
+static const sample_sched_config_t default_sched = SAMPLE_SCHED_CONFIG_DEFAULT;
+static const env_config_t default_env = ENV_CONFIG_DEFAULT;
+
+static int iabs(int v) {
+    return v < 0 ? -v : v;
+}
+
+static int imin(int a, int b) {
+    return a < b ? a : b;
+}
+
+int sample_sched_boundary_distance(const env_band_t *band, int value) {
+    // 판정 경계 4개 + 좋아질 때 넘어야 하는 히스테리시스 복귀선 4개
+    const int edges[8] = {
+        band->good_min, band->good_max, band->warn_min, band->warn_max,
+        band->good_min + band->hysteresis, band->good_max - band->hysteresis,
+        band->warn_min + band->hysteresis, band->warn_max - band->hysteresis,
+    };
+    int best = iabs(value - edges[0]);
+
+    for (int i = 1; i < 8; i++) best = imin(best, iabs(value - edges[i]));
+    return best;
+}
+
+// 경계까지 거리를 가정한 최대 변화율로 가는 데 걸리는 시간 (ms)
+static int time_to_edge_ms(int distance, int slew_centi_min) {
+    int64_t ms;
+
+    if (slew_centi_min <= 0) return INT32_MAX;
+    ms = (int64_t)distance * 60000 / slew_centi_min;
+    return ms > INT32_MAX ? INT32_MAX : (int)ms;
+}
+
+void sample_sched_init(sample_sched_t *s, const sample_sched_config_t *config,
+                       const env_config_t *env, int64_t now_ms) {
+    memset(s, 0, sizeof(*s));
+    s->config = config;
+    s->env = env;
+    s->next_due_ms = now_ms;
+    s->stats.interval_ms = (uint32_t)(config ? config : &default_sched)->min_interval_ms;
+    s->stats.avg_interval_ms = s->stats.interval_ms;
+}
+
+int sample_sched_due(const sample_sched_t *s, int64_t now_ms) {
+    return now_ms >= s->next_due_ms;
+}
+
+int64_t sample_sched_wait_ms(const sample_sched_t *s, int64_t now_ms) {
+    return now_ms >= s->next_due_ms ? 0 : s->next_due_ms - now_ms;
+}
+
+void sample_sched_update(sample_sched_t *s, const env_status_t *status, int ok,
+                         int temp_centi, int humi_centi, int64_t now_ms) {
+    const sample_sched_config_t *c = s->config ? s->config : &default_sched;
+    const env_config_t *env = s->env ? s->env : &default_env;
+    int interval = (int)s->stats.interval_ms;
+    int cap = c->max_interval_ms;
+
+    // 실효 간격: 실제 시도 간격의 이동 평균
+    if (s->last_ms) {
+        int64_t gap = now_ms - s->last_ms;
+        s->stats.avg_interval_ms = (uint32_t)((int64_t)s->stats.avg_interval_ms +
+                                              (gap - (int64_t)s->stats.avg_interval_ms) / 8);
+    }
+    s->last_ms = now_ms;
+    s->stats.attempts++;
+
+    if (!ok) {
+        // 실패는 곧바로 다시 (물러나 있던 간격도 초기화)
+        s->stats.failures++;
+        s->stable_count = 0;
+        interval = c->min_interval_ms;
+    } else {
+        int changed = !s->have_ref ||
+                      iabs(temp_centi - s->ref_temp_centi) >= c->change_temp_centi ||
+                      iabs(humi_centi - s->ref_humi_centi) >= c->change_humi_centi;
+
+        cap = imin(cap, time_to_edge_ms(sample_sched_boundary_distance(&env->temp, temp_centi),
+                                        c->temp_slew_centi_min));
+        cap = imin(cap, time_to_edge_ms(sample_sched_boundary_distance(&env->humi, humi_centi),
+                                        c->humi_slew_centi_min));
+        if (status && status->warning_active && !status->prolonged_warning) {
+            cap = c->min_interval_ms;       // 승격 판정이 늦어지지 않게
+        }
+
+        if (changed) {
+            s->ref_temp_centi = temp_centi;
+            s->ref_humi_centi = humi_centi;
+            s->have_ref = 1;
+            s->stable_count = 0;
+            interval = c->min_interval_ms;
+        } else if (++s->stable_count >= c->backoff_after) {
+            s->stable_count = 0;
+            interval = interval > c->max_interval_ms / 2 ? c->max_interval_ms : interval * 2;
+        }
+        interval = imin(interval, cap);
+    }
+
+    if (interval < c->min_interval_ms) interval = c->min_interval_ms;
+    if (interval == c->min_interval_ms && ok) s->stats.fast_samples++;
+    s->stats.interval_ms = (uint32_t)interval;
+    s->next_due_ms = now_ms + interval;
+}
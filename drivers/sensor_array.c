@@ -0,0 +1,317 @@
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include "sensor_array.h"
+#include "gpio_driver.h"
+
+#define ZONE_TAG_TIMER  0xFFFFFFFFu     // epoll data: 타이머, 그 외는 구역 번호
+#define ZONE_CONSUMER   "dht11_zone"
+#define EVENT_BATCH     32
+
+static uint64_t mono_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static int64_t ns_to_ms(uint64_t ns) {
+    return (int64_t)(ns / 1000000ULL);
+}
+
+// 다른 구역 예약과 겹치지 않게 시작 신호 해제 시각 예약
+static void zone_reserve(sensor_array_t *arr, int idx, uint64_t want) {
+    uint64_t reserved[SENSOR_ARRAY_MAX];
+    uint64_t at;
+
+    for (int i = 0; i < arr->count; i++) {
+        reserved[i] = (i == idx) ? 0 : arr->zones[i].release_ns;
+    }
+    at = dht11_stagger(reserved, arr->count, want, (uint64_t)DHT11_CAPTURE_US * 1000ULL);
+    if (at != want) arr->stats.staggered++;
+
+    arr->zones[idx].release_ns = at;
+    arr->zones[idx].phase = ZONE_IDLE;
+}
+
+// 결과를 스케줄러에 반영하고 다음 시작 신호를 예약 (시작 신호는 예정 시각에 내림)
+static void zone_schedule(sensor_array_t *arr, int idx, int ok, int temp, int humi, uint64_t now) {
+    sensor_zone_t *z = &arr->zones[idx];
+
+    sample_sched_update(&z->sched, NULL, ok, temp, humi, ns_to_ms(now));
+    zone_reserve(arr, idx,
+                 (uint64_t)z->sched.next_due_ms * 1000000ULL + (uint64_t)DHT11_START_LOW_US * 1000ULL);
+}
+
+// 구역이 다음으로 깨어나야 할 시각
+static uint64_t zone_deadline(const sensor_zone_t *z) {
+    switch (z->phase) {
+    case ZONE_IDLE:    return z->release_ns - (uint64_t)DHT11_START_LOW_US * 1000ULL;
+    case ZONE_START:   return z->release_ns;
+    case ZONE_CAPTURE: return z->release_ns + (uint64_t)DHT11_CAPTURE_US * 1000ULL;
+    }
+    return 0;
+}
+
+static int arm_timer(sensor_array_t *arr) {
+    struct itimerspec its;
+    uint64_t next = 0;
+
+    for (int i = 0; i < arr->count; i++) {
+        uint64_t d = zone_deadline(&arr->zones[i]);
+        if (next == 0 || d < next) next = d;
+    }
+    if (next == arr->timer_ns) return 0;
+
+    // 이미 지난 시각이면 다음 poll에서 바로 만료 (0은 타이머 해제라 1ns로)
+    memset(&its, 0, sizeof(its));
+    its.it_value.tv_sec = (time_t)(next / 1000000000ULL);
+    its.it_value.tv_nsec = (long)(next % 1000000000ULL);
+    if (next == 0) its.it_value.tv_nsec = 1;
+
+    if (timerfd_settime(arr->timer_fd, TFD_TIMER_ABSTIME, &its, NULL) < 0) {
+        perror("센서 배열: 타이머 설정 실패");
+        return -1;
+    }
+    arr->timer_ns = next;
+    return 0;
+}
+
+// 시작 신호: 라인을 출력 LOW로 요청
+static int zone_start(sensor_zone_t *z) {
+    if (gpiod_line_request_output(z->line, ZONE_CONSUMER, 0) < 0) {
+        perror("센서 배열: 시작 신호 출력 요청 실패");
+        return -1;
+    }
+    z->phase = ZONE_START;
+    return 0;
+}
+
+// 시작 신호 해제: 출력을 놓고 같은 라인을 양쪽 에지 이벤트로 다시 요청
+static int zone_capture(sensor_array_t *arr, int idx) {
+    sensor_zone_t *z = &arr->zones[idx];
+    struct epoll_event ev;
+
+    gpiod_line_release(z->line);
+    if (gpiod_line_request_both_edges_events_flags(z->line, ZONE_CONSUMER,
+            GPIOD_LINE_REQUEST_FLAG_BIAS_PULL_UP) < 0) {
+        perror("센서 배열: 에지 이벤트 요청 실패");
+        return -1;
+    }
+
+    z->event_fd = gpiod_line_event_get_fd(z->line);
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.u32 = (uint32_t)idx;
+    if (z->event_fd < 0 || epoll_ctl(arr->epoll_fd, EPOLL_CTL_ADD, z->event_fd, &ev) < 0) {
+        perror("센서 배열: 에지 fd 등록 실패");
+        gpiod_line_release(z->line);
+        z->event_fd = -1;
+        return -1;
+    }
+
+    z->n_edges = 0;
+    z->phase = ZONE_CAPTURE;
+    return 0;
+}
+
+static void zone_stop_capture(sensor_array_t *arr, sensor_zone_t *z) {
+    if (z->event_fd >= 0) {
+        epoll_ctl(arr->epoll_fd, EPOLL_CTL_DEL, z->event_fd, NULL);
+        z->event_fd = -1;
+    }
+    if (z->phase != ZONE_IDLE) gpiod_line_release(z->line);
+}
+
+// 캡처 끝: 해독 → 검증 → 필터 → 다음 예약 (실패해도 재시도는 스케줄러 간격으로)
+static void zone_finish(sensor_array_t *arr, int idx, uint64_t now, sensor_reading_t *out) {
+    sensor_zone_t *z = &arr->zones[idx];
+    uint8_t data[5];
+    int temp = 0, humi = 0, ok = 0;
+
+    zone_stop_capture(arr, z);
+    arr->stats.captures++;
+
+    memset(out, 0, sizeof(*out));
+    out->zone = idx;
+
+    if (dht11_decode_edges(z->edges, z->n_edges, data) != 0) {
+        z->state.stats.timeout_errors++;
+    } else if (dht11_frame_check(&z->state, data, &temp, &humi) == 0) {
+        ok = 1;
+    }
+
+    if (ok) {
+        dht11_state_accept(&z->state, temp, humi);
+        out->sample.temp_centi = sample_clamp_temp(temp);
+        out->sample.humi_centi = sample_clamp_humi(humi);
+        out->sample.flags = SAMPLE_FLAG_VALID;
+    } else if (dht11_state_reject(&z->state, &temp, &humi)) {
+        out->sample.temp_centi = sample_clamp_temp(temp);
+        out->sample.humi_centi = sample_clamp_humi(humi);
+        out->sample.flags = SAMPLE_FLAG_STALE;
+    }
+
+    zone_schedule(arr, idx, ok, temp, humi, now);
+}
+
+static int zone_read_edges(sensor_array_t *arr, int idx) {
+    sensor_zone_t *z = &arr->zones[idx];
+    struct gpiod_line_event events[EVENT_BATCH];
+    int n;
+
+    n = gpiod_line_event_read_fd_multiple(z->event_fd, events, EVENT_BATCH);
+    if (n < 0) {
+        perror("센서 배열: 에지 읽기 실패");
+        return -1;
+    }
+
+    for (int i = 0; i < n && z->n_edges < DHT11_MAX_EDGES; i++) {
+        dht11_edge_t *e = &z->edges[z->n_edges++];
+        e->ns = (uint64_t)events[i].ts.tv_sec * 1000000000ULL + (uint64_t)events[i].ts.tv_nsec;
+        e->rising = (events[i].event_type == GPIOD_LINE_EVENT_RISING_EDGE);
+    }
+    arr->stats.edges += (uint64_t)n;
+    return n;
+}
+
+int sensor_array_open(sensor_array_t *arr, const sensor_zone_config_t *zones, int count) {
+    struct epoll_event ev;
+    uint64_t now;
+
+    memset(arr, 0, sizeof(*arr));
+    arr->epoll_fd = -1;
+    arr->timer_fd = -1;
+
+    if (count <= 0 || count > SENSOR_ARRAY_MAX) {
+        fprintf(stderr, "❌ 센서 배열: 센서 수 오류 (%d, 최대 %d)\n", count, SENSOR_ARRAY_MAX);
+        return -1;
+    }
+    if (!gpio_chip) {
+        fprintf(stderr, "❌ 센서 배열: GPIO 칩이 초기화되지 않음\n");
+        return -1;
+    }
+
+    arr->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    arr->timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (arr->epoll_fd < 0 || arr->timer_fd < 0) {
+        perror("센서 배열: epoll/timerfd 생성 실패");
+        sensor_array_close(arr);
+        return -1;
+    }
+
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.u32 = ZONE_TAG_TIMER;
+    if (epoll_ctl(arr->epoll_fd, EPOLL_CTL_ADD, arr->timer_fd, &ev) < 0) {
+        perror("센서 배열: 타이머 등록 실패");
+        sensor_array_close(arr);
+        return -1;
+    }
+
+    now = mono_ns();
+    for (int i = 0; i < count; i++) {
+        sensor_zone_t *z = &arr->zones[i];
+
+        z->pin = zones[i].pin;
+        z->event_fd = -1;
+        snprintf(z->name, sizeof(z->name), "%s", zones[i].name ? zones[i].name : "zone");
+        z->line = gpiod_chip_get_line(gpio_chip, (unsigned int)z->pin);
+        if (!z->line) {
+            fprintf(stderr, "❌ 센서 배열: %s GPIO%d 라인 가져오기 실패\n", z->name, z->pin);
+            sensor_array_close(arr);
+            return -1;
+        }
+        dht11_state_init(&z->state);
+        sample_sched_init(&z->sched, NULL, NULL, ns_to_ms(now));
+        arr->count = i + 1;
+
+        // 첫 측정: 모두 바로 시작하되 캡처 구간은 차례로
+        zone_reserve(arr, i, now + (uint64_t)DHT11_START_LOW_US * 1000ULL);
+    }
+
+    return arm_timer(arr);
+}
+
+void sensor_array_close(sensor_array_t *arr) {
+    for (int i = 0; i < arr->count; i++) {
+        zone_stop_capture(arr, &arr->zones[i]);
+        arr->zones[i].phase = ZONE_IDLE;
+    }
+    arr->count = 0;
+
+    if (arr->timer_fd >= 0) close(arr->timer_fd);
+    if (arr->epoll_fd >= 0) close(arr->epoll_fd);
+    arr->timer_fd = -1;
+    arr->epoll_fd = -1;
+}
+
+int sensor_array_fd(const sensor_array_t *arr) {
+    return arr->epoll_fd;
+}
+
+int sensor_array_poll(sensor_array_t *arr, int timeout_ms, sensor_reading_t *out, int max_out) {
+    struct epoll_event events[SENSOR_ARRAY_MAX + 1];
+    int produced = 0;
+    uint64_t now;
+    int n;
+
+    n = epoll_wait(arr->epoll_fd, events, SENSOR_ARRAY_MAX + 1, timeout_ms);
+    if (n < 0) {
+        if (errno == EINTR) return 0;
+        perror("센서 배열: epoll_wait 실패");
+        return -1;
+    }
+    if (n == 0) return 0;
+    arr->stats.wakeups++;
+
+    for (int i = 0; i < n; i++) {
+        uint32_t tag = events[i].data.u32;
+
+        if (tag == ZONE_TAG_TIMER) {
+            uint64_t expirations;
+            if (read(arr->timer_fd, &expirations, sizeof(expirations)) < 0 && errno != EAGAIN) {
+                perror("센서 배열: 타이머 읽기 실패");
+            }
+            arr->timer_ns = 0;
+            continue;
+        }
+
+        if (tag < (uint32_t)arr->count && arr->zones[tag].phase == ZONE_CAPTURE) {
+            zone_read_edges(arr, (int)tag);
+        }
+    }
+
+    // 시각이 된 단계 진행 + 프레임이 다 들어온 캡처 마무리
+    now = mono_ns();
+    for (int i = 0; i < arr->count; i++) {
+        sensor_zone_t *z = &arr->zones[i];
+        int due = (zone_deadline(z) <= now);
+
+        switch (z->phase) {
+        case ZONE_IDLE:
+            if (due && zone_start(z) != 0) {
+                z->state.stats.reads_failed++;
+                zone_schedule(arr, i, 0, 0, 0, now);
+            }
+            break;
+        case ZONE_START:
+            if (due && zone_capture(arr, i) != 0) {
+                z->state.stats.reads_failed++;
+                zone_schedule(arr, i, 0, 0, 0, now);
+            }
+            break;
+        case ZONE_CAPTURE:
+            if ((due || dht11_count_highs(z->edges, z->n_edges) >= 41) && produced < max_out) {
+                zone_finish(arr, i, now, &out[produced++]);
+            }
+            break;
+        }
+    }
+
+    if (arm_timer(arr) != 0) return -1;
+    return produced;
+}
@@ -2,37 +2,113 @@
 #include "dht11_sensor.h"
 #include "ds1307_rtc.h"
 #include "smart_env_monitor.h"  // GPIO_DHT11_DATA 정의
+#include "sample_filter.h"
 #include <time.h>
 
+// RTC 기준 시각: RTC(로컬 시간)를 epoch로 한 번 변환해 두고
+// 이후 샘플은 단조 시계 경과분만 더함 (샘플마다 I2C/달력 변환 없음)
+static time_t base_epoch = 0;
+static struct timespec base_mono;
+static uint16_t time_source = 0;
+static sample_filter_t filter;          // 단일 센서 이상치 제거 + 평활
+
+static int sync_time_base(void) {
+    struct tm rtc_time;
+    time_t epoch;
+
+    clock_gettime(CLOCK_MONOTONIC, &base_mono);
+
+    if (ds1307_read_time(&rtc_time) == 0) {
+        rtc_time.tm_isdst = -1;
+        epoch = mktime(&rtc_time);  // 시간대 변환은 재동기 때만
+        if (epoch != (time_t)-1) {
+            base_epoch = epoch;
+            time_source = SAMPLE_FLAG_TIME_RTC;
+            return 0;
+        }
+    }
+
+    // RTC 오류 시 현재 시스템 시간으로 대체
+    base_epoch = time(NULL);
+    time_source = SAMPLE_FLAG_TIME_SYS;
+    return -1;
+}
+
+static void current_time(struct timespec *realtime) {
+    struct timespec now;
+    long nsec;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    if (now.tv_sec - base_mono.tv_sec >= SENSOR_COLLECTOR_RTC_RESYNC_S) {
+        sync_time_base();
+        now = base_mono;
+    }
+
+    nsec = now.tv_nsec - base_mono.tv_nsec;
+    realtime->tv_sec = base_epoch + (now.tv_sec - base_mono.tv_sec);
+    if (nsec < 0) {
+        realtime->tv_sec--;
+        nsec += 1000000000L;
+    }
+    realtime->tv_nsec = nsec;
+}
+
 void sensor_collector_init(void) {
     gpio_init();
     dht11_init(GPIO_DHT11_DATA);
     ds1307_init();
+    sync_time_base();
+    sample_filter_init(&filter, NULL);
 }
 
-int collect_sensor_data(sensor_data_t *result) {
+int collect_sensor_data(sensor_sample_t *result) {
     dht11_data_t dht;
-    struct tm rtc_time;
+    struct timespec realtime, mono;
+    int temp, humi, errors;
 
     // DHT11 데이터 수집
     if (dht11_is_ready_to_read() && dht11_read_data(&dht) == 0 && dht.checksum_valid) {
-        result->temperature = dht.temperature;
-        result->humidity = dht.humidity;
-        result->data_valid = 1;
+        result->temp_centi = sample_clamp_temp(dht.temp_centi);
+        result->humi_centi = sample_clamp_humi(dht.humi_centi);
+        result->flags = SAMPLE_FLAG_VALID;
     } else {
-        result->temperature = 0.0f;
-        result->humidity = 0.0f;
-        result->data_valid = 0;
+        // 마지막 정상값으로 채우고 표시만 남김
+        dht11_get_last_valid(&temp, &humi, &errors);
+        result->temp_centi = sample_clamp_temp(temp);
+        result->humi_centi = sample_clamp_humi(humi);
+        result->flags = SAMPLE_FLAG_STALE;
     }
 
-    // RTC 시간 수집
-    if (ds1307_read_time(&rtc_time) == 0) {
-        result->timestamp = rtc_time;
-    } else {
-        // RTC 오류 시 현재 시스템 시간으로 대체
-        time_t now = time(NULL);
-        result->timestamp = *localtime(&now);
-    }
+    // 튐 제거/평활 (정상값이 아니면 마지막 필터 출력 유지)
+    clock_gettime(CLOCK_MONOTONIC, &mono);
+    sample_filter_update(&filter, result, (int64_t)mono.tv_sec * 1000 + mono.tv_nsec / 1000000);
+
+    // 시각 (RTC 기준 + 단조 시계 경과분)
+    current_time(&realtime);
+    sample_set_time(result, &realtime);
+    result->flags |= time_source;
+
+    return (result->flags & SAMPLE_FLAG_VALID) ? 1 : 0;
+}
 
-    return result->data_valid;
+int sensor_collector_open_zones(sensor_array_t *arr, const sensor_zone_config_t *zones, int count) {
+    gpio_init();
+    ds1307_init();
+    sync_time_base();
+    return sensor_array_open(arr, zones, count);
+}
+
+int collect_zone_samples(sensor_array_t *arr, int timeout_ms, sensor_reading_t *out, int max_out) {
+    struct timespec realtime;
+    int n = sensor_array_poll(arr, timeout_ms, out, max_out);
+
+    if (n <= 0) return n;
+
+    // 같은 poll에서 끝난 측정은 캡처 구간이 8ms 차이라 시각 하나로 충분
+    current_time(&realtime);
+    for (int i = 0; i < n; i++) {
+        sample_set_time(&out[i].sample, &realtime);
+        out[i].sample.flags |= time_source;
+    }
+    return n;
 }
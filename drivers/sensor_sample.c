@@ -0,0 +1,27 @@
+#include "sensor_sample.h"
+
+int16_t sample_clamp_temp(int temp_centi) {
+    if (temp_centi > INT16_MAX) return INT16_MAX;
+    if (temp_centi < INT16_MIN) return INT16_MIN;
+    return (int16_t)temp_centi;
+}
+
+uint16_t sample_clamp_humi(int humi_centi) {
+    if (humi_centi < 0) return 0;
+    if (humi_centi > UINT16_MAX) return UINT16_MAX;
+    return (uint16_t)humi_centi;
+}
+
+void sample_set_time(sensor_sample_t *sample, const struct timespec *realtime) {
+    sample->time = (uint32_t)realtime->tv_sec;
+    sample->time_ms = (uint16_t)(realtime->tv_nsec / 1000000);
+}
+
+int64_t sample_time_ms(const sensor_sample_t *sample) {
+    return (int64_t)sample->time * 1000 + sample->time_ms;
+}
+
+void sample_to_localtime(const sensor_sample_t *sample, struct tm *tm) {
+    time_t t = (time_t)sample->time;
+    localtime_r(&t, tm);
+}
@@ -0,0 +1,109 @@
+#include <stdio.h>
+#include <stddef.h>
+#include <string.h>
+#include <time.h>
+#include "state_store.h"
+#include "ds1307_rtc.h"
+
+// RAM 56바이트를 두 슬롯으로 나눠 번갈아 씁니다. 쓰는 도중 전원이 끊겨도
+// 다른 슬롯의 이전 기록은 CRC가 맞으므로 그대로 복원됩니다.
+typedef struct __attribute__((packed)) {
+    uint8_t magic;
+    uint8_t version;
+    uint16_t seq;
+    env_state_t state;
+    uint8_t crc;
+} state_slot_t;
+
+#define STATE_SLOT_COUNT 2
+#define STATE_SLOT_SIZE  (DS1307_RAM_SIZE / STATE_SLOT_COUNT)
+
+_Static_assert(sizeof(state_slot_t) <= STATE_SLOT_SIZE, "state slot too large");
+
+static env_state_t pending;
+static int dirty = 0;
+static uint16_t last_seq = 0;
+static int next_slot = 0;
+static struct timespec last_flush = {0};
+
+// CRC-8 (다항식 0x31, Dallas/Maxim)
+static uint8_t state_crc8(const uint8_t *data, size_t len) {
+    uint8_t crc = 0xFF;
+    for (size_t i = 0; i < len; i++) {
+        crc ^= data[i];
+        for (int b = 0; b < 8; b++) {
+            crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x31) : (uint8_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+static int slot_valid(const state_slot_t *slot) {
+    return slot->magic == STATE_STORE_MAGIC &&
+           slot->version == STATE_STORE_VERSION &&
+           slot->crc == state_crc8((const uint8_t *)slot, offsetof(state_slot_t, crc));
+}
+
+int state_store_load(env_state_t *state) {
+    state_slot_t slots[STATE_SLOT_COUNT];
+    int best = -1;
+
+    for (int i = 0; i < STATE_SLOT_COUNT; i++) {
+        if (ds1307_read_ram(i * STATE_SLOT_SIZE, (unsigned char *)&slots[i],
+                            sizeof(state_slot_t)) != 0) {
+            return -1;
+        }
+        if (!slot_valid(&slots[i])) continue;
+
+        // 시퀀스 번호 비교는 wrap-around 고려
+        if (best < 0 || (int16_t)(slots[i].seq - slots[best].seq) > 0) {
+            best = i;
+        }
+    }
+
+    if (best < 0) return -1;
+
+    *state = slots[best].state;
+    pending = slots[best].state;
+    last_seq = slots[best].seq;
+    next_slot = (best + 1) % STATE_SLOT_COUNT;
+    dirty = 0;
+    clock_gettime(CLOCK_MONOTONIC, &last_flush);
+    return 0;
+}
+
+void state_store_update(const env_state_t *state) {
+    if (memcmp(&pending, state, sizeof(pending)) == 0) return;
+    pending = *state;
+    dirty = 1;
+}
+
+int state_store_flush(int force) {
+    struct timespec now;
+    state_slot_t slot;
+
+    if (!dirty) return 0;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    if (!force && now.tv_sec - last_flush.tv_sec < STATE_STORE_MIN_INTERVAL) {
+        return 0;
+    }
+
+    memset(&slot, 0, sizeof(slot));
+    slot.magic = STATE_STORE_MAGIC;
+    slot.version = STATE_STORE_VERSION;
+    slot.seq = last_seq + 1;
+    slot.state = pending;
+    slot.crc = state_crc8((const uint8_t *)&slot, offsetof(state_slot_t, crc));
+
+    if (ds1307_write_ram(next_slot * STATE_SLOT_SIZE, (const unsigned char *)&slot,
+                         sizeof(slot)) != 0) {
+        return -1;
+    }
+
+    last_seq = slot.seq;
+    next_slot = (next_slot + 1) % STATE_SLOT_COUNT;
+    last_flush = now;
+    dirty = 0;
+    return 1;
+}
@@ -0,0 +1,95 @@
+// 여러 모니터의 샘플을 모으는 집계 서버 (개발 PC/홈 서버에서 실행)
+//
+// 사용법: fleet_aggregatord [-b 수신주소] [-p 포트] [-c 최대연결]
+// 모니터는 SMART_ENV_AGGREGATOR=호스트:포트 환경 변수로 접속합니다.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include "fleet_aggregator.h"
+
+#define STATS_INTERVAL_S    10
+
+static volatile sig_atomic_t running = 1;
+
+static void signal_handler(int sig) {
+    (void)sig;
+    running = 0;
+}
+
+// 노드 수천 개면 기본 fd 한도(1024)로는 모자람
+static void raise_fd_limit(uint32_t want) {
+    struct rlimit rl;
+
+    if (getrlimit(RLIMIT_NOFILE, &rl) != 0) return;
+    if (rl.rlim_cur >= want + 16) return;
+    rl.rlim_cur = want + 16 < rl.rlim_max ? want + 16 : rl.rlim_max;
+    if (setrlimit(RLIMIT_NOFILE, &rl) != 0 || rl.rlim_cur < want) {
+        fprintf(stderr, "⚠️ fd 한도 %lu - 연결이 그보다 적게 받아질 수 있음\n",
+                (unsigned long)rl.rlim_cur);
+    }
+}
+
+static void print_stats(const fleet_aggregator_t *agg, double elapsed, uint64_t prev_samples) {
+    fleet_stats_t st;
+
+    fleet_aggregator_stats(agg, &st);
+    printf("📊 노드 %u (연결 %u), 샘플 %llu (+%.0f/s), 버림 %llu, 저장 %.1f MB (노드당 %.0f B)\n",
+           st.nodes, st.nodes_connected, (unsigned long long)st.samples,
+           (st.samples - prev_samples) / elapsed, (unsigned long long)st.samples_dropped,
+           st.store_bytes / 1e6, st.nodes ? (double)st.store_bytes / st.nodes : 0.0);
+    fflush(stdout);
+}
+
+int main(int argc, char **argv) {
+    static fleet_aggregator_t agg;
+    const char *bind_addr = NULL;
+    uint16_t port = NODE_DEFAULT_PORT;
+    uint32_t max_conns = FLEET_DEFAULT_MAX_CONNS;
+    struct timespec last, now;
+    uint64_t prev_samples = 0;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "b:p:c:")) != -1) {
+        switch (opt) {
+        case 'b': bind_addr = optarg; break;
+        case 'p': port = (uint16_t)atoi(optarg); break;
+        case 'c': max_conns = (uint32_t)atoi(optarg); break;
+        default:
+            fprintf(stderr, "사용법: %s [-b 수신주소] [-p 포트] [-c 최대연결]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    signal(SIGINT, signal_handler);
+    signal(SIGTERM, signal_handler);
+    raise_fd_limit(max_conns);
+
+    if (fleet_aggregator_open(&agg, bind_addr, port, max_conns) != 0) return 1;
+    printf("✅ 집계 서버 시작: %s:%u (최대 연결 %u)\n",
+           bind_addr ? bind_addr : "0.0.0.0", port, max_conns);
+
+    clock_gettime(CLOCK_MONOTONIC, &last);
+    while (running) {
+        if (fleet_aggregator_poll(&agg, 1000) < 0) {
+            perror("❌ epoll_wait 실패");
+            break;
+        }
+
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        double elapsed = (now.tv_sec - last.tv_sec) + (now.tv_nsec - last.tv_nsec) / 1e9;
+        if (elapsed >= STATS_INTERVAL_S) {
+            print_stats(&agg, elapsed, prev_samples);
+            prev_samples = agg.stats.samples;
+            last = now;
+        }
+    }
+
+    fleet_aggregator_close(&agg);
+    printf("👋 집계 서버 종료\n");
+    return 0;
+}
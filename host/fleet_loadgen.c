@@ -0,0 +1,314 @@
+// 집계 서버 부하 생성기: 루프백으로 노드 수천 개를 흉내 내 수집 처리량과
+// 노드당 메모리를 잽니다.
+//
+// 사용법: fleet_loadgen [-h 호스트] [-p 포트] [-n 노드수] [-d 초] [-r 노드당 샘플/초] [-b 묶음]
+//   -r 0 = 최대 속도 (서버가 받는 만큼 계속 보냄)
+// 각 노드는 3초 간격 샘플(실제 모니터와 같은 시간 간격, 온습도 무작위 보행)을
+// 시각 순으로 보냅니다. 끝나면 STATS/SUMMARY 질의로 서버 쪽 수치를 확인합니다.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <time.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include "node_protocol.h"
+
+#define SAMPLE_INTERVAL_S   3
+#define FIRST_NODE_ID       100000
+#define BASE_TIME           1700000000u     // 흉내 낸 첫 샘플 시각
+
+typedef struct {
+    int fd;
+    uint32_t time;              // 다음 샘플 시각 (흉내 낸 epoch 초)
+    int temp;
+    int humi;
+    double due;                 // 다음 묶음을 보낼 시각 (실제 단조 시계 초)
+    uint32_t out_off;
+    uint32_t out_len;
+    uint8_t out[sizeof(node_frame_t) + NODE_MAX_BATCH * sizeof(sensor_sample_t)];
+} sim_node_t;
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void raise_fd_limit(uint32_t want) {
+    struct rlimit rl;
+
+    if (getrlimit(RLIMIT_NOFILE, &rl) != 0 || rl.rlim_cur >= want + 16) return;
+    rl.rlim_cur = want + 16 < rl.rlim_max ? want + 16 : rl.rlim_max;
+    setrlimit(RLIMIT_NOFILE, &rl);
+}
+
+static int connect_to(const struct sockaddr_in *addr) {
+    int fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+
+    if (fd < 0) return -1;
+    if (connect(fd, (const struct sockaddr *)addr, sizeof(*addr)) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static int write_all(int fd, const void *buf, size_t len) {
+    const uint8_t *p = buf;
+
+    while (len > 0) {
+        ssize_t n = send(fd, p, len, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        p += n;
+        len -= (size_t)n;
+    }
+    return 0;
+}
+
+static int read_all(int fd, void *buf, size_t len) {
+    uint8_t *p = buf;
+
+    while (len > 0) {
+        ssize_t n = recv(fd, p, len, 0);
+        if (n <= 0) {
+            if (n < 0 && errno == EINTR) continue;
+            return -1;
+        }
+        p += n;
+        len -= (size_t)n;
+    }
+    return 0;
+}
+
+// 질의 하나 보내고 응답 페이로드 받기 (반환: 페이로드 바이트, -1 실패)
+static int query(int fd, uint8_t type, const void *req, uint32_t req_len, void *out, uint32_t max) {
+    node_frame_t hdr = { NODE_PROTOCOL_MAGIC, type, NODE_OK, req_len };
+    uint8_t msg[sizeof(hdr) + 64];
+
+    // 헤더와 요청을 한 번에 (나눠 쓰면 Nagle + 지연 ACK로 40ms씩 밀림)
+    if (req_len > sizeof(msg) - sizeof(hdr)) return -1;
+    memcpy(msg, &hdr, sizeof(hdr));
+    memcpy(msg + sizeof(hdr), req, req_len);
+    if (write_all(fd, msg, sizeof(hdr) + req_len) != 0) return -1;
+    if (read_all(fd, &hdr, sizeof(hdr)) != 0 || hdr.status != NODE_OK || hdr.len > max) return -1;
+    if (read_all(fd, out, hdr.len) != 0) return -1;
+    return (int)hdr.len;
+}
+
+static void fill_batch(sim_node_t *node, uint32_t batch) {
+    node_frame_t hdr = { NODE_PROTOCOL_MAGIC, NODE_MSG_SAMPLES, NODE_OK,
+                         batch * (uint32_t)sizeof(sensor_sample_t) };
+
+    memcpy(node->out, &hdr, sizeof(hdr));
+    for (uint32_t i = 0; i < batch; i++) {
+        sensor_sample_t s;
+
+        // 천천히 움직이는 온습도 (대부분 그대로, 가끔 0.1 단위로)
+        int r = rand();
+        if ((r & 7) == 0) node->temp += (r & 8) ? 10 : -10;
+        if ((r & 0x70) == 0) node->humi += (r & 0x80) ? 100 : -100;
+        if (node->humi < 2000 || node->humi > 8000) node->humi = 5000;
+        s.time = node->time;
+        s.temp_centi = (int16_t)node->temp;
+        s.humi_centi = (uint16_t)node->humi;
+        s.time_ms = 0;
+        s.flags = SAMPLE_FLAG_VALID | SAMPLE_FLAG_TIME_RTC;
+        memcpy(node->out + sizeof(hdr) + i * sizeof(s), &s, sizeof(s));
+        node->time += SAMPLE_INTERVAL_S;
+    }
+    node->out_off = 0;
+    node->out_len = sizeof(hdr) + hdr.len;
+}
+
+// 반환: 1 다 보냄, 0 소켓 버퍼 참, -1 오류
+static int flush_node(sim_node_t *node) {
+    while (node->out_off < node->out_len) {
+        ssize_t n = send(node->fd, node->out + node->out_off, node->out_len - node->out_off,
+                         MSG_NOSIGNAL | MSG_DONTWAIT);
+        if (n < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) return 0;
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        node->out_off += (uint32_t)n;
+    }
+    return 1;
+}
+
+int main(int argc, char **argv) {
+    const char *host = "127.0.0.1";
+    uint16_t port = NODE_DEFAULT_PORT;
+    uint32_t nodes = 1000, batch = 1;
+    double duration = 10, rate = 1;
+    struct sockaddr_in addr;
+    sim_node_t *sim;
+    fleet_stats_t before, after;
+    fleet_summary_t sum;
+    uint64_t sent = 0, stalls = 0;
+    double t0, t_end, t_caught;
+    int opt, qfd;
+
+    while ((opt = getopt(argc, argv, "h:p:n:d:r:b:")) != -1) {
+        switch (opt) {
+        case 'h': host = optarg; break;
+        case 'p': port = (uint16_t)atoi(optarg); break;
+        case 'n': nodes = (uint32_t)atoi(optarg); break;
+        case 'd': duration = atof(optarg); break;
+        case 'r': rate = atof(optarg); break;
+        case 'b': batch = (uint32_t)atoi(optarg); break;
+        default:
+            fprintf(stderr, "사용법: %s [-h 호스트] [-p 포트] [-n 노드수] [-d 초] "
+                    "[-r 노드당 샘플/초, 0=최대] [-b 묶음]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (batch < 1) batch = 1;
+    if (batch > NODE_MAX_BATCH) batch = NODE_MAX_BATCH;
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    if (inet_pton(AF_INET, host, &addr.sin_addr) != 1) {
+        fprintf(stderr, "❌ 잘못된 주소: %s\n", host);
+        return 1;
+    }
+    raise_fd_limit(nodes + 1);
+
+    qfd = connect_to(&addr);
+    if (qfd < 0 || query(qfd, FLEET_MSG_STATS, NULL, 0, &before, sizeof(before)) != sizeof(before)) {
+        perror("❌ 집계 서버 STATS 질의 실패");
+        return 1;
+    }
+
+    sim = calloc(nodes, sizeof(*sim));
+    if (!sim) {
+        fprintf(stderr, "❌ 메모리 부족\n");
+        return 1;
+    }
+
+    printf("🔌 노드 %u개 접속 중 (%s:%u)...\n", nodes, host, port);
+    for (uint32_t i = 0; i < nodes; i++) {
+        node_hello_t hello;
+        node_frame_t hdr = { NODE_PROTOCOL_MAGIC, NODE_MSG_HELLO, NODE_OK, sizeof(hello) };
+        int one = 1;
+
+        sim[i].fd = connect_to(&addr);
+        if (sim[i].fd < 0) {
+            fprintf(stderr, "❌ 노드 %u 접속 실패: %s\n", i, strerror(errno));
+            return 1;
+        }
+        memset(&hello, 0, sizeof(hello));
+        hello.node_id = FIRST_NODE_ID + i;
+        snprintf(hello.room, sizeof(hello.room), "ROOM %u", i);
+        if (write_all(sim[i].fd, &hdr, sizeof(hdr)) != 0 ||
+            write_all(sim[i].fd, &hello, sizeof(hello)) != 0) {
+            fprintf(stderr, "❌ 노드 %u HELLO 실패\n", i);
+            return 1;
+        }
+        setsockopt(sim[i].fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        fcntl(sim[i].fd, F_SETFL, O_NONBLOCK);
+        sim[i].time = BASE_TIME;
+        sim[i].temp = 2000 + (int)(i % 800);
+        sim[i].humi = 4000 + (int)(i % 2000);
+    }
+
+    printf("🚀 %.0f초 동안 전송 (노드당 %s, 묶음 %u)\n", duration,
+           rate > 0 ? "속도 제한" : "최대 속도", batch);
+    t0 = now_sec();
+    for (uint32_t i = 0; i < nodes; i++) {
+        // 노드마다 시작 시각을 흩어 한꺼번에 몰리지 않게
+        sim[i].due = rate > 0 ? t0 + (batch / rate) * i / nodes : t0;
+    }
+
+    while ((t_end = now_sec()) - t0 < duration) {
+        int busy = 0;
+
+        for (uint32_t i = 0; i < nodes; i++) {
+            sim_node_t *node = &sim[i];
+            int r;
+
+            if (node->out_off < node->out_len) {
+                r = flush_node(node);
+                if (r < 0) goto peer_error;
+                if (r == 0) {
+                    stalls++;
+                    continue;
+                }
+            }
+            if (rate > 0 && t_end < node->due) continue;
+
+            fill_batch(node, batch);
+            sent += batch;
+            if (rate > 0) node->due += batch / rate;
+            busy = 1;
+            if (flush_node(node) < 0) goto peer_error;
+        }
+        if (!busy) {
+            struct timespec ms = { 0, 1000000 };
+            nanosleep(&ms, NULL);
+        }
+    }
+
+    // 보내다 남은 프레임 마저 보내기
+    for (uint32_t i = 0; i < nodes; i++) {
+        while (sim[i].out_off < sim[i].out_len) {
+            struct pollfd pfd = { sim[i].fd, POLLOUT, 0 };
+            poll(&pfd, 1, 100);
+            if (flush_node(&sim[i]) < 0) goto peer_error;
+        }
+    }
+    t_end = now_sec();
+
+    // 서버가 다 받을 때까지 STATS로 확인 (최대 30초)
+    do {
+        if (query(qfd, FLEET_MSG_STATS, NULL, 0, &after, sizeof(after)) != sizeof(after)) {
+            perror("❌ STATS 질의 실패");
+            return 1;
+        }
+        t_caught = now_sec();
+        if ((after.samples + after.samples_dropped) - (before.samples + before.samples_dropped) >= sent) break;
+        struct timespec ms = { 0, 10000000 };
+        nanosleep(&ms, NULL);
+    } while (t_caught - t_end < 30);
+
+    uint64_t ingested = after.samples - before.samples;
+    printf("📤 보냄: 샘플 %llu개, %.2f초, %.0f 샘플/초 (소켓 버퍼 참 %llu회)\n",
+           (unsigned long long)sent, t_end - t0, sent / (t_end - t0), (unsigned long long)stalls);
+    printf("📥 서버 저장: 샘플 %llu개 (버림 %llu), %.0f 샘플/초 (마지막 샘플까지 %.2f초)\n",
+           (unsigned long long)ingested,
+           (unsigned long long)(after.samples_dropped - before.samples_dropped),
+           ingested / (t_caught - t0), t_caught - t0);
+    printf("💾 서버 시계열 메모리: %.1f MB, 노드당 %.0f B, 샘플당 %.2f B\n",
+           after.store_bytes / 1e6, after.nodes ? (double)after.store_bytes / after.nodes : 0.0,
+           after.samples ? (double)after.store_bytes / after.samples : 0.0);
+
+    // 전체 노드 요약 질의 지연
+    fleet_summary_req_t req = { BASE_TIME, UINT32_MAX };
+    double q0 = now_sec();
+    if (query(qfd, FLEET_MSG_SUMMARY, &req, sizeof(req), &sum, sizeof(sum)) == sizeof(sum)) {
+        history_agg_t a = sum.agg;
+        printf("🔎 SUMMARY: 노드 %u개 보고, 유효 샘플 %u개, 평균 %.2f°C, %.3f ms\n",
+               sum.nodes_reporting, a.count,
+               a.count ? a.temp_sum / 100.0 / a.count : 0.0, (now_sec() - q0) * 1e3);
+    }
+
+    for (uint32_t i = 0; i < nodes; i++) close(sim[i].fd);
+    close(qfd);
+    free(sim);
+    return ingested + (after.samples_dropped - before.samples_dropped) >= sent ? 0 : 1;
+
+peer_error:
+    fprintf(stderr, "❌ 노드 전송 실패 (서버가 연결을 끊음): %s\n", strerror(errno));
+    return 1;
+}
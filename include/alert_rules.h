@@ -0,0 +1,138 @@
+#ifndef ALERT_RULES_H
+#define ALERT_RULES_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// 경보 규칙 엔진 (샘플 스트림 위의 증분 평가기)
+//
+// 시작할 때 규칙 문장을 한 번 컴파일하고, 샘플마다 규칙당 O(1)로 평가합니다.
+// 규칙 파일은 한 줄에 하나 ('#' 뒤는 주석):
+//
+//   high_humidity: humi > 70 for 10m       값이 10분 동안 계속 70% 초과
+//   cold:          temp <= 18 for 30m
+//   heating_fast:  temp rises 3 within 15m  15분 안에 3°C 이상 상승
+//   door_open:     temp falls 2 within 5m   5분 안에 2°C 이상 하강
+//   damp_hour:     humi avg > 65 over 1h    1시간 평균 65% 초과
+//
+// 값은 소수 둘째 자리까지 (centi), 기간 단위는 s/m/h. 이름은 생략 가능.
+//
+// 평가 방식:
+//   - for:    조건이 참이 된 시각만 기억 (창 없음)
+//   - rises:  창의 최솟값을 단조 덱으로 유지, 현재값 - 최솟값
+//   - falls:  창의 최댓값을 단조 덱으로 유지, 최댓값 - 현재값
+//   - avg:    (시각, 값) 링 버퍼 + 누적 합
+// 같은 채널/기간 창은 규칙끼리 공유하므로 규칙 수천 개라도 창 갱신은
+// 서로 다른 창 수만큼입니다. 창 저장 공간은 컴파일 때 "기간 / 최소 측정
+// 간격" 크기로 한 번 할당하고, 평가 중에는 할당하지 않습니다.
+// 시각은 호출자가 넘깁니다 (ms, 단조 시계).
+
+#define ALERT_NAME_LEN          24
+#define ALERT_MIN_SAMPLE_MS     3000    // 창 크기 계산 기준 (DHT11 최소 간격)
+#define ALERT_MAX_RULES         65535   // 이벤트의 규칙 번호가 16비트
+
+typedef enum {
+    ALERT_CH_TEMP = 0,
+    ALERT_CH_HUMI,
+    ALERT_CH_COUNT
+} alert_channel_t;
+
+typedef enum {
+    ALERT_KIND_FOR = 0,         // 비교가 기간 내내 참
+    ALERT_KIND_RISES,           // 기간 안 상승폭
+    ALERT_KIND_FALLS,           // 기간 안 하강폭
+    ALERT_KIND_AVG              // 기간 평균 비교
+} alert_kind_t;
+
+typedef enum {
+    ALERT_CMP_GT = 0,
+    ALERT_CMP_GE,
+    ALERT_CMP_LT,
+    ALERT_CMP_LE
+} alert_cmp_t;
+
+typedef struct {
+    char name[ALERT_NAME_LEN];
+    uint8_t kind;               // alert_kind_t
+    uint8_t channel;            // alert_channel_t
+    uint8_t cmp;                // alert_cmp_t (FOR, AVG)
+    uint8_t active;             // 현재 발생 중
+    int32_t threshold;          // centi (RISES/FALLS는 폭)
+    int32_t window;             // 공유 창 번호 (FOR는 -1)
+    int64_t span_ms;
+    int64_t since_ms;           // FOR: 조건이 참이 된 시각 (-1 = 거짓)
+} alert_rule_t;
+
+// 시계열 점 (창 저장 단위)
+typedef struct {
+    int64_t t_ms;
+    int32_t value;
+} alert_point_t;
+
+// 고정 용량 링 (덱/슬라이딩 창 공용)
+typedef struct {
+    alert_point_t *buf;
+    uint32_t cap;
+    uint32_t head;              // 가장 오래된 점
+    uint32_t len;
+} alert_ring_t;
+
+#define ALERT_WIN_MIN   0x1     // 최솟값 덱 필요 (RISES)
+#define ALERT_WIN_MAX   0x2     // 최댓값 덱 필요 (FALLS)
+#define ALERT_WIN_SUM   0x4     // 링 + 합 필요 (AVG)
+
+typedef struct {
+    uint8_t channel;
+    uint8_t needs;              // ALERT_WIN_*
+    int64_t span_ms;
+    alert_ring_t min_dq;        // 값이 증가하는 단조 덱 (앞 = 최솟값)
+    alert_ring_t max_dq;        // 값이 감소하는 단조 덱 (앞 = 최댓값)
+    alert_ring_t samples;       // 평균용 원래 순서
+    int64_t sum;
+    int64_t first_ms;           // 첫 샘플 시각 (평균이 기간을 다 덮었는지)
+    int primed;
+} alert_window_t;
+
+// 발생/해제 이벤트
+typedef struct {
+    int64_t t_ms;
+    int32_t value;              // 평가한 값 (현재값/폭/평균, centi)
+    uint16_t rule;
+    uint8_t active;             // 1 발생, 0 해제
+    uint8_t reserved;
+} alert_event_t;
+
+typedef struct {
+    alert_rule_t *rules;
+    int count;
+    int rules_cap;
+    alert_window_t *windows;
+    int window_count;
+    int windows_cap;
+    alert_point_t *pool;        // 모든 창 링이 나눠 쓰는 저장 공간
+    uint64_t samples;
+    uint64_t events;
+    uint64_t events_dropped;    // 출력 배열이 모자라 버린 이벤트
+} alert_engine_t;
+
+void alert_engine_init(alert_engine_t *eng);
+void alert_engine_free(alert_engine_t *eng);
+
+// 규칙 문장들 컴파일 (여러 줄). 반환: 추가된 규칙 수, 문법 오류 -1
+// 모든 규칙을 추가한 뒤 alert_engine_finalize()를 한 번 호출
+int alert_engine_compile(alert_engine_t *eng, const char *text);
+
+// 규칙 파일 컴파일. 반환: 추가된 규칙 수, 오류 -1
+int alert_engine_load(alert_engine_t *eng, const char *path);
+
+// 창 저장 공간 할당 (min_sample_ms: 예상 최소 측정 간격, 0 = ALERT_MIN_SAMPLE_MS)
+int alert_engine_finalize(alert_engine_t *eng, int min_sample_ms);
+
+// 샘플 하나 평가. 상태가 바뀐 규칙마다 이벤트 (반환: out에 쓴 수)
+int alert_engine_update(alert_engine_t *eng, int64_t now_ms, int temp_centi, int humi_centi,
+                        alert_event_t *out, int max_out);
+
+// 이벤트 한 줄 문장 (콘솔/UART용, 예: "ALERT high_humidity humi 72.0")
+int alert_format_event(const alert_engine_t *eng, const alert_event_t *ev, char *buf, size_t size);
+
+#endif // ALERT_RULES_H
@@ -0,0 +1,32 @@
+#ifndef COMFORT_METRICS_H
+#define COMFORT_METRICS_H
+
+// 편의 지표: 이슬점, 체감 온도(열지수), 절대 습도
+// 빌드 시 생성한 룩업 테이블(comfort_tables.h)을 쌍선형 보간합니다.
+// 입력/출력 모두 0.01 단위 정수이며 log/exp/float 연산이 없습니다.
+
+// 테이블 정의역 (밖의 입력은 경계값으로 포화)
+#define COMFORT_TEMP_MIN_CENTI   0       //  0°C
+#define COMFORT_TEMP_MAX_CENTI   5000    // 50°C
+#define COMFORT_TEMP_STEP_CENTI  100     // 격자 1°C
+#define COMFORT_HUMI_MIN_CENTI   2000    // 20%
+#define COMFORT_HUMI_MAX_CENTI   9000    // 90%
+#define COMFORT_HUMI_STEP_CENTI  200     // 격자 2%
+
+#define COMFORT_TEMP_POINTS  ((COMFORT_TEMP_MAX_CENTI - COMFORT_TEMP_MIN_CENTI) / COMFORT_TEMP_STEP_CENTI + 1)
+#define COMFORT_HUMI_POINTS  ((COMFORT_HUMI_MAX_CENTI - COMFORT_HUMI_MIN_CENTI) / COMFORT_HUMI_STEP_CENTI + 1)
+
+typedef struct {
+    int dew_point_centi;        // 이슬점 (0.01°C)
+    int heat_index_centi;       // 체감 온도 (0.01°C)
+    int abs_humidity_centi;     // 절대 습도 (0.01 g/m³)
+} comfort_metrics_t;
+
+int comfort_dew_point(int temp_centi, int humi_centi);
+int comfort_heat_index(int temp_centi, int humi_centi);
+int comfort_abs_humidity(int temp_centi, int humi_centi);
+
+// 세 지표를 한 번에 (격자 위치 계산 1회)
+void comfort_compute(int temp_centi, int humi_centi, comfort_metrics_t *out);
+
+#endif // COMFORT_METRICS_H
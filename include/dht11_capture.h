@@ -0,0 +1,79 @@
+#ifndef DHT11_CAPTURE_H
+#define DHT11_CAPTURE_H
+
+#include <stdint.h>
+
+// DHT11 프레임 처리 (GPIO 없음): 에지 타임스탬프 해독, 프레임 검증,
+// 센서별 필터 상태, 여러 센서의 캡처 구간 엇갈림 배치
+//
+// 비트뱅잉 읽기(dht11_sensor.c)와 에지 이벤트 수집(sensor_array.c)이
+// 검증/필터 규칙을 공유하도록 여기 모았습니다.
+//
+// 프레임 타이밍: 호스트가 18ms 이상 LOW로 시작 신호를 보내고 놓으면 센서가
+// 80µs LOW + 80µs HIGH로 응답한 뒤 비트 40개를 보냅니다. 비트마다 50µs LOW
+// 다음 HIGH 폭이 26~28µs면 0, 70µs면 1입니다 (프레임 전체 약 4~5ms).
+
+// 유효 범위 (0.01 단위 정수)
+#define DHT11_TEMP_MIN_CENTI  (-1000)  // -10.00°C
+#define DHT11_TEMP_MAX_CENTI  6000     //  60.00°C
+#define DHT11_HUMI_MIN_CENTI  500      //   5.00%
+#define DHT11_HUMI_MAX_CENTI  9500     //  95.00%
+
+#define DHT11_START_LOW_US    20000    // 시작 신호 LOW 유지
+#define DHT11_CAPTURE_US      8000     // 시작 신호를 놓은 뒤 프레임을 기다리는 구간
+#define DHT11_MAX_EDGES       96       // 응답 + 40비트 양쪽 에지 (86개) + 여유
+#define DHT11_BIT_ONE_US      50       // HIGH가 이보다 길면 1
+#define DHT11_BIT_MIN_US      10       // 이보다 짧은 HIGH는 잡음
+#define DHT11_BIT_MAX_US      100      // 데이터 HIGH 최대 (응답 80µs는 프레임 앞)
+#define DHT11_STALE_LIMIT     3        // 연속 실패가 이보다 적으면 마지막 값으로 대체
+
+// 읽기 통계 (누적, 상태 공유/모니터링용)
+typedef struct {
+    uint32_t reads_ok;          // 성공한 읽기
+    uint32_t reads_failed;      // 재시도를 모두 실패한 읽기
+    uint32_t retries;           // 재시도 횟수 (첫 시도 제외)
+    uint32_t timeout_errors;    // 응답/비트 대기 시간 초과
+    uint32_t checksum_errors;   // 체크섬 불일치
+    uint32_t range_errors;      // 유효 범위 밖 값
+} dht11_stats_t;
+
+// 센서 하나의 필터 상태 (마지막 유효값 + 연속 오류 + 통계)
+typedef struct {
+    int last_valid_temp;        // 0.01°C
+    int last_valid_humi;        // 0.01%
+    int consecutive_errors;
+    dht11_stats_t stats;
+} dht11_state_t;
+
+// 에지 하나 (커널 타임스탬프)
+typedef struct {
+    uint64_t ns;
+    uint8_t rising;
+} dht11_edge_t;
+
+// 필터 상태 초기화 (기본 25°C/50%)
+void dht11_state_init(dht11_state_t *st);
+
+// 5바이트 프레임 검증 (체크섬, 범위). 성공이면 centi 값을 채우고 0,
+// 실패면 해당 오류 통계를 올리고 -1 (성공/실패 확정은 아래 함수가)
+int dht11_frame_check(dht11_state_t *st, const uint8_t data[5], int *temp_centi, int *humi_centi);
+
+// 읽기 성공 반영 (마지막 유효값 갱신, 연속 오류 초기화)
+void dht11_state_accept(dht11_state_t *st, int temp_centi, int humi_centi);
+
+// 읽기 실패 반영. 연속 실패가 짧으면 마지막 유효값을 채우고 1, 아니면 0
+int dht11_state_reject(dht11_state_t *st, int *temp_centi, int *humi_centi);
+
+// 에지 목록 → 5바이트. 앞쪽 에지를 놓쳐도 되도록 마지막 HIGH 40개를 비트로 씀
+// (중간 에지 누락은 방향이 두 번 연달아 나오므로 오류)
+// 반환: 0 성공, -1 비트 부족/폭 이상 (timeout_errors로 셈)
+int dht11_decode_edges(const dht11_edge_t *edges, int n, uint8_t data[5]);
+
+// HIGH 펄스 수 (캡처 완료 판단: 응답 + 40비트 = 41)
+int dht11_count_highs(const dht11_edge_t *edges, int n);
+
+// 캡처 구간이 겹치지 않는 가장 이른 시작 신호 해제 시각 (ns)
+// reserved: 다른 센서들이 예약한 해제 시각 (0 = 예약 없음), want: 원하는 해제 시각
+uint64_t dht11_stagger(const uint64_t *reserved, int n, uint64_t want, uint64_t window_ns);
+
+#endif // DHT11_CAPTURE_H
@@ -2,6 +2,7 @@
 #define DHT11_SENSOR_H
 
 #include "smart_env_monitor.h"
+#include "dht11_capture.h"
 
 // DHT11 센서 설정
 #define DHT11_MAX_TIMINGS   85
@@ -10,18 +11,33 @@
 
 // DHT11 데이터 구조체
 typedef struct {
-    float temperature;
-    float humidity;
+    int temp_centi;     // 온도 (0.01°C)
+    int humi_centi;     // 습도 (0.01%)
     int checksum_valid;
     struct timespec last_read;
 } dht11_data_t;
 
-// DHT11 센서 함수
+// 센서 하나 (GPIO 핀 + 읽기 간격 + 필터 상태)
+typedef struct {
+    int pin;
+    struct timespec last_read_time;
+    dht11_state_t state;
+} dht11_t;
+
+// 인스턴스 함수 (여러 센서)
+int dht11_open(dht11_t *dev, int gpio_pin);
+int dht11_ready(const dht11_t *dev);
+int dht11_read(dht11_t *dev, dht11_data_t *data);
+
+// 기본 센서 함수 (센서 하나, 기존 호출부용)
 int dht11_init(int gpio_pin);
 void dht11_cleanup(void);
 int dht11_read_data(dht11_data_t *data);
 int dht11_is_ready_to_read(void);
 void dht11_print_data(const dht11_data_t *data);
+void dht11_get_last_valid(int *temp_centi, int *humi_centi, int *errors);
+void dht11_set_last_valid(int temp_centi, int humi_centi, int errors);
+void dht11_get_stats(dht11_stats_t *stats);
 
 // 내부 함수 (1-Wire 통신)
 int dht11_wait_for_state(int pin, int state, int timeout_us);
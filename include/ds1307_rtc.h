@@ -2,6 +2,7 @@
 #define DS1307_RTC_H
 
 #include "smart_env_monitor.h"
+#include "i2c_stats.h"
 
 // DS1307 I2C 주소
 #define DS1307_I2C_ADDR       0x68
@@ -15,12 +16,23 @@
 #define DS1307_REG_MONTH      0x05
 #define DS1307_REG_YEAR       0x06
 #define DS1307_REG_CONTROL    0x07
+#define DS1307_REG_RAM        0x08  // 배터리 백업 RAM 시작 (0x08~0x3F)
+#define DS1307_RAM_SIZE       56
 
 // DS1307 제어 비트
 #define DS1307_CLOCK_HALT     0x80  // CH bit in seconds register
 #define DS1307_12_HOUR_MODE   0x40  // 12/24 hour mode bit
 #define DS1307_PM_BIT         0x20  // PM bit in 12-hour mode
 
+// 제어 레지스터(0x07) 비트
+#define DS1307_CTRL_OUT       0x80  // SQW 비활성 시 출력 레벨
+#define DS1307_CTRL_SQWE      0x10  // 구형파 출력 활성화
+#define DS1307_SQW_1HZ        0x00  // RS1:RS0 = 00
+#define DS1307_SQW_4KHZ       0x01  // 4.096 kHz
+#define DS1307_SQW_8KHZ       0x02  // 8.192 kHz
+#define DS1307_SQW_32KHZ      0x03  // 32.768 kHz
+#define DS1307_SQW_RATE_MASK  0x03  // RS1:RS0
+
 // BCD 변환 매크로
 #define BCD_TO_DEC(val)  (((val) >> 4) * 10 + ((val) & 0x0F))
 #define DEC_TO_BCD(val)  ((((val) / 10) << 4) + ((val) % 10))
@@ -34,6 +46,13 @@ int ds1307_set_current_time(void);
 void ds1307_print_time(const struct tm *time);
 int ds1307_start_clock(void);
 int ds1307_stop_clock(void);
+int ds1307_enable_square_wave(int rate);
+int ds1307_disable_square_wave(void);
+int ds1307_read_ram(int offset, unsigned char *data, int len);
+int ds1307_write_ram(int offset, const unsigned char *data, int len);
+
+// I2C 트랜잭션 통계 (레지스터/RAM 접근마다 누적)
+void ds1307_get_i2c_stats(i2c_stats_t *out);
 
 // 내부 I2C 통신 함수
 //int ds1307_read_register(unsigned char reg);
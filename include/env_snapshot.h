@@ -0,0 +1,90 @@
+#ifndef ENV_SNAPSHOT_H
+#define ENV_SNAPSHOT_H
+
+#include <stdint.h>
+#include "sensor_sample.h"
+#include "i2c_stats.h"
+
+// 현재 상태 공유: 센서를 소유한 프로세스(smart_env_ui)가 최신 샘플, 환경
+// 등급, 센서 건강 카운터를 POSIX 공유 메모리에 게시하고, 다른 로컬 프로세스는
+// DHT11을 직접 읽지 않고 이 스냅샷을 읽습니다.
+//
+// 동기화는 seqlock: 쓰는 쪽은 seq를 홀수로 만든 뒤 내용을 쓰고 다시 짝수로
+// 만듭니다. 읽는 쪽은 seq가 짝수이고 복사 전후로 같을 때만 받아들이므로
+// 시스템 콜/잠금 없이 수십 ns에 읽고, 쓰는 쪽은 읽는 쪽 수와 무관하게
+// 기다리지 않습니다. 쓰는 쪽은 하나만 허용합니다.
+
+#define ENV_SNAPSHOT_NAME           "/smart_env_snapshot"
+#define ENV_SNAPSHOT_MAGIC          0x534E4150  // "SNAP"
+#define ENV_SNAPSHOT_VERSION        3
+#define ENV_SNAPSHOT_MAX_RETRIES    1000        // 읽기 재시도 한도 (쓰는 쪽 중단 대비)
+
+// 게시 내용
+typedef struct {
+    sensor_sample_t sample;         // 마지막 샘플 (flags로 정상/대체값 구분)
+    uint8_t temp_level;             // env_level_t
+    uint8_t humi_level;
+    uint8_t overall_level;
+    uint8_t prolonged_warning;
+    uint32_t warning_elapsed_s;     // 주의 상태 지속 시간
+    uint64_t publish_count;         // 게시 순번 (1부터)
+    uint64_t publish_mono_ns;       // 게시 시각 (CLOCK_MONOTONIC, 오래됨 판단용)
+
+    // 센서 건강 카운터 (누적)
+    uint32_t reads_ok;
+    uint32_t reads_failed;
+    uint32_t retries;
+    uint32_t timeout_errors;
+    uint32_t checksum_errors;
+    uint32_t range_errors;
+    uint32_t consecutive_errors;
+    uint32_t display_mode;
+
+    // 측정 주기 (적응형 스케줄러)
+    uint32_t sample_interval_ms;    // 현재 간격
+    uint32_t sample_avg_interval_ms; // 실효 간격 (이동 평균)
+
+    // I2C 버스 통계 (누적)
+    i2c_stats_t rtc_i2c;            // DS1307 레지스터/RAM 접근
+    i2c_stats_t oled_i2c;           // OLED 화면 전송
+} env_snapshot_t;
+
+// 공유 메모리 배치
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t size;                  // sizeof(env_snapshot_shm_t)
+    uint32_t seq;                   // seqlock (홀수 = 쓰는 중)
+    uint32_t publisher_pid;         // 0 = 게시자 종료
+    env_snapshot_t data;
+} env_snapshot_shm_t;
+
+typedef struct {
+    env_snapshot_shm_t *shm;
+} env_snapshot_publisher_t;
+
+typedef struct {
+    const env_snapshot_shm_t *shm;
+} env_snapshot_reader_t;
+
+// 게시자: 세그먼트 생성(또는 재사용) 후 매핑
+int env_snapshot_publisher_open(env_snapshot_publisher_t *pub, const char *name);
+
+// 스냅샷 게시 (publish_count/publish_mono_ns는 여기서 채움)
+void env_snapshot_publish(env_snapshot_publisher_t *pub, const env_snapshot_t *snap);
+
+// 매핑 해제 (세그먼트는 남겨 마지막 상태를 계속 읽을 수 있게 함)
+void env_snapshot_publisher_close(env_snapshot_publisher_t *pub);
+
+// 읽는 쪽: 기존 세그먼트를 읽기 전용으로 매핑 (없으면 -1)
+int env_snapshot_reader_open(env_snapshot_reader_t *reader, const char *name);
+
+// 일관된 스냅샷 복사 (반환: 0 성공, -1 아직 게시 전이거나 재시도 한도 초과)
+int env_snapshot_read(const env_snapshot_reader_t *reader, env_snapshot_t *out);
+
+// 게시자 실행 여부 (0 = 종료했거나 아직 없음)
+uint32_t env_snapshot_publisher_pid(const env_snapshot_reader_t *reader);
+
+void env_snapshot_reader_close(env_snapshot_reader_t *reader);
+
+#endif // ENV_SNAPSHOT_H
@@ -0,0 +1,72 @@
+#ifndef ENVIRONMENT_INDICATOR_H
+#define ENVIRONMENT_INDICATOR_H
+
+#include <stdint.h>
+
+// 환경 지수: 온도/습도를 적정·주의·위험 3단계로 판정하는 증분 상태 기계
+// 갱신은 샘플 하나당 O(1)이며 이력을 다시 훑지 않습니다.
+// 모든 값은 0.01 단위 정수(centi)입니다.
+
+typedef enum {
+    ENV_GOOD = 0,       // 적정
+    ENV_WARNING = 1,    // 주의
+    ENV_DANGER = 2      // 위험
+} env_level_t;
+
+// 한 축(온도 또는 습도)의 판정 구간
+typedef struct {
+    int good_min;       // 적정 하한
+    int good_max;       // 적정 상한
+    int warn_min;       // 주의 하한 (이 밖은 위험)
+    int warn_max;       // 주의 상한
+    int hysteresis;     // 더 좋은 등급으로 돌아갈 때 구간 안쪽으로 들어와야 하는 여유
+} env_band_t;
+
+typedef struct {
+    env_band_t temp;
+    env_band_t humi;
+    int escalation_ms;  // 주의 상태가 이 시간 이상 계속되면 위험으로 승격
+} env_config_t;
+
+// 기본 기준: 온도 적정 20~26°C / 주의 18~28°C, 습도 적정 40~60% / 주의 30~70%
+#define ENV_CONFIG_DEFAULT {                                  \
+    .temp = { 2000, 2600, 1800, 2800, 50 },                   \
+    .humi = { 4000, 6000, 3000, 7000, 200 },                  \
+    .escalation_ms = 10000,                                   \
+}
+
+// 상태 (0으로 초기화하면 기본 기준으로 동작)
+typedef struct {
+    const env_config_t *config;     // NULL이면 기본 기준
+    env_level_t temp_level;         // 온도 축 등급 (히스테리시스 적용)
+    env_level_t humi_level;         // 습도 축 등급 (히스테리시스 적용)
+    env_level_t overall_level;      // 최종 등급 (승격 포함)
+    int prolonged_warning;          // 장기 주의로 위험 승격됨
+    int warning_active;             // 주의 타이머 동작 중
+    int64_t warning_since_ms;       // 주의 시작 시각 (단조 시계, ms)
+    int initialized;                // 첫 샘플 처리 여부
+} env_status_t;
+
+// 기준 변경 (config는 상태보다 오래 살아 있어야 함, NULL = 기본)
+void environment_set_config(env_status_t *status, const env_config_t *config);
+
+// 샘플 하나 반영 (단조 시계 사용)
+void update_environment_status(env_status_t *status, int temp_centi, int humi_centi);
+
+// 샘플 하나 반영 (시각 지정: 테스트/재생용)
+void update_environment_status_at(env_status_t *status, int temp_centi, int humi_centi,
+                                  int64_t now_ms);
+
+// 주의 상태 지속 시간 (초, 주의 아님이면 0)
+int environment_warning_elapsed_s(const env_status_t *status);
+
+// 재시작 후 주의 타이머 복원 (이미 elapsed_s초 동안 주의였던 것으로 간주)
+void environment_restore_warning(env_status_t *status, int elapsed_s);
+
+// 단조 시계 (ms)
+int64_t environment_now_ms(void);
+
+const char *get_level_icon(env_level_t level);
+const char *get_level_text(env_level_t level);
+
+#endif // ENVIRONMENT_INDICATOR_H
@@ -0,0 +1,29 @@
+#ifndef FIXED_POINT_H
+#define FIXED_POINT_H
+
+#include <stdarg.h>
+#include <stddef.h>
+
+// 고정소수점(0.01 단위 정수, "centi") 연산과 정수 전용 문자열 포맷
+// 센서 원시 바이트 → 검증 → 필터 → 임계값 → 표시 문자열까지 float 없이 처리합니다.
+
+#define FX_CENTI            100
+
+// 정수 값과 소수 부분(0.1 단위)으로 centi 값 만들기 (예: 23, 4 → 2340)
+#define FX_CENTI_FROM_TENTHS(whole, tenths)  ((whole) * FX_CENTI + (tenths) * 10)
+#define FX_CENTI_FROM_INT(whole)             ((whole) * FX_CENTI)
+
+/*
+ * 정수 전용 snprintf 대체
+ *   %d %u %c %s %%   폭/0 채움/왼쪽 정렬(-) 지원 (예: %02d, %-8s)
+ *   %q               centi 값을 소수로 출력 (기본 소수 1자리, %.0q ~ %.2q)
+ *                    예: fx_format(buf, n, "%.1q C", 2345) → "23.5 C"
+ * 항상 NUL 종료하며, 잘리지 않았을 때의 길이를 반환합니다.
+ */
+int fx_format(char *buf, size_t size, const char *fmt, ...);
+int fx_vformat(char *buf, size_t size, const char *fmt, va_list ap);
+
+// centi 값을 소수 decimals 자리로 반올림 (0.5는 0에서 먼 쪽, int 범위 끝에서는 0 쪽)
+int fx_round_centi(int centi, int decimals);
+
+#endif // FIXED_POINT_H
@@ -0,0 +1,106 @@
+#ifndef FLEET_AGGREGATOR_H
+#define FLEET_AGGREGATOR_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "node_protocol.h"
+#include "sample_codec.h"
+
+// 여러 모니터의 샘플을 모으는 집계 서버 (호스트 쪽, TCP, epoll 단일 스레드)
+//
+// 노드마다 시계열을 sample_codec 블록으로 압축해 메모리에 보관합니다.
+// 채우는 중인 블록 하나만 고정 크기이고, 봉인한 블록은 실제 길이만큼만
+// 할당하며 블록마다 집계(history_agg_t)를 붙여 두어 SUMMARY는 구간에 완전히
+// 들어가는 블록을 풀지 않고 합칩니다. 노드당 블록 수가 한도에 이르면 가장
+// 오래된 블록부터 재사용합니다.
+//
+// SAMPLES 프레임은 통째로 모으지 않고 도착한 샘플 단위로 바로 저장하므로
+// 연결당 입력 버퍼는 작게 고정됩니다. 질의 응답만 필요할 때 할당합니다.
+
+#define FLEET_DEFAULT_MAX_CONNS     16384
+#define FLEET_BLOCK_BYTES           256     // 노드 블록 압축 데이터 최대 크기
+#define FLEET_NODE_MAX_BLOCKS       1024    // 노드당 보관 블록 수 한도
+#define FLEET_IN_BUF                512     // 연결당 입력 버퍼
+
+// 봉인된 블록 (data는 len 바이트만 할당)
+typedef struct {
+    uint32_t first_time;        // epoch 초
+    uint32_t last_time;
+    uint16_t count;
+    uint16_t len;
+    history_agg_t agg;
+    uint8_t data[];
+} fleet_block_t;
+
+typedef struct {
+    uint32_t node_id;
+    char room[NODE_ROOM_LEN];
+    int32_t conn;               // 연결 슬롯, -1 = 끊김
+    uint32_t stored;            // 보관 중인 샘플 수
+    int64_t last_ms;            // 마지막 저장 샘플 시각 (중복 제거 기준)
+    sensor_sample_t latest;
+    // 봉인된 블록 링 (시각 순, 가장 오래된 것이 block_head)
+    fleet_block_t **blocks;
+    uint32_t block_cap;
+    uint32_t block_head;
+    uint32_t block_count;
+    // 채우는 중인 블록
+    sample_encoder_t enc;
+    uint32_t open_first;
+    history_agg_t open_agg;
+    uint8_t open_data[FLEET_BLOCK_BYTES];
+} fleet_node_t;
+
+typedef struct {
+    int fd;
+    int32_t node;               // HELLO 보낸 노드 번호, -1 = 질의 연결/아직 모름
+    uint32_t events;            // 현재 epoll 등록 이벤트
+    uint32_t in_len;
+    uint32_t frame_type;        // 받는 중인 SAMPLES 프레임
+    uint32_t frame_left;        // 그 프레임의 남은 바이트
+    uint8_t *out;               // 질의 응답 (보낼 때만 할당)
+    uint32_t out_off;
+    uint32_t out_len;
+    uint32_t out_cap;
+    uint8_t in[FLEET_IN_BUF];
+} fleet_conn_t;
+
+typedef struct {
+    int listen_fd;
+    int epoll_fd;
+    uint32_t max_conns;
+    fleet_conn_t **conns;       // 슬롯별 연결 (accept 때 할당)
+    uint32_t *free_slots;       // 빈 슬롯 스택
+    uint32_t free_count;
+    fleet_node_t **nodes;       // 등록 순
+    uint32_t node_count;
+    uint32_t node_cap;
+    uint32_t *table;            // node_id 해시 → 노드 번호 + 1 (0 = 빔)
+    uint32_t table_size;        // 2의 거듭제곱
+    fleet_stats_t stats;
+} fleet_aggregator_t;
+
+// TCP 수신 시작 (bind_addr NULL이면 모든 주소, max_conns 0이면 기본값)
+int fleet_aggregator_open(fleet_aggregator_t *agg, const char *bind_addr, uint16_t port,
+                          uint32_t max_conns);
+
+void fleet_aggregator_close(fleet_aggregator_t *agg);
+
+// 대기 중인 이벤트 처리 (반환: 처리한 이벤트 수, -1 오류)
+int fleet_aggregator_poll(fleet_aggregator_t *agg, int timeout_ms);
+
+// 노드 찾기 (없으면 NULL)
+const fleet_node_t *fleet_aggregator_find(const fleet_aggregator_t *agg, uint32_t node_id);
+
+// 노드의 [from_ms, to_ms) 샘플을 out에 최대 max개 복원 (시각 순)
+size_t fleet_aggregator_range(const fleet_aggregator_t *agg, uint32_t node_id,
+                              int64_t from_ms, int64_t to_ms, sensor_sample_t *out, size_t max);
+
+// 전체 노드 [from, to) 초 구간 요약
+void fleet_aggregator_summary(const fleet_aggregator_t *agg, uint32_t from, uint32_t to,
+                              fleet_summary_t *out);
+
+// 통계 (stats 구조체 복사, nodes/clients는 현재 값)
+void fleet_aggregator_stats(const fleet_aggregator_t *agg, fleet_stats_t *out);
+
+#endif // FLEET_AGGREGATOR_H
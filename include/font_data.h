@@ -1,7 +1,12 @@
 #ifndef FONT_DATA_H
 #define FONT_DATA_H
 
+#ifdef __KERNEL__
 #include <linux/types.h> // u8 타입 정의
+#else
+#include <stdint.h>      // 사용자 공간 위젯 래스터라이저도 같은 글꼴 사용
+typedef uint8_t u8;
+#endif
 
 // Row-Major 방식의 전체 6x8 폰트 데이터 
 static const u8 font6x8_basic[96][8] = {
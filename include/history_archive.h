@@ -0,0 +1,70 @@
+#ifndef HISTORY_ARCHIVE_H
+#define HISTORY_ARCHIVE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "sample_codec.h"
+#include "history_store.h"
+
+// 압축 이력 아카이브: 샘플을 sample_codec 블록으로 묶어 고정 크기 슬롯 링
+// 파일(mmap)에 봉인합니다. 원본 링(history_store)이 최근 며칠을 12바이트로
+// 보관하는 동안 아카이브는 샘플당 1~2바이트로 몇 달을 보관합니다.
+//
+// 각 슬롯은 자체 헤더(seq, 시각 범위, CRC)를 가지므로 전역 헤더가 없고,
+// 봉인 중 전원이 끊겨도 그 슬롯 하나만 무효가 됩니다. 봉인 전 블록은 메모리에만
+// 있으므로, 비정상 종료 뒤에는 history_archive_backfill로 마지막 봉인 블록 이후의
+// 샘플을 원본 링에서 다시 인코딩합니다 (원본 링이 그 구간을 덮어쓰기 전까지만 가능).
+
+#define HISTORY_ARCHIVE_DEFAULT_PATH    "/var/lib/smart_env_monitor/history.archive"
+#define HISTORY_ARCHIVE_DEFAULT_BLOCKS  4096    // 4MB, 3초 간격 약 3개월
+#define HISTORY_ARCHIVE_BLOCK_SIZE      1024
+#define HISTORY_ARCHIVE_MAGIC           0x48415243  // "HARC"
+#define HISTORY_ARCHIVE_VERSION         1
+
+typedef struct __attribute__((packed)) {
+    uint32_t crc;               // 이 필드 뒤 헤더 + 데이터의 CRC-32
+    uint32_t magic;
+    uint16_t version;
+    uint16_t count;             // 블록 안 샘플 수
+    uint32_t first_time;        // 첫 샘플 시각 (epoch 초)
+    uint32_t last_time;         // 마지막 샘플 시각 (epoch 초)
+    uint64_t seq;               // 봉인 순번 (1부터)
+    uint16_t len;               // 압축 데이터 바이트 수
+    uint16_t reserved;
+} archive_block_header_t;
+
+#define HISTORY_ARCHIVE_PAYLOAD  (HISTORY_ARCHIVE_BLOCK_SIZE - sizeof(archive_block_header_t))
+
+typedef struct {
+    int fd;
+    uint8_t *map;
+    size_t map_size;
+    uint32_t blocks;            // 슬롯 수
+    uint64_t next_seq;          // 다음 봉인 순번
+    sample_encoder_t enc;       // 봉인 전 블록
+    uint8_t open_block[HISTORY_ARCHIVE_PAYLOAD];
+} history_archive_t;
+
+int history_archive_open(history_archive_t *archive, const char *path, uint32_t blocks);
+
+// 아카이브의 마지막 샘플 이후의 원본 링 샘플을 다시 추가 (열고 나서 한 번)
+// 반환: 추가한 샘플 수, -1 봉인 실패. 아카이브가 비어 있으면 아무것도 하지 않음
+int history_archive_backfill(history_archive_t *archive, const history_store_t *raw);
+
+// 봉인 전 블록을 기록하고 닫기
+void history_archive_close(history_archive_t *archive);
+
+// 샘플 추가 (블록이 차면 봉인, 반환: 0 성공, -1 봉인 실패)
+int history_archive_append(history_archive_t *archive, const sensor_sample_t *sample);
+
+// 봉인 전 블록을 지금 봉인 (종료 시)
+int history_archive_seal(history_archive_t *archive);
+
+// 봉인된 블록 수
+uint32_t history_archive_block_count(const history_archive_t *archive);
+
+// [from_ms, to_ms) 구간 샘플을 out에 최대 max개 복원 (봉인 전 블록 포함)
+size_t history_archive_query(const history_archive_t *archive, int64_t from_ms, int64_t to_ms,
+                             sensor_sample_t *out, size_t max);
+
+#endif // HISTORY_ARCHIVE_H
@@ -0,0 +1,95 @@
+#ifndef HISTORY_INDEX_H
+#define HISTORY_INDEX_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "history_store.h"
+
+// 이력 구간 집계 색인: 링 슬롯을 HISTORY_INDEX_BLOCK개씩 묶은 블록 위에
+// 상향식 세그먼트 트리를 두어, 임의 구간의 min/max/합계를 O(log n)에 답합니다
+// ("최근 6시간 최대 습도" 같은 경보/추세 질의가 원본을 훑지 않도록).
+//
+// 트리는 논리 순서가 아니라 물리 슬롯 위에 있으므로 링이 돌며 가장 오래된
+// 샘플을 덮어써도 해당 블록 하나와 조상만 다시 계산하면 됩니다.
+// 구간 양끝의 걸친 블록은 샘플을 직접 훑습니다 (최대 2 x 블록 크기).
+// 메모리: 노드 32바이트 x 2 x (용량 / 블록) - 기본 용량에서 약 400KB.
+
+#define HISTORY_INDEX_BLOCK     32
+
+// 구간 집계 (유효 샘플만, count 0이면 min/max는 의미 없음)
+typedef struct {
+    int64_t temp_sum;           // 0.01°C 합계
+    int64_t humi_sum;           // 0.01% 합계
+    uint32_t count;
+    int16_t temp_min;
+    int16_t temp_max;
+    uint16_t humi_min;
+    uint16_t humi_max;
+    uint32_t reserved;
+} history_agg_t;
+
+// 빈 집계 (min/max는 첫 샘플이 덮어쓰도록 반대 끝 값)
+static inline void history_agg_reset(history_agg_t *agg) {
+    agg->temp_sum = 0;
+    agg->humi_sum = 0;
+    agg->count = 0;
+    agg->temp_min = INT16_MAX;
+    agg->temp_max = INT16_MIN;
+    agg->humi_min = UINT16_MAX;
+    agg->humi_max = 0;
+    agg->reserved = 0;
+}
+
+static inline void history_agg_merge(history_agg_t *dst, const history_agg_t *src) {
+    dst->temp_sum += src->temp_sum;
+    dst->humi_sum += src->humi_sum;
+    dst->count += src->count;
+    if (src->temp_min < dst->temp_min) dst->temp_min = src->temp_min;
+    if (src->temp_max > dst->temp_max) dst->temp_max = src->temp_max;
+    if (src->humi_min < dst->humi_min) dst->humi_min = src->humi_min;
+    if (src->humi_max > dst->humi_max) dst->humi_max = src->humi_max;
+}
+
+static inline void history_agg_add(history_agg_t *dst, const sensor_sample_t *s) {
+    // 아직 쓰이지 않은 슬롯(time 0)과 무효 샘플은 제외
+    if (s->time == 0 || !(s->flags & SAMPLE_FLAG_VALID)) return;
+    dst->temp_sum += s->temp_centi;
+    dst->humi_sum += s->humi_centi;
+    dst->count++;
+    if (s->temp_centi < dst->temp_min) dst->temp_min = s->temp_centi;
+    if (s->temp_centi > dst->temp_max) dst->temp_max = s->temp_centi;
+    if (s->humi_centi < dst->humi_min) dst->humi_min = s->humi_centi;
+    if (s->humi_centi > dst->humi_max) dst->humi_max = s->humi_centi;
+}
+
+typedef struct {
+    history_agg_t *tree;        // [blocks, 2*blocks) = 블록 잎, [1, blocks) = 내부 노드
+    uint32_t blocks;            // 잎 수 = ceil(capacity / HISTORY_INDEX_BLOCK)
+    uint32_t capacity;          // 색인 대상 링 용량
+    uint32_t head;              // 마지막으로 반영한 링 head
+    uint32_t count;             // 마지막으로 반영한 링 샘플 수
+    uint64_t appended;          // 마지막 반영 시점의 링 appended (한 바퀴 넘게 밀렸는지 판단)
+} history_index_t;
+
+// 링의 현재 내용으로 색인 구성 (O(capacity))
+int history_index_init(history_index_t *idx, const history_store_t *store);
+
+void history_index_free(history_index_t *idx);
+
+// 마지막 반영 이후 추가된 샘플을 색인에 반영 (블록당 O(B + log n)).
+// 추가할 때마다 또는 질의 직전에 호출. 그 사이 링이 한 바퀴 넘게 돌았으면 다시 구성
+void history_index_sync(history_index_t *idx, const history_store_t *store);
+
+// 논리 구간 [first, last) (0 = 가장 오래됨) 집계 (반환: 유효 샘플 수)
+uint32_t history_index_range(const history_index_t *idx, const history_store_t *store,
+                             uint32_t first, uint32_t last, history_agg_t *out);
+
+// 시각 [from_ms, to_ms) 집계 (이분 탐색 2회 + 구간 집계)
+uint32_t history_index_query(const history_index_t *idx, const history_store_t *store,
+                             int64_t from_ms, int64_t to_ms, history_agg_t *out);
+
+// 평균 (0.01 단위 반올림, count 0이면 0)
+int history_agg_temp_mean(const history_agg_t *agg);
+int history_agg_humi_mean(const history_agg_t *agg);
+
+#endif // HISTORY_INDEX_H
@@ -0,0 +1,114 @@
+#ifndef HISTORY_ROLLUP_H
+#define HISTORY_ROLLUP_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "sensor_sample.h"
+#include "history_store.h"
+
+// 다중 해상도 요약 (1분 / 1시간 / 1일): 샘플이 들어올 때마다 세 단계의 현재
+// 구간에 min/max/합계/개수를 더합니다 (샘플당 O(1), 원본 재스캔 없음).
+// 요약은 원본 링 옆의 mmap 파일에 보관하며, 추세 화면은 요청한 구간과 픽셀
+// 폭을 만족하는 가장 거친 해상도에서 읽습니다 (24시간 추세 = 1분 구간 1440개).
+//
+// 파일 구성: [헤더 (1페이지)][1분 구간 링][1시간 구간 링][1일 구간 링]
+// 구간은 제자리에서 갱신하므로 헤더에 CRC가 없고, 대신 정상 종료 표시(clean)를
+// 둡니다. 비정상 종료 후 열면 원본 링이 덮는 시간대의 구간을 원본에서 다시
+// 만듭니다 (그보다 오래된 구간은 그대로 유지).
+
+#define HISTORY_ROLLUP_DEFAULT_PATH     "/var/lib/smart_env_monitor/history.rollup"
+#define HISTORY_ROLLUP_MAGIC            0x524F4C4C  // "ROLL"
+#define HISTORY_ROLLUP_VERSION          1
+
+// 해상도 단계 (가는 것부터)
+typedef enum {
+    ROLLUP_MINUTE = 0,
+    ROLLUP_HOUR,
+    ROLLUP_DAY,
+    ROLLUP_LEVELS
+} rollup_level_t;
+
+#define ROLLUP_MINUTE_BUCKETS   10080   // 7일
+#define ROLLUP_HOUR_BUCKETS     2160    // 90일
+#define ROLLUP_DAY_BUCKETS      730     // 2년
+
+// 구간 하나의 요약 (24바이트)
+typedef struct {
+    uint32_t start;             // 구간 시작 시각 (epoch 초, 구간 길이 배수)
+    uint32_t count;             // 유효 샘플 수
+    int32_t temp_sum;           // 0.01°C 합계 (1일 28800개 x 6000 < 2^31)
+    uint32_t humi_sum;          // 0.01% 합계
+    int16_t temp_min;
+    int16_t temp_max;
+    uint16_t humi_min;
+    uint16_t humi_max;
+} rollup_bucket_t;
+
+_Static_assert(sizeof(rollup_bucket_t) == 24, "rollup_bucket_t must stay 24 bytes");
+
+// 단계별 링 위치 (제자리 갱신)
+typedef struct __attribute__((packed)) {
+    uint32_t seconds;           // 구간 길이
+    uint32_t capacity;          // 구간 수
+    uint32_t head;              // 다음에 쓸 구간
+    uint32_t count;             // 유효 구간 수
+} rollup_level_info_t;
+
+// 디스크 헤더
+typedef struct __attribute__((packed)) {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t levels;            // ROLLUP_LEVELS
+    uint32_t clean;             // 1 = 정상 종료, 열려 있는 동안 0
+    uint32_t reserved;
+    rollup_level_info_t level[ROLLUP_LEVELS];
+} rollup_header_t;
+
+typedef struct {
+    int fd;
+    uint8_t *map;
+    size_t map_size;
+    rollup_header_t *hdr;                       // 맵 안의 헤더
+    rollup_bucket_t *buckets[ROLLUP_LEVELS];    // 맵 안의 단계별 링
+} history_rollup_t;
+
+// 추세 화면 한 열 (요청 구간을 width 등분)
+typedef struct {
+    uint32_t start;             // 열 시작 시각 (epoch 초)
+    uint32_t count;             // 0이면 데이터 없음
+    int16_t temp_min;
+    int16_t temp_max;
+    int16_t temp_mean;
+    uint16_t humi_min;
+    uint16_t humi_max;
+    uint16_t humi_mean;
+} rollup_point_t;
+
+// 열기 (없거나 형식이 다르면 새로 만듦). 비정상 종료 흔적이 있으면 raw가
+// 덮는 시간대를 raw에서 다시 만듦 (raw = NULL이면 있는 그대로 사용)
+int history_rollup_open(history_rollup_t *rollup, const char *path,
+                        const history_store_t *raw);
+
+// 디스크에 반영하고 정상 종료 표시 후 닫기
+void history_rollup_close(history_rollup_t *rollup);
+
+// 샘플 반영 (유효 샘플만, 단계마다 현재 구간 갱신 또는 새 구간 시작)
+void history_rollup_add(history_rollup_t *rollup, const sensor_sample_t *sample);
+
+// 단계 정보
+uint32_t history_rollup_seconds(rollup_level_t level);
+uint32_t history_rollup_count(const history_rollup_t *rollup, rollup_level_t level);
+
+// 단계의 i번째로 오래된 구간 (0 = 가장 오래됨)
+const rollup_bucket_t *history_rollup_get(const history_rollup_t *rollup,
+                                          rollup_level_t level, uint32_t i);
+
+// [from, to) 구간(epoch 초)을 width개 열로 요약해 out에 채움.
+// 열 폭(= (to - from) / width)보다 길지 않은 가장 거친 단계를 고르고, 열 폭이
+// 1분보다 짧으면 raw 샘플을 직접 요약합니다 (raw = NULL이면 1분 단계).
+// 고른 단계가 from까지 거슬러 가지 못하면 더 거친 단계로 넘어갑니다.
+// 반환: 사용한 구간 길이(초, raw는 0), 잘못된 인자는 -1
+int history_rollup_query(const history_rollup_t *rollup, const history_store_t *raw,
+                         uint32_t from, uint32_t to, rollup_point_t *out, unsigned width);
+
+#endif // HISTORY_ROLLUP_H
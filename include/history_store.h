@@ -0,0 +1,84 @@
+#ifndef HISTORY_STORE_H
+#define HISTORY_STORE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <time.h>
+#include "sensor_sample.h"
+
+// 센서 이력 저장소: 미리 할당한 고정 크기 링 파일을 mmap해 12바이트 샘플을
+// 이어 씁니다. 추가는 메모리 복사 한 번(할당/시스템 콜 없음)이고, 내구성은
+// 샘플 수/시간 단위로 묶어 커밋합니다 (SD 카드 쓰기 횟수 절감).
+//
+// 파일 구성: [헤더 슬롯 A (1페이지)][헤더 슬롯 B (1페이지)][샘플 x capacity]
+//            [샘플별 CRC-32 x capacity]
+// 커밋 = 데이터 msync → 다른 헤더 슬롯에 seq+1, CRC로 기록 → msync.
+// 헤더를 쓰다 전원이 끊겨도 이전 슬롯이 유효하고, 마지막 커밋 이후 추가된
+// 샘플은 열 때 샘플 CRC와 시각 순서를 확인하며 복구합니다.
+// (CRC를 샘플 밖에 두는 이유: 읽는 쪽이 12바이트 샘플 배열을 그대로 전송)
+
+#define HISTORY_STORE_DEFAULT_PATH      "/var/lib/smart_env_monitor/history.ring"
+#define HISTORY_STORE_DEFAULT_CAPACITY  201600  // 3초 간격 7일 (≈2.3MB)
+#define HISTORY_STORE_BATCH_SAMPLES     100     // 이만큼 쌓이면 커밋
+#define HISTORY_STORE_BATCH_INTERVAL_S  300     // 또는 이 시간이 지나면 커밋
+
+#define HISTORY_STORE_MAGIC     0x48495354      // "HIST"
+#define HISTORY_STORE_VERSION   2       // 2: 샘플별 CRC 영역 추가
+
+// 디스크 헤더 (각 슬롯 맨 앞)
+typedef struct __attribute__((packed)) {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t record_size;       // sizeof(sensor_sample_t)
+    uint32_t capacity;          // 샘플 슬롯 수
+    uint32_t head;              // 다음에 쓸 슬롯
+    uint32_t count;             // 유효 샘플 수 (tail = head - count)
+    uint32_t reserved;
+    uint64_t seq;               // 커밋 번호 (큰 쪽이 최신)
+    uint32_t crc;               // 앞 필드 전체의 CRC-32
+} history_header_t;
+
+typedef struct {
+    int fd;
+    uint8_t *map;
+    size_t map_size;
+    sensor_sample_t *records;
+    uint32_t *crcs;             // records[i]의 CRC-32 (복구 시 찢긴 기록 검출)
+    history_header_t hdr;       // 메모리상 현재 상태 (커밋 전)
+    uint32_t committed_head;    // 마지막 커밋 시점 head
+    uint32_t pending;           // 커밋 안 된 샘플 수
+    uint64_t appended;          // 연 뒤로 추가한 샘플 수 (읽는 쪽의 덮어쓰기 감지용)
+    int next_slot;              // 다음 커밋이 쓸 헤더 슬롯
+    struct timespec last_commit;
+} history_store_t;
+
+// CRC-32 (IEEE 802.3) - 이력 헤더/샘플, 아카이브 헤더 검증용
+uint32_t history_crc32(const void *data, size_t len);
+
+// 열기 (없으면 capacity 크기로 만들고, 있으면 기존 capacity 사용)
+int history_store_open(history_store_t *store, const char *path, uint32_t capacity);
+
+// 커밋 후 닫기
+void history_store_close(history_store_t *store);
+
+// 샘플 추가. 시각이 직전 샘플보다 이르면 직전 시각으로 맞춰 순서를 유지.
+// 배치 조건을 채우면 커밋까지 수행 (반환: 0 성공, -1 커밋 실패)
+int history_store_append(history_store_t *store, const sensor_sample_t *sample);
+
+// 커밋 안 된 샘플을 디스크에 반영
+int history_store_commit(history_store_t *store);
+
+// 저장된 샘플 수
+uint32_t history_store_count(const history_store_t *store);
+
+// i번째로 오래된 샘플 (0 = 가장 오래됨, 복사 없이 맵 안을 가리킴)
+const sensor_sample_t *history_store_get(const history_store_t *store, uint32_t i);
+
+// 시각(ms)이 from_ms 이상인 첫 샘플 위치 (이분 탐색, 없으면 count)
+uint32_t history_store_lower_bound(const history_store_t *store, int64_t from_ms);
+
+// [from_ms, to_ms) 구간 샘플을 out에 최대 max개 복사 (반환: 복사한 개수)
+size_t history_store_query(const history_store_t *store, int64_t from_ms, int64_t to_ms,
+                           sensor_sample_t *out, size_t max);
+
+#endif // HISTORY_STORE_H
@@ -0,0 +1,51 @@
+#ifndef I2C_STATS_H
+#define I2C_STATS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <time.h>
+
+// I2C 트랜잭션 카운터 + 지연 히스토그램 (DS1307 레지스터 접근, OLED 전송)
+//
+// 지연은 시스템 콜 하나(write/read/ioctl) 기준이며, 드라이버가 그 안에서
+// 버스 전송을 끝내고 돌아오므로 실제 버스 시간 + 커널 오버헤드입니다.
+// 버킷 경계는 100kHz에서 레지스터 몇 바이트(~1ms)부터 400kHz OLED 전체
+// 프레임(~25ms)까지 나뉘도록 골랐습니다.
+
+#define I2C_HIST_BUCKETS    10      // 유한 경계 수 (+Inf 버킷 별도)
+
+static const uint32_t i2c_hist_bounds_us[I2C_HIST_BUCKETS] = {
+    100, 250, 500, 1000, 2500, 5000, 10000, 25000, 50000, 100000
+};
+
+typedef struct {
+    uint64_t transactions;
+    uint64_t errors;
+    uint64_t bytes;                         // 성공한 트랜잭션의 전송 바이트
+    uint64_t latency_sum_ns;
+    uint64_t buckets[I2C_HIST_BUCKETS + 1]; // 누적 아님, 마지막은 +Inf
+} i2c_stats_t;
+
+static inline uint64_t i2c_stats_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+// 트랜잭션 하나 기록 (start_ns는 i2c_stats_now_ns()로 잰 시작 시각)
+static inline void i2c_stats_record(i2c_stats_t *st, uint64_t start_ns, size_t bytes, int ok) {
+    uint64_t ns = i2c_stats_now_ns() - start_ns;
+    int b = 0;
+
+    while (b < I2C_HIST_BUCKETS && ns > (uint64_t)i2c_hist_bounds_us[b] * 1000) b++;
+    st->buckets[b]++;
+    st->transactions++;
+    st->latency_sum_ns += ns;
+    if (ok) {
+        st->bytes += bytes;
+    } else {
+        st->errors++;
+    }
+}
+
+#endif // I2C_STATS_H
@@ -0,0 +1,61 @@
+#ifndef METRICS_SERVER_H
+#define METRICS_SERVER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <pthread.h>
+#include "env_snapshot.h"
+
+// Prometheus/OpenMetrics 수집 엔드포인트 (HTTP GET /metrics)
+//
+// 자체 스레드에서 epoll로 돌며, 데이터는 공유 메모리 스냅샷(seqlock)에서만
+// 읽으므로 센서/화면 루프와 잠금을 공유하지 않습니다 - 수집기가 느리거나
+// 멈춰도 게시 쪽은 기다리지 않습니다.
+// 응답은 연결마다 미리 잡아 둔 버퍼에 직접 렌더링하며 수집 한 번에
+// 할당이 없습니다 (숫자 포맷도 정수 연산만 사용).
+
+#define METRICS_SERVER_DEFAULT_ADDR     "127.0.0.1"
+#define METRICS_SERVER_DEFAULT_PORT     9464
+#define METRICS_SERVER_MAX_CLIENTS      8
+#define METRICS_REQUEST_BUF             2048    // 요청 헤더 최대
+#define METRICS_RESPONSE_BUF            16384   // HTTP 헤더 + 본문
+#define METRICS_ROOM_LEN                48      // room 레이블 (이스케이프 후)
+
+typedef struct {
+    int fd;                     // -1 = 빈 슬롯
+    uint32_t in_len;
+    uint32_t out_off;
+    uint32_t out_len;
+    int close_after;            // 응답 후 닫기 (Connection: close)
+    int peer_closed;            // 상대가 쓰기를 닫음 (남은 요청만 응답)
+    char in[METRICS_REQUEST_BUF];
+    char out[METRICS_RESPONSE_BUF];
+} metrics_conn_t;
+
+typedef struct {
+    int listen_fd;
+    int epoll_fd;
+    int wake_fd;                // 종료 알림 (eventfd)
+    pthread_t thread;
+    int started;
+    char snapshot_name[64];
+    env_snapshot_reader_t reader;   // 게시자가 늦게 뜨면 수집 때 다시 열어 봄
+    uint64_t last_open_ns;          // 마지막 열기 시도 (CLOCK_MONOTONIC)
+    char room[METRICS_ROOM_LEN];    // 이스케이프한 레이블 값
+    uint64_t scrapes;
+    uint64_t scrape_errors;
+    metrics_conn_t conns[METRICS_SERVER_MAX_CLIENTS];
+} metrics_server_t;
+
+// 수신 소켓을 열고 스레드 시작 (snapshot_name: 읽을 공유 메모리 이름)
+int metrics_server_start(metrics_server_t *ms, const char *bind_addr, uint16_t port,
+                         const char *snapshot_name, const char *room);
+
+// 스레드를 멈추고 정리
+void metrics_server_stop(metrics_server_t *ms);
+
+// OpenMetrics 본문 렌더링 (snap NULL = 게시 전). 반환: 길이, 0 = 버퍼 부족
+size_t metrics_render(char *buf, size_t cap, const env_snapshot_t *snap, const char *room,
+                      uint64_t scrapes);
+
+#endif // METRICS_SERVER_H
@@ -0,0 +1,95 @@
+#ifndef NODE_PROTOCOL_H
+#define NODE_PROTOCOL_H
+
+#include <stdint.h>
+#include "sensor_sample.h"
+#include "history_index.h"
+
+// 여러 모니터 → 집계 서버 TCP 프로토콜 (리틀 엔디언 고정 크기 바이너리)
+//
+// 모든 메시지 = node_frame_t 헤더 8바이트 + len 바이트
+//   노드 → 서버   HELLO (node_hello_t) 한 번, 이후 SAMPLES (sensor_sample_t x n)
+//   질의 → 서버   LIST / RANGE / SUMMARY / STATS 요청, 같은 type으로 응답
+// 응답 헤더의 status가 NODE_OK가 아니면 페이로드 없음.
+// 노드는 재접속 후 보냈는지 모르는 샘플을 다시 보내고, 서버는 노드별로
+// 마지막 샘플 시각 이하인 샘플을 버려 중복을 없앱니다.
+
+#define NODE_PROTOCOL_MAGIC     0x4E53      // "SN"
+#define NODE_DEFAULT_PORT       7070
+#define NODE_ROOM_LEN           24          // NUL 포함
+#define NODE_MAX_BATCH          256         // SAMPLES 프레임 하나의 최대 샘플 수
+
+#define NODE_MSG_HELLO          1
+#define NODE_MSG_SAMPLES        2
+#define FLEET_MSG_LIST          3
+#define FLEET_MSG_RANGE         4
+#define FLEET_MSG_SUMMARY       5
+#define FLEET_MSG_STATS         6
+
+#define NODE_OK                 0
+#define NODE_ERR_BAD_REQUEST    1
+#define NODE_ERR_NO_NODE        2
+
+typedef struct __attribute__((packed)) {
+    uint16_t magic;             // NODE_PROTOCOL_MAGIC
+    uint8_t type;               // NODE_MSG_* / FLEET_MSG_*
+    uint8_t status;             // 응답만 사용 (NODE_OK / NODE_ERR_*)
+    uint32_t len;               // 뒤따르는 바이트 수
+} node_frame_t;
+
+typedef struct __attribute__((packed)) {
+    uint32_t node_id;           // 0은 사용 불가
+    char room[NODE_ROOM_LEN];   // 표시용 방 이름
+} node_hello_t;
+
+// LIST 응답 항목
+typedef struct __attribute__((packed)) {
+    uint32_t node_id;
+    char room[NODE_ROOM_LEN];
+    uint8_t connected;
+    uint8_t reserved[3];
+    uint32_t sample_count;      // 보관 중인 샘플 수
+    sensor_sample_t latest;
+} fleet_node_info_t;
+
+// RANGE 요청 (응답: sensor_sample_t x n, 시각 순)
+typedef struct __attribute__((packed)) {
+    uint32_t node_id;
+    uint32_t from;              // epoch 초 [from, to)
+    uint32_t to;
+    uint32_t max;               // 0 = 제한 없음
+} fleet_range_req_t;
+
+// SUMMARY 요청 (응답: fleet_summary_t)
+typedef struct __attribute__((packed)) {
+    uint32_t from;
+    uint32_t to;
+} fleet_summary_req_t;
+
+typedef struct __attribute__((packed)) {
+    uint32_t nodes;             // 등록된 노드
+    uint32_t nodes_connected;
+    uint32_t nodes_reporting;   // 구간 안에 유효 샘플이 있는 노드
+    uint32_t warmest_node;      // 구간 평균 온도가 가장 높은/낮은 노드
+    uint32_t coldest_node;
+    uint32_t reserved;
+    history_agg_t agg;          // 전체 노드 합산 (유효 샘플만)
+} fleet_summary_t;
+
+// STATS 응답
+typedef struct __attribute__((packed)) {
+    uint32_t nodes;
+    uint32_t nodes_connected;
+    uint32_t clients;           // 노드 + 질의 연결
+    uint32_t reserved;
+    uint64_t frames;
+    uint64_t samples;           // 저장한 샘플
+    uint64_t samples_dropped;   // 중복/역행으로 버린 샘플
+    uint64_t bytes_in;
+    uint64_t store_bytes;       // 노드별 시계열 메모리 합계
+} fleet_stats_t;
+
+_Static_assert(sizeof(node_frame_t) == 8, "node_frame_t must be 8 bytes");
+_Static_assert(sizeof(node_hello_t) == 28, "node_hello_t must be 28 bytes");
+
+#endif // NODE_PROTOCOL_H
@@ -0,0 +1,59 @@
+#ifndef NODE_UPLINK_H
+#define NODE_UPLINK_H
+
+#include <stdint.h>
+#include <netinet/in.h>
+#include "node_protocol.h"
+
+// 집계 서버로 샘플 올리기 (모니터 쪽 TCP 클라이언트)
+//
+// 메인 루프에서 node_uplink_poll()을 부르면 연결/재접속/전송을 한 단계씩
+// 진행하며 절대 기다리지 않습니다 (논블로킹 connect, MSG_DONTWAIT).
+// 끊긴 동안 샘플은 큐에 쌓였다가 재접속하면 HELLO 뒤에 이어서 보내고,
+// 큐가 가득 차면 가장 오래된 샘플부터 버립니다.
+// 샘플은 프레임이 소켓에 다 들어간 뒤에야 큐에서 빠지므로 전송 중 끊기면
+// 다시 보내며, 중복은 서버가 시각으로 걸러냅니다.
+
+#define NODE_UPLINK_QUEUE           1024    // 3초 간격 약 50분
+#define NODE_UPLINK_RETRY_MIN_MS    1000
+#define NODE_UPLINK_RETRY_MAX_MS    60000
+
+#define NODE_UPLINK_DOWN            0
+#define NODE_UPLINK_CONNECTING      1
+#define NODE_UPLINK_UP              2
+
+typedef struct {
+    int fd;
+    int state;                  // NODE_UPLINK_*
+    struct sockaddr_in addr;
+    node_hello_t hello;
+    // 보낼 샘플 큐 (가장 오래된 것이 head)
+    sensor_sample_t queue[NODE_UPLINK_QUEUE];
+    uint32_t head;
+    uint32_t count;
+    uint32_t inflight;          // out에 실린 큐 앞쪽 샘플 수
+    // 보내는 중인 프레임
+    uint8_t out[2 * sizeof(node_frame_t) + sizeof(node_hello_t) +
+                NODE_MAX_BATCH * sizeof(sensor_sample_t)];
+    uint32_t out_off;
+    uint32_t out_len;
+    uint32_t retry_ms;          // 다음 재접속 대기 (지수 증가)
+    int64_t next_retry_ms;      // CLOCK_MONOTONIC
+    uint64_t samples_sent;
+    uint64_t samples_dropped;   // 큐가 넘쳐 버린 샘플
+    uint32_t connects;
+} node_uplink_t;
+
+// 서버 주소 해석 후 준비 (연결은 poll에서). host는 IPv4 주소 또는 이름
+int node_uplink_open(node_uplink_t *u, const char *host, uint16_t port,
+                     uint32_t node_id, const char *room);
+
+void node_uplink_close(node_uplink_t *u);
+
+// 샘플 큐에 추가 (전송은 poll에서)
+void node_uplink_append(node_uplink_t *u, const sensor_sample_t *sample);
+
+// 연결/전송 한 단계 진행 (기다리지 않음, 반환: 현재 상태)
+int node_uplink_poll(node_uplink_t *u);
+
+#endif // NODE_UPLINK_H
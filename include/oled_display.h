@@ -2,6 +2,7 @@
 #define OLED_DISPLAY_H
 
 #include "smart_env_monitor.h"
+#include "sensor_sample.h"
 
 // OLED 디스플레이 설정
 #define OLED_WIDTH        128
@@ -30,7 +31,7 @@ int oled_write_command(unsigned char cmd);
 int oled_write_data(unsigned char data);
 int oled_set_cursor(int x, int y);
 int oled_print_string(const char *str);
-int oled_display_sensor_data(const sensor_data_t *data, display_mode_t mode);
+int oled_display_sensor_data(const sensor_sample_t *data, display_mode_t mode);
 
 // 폰트 및 그래픽
 int oled_draw_pixel(int x, int y);
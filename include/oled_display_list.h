@@ -0,0 +1,32 @@
+#ifndef OLED_DISPLAY_LIST_H
+#define OLED_DISPLAY_LIST_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "oled_ioctl.h"
+#include "i2c_stats.h"
+
+// 사용자 공간 디스플레이 리스트 빌더 (OLED_IOC_SUBMIT 용)
+typedef struct {
+    uint8_t buf[OLED_DL_MAX_BYTES];
+    size_t len;
+    int overflow;   // 버퍼 초과 시 1, 이후 제출은 실패
+} oled_dl_t;
+
+void oled_dl_reset(oled_dl_t *dl);
+int oled_dl_clear(oled_dl_t *dl, int x, int y, int w, int h, int on);
+int oled_dl_text(oled_dl_t *dl, int x, int y, const char *text);
+int oled_dl_blit(oled_dl_t *dl, int x, int y, int w, int h, const uint8_t *bits);
+int oled_dl_contrast(oled_dl_t *dl, int contrast);
+int oled_dl_invert(oled_dl_t *dl, int invert);
+
+// 리스트 전체를 ioctl 한 번으로 제출
+int oled_dl_submit(int fd, const oled_dl_t *dl);
+
+// 텍스트 화면을 write() 한 번으로 전송 (드라이버가 바뀐 글자 셀만 I2C로 보냄)
+int oled_write_text(int fd, const char *text, size_t len);
+
+// 제출/전송 통계 (시스템 콜 하나 = 드라이버 안에서 끝나는 I2C 전송 묶음)
+void oled_get_i2c_stats(i2c_stats_t *out);
+
+#endif // OLED_DISPLAY_LIST_H
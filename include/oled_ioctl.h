@@ -2,16 +2,111 @@
 #define OLED_IOCTL_H
 
 #include <linux/ioctl.h>
+#include <linux/types.h>
 
 #define OLED_IOC_MAGIC 'o'
 
+// 패널별 디바이스 노드: /dev/oled_display0..N (0x3C, 0x3D 순으로 할당)
+#define OLED_DEVICE_PATH    "/dev/oled_display0"
+
+/*
+ * 디스플레이 리스트 (OLED_IOC_SUBMIT)
+ *
+ * 화면 하나를 구성하는 그리기 명령들을 한 버퍼에 이어 붙여 한 번에
+ * 제출합니다. 드라이버는 명령을 순서대로 프레임 버퍼에 실행한 뒤
+ * 바뀐 구간만 한 번에 전송합니다 (syscall 1회, 복사 1회, 버스 전송 1회).
+ *
+ * 각 명령 = struct oled_op 헤더 + len 바이트 페이로드 (정렬 패딩 없음)
+ *   OLED_OP_CLEAR    x, y, w, h 영역을 arg(0=지움, 1=채움)로 칠함
+ *   OLED_OP_TEXT     (x, y)에 6x8 텍스트, 페이로드 = 문자들
+ *   OLED_OP_BLIT     (x, y)에 w x h 비트맵, 페이로드 = 페이지 형식 열 데이터
+ *                    (w * ceil(h/8) 바이트, 위쪽 8줄부터 행 우선)
+ *   OLED_OP_CONTRAST arg = 명암 (0~255)
+ *   OLED_OP_INVERT   arg = 1 반전, 0 정상
+ * 명암/반전은 프레임 전송이 끝난 뒤 적용됩니다.
+ */
+#define OLED_OP_CLEAR       1
+#define OLED_OP_TEXT        2
+#define OLED_OP_BLIT        3
+#define OLED_OP_CONTRAST    4
+#define OLED_OP_INVERT      5
+
+#define OLED_DL_MAX_BYTES   2048
+
+struct oled_op {
+    __u8  opcode;
+    __u8  x;
+    __u8  y;
+    __u8  w;
+    __u8  h;
+    __u8  arg;
+    __u16 len;      // 헤더 뒤 페이로드 바이트 수
+};
+
+struct oled_display_list {
+    __u64 ops;      // 사용자 버퍼 주소 (struct oled_op 스트림)
+    __u32 len;      // 전체 바이트 수 (<= OLED_DL_MAX_BYTES)
+    __u32 reserved; // 0
+};
+
+/*
+ * 하드웨어 스크롤 (OLED_IOC_SCROLL)
+ *
+ * 컨트롤러가 스스로 화면을 미는 연속 스크롤입니다. 설정 후에는 I2C 전송
+ * 없이 움직이므로 긴 방 이름 티커 등에 씁니다. 수평 스크롤은 해당 페이지
+ * 128열을 원형으로 회전시키고, 대각 스크롤은 vertical_offset 줄씩 함께
+ * 내려갑니다 (fixed_rows/scroll_rows = 수직 스크롤 영역, 0/0이면 전체).
+ * 스크롤 중인 페이지에 그리면 드라이버가 잠시 멈추고 다시 쓴 뒤 재시작합니다.
+ */
+#define OLED_SCROLL_RIGHT       0x26
+#define OLED_SCROLL_LEFT        0x27
+#define OLED_SCROLL_DIAG_RIGHT  0x29
+#define OLED_SCROLL_DIAG_LEFT   0x2A
+
+struct oled_scroll {
+    __u8 mode;              // OLED_SCROLL_*
+    __u8 start_page;        // 0~7
+    __u8 end_page;          // start_page~7
+    __u8 interval;          // 스텝 간격 코드 0~7 (7 = 2프레임, 가장 빠름)
+    __u8 vertical_offset;   // 대각 전용, 1~63
+    __u8 fixed_rows;        // 대각 전용, 위쪽 고정 줄 수
+    __u8 scroll_rows;       // 대각 전용, 스크롤 줄 수
+    __u8 reserved;          // 0
+};
+
+/*
+ * 텍스트 셀 (write(), OLED_IOC_TEXT)
+ *
+ * 드라이버는 21열 x 8줄 글자 셀로 현재 화면을 기억합니다. write()로 보낸
+ * 자동 줄바꿈 텍스트나 OLED_IOC_TEXT의 부분 문자열은 기존 셀과 비교해
+ * 바뀐 글자 구간만 열 창(6바이트/글자)으로 전송합니다.
+ * 예: "HH:MM:SS" 화면은 초당 6~12바이트만 전송됩니다.
+ */
+#define OLED_TEXT_COLS      21
+#define OLED_TEXT_ROWS      8
+
+struct oled_text {
+    __u8 row;                   // 0~7
+    __u8 col;                   // 0~20
+    __u8 len;                   // 1~21, col + len <= 21
+    __u8 reserved;              // 0
+    char text[OLED_TEXT_COLS];  // NUL 종료 불필요
+};
+
 // ioctl 명령어 정의
+// fbdev=1로 올린 패널의 /dev/fbN(또는 fbcon)이 열려 있는 동안에는 프레임을
+// 그리는 write()와 CLEAR/SUBMIT/SCROLL/SCROLL_STOP/TEXT가 -EBUSY로 거절됩니다.
 #define OLED_IOC_INIT       _IO(OLED_IOC_MAGIC, 1)
 #define OLED_IOC_CLEAR      _IO(OLED_IOC_MAGIC, 2)
 #define OLED_IOC_ON         _IO(OLED_IOC_MAGIC, 3)
 #define OLED_IOC_OFF        _IO(OLED_IOC_MAGIC, 4)
 #define OLED_IOC_CONTRAST   _IOW(OLED_IOC_MAGIC, 5, int)
+#define OLED_IOC_SUBMIT     _IOW(OLED_IOC_MAGIC, 6, struct oled_display_list)
+#define OLED_IOC_SCROLL     _IOW(OLED_IOC_MAGIC, 7, struct oled_scroll)
+#define OLED_IOC_SCROLL_STOP _IO(OLED_IOC_MAGIC, 8)
+#define OLED_IOC_START_LINE _IOW(OLED_IOC_MAGIC, 9, int)   // 0~63
+#define OLED_IOC_TEXT       _IOW(OLED_IOC_MAGIC, 10, struct oled_text)
 
-#define OLED_IOC_MAXNR 5
+#define OLED_IOC_MAXNR 10
 
 #endif
@@ -4,19 +4,54 @@
 #include <linux/i2c.h>
 #include <linux/types.h>
 
+// 패널 기하 정보 (128x64, 페이지 = 세로 8픽셀)
+#define SSD1306_WIDTH        128
+#define SSD1306_HEIGHT       64
+#define SSD1306_PAGES        (SSD1306_HEIGHT / 8)
+#define SSD1306_GLYPH_WIDTH  6
+#define SSD1306_TEXT_COLS    (SSD1306_WIDTH / SSD1306_GLYPH_WIDTH)  // 21
+
+// 페이지 형식 프레임: frame[page][column], bit0 = 페이지 맨 윗줄
+typedef u8 ssd1306_frame_t[SSD1306_PAGES][SSD1306_WIDTH];
+
 // 기본 OLED 제어 함수
 int ssd1306_init_display(struct i2c_client *client);
 int ssd1306_clear_display(struct i2c_client *client);
 int ssd1306_display_on(struct i2c_client *client);
 int ssd1306_display_off(struct i2c_client *client);
 int ssd1306_set_contrast(struct i2c_client *client, u8 contrast);
+int ssd1306_write_window(struct i2c_client *client,
+                         int page, int col,
+                         const u8 *data, int len);
+int ssd1306_set_invert(struct i2c_client *client, bool invert);
+
+// 하드웨어 스크롤 / 시작 줄
+int ssd1306_start_scroll(struct i2c_client *client, u8 opcode,
+                         u8 start_page, u8 end_page,
+                         u8 interval, u8 vertical_offset);
+int ssd1306_stop_scroll(struct i2c_client *client);
+int ssd1306_set_vertical_area(struct i2c_client *client,
+                              u8 fixed_rows, u8 scroll_rows);
+int ssd1306_set_start_line(struct i2c_client *client, u8 line);
 
 // 텍스트 렌더링 함수
 int ssd1306_render_text(struct i2c_client *client, const char *text, int page);
+void ssd1306_glyph_columns(char c, u8 cols[SSD1306_GLYPH_WIDTH]);
+void ssd1306_draw_text_page(u8 *page_buf, const char *text);
 
 // --- 추가된 부분: 자동 줄바꿈 렌더링 함수 선언 ---
 int ssd1306_render_auto_wrapped(struct i2c_client *client, const char *text);
 
+// 프레임 버퍼 그리기 함수 (I2C 전송 없음)
+void ssd1306_fb_fill_rect(ssd1306_frame_t frame, int x, int y,
+                          int w, int h, int on);
+void ssd1306_fb_draw_text(ssd1306_frame_t frame, int x, int y,
+                          const char *text, int len);
+void ssd1306_fb_blit(ssd1306_frame_t frame, int x, int y,
+                     int w, int h, const u8 *bits);
+void ssd1306_text_layout(const char *text,
+                         char cells[SSD1306_PAGES][SSD1306_TEXT_COLS]);
+
 // --- 제거된 부분: 미사용 멀티라인 함수 선언 ---
 // int ssd1306_render_multiline(struct i2c_client *client, const char *lines[], int num_lines);
 
@@ -0,0 +1,173 @@
+#ifndef QUERY_SERVER_H
+#define QUERY_SERVER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "sensor_sample.h"
+#include "env_snapshot.h"
+#include "history_store.h"
+#include "history_index.h"
+
+// 로컬 질의/구독 서버 (Unix 도메인 소켓, epoll)
+//
+// 데몬 메인 루프에서 query_server_poll(timeout 0)로 돌리므로 스레드가 없고,
+// 이력 링/스냅샷을 잠금 없이 그대로 읽습니다. 연결마다 고정 버퍼를 미리
+// 할당해 두고(연결 중 malloc 없음), 범위 응답은 헤더 + mmap 링 구간을
+// sendmsg 한 번으로 보냅니다 (샘플 복사 없음, 링 끝에서 두 구간).
+//
+// 프로토콜 (리틀 엔디언 고정 크기 바이너리):
+//   요청 16바이트 qs_request_t
+//   응답 qs_response_t 헤더 + payload_len 바이트 (요청 순서대로, 파이프라이닝 가능)
+//     LATEST      → 샘플 1개
+//     RANGE       → [arg0, arg1) 초 구간 샘플 (arg2 = 최대 개수, 0 = 제한 없음)
+//     SUMMARY     → [arg0, arg1) 초 구간 qs_summary_t (구간 집계 색인, 원본을 훑지 않음)
+//     STATUS      → qs_status_t
+//     SUBSCRIBE   → 빈 응답 후 새 샘플마다 PUSH (arg0 = N개마다 1개, arg1 = 최소 간격 ms)
+//     UNSUBSCRIBE → 빈 응답
+//     (구독 중) ALERT → 경보 발생/해제마다 qs_alert_t (합치지 않고 순서대로)
+// 범위 응답을 보내는 동안 생긴 PUSH, 느린 구독자에게 쌓일 PUSH는 최신 샘플
+// 하나로 합쳐 나중에 보냅니다 (서버는 어떤 클라이언트도 기다리지 않음).
+// 경보는 합칠 수 없으므로 서버의 최근 경보 링에서 연결마다 어디까지 보냈는지만
+// 기억하고, 링보다 더 밀린 구독자는 오래된 경보를 건너뜁니다.
+
+#define QUERY_SERVER_DEFAULT_PATH   "/run/smart_env_monitor.sock"
+#define QUERY_SERVER_MAX_CLIENTS    512
+#define QUERY_SERVER_IN_BUF         64      // 요청 4개분
+#define QUERY_SERVER_OUT_BUF        512     // 헤더/PUSH 대기열
+#define QUERY_SERVER_WRITE_CHUNK    65536   // sendmsg 한 번에 보낼 최대 범위 바이트
+#define QUERY_SERVER_ALERT_RING     16      // 구독자별로 밀려도 보관하는 최근 경보 수
+
+#define QS_OP_LATEST        1
+#define QS_OP_RANGE         2
+#define QS_OP_STATUS        3
+#define QS_OP_SUBSCRIBE     4
+#define QS_OP_UNSUBSCRIBE   5
+#define QS_OP_PUSH          6
+#define QS_OP_ALERT         7
+#define QS_OP_SUMMARY       8
+
+#define QS_OK               0
+#define QS_ERR_BAD_REQUEST  1
+#define QS_ERR_NO_DATA      2
+
+typedef struct __attribute__((packed)) {
+    uint8_t op;                 // QS_OP_*
+    uint8_t reserved[3];
+    uint32_t arg0;
+    uint32_t arg1;
+    uint32_t arg2;
+} qs_request_t;
+
+typedef struct __attribute__((packed)) {
+    uint8_t op;                 // 요청 op 또는 QS_OP_PUSH
+    uint8_t status;             // QS_OK / QS_ERR_*
+    uint16_t reserved;
+    uint32_t count;             // 샘플 수 (STATUS는 1)
+    uint32_t payload_len;       // 뒤따르는 바이트 수
+} qs_response_t;
+
+typedef struct __attribute__((packed)) {
+    uint32_t clients;
+    uint32_t subscribers;
+    uint32_t history_count;     // 링에 보관 중인 샘플 수
+    uint32_t uptime_s;
+    uint8_t temp_level;
+    uint8_t humi_level;
+    uint8_t overall_level;
+    uint8_t prolonged_warning;
+    uint32_t warning_elapsed_s;
+    uint32_t reads_ok;
+    uint32_t reads_failed;
+    uint64_t pushes_sent;
+    uint64_t pushes_coalesced;
+} qs_status_t;
+
+// 구간 집계 (유효 샘플만, count 0이면 나머지는 0)
+typedef struct __attribute__((packed)) {
+    uint32_t count;
+    int16_t temp_min;           // 0.01°C
+    int16_t temp_max;
+    int16_t temp_mean;
+    uint16_t humi_min;          // 0.01%
+    uint16_t humi_max;
+    uint16_t humi_mean;
+} qs_summary_t;
+
+// 경보 발생/해제 (alert_rules.h 이벤트의 전송 형식)
+typedef struct __attribute__((packed)) {
+    uint32_t time;              // epoch 초 (UTC)
+    int32_t value;              // 평가한 값 (0.01 단위)
+    uint16_t rule;              // 규칙 번호
+    uint8_t active;             // 1 발생, 0 해제
+    uint8_t reserved;
+    char name[24];              // 규칙 이름 (NUL 종료)
+} qs_alert_t;
+
+_Static_assert(sizeof(qs_alert_t) == 36, "qs_alert_t must be 36 bytes");
+_Static_assert(sizeof(qs_summary_t) == 16, "qs_summary_t must be 16 bytes");
+_Static_assert(sizeof(qs_request_t) == 16, "qs_request_t must be 16 bytes");
+_Static_assert(sizeof(qs_response_t) == 12, "qs_response_t must be 12 bytes");
+
+typedef struct {
+    int fd;                     // -1 = 빈 슬롯
+    uint8_t in[QUERY_SERVER_IN_BUF];
+    uint32_t in_len;
+    uint8_t out[QUERY_SERVER_OUT_BUF];
+    uint32_t out_off;           // out에서 이미 보낸 바이트
+    uint32_t out_len;
+    // 진행 중인 범위 응답 (물리 슬롯 기준)
+    uint32_t range_slot;
+    uint32_t range_left;        // 남은 샘플 수
+    uint32_t range_byte;        // 현재 샘플에서 이미 보낸 바이트
+    int64_t range_seq;          // 현재 샘플의 추가 번호 (history appended 기준, 덮어쓰기 감지)
+    // 구독
+    uint8_t subscribed;
+    uint8_t push_pending;       // 합쳐 둔 최신 PUSH 있음
+    uint16_t reserved;
+    uint32_t events;            // 현재 epoll 등록 이벤트
+    uint32_t every_n;
+    uint32_t skip;              // every_n 간격 계산용
+    uint32_t min_interval_ms;
+    int64_t last_push_ms;       // CLOCK_MONOTONIC
+    uint32_t alert_seq;         // 다음에 보낼 경보 번호
+} qs_conn_t;
+
+typedef struct {
+    int listen_fd;
+    int epoll_fd;
+    const history_store_t *history;     // NULL이면 RANGE/SUMMARY 불가
+    history_index_t index;              // SUMMARY용 (첫 요청 때 구성, 이후 질의 직전 반영)
+    int index_ready;
+    env_snapshot_t latest;
+    int have_latest;
+    uint32_t clients;
+    uint32_t subscribers;
+    uint64_t pushes_sent;
+    uint64_t pushes_coalesced;
+    qs_alert_t alerts[QUERY_SERVER_ALERT_RING];     // 최근 경보 (alert_seq % 링 크기)
+    uint32_t alert_seq;                             // 지금까지 낸 경보 수
+    uint64_t alerts_sent;
+    uint64_t alerts_skipped;                        // 너무 밀린 구독자가 건너뛴 경보
+    uint64_t ranges_aborted;                        // 보내는 중 링이 덮어써 끊은 범위 응답
+    struct timespec started;
+    char path[108];
+    uint32_t free_count;
+    uint16_t free_slots[QUERY_SERVER_MAX_CLIENTS];     // 빈 연결 슬롯 스택
+    qs_conn_t conns[QUERY_SERVER_MAX_CLIENTS];
+} query_server_t;
+
+// 소켓 생성/바인드 (기존 소켓 파일은 지움). history는 NULL 가능
+int query_server_open(query_server_t *srv, const char *path, const history_store_t *history);
+
+void query_server_close(query_server_t *srv);
+
+// 대기 중인 이벤트 처리 (timeout_ms 0 = 기다리지 않음, 반환: 처리한 이벤트 수, -1 오류)
+int query_server_poll(query_server_t *srv, int timeout_ms);
+
+// 최신 상태 갱신. 샘플이 바뀌었으면 구독자에게 PUSH (간격 조건 충족 시)
+void query_server_update(query_server_t *srv, const env_snapshot_t *snap);
+
+// 경보를 구독자 모두에게 보냄 (순서 보장, 합치지 않음)
+void query_server_alert(query_server_t *srv, const qs_alert_t *alert);
+
+#endif // QUERY_SERVER_H
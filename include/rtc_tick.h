@@ -0,0 +1,33 @@
+#ifndef RTC_TICK_H
+#define RTC_TICK_H
+
+#include <gpiod.h>
+#include <time.h>
+
+// 이 틱 수마다 RTC를 다시 읽어 놓친 에지를 보정 (1시간)
+#define RTC_TICK_RESYNC_TICKS  3600
+
+// 이 시간 동안 에지가 없으면 SQW 배선 없음/끊김으로 보고 오류 (풀업이 라인을 계속 high로 유지)
+#define RTC_TICK_WATCHDOG_MS   2000
+
+// DS1307 1Hz SQW 에지로 구동되는 소프트웨어 시계
+typedef struct {
+    struct gpiod_line *line;
+    struct tm now;              // 현재 시각 (RTC 기준, 틱마다 1초 증가)
+    unsigned long ticks;        // 누적 틱 수
+    int ticks_since_sync;
+    long long last_edge_ms;     // 마지막 에지 (초기화 시각으로 시작, CLOCK_MONOTONIC)
+} rtc_tick_t;
+
+int rtc_tick_init(rtc_tick_t *tick, int sqw_pin);
+void rtc_tick_cleanup(rtc_tick_t *tick);
+
+// 다음 초 경계(하강 에지)까지 최대 timeout_ms 대기
+// 반환: 지난 초 수(>0), 시간 초과 0, 오류 -1
+// RTC_TICK_WATCHDOG_MS 동안 에지가 없어도 -1 (errno = ETIMEDOUT) → 폴링으로 전환할 것
+int rtc_tick_wait(rtc_tick_t *tick, int timeout_ms);
+
+// struct tm을 1초 앞으로 (달력 라이브러리 호출 없음)
+void rtc_tick_advance(struct tm *tm);
+
+#endif // RTC_TICK_H
@@ -0,0 +1,59 @@
+#ifndef SAMPLE_CODEC_H
+#define SAMPLE_CODEC_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "sensor_sample.h"
+
+// 센서 샘플 블록 압축 (Gorilla 방식 변형)
+//
+// 블록 = 첫 샘플 원본 12바이트 + 이후 샘플의 비트 스트림
+//   시각 (ms)       delta-of-delta:  0 | 10+7비트 | 110+9비트 | 1110+12비트 | 1111+32비트
+//   온도/습도       직전 대비 delta:  0 | 10+4비트 | 110+8비트 | 1110+12비트 | 1111+17비트
+//   플래그          0 (같음) | 1+16비트
+// 가변 폭 필드는 모두 zigzag 부호화입니다. 센서 값은 천천히 변하므로
+// 일정 간격 + 값 변화 없음 샘플은 4비트로 줄어듭니다.
+
+#define SAMPLE_CODEC_HEADER_BYTES   12
+#define SAMPLE_CODEC_MAX_BITS       95      // 샘플 하나의 최대 비트 수 (4+32 + 2x(4+17) + 1+16)
+
+typedef struct {
+    uint8_t *buf;
+    size_t cap;
+    size_t len;             // 완성된 바이트 수
+    uint64_t acc;           // 아직 바이트로 내보내지 않은 비트
+    unsigned nbits;
+    uint16_t count;         // 블록에 들어간 샘플 수
+    sensor_sample_t prev;
+    int64_t prev_ms;
+    int64_t prev_delta_ms;
+} sample_encoder_t;
+
+typedef struct {
+    const uint8_t *buf;
+    size_t len;
+    size_t pos;             // 다음에 읽을 바이트
+    uint64_t window;        // 왼쪽 정렬 비트 창
+    unsigned nbits;
+    uint16_t remaining;
+    sensor_sample_t prev;
+    int64_t prev_ms;
+    int64_t prev_delta_ms;
+} sample_decoder_t;
+
+// 인코더: buf(cap 바이트)에 직접 기록 (할당 없음)
+void sample_encoder_init(sample_encoder_t *enc, uint8_t *buf, size_t cap);
+
+// 샘플 추가 (반환: 0 성공, -1 블록이 가득 참 → finish 후 새 블록)
+int sample_encoder_add(sample_encoder_t *enc, const sensor_sample_t *sample);
+
+// 남은 비트를 내보내고 블록 바이트 수 반환
+size_t sample_encoder_finish(sample_encoder_t *enc);
+
+// 디코더: count개 샘플이 든 블록을 순서대로 풀어냄
+void sample_decoder_init(sample_decoder_t *dec, const uint8_t *buf, size_t len, uint16_t count);
+
+// 다음 샘플 (반환: 1 있음, 0 끝, -1 손상된 블록)
+int sample_decoder_next(sample_decoder_t *dec, sensor_sample_t *out);
+
+#endif // SAMPLE_CODEC_H
@@ -0,0 +1,91 @@
+#ifndef SAMPLE_FILTER_H
+#define SAMPLE_FILTER_H
+
+#include <stdint.h>
+#include "sensor_sample.h"
+
+// 측정값 필터 (수집 → 필터 → 화면/판정/이력)
+//
+// 1) 이동 중앙값 이상치 제거: 최근 N개 창의 중앙값과 임계값 넘게 다르면
+//    그 값 대신 중앙값을 씀 (Hampel 방식). 원값은 창에 그대로 넣으므로
+//    실제 계단 변화는 창의 절반이 채워지면 통과합니다.
+// 2) 지수 평활: 시간 상수 tau 기준 α = dt / (tau + dt). 측정 간격이
+//    적응형 스케줄러로 3~60초 사이에서 바뀌어도 같은 시간 응답을 냅니다.
+// 3) 변화율 제한: 출력이 경과 시간당 허용 폭 넘게 움직이지 않게 자름.
+//
+// 창 크기가 고정(최대 9)이라 정렬 배열 갱신은 샘플당 상수 비용이고
+// 동적 할당이 없습니다. 시각은 호출자가 넘깁니다 (ms, 단조 시계).
+
+#define SAMPLE_FILTER_MAX_WINDOW  9
+
+// 필터 결과 표시 (sensor_sample_t.flags)
+#define SAMPLE_FLAG_FILTERED   0x0010  // 값이 필터 출력 (원값 아님)
+#define SAMPLE_FLAG_SUSPECT    0x0020  // 이상치 대체 또는 변화율 제한이 걸림
+
+typedef enum {
+    SAMPLE_QUALITY_GOOD = 0,    // 정상값 그대로 반영
+    SAMPLE_QUALITY_SUSPECT,     // 이상치/변화율 제한으로 보정
+    SAMPLE_QUALITY_BAD          // 정상값 없음 (센서 오류, 마지막 출력 유지)
+} sample_quality_t;
+
+typedef struct {
+    int window;                 // 중앙값 창 (홀수, 3~9, 1 = 끔)
+    int outlier_temp_centi;     // 중앙값과 이보다 크게 다르면 이상치 (0 = 검사 안 함)
+    int outlier_humi_centi;
+    int tau_ms;                 // 평활 시간 상수 (0 = 평활 안 함)
+    int slew_temp_centi_min;    // 출력 최대 변화율 (0.01 단위/분, 0 = 제한 없음)
+    int slew_humi_centi_min;
+} sample_filter_config_t;
+
+// 기본: 창 5, 이상치 3°C/10%, tau 6초, 변화율 10°C/분, 30%/분
+// (변화율 제한은 DHT11 양자화 흔들림(1°C/1%)이 평활을 거친 폭보다 커야
+// 평상시에 걸리지 않음. 실제 실내 변화는 스케줄러 가정 1°C/분, 5%/분 이하)
+#define SAMPLE_FILTER_CONFIG_DEFAULT {  \
+    .window = 5,                        \
+    .outlier_temp_centi = 300,          \
+    .outlier_humi_centi = 1000,         \
+    .tau_ms = 6000,                     \
+    .slew_temp_centi_min = 1000,        \
+    .slew_humi_centi_min = 3000,        \
+}
+
+// 채널 하나 (온도 또는 습도)
+typedef struct {
+    int32_t ring[SAMPLE_FILTER_MAX_WINDOW];     // 입력 순서
+    int32_t sorted[SAMPLE_FILTER_MAX_WINDOW];   // 같은 값들을 정렬
+    int count;
+    int head;                                   // 다음에 덮어쓸 ring 위치
+    int32_t ema_q8;                             // 평활 상태 (centi × 256)
+    int32_t out;                                // 마지막 출력 (centi)
+} sample_filter_channel_t;
+
+typedef struct {
+    uint32_t samples;           // 반영한 정상값
+    uint32_t outliers;          // 중앙값으로 대체한 값 (채널별 합)
+    uint32_t slew_limited;      // 변화율 제한이 걸린 출력 (채널별 합)
+    uint32_t bad;               // 정상값 없이 들어온 샘플
+} sample_filter_stats_t;
+
+typedef struct {
+    const sample_filter_config_t *config;   // NULL이면 기본
+    sample_filter_channel_t temp;
+    sample_filter_channel_t humi;
+    int64_t last_ms;
+    int primed;                             // 첫 정상값을 받았는지
+    sample_filter_stats_t stats;
+} sample_filter_t;
+
+void sample_filter_init(sample_filter_t *f, const sample_filter_config_t *config);
+
+// 재부팅 뒤 웜 스타트: 마지막 출력(at_ms 시각)을 평활/변화율 제한의 시작값으로.
+// 중앙값 창은 비워 둠 (꺼져 있던 동안의 실제 변화를 이상치로 막지 않도록)
+void sample_filter_seed(sample_filter_t *f, int32_t temp_centi, int32_t humi_centi, int64_t at_ms);
+
+// 샘플 하나를 필터에 넣고 값/플래그를 필터 출력으로 바꿈
+// VALID가 아니면 창에 넣지 않고 마지막 출력으로 채움 (아직 없으면 그대로)
+sample_quality_t sample_filter_update(sample_filter_t *f, sensor_sample_t *sample, int64_t now_ms);
+
+// 채널 창의 현재 중앙값 (창이 비면 0)
+int32_t sample_filter_median(const sample_filter_channel_t *ch);
+
+#endif // SAMPLE_FILTER_H
@@ -0,0 +1,79 @@
+#ifndef SAMPLE_SCHEDULER_H
+#define SAMPLE_SCHEDULER_H
+
+#include <stdint.h>
+#include "environment_indicator.h"
+
+// DHT11 측정 주기 스케줄러 (변화율 기반 적응형)
+//
+// 값이 변하거나 판정 경계 가까이 있으면 센서 최소 간격(3초)으로 읽고,
+// 안정되면 간격을 두 배씩 늘려 최대 간격까지 물러납니다. 읽기 한 번은
+// 수 ms 동안 GPIO를 바쁜 대기로 비트뱅잉하고 센서를 자체 발열시키므로
+// 안정 상태에서 읽기를 줄이는 것이 목적입니다.
+//
+// 경보 지연 보장: 물러난 간격은 "가장 가까운 경계까지 거리 / 가정한 최대
+// 변화율"을 넘지 않으므로, 실제 변화가 그 변화율 안이면 다음 측정 전에
+// 경계를 넘을 수 없습니다 (경계에 가까워질수록 간격이 최소로 줄어듦).
+// 주의 타이머가 도는 동안(승격 대기)에는 항상 최소 간격입니다.
+// 입출력이 없는 순수 로직이라 시각은 호출자가 넘깁니다 (ms, 단조 시계).
+
+typedef struct {
+    int min_interval_ms;        // 센서 최소 간격 (DHT11_MIN_INTERVAL)
+    int max_interval_ms;        // 안정 시 최대 간격
+    int backoff_after;          // 이만큼 연속 안정이면 간격 두 배
+    int change_temp_centi;      // 기준값 대비 이 이상이면 변화 (DHT11 ±1 흔들림 무시)
+    int change_humi_centi;
+    int temp_slew_centi_min;    // 가정한 최대 변화율 (0.01 단위/분)
+    int humi_slew_centi_min;
+} sample_sched_config_t;
+
+// 기본: 3초~60초, 안정 3회마다 두 배, 변화 1.5°C/3%, 최대 변화율 1°C/분, 5%/분
+#define SAMPLE_SCHED_CONFIG_DEFAULT {   \
+    .min_interval_ms = 3000,            \
+    .max_interval_ms = 60000,           \
+    .backoff_after = 3,                 \
+    .change_temp_centi = 150,           \
+    .change_humi_centi = 300,           \
+    .temp_slew_centi_min = 100,         \
+    .humi_slew_centi_min = 500,         \
+}
+
+// 누적 통계 (실효 측정률 기록용)
+typedef struct {
+    uint32_t attempts;          // 읽기 시도
+    uint32_t failures;          // 실패한 시도 (최소 간격으로 재시도)
+    uint32_t fast_samples;      // 다음 측정을 최소 간격으로 잡은 횟수 (변화/경계/주의)
+    uint32_t interval_ms;       // 현재 간격
+    uint32_t avg_interval_ms;   // 실효 간격 (지수 이동 평균, 1/8)
+} sample_sched_stats_t;
+
+typedef struct {
+    const sample_sched_config_t *config;    // NULL이면 기본
+    const env_config_t *env;                // 경계 기준 (NULL이면 판정 기본)
+    int64_t next_due_ms;
+    int64_t last_ms;                        // 마지막 시도 시각 (0 = 없음)
+    int ref_temp_centi;                     // 변화 판단 기준값
+    int ref_humi_centi;
+    int have_ref;
+    int stable_count;
+    sample_sched_stats_t stats;
+} sample_sched_t;
+
+// 초기화 (첫 측정은 바로 가능)
+void sample_sched_init(sample_sched_t *s, const sample_sched_config_t *config,
+                       const env_config_t *env, int64_t now_ms);
+
+// 지금 읽을 차례인지
+int sample_sched_due(const sample_sched_t *s, int64_t now_ms);
+
+// 다음 읽기까지 남은 시간 (ms, 0 = 지금)
+int64_t sample_sched_wait_ms(const sample_sched_t *s, int64_t now_ms);
+
+// 읽기 결과 반영 후 다음 시각 결정 (status: 이 샘플을 반영한 환경 상태, NULL 가능)
+void sample_sched_update(sample_sched_t *s, const env_status_t *status, int ok,
+                         int temp_centi, int humi_centi, int64_t now_ms);
+
+// 가장 가까운 경계까지 거리 (0.01 단위, 히스테리시스 복귀선 포함)
+int sample_sched_boundary_distance(const env_band_t *band, int value);
+
+#endif // SAMPLE_SCHEDULER_H
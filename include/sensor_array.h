@@ -0,0 +1,83 @@
+#ifndef SENSOR_ARRAY_H
+#define SENSOR_ARRAY_H
+
+#include <stdint.h>
+#include "dht11_capture.h"
+#include "sample_scheduler.h"
+#include "sensor_sample.h"
+
+// 여러 구역의 DHT11 (센서마다 GPIO 라인 하나)
+//
+// 비트뱅잉 읽기는 시작 신호 20ms + 프레임 4~5ms 동안 CPU를 바쁜 대기로
+// 잡으므로 센서 수에 비례해 CPU를 씁니다. 여기서는 시작 신호를 timerfd로
+// 기다리고, 프레임은 라인을 에지 이벤트로 요청해 커널 타임스탬프로 받습니다.
+// 모든 센서의 타이머와 이벤트 fd를 epoll 하나로 기다리므로 센서가 늘어도
+// 깨어나는 횟수만 늘고 바쁜 대기는 없습니다.
+//
+// 캡처 구간(시작 신호를 놓은 뒤 8ms)은 센서끼리 겹치지 않게 엇갈려 예약하고,
+// 측정 주기는 구역마다 적응형 스케줄러가 정합니다 (sample_scheduler.h).
+
+#define SENSOR_ARRAY_MAX        16
+#define SENSOR_ZONE_NAME_LEN    24
+#define SENSOR_ARRAY_READINGS   SENSOR_ARRAY_MAX    // poll 한 번에 나올 수 있는 최대 측정
+
+struct gpiod_line;
+
+typedef struct {
+    int pin;
+    const char *name;
+} sensor_zone_config_t;
+
+typedef enum {
+    ZONE_IDLE = 0,      // 다음 시작 신호 대기
+    ZONE_START,         // 시작 신호 LOW 유지 중
+    ZONE_CAPTURE        // 에지 수집 중
+} sensor_zone_phase_t;
+
+typedef struct {
+    char name[SENSOR_ZONE_NAME_LEN];
+    int pin;
+    struct gpiod_line *line;
+    int event_fd;                   // 캡처 중일 때만 (-1 = 없음)
+    sensor_zone_phase_t phase;
+    uint64_t release_ns;            // 예약한 시작 신호 해제 시각 (CLOCK_MONOTONIC)
+    int n_edges;
+    dht11_edge_t edges[DHT11_MAX_EDGES];
+    dht11_state_t state;            // 마지막 유효값 + 통계
+    sample_sched_t sched;
+} sensor_zone_t;
+
+// 측정 하나 (sample.time은 호출자가 채움)
+typedef struct {
+    int zone;
+    sensor_sample_t sample;         // flags: VALID 또는 STALE(마지막 유효값), 0이면 값 없음
+} sensor_reading_t;
+
+typedef struct {
+    uint64_t captures;              // 끝난 캡처
+    uint64_t edges;                 // 받은 에지
+    uint64_t wakeups;               // epoll에서 깨어난 횟수
+    uint64_t staggered;             // 겹침을 피해 뒤로 민 예약
+} sensor_array_stats_t;
+
+typedef struct {
+    int epoll_fd;
+    int timer_fd;
+    uint64_t timer_ns;              // 설정해 둔 타이머 (0 = 꺼짐)
+    int count;
+    sensor_zone_t zones[SENSOR_ARRAY_MAX];
+    sensor_array_stats_t stats;
+} sensor_array_t;
+
+// 센서 배열 열기 (gpio_init() 후). 첫 측정은 바로 엇갈려 시작
+int sensor_array_open(sensor_array_t *arr, const sensor_zone_config_t *zones, int count);
+
+void sensor_array_close(sensor_array_t *arr);
+
+// 바깥 이벤트 루프에 넣을 fd (읽기 가능해지면 sensor_array_poll(arr, 0, ...))
+int sensor_array_fd(const sensor_array_t *arr);
+
+// 타이머/에지 처리 (최대 timeout_ms 대기). 반환: 끝난 측정 수, 오류 -1
+int sensor_array_poll(sensor_array_t *arr, int timeout_ms, sensor_reading_t *out, int max_out);
+
+#endif // SENSOR_ARRAY_H
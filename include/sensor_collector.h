@@ -1,18 +1,21 @@
 #ifndef SENSOR_COLLECTOR_H
 #define SENSOR_COLLECTOR_H
 
-#include <time.h>
+#include "sensor_sample.h"
+#include "sensor_array.h"
 
-typedef struct {
-    float temperature;
-    float humidity;
-    int rotary_position;
-    int button_pressed;
-    struct tm timestamp;
-    int data_valid;
-} sensor_data_t;
+// RTC 재동기 주기 (초). 그 사이에는 단조 시계로 시각을 이어 붙입니다.
+#define SENSOR_COLLECTOR_RTC_RESYNC_S  3600
 
 void sensor_collector_init(void);
-int collect_sensor_data(sensor_data_t *result);
+
+// 샘플 수집: 정상값이면 1, 마지막 값 대체/오류면 0
+int collect_sensor_data(sensor_sample_t *result);
+
+// 여러 구역: 센서 배열 열기 (시각 기준은 단일 센서와 공유)
+int sensor_collector_open_zones(sensor_array_t *arr, const sensor_zone_config_t *zones, int count);
+
+// 끝난 구역 측정을 모아 시각을 붙임 (최대 timeout_ms 대기). 반환: 측정 수, 오류 -1
+int collect_zone_samples(sensor_array_t *arr, int timeout_ms, sensor_reading_t *out, int max_out);
 
 #endif // SENSOR_COLLECTOR_H
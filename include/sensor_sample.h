@@ -0,0 +1,37 @@
+#ifndef SENSOR_SAMPLE_H
+#define SENSOR_SAMPLE_H
+
+#include <stdint.h>
+#include <time.h>
+
+// 샘플 한 개 = 12바이트 고정 크기 레코드
+// 히스토리 버퍼, 저장소, IPC/전송 계층이 같은 형식을 그대로 사용합니다.
+// 시각은 epoch 초(UTC) + ms로 보관하고, 달력 변환은 표시할 때만 합니다.
+
+#define SAMPLE_FLAG_VALID      0x0001  // 온습도 값이 이번 측정에서 얻은 정상값
+#define SAMPLE_FLAG_STALE      0x0002  // 센서 오류로 마지막 정상값을 대신 채움
+#define SAMPLE_FLAG_TIME_RTC   0x0004  // 시각 기준이 DS1307
+#define SAMPLE_FLAG_TIME_SYS   0x0008  // RTC 오류로 시스템 시계 사용
+
+typedef struct __attribute__((packed)) {
+    uint32_t time;          // epoch 초 (UTC)
+    int16_t  temp_centi;    // 온도 (0.01°C)
+    uint16_t humi_centi;    // 습도 (0.01%)
+    uint16_t time_ms;       // 초 이하 밀리초 (0~999)
+    uint16_t flags;         // SAMPLE_FLAG_*
+} sensor_sample_t;
+
+_Static_assert(sizeof(sensor_sample_t) == 12, "sensor_sample_t must be 12 bytes");
+
+// centi 값 저장 (범위 밖은 포화)
+int16_t sample_clamp_temp(int temp_centi);
+uint16_t sample_clamp_humi(int humi_centi);
+
+// 시각 설정/조회
+void sample_set_time(sensor_sample_t *sample, const struct timespec *realtime);
+int64_t sample_time_ms(const sensor_sample_t *sample);
+
+// 표시용 달력 변환 (로컬 시간대)
+void sample_to_localtime(const sensor_sample_t *sample, struct tm *tm);
+
+#endif // SENSOR_SAMPLE_H
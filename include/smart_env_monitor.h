@@ -27,6 +27,7 @@
 #define GPIO_ROTARY_DT     18
 #define GPIO_ROTARY_SW     27
 #define GPIO_DHT11_DATA    4
+#define GPIO_DS1307_SQW    22   // DS1307 SQW/OUT (오픈 드레인, 풀업 필요)
 
 // I2C 설정
 #define I2C_DEVICE         "/dev/i2c-1"
@@ -0,0 +1,37 @@
+#ifndef STATE_STORE_H
+#define STATE_STORE_H
+
+#include <stdint.h>
+
+// DS1307 배터리 백업 RAM(56바이트)에 마지막 상태를 보관해 재부팅 직후
+// 기본값 대신 의미 있는 첫 화면을 보여 주기 위한 저장소
+
+#define STATE_STORE_MAGIC          0xE5
+#define STATE_STORE_VERSION        1
+#define STATE_STORE_MIN_INTERVAL   10   // 쓰기 최소 간격 (초)
+
+// 보관할 상태 (정수 단위로 압축)
+typedef struct __attribute__((packed)) {
+    int16_t  temp_centi;          // 마지막 정상 샘플 온도 (0.01°C, 필터 출력 → 재부팅 후 필터 시작값)
+    uint16_t humi_centi;          // 마지막 정상 샘플 습도 (0.01%, 필터 출력)
+    uint32_t sample_time;         // 마지막 정상 샘플 시각 (epoch 초)
+    uint8_t  display_mode;        // 마지막 화면 모드
+    uint8_t  env_level;           // 마지막 환경 등급
+    uint16_t warning_elapsed_s;   // 주의 상태 지속 시간 (초)
+    int16_t  filter_temp_centi;   // 센서 필터 상태 (마지막 유효 온도)
+    uint16_t filter_humi_centi;   // 센서 필터 상태 (마지막 유효 습도)
+    uint8_t  filter_errors;       // 센서 필터 상태 (연속 오류 수)
+    uint8_t  reserved;
+} env_state_t;
+
+// 시작 시 복원: 유효한 기록이 있으면 0
+int state_store_load(env_state_t *state);
+
+// 메모리상 상태만 갱신 (I2C 전송 없음)
+void state_store_update(const env_state_t *state);
+
+// 변경이 있고 최소 간격이 지났으면 기록 (force = 1이면 간격 무시)
+// 반환: 기록함 1, 건너뜀 0, 실패 -1
+int state_store_flush(int force);
+
+#endif // STATE_STORE_H
@@ -2,6 +2,7 @@
 #define UART_COMMUNICATION_H
 
 #include "smart_env_monitor.h"
+#include "sensor_sample.h"
 
 // UART 설정
 #define UART_DEVICE           "/dev/ttyAMA0"
@@ -39,7 +40,7 @@ int uart_init(const char *device, int baudrate);
 void uart_cleanup(void);
 int uart_send_data(const char *data, int len);
 int uart_receive_data(char *buffer, int max_len, int timeout_ms);
-int uart_send_sensor_data(const sensor_data_t *data);
+int uart_send_sensor_data(const sensor_sample_t *data);
 int uart_send_command(const char *command);
 int uart_parse_command(const char *buffer, uart_packet_t *packet);
 
@@ -52,6 +53,6 @@ int uart_send_status_response(void);
 // 유틸리티 함수
 void uart_calculate_checksum(const char *data, char *checksum);
 int uart_verify_checksum(const uart_packet_t *packet);
-void uart_format_json_response(const sensor_data_t *data, char *json_buffer, int buffer_size);
+void uart_format_json_response(const sensor_sample_t *data, char *json_buffer, int buffer_size);
 
 #endif // UART_COMMUNICATION_H
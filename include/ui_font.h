@@ -0,0 +1,35 @@
+#ifndef UI_FONT_H
+#define UI_FONT_H
+
+#include <stdint.h>
+
+// 글꼴 (빌드 때 scripts/gen_font_atlas로 만든 아틀라스)
+//
+// 글자마다 [페이지][열] 바이트의 SSD1306 페이지 형식이라, 그릴 때는 열
+// 바이트를 프레임에 복사만 합니다 (y가 페이지 경계면 페이지마다 memcpy).
+// 큰 글꼴도 픽셀 단위 작업이 없어 비용은 덮는 열 바이트 수에 비례합니다.
+//   ui_font_6x8     ASCII 전체 (기존 6x8 글꼴)
+//   ui_font_12x16   ASCII 전체
+//   ui_font_24x32   숫자/기호만 (" +-.0123456789:%C"), 나머지는 공백
+
+typedef struct {
+    uint8_t width;              // 글자 폭 (열)
+    uint8_t pages;              // 글자 높이 / 8
+    uint16_t glyph_bytes;       // width * pages
+    const uint8_t *index;       // ASCII 32~127 → 아틀라스 글자 번호
+    const uint8_t *atlas;       // 글자 번호 * glyph_bytes 위치부터 [페이지][열]
+} ui_font_t;
+
+extern const ui_font_t ui_font_6x8;
+extern const ui_font_t ui_font_12x16;
+extern const ui_font_t ui_font_24x32;
+
+// 글자 하나의 열 데이터 (범위 밖 문자는 대체 글자)
+static inline const uint8_t *ui_font_glyph(const ui_font_t *font, char c) {
+    unsigned char u = (unsigned char)c;
+
+    if (u < 32 || u > 127) u = '?';
+    return font->atlas + (unsigned)font->index[u - 32] * font->glyph_bytes;
+}
+
+#endif // UI_FONT_H
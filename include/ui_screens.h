@@ -0,0 +1,44 @@
+#ifndef UI_SCREENS_H
+#define UI_SCREENS_H
+
+#include <time.h>
+#include "ui_widget.h"
+#include "comfort_metrics.h"
+
+// smart_env_ui의 세 화면 위젯 트리와 값 갱신
+//
+// 배치(줄 높이, 글자 폭)는 여기 한 곳에만 두고 UI와 테스트가 같이 씁니다.
+// 갱신 함수는 값만 넘겨받아 위젯에 반영하며, 제출은 호출자가 합니다.
+
+typedef enum {
+    UI_SENSOR_LIVE = 0,         // 방금 읽은 값
+    UI_SENSOR_STALE,            // 센서 오류 → 마지막 값
+    UI_SENSOR_NONE              // 값 없음
+} ui_sensor_state_t;
+
+typedef struct {
+    // 화면 1: 방 이름 + 환경 지수 + 편의 지표 (경보가 있으면 체감 온도 자리에)
+    ui_widget_t room_screen, room_label, level_row, level_icon, level_label;
+    ui_widget_t comfort_row, dew_value, ah_value, feel_value, alert_label;
+    // 화면 2: 큰 글씨 온도 + 습도/막대 + 온도 추이
+    ui_widget_t sensor_screen, temp_row, temp_big, temp_unit, humi_row, humi_value, humi_bar;
+    ui_widget_t sensor_note, temp_spark;
+    // 화면 3: 날짜 + 큰 글씨 시:분 + 초
+    ui_widget_t time_screen, time_head, time_title, date_label, time_label;
+    ui_widget_t sec_row, sec_pad, sec_label;
+} ui_screens_t;
+
+// 위젯 트리 구성 (한 번만, 이후에는 값만 바꿈)
+void ui_screens_build(ui_screens_t *s, const char *room_name);
+
+// 화면 1 (level: env_level_t, alert: "" = 경보 없음)
+void ui_screens_room(ui_screens_t *s, const char *room_name, int level, const char *level_text,
+                     const comfort_metrics_t *comfort, const char *alert);
+
+// 화면 2 (NONE이면 값은 무시)
+void ui_screens_sensor(ui_screens_t *s, ui_sensor_state_t state, int temp_centi, int humi_centi);
+
+// 화면 3
+void ui_screens_time(ui_screens_t *s, const struct tm *tm);
+
+#endif // UI_SCREENS_H
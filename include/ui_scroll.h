@@ -0,0 +1,23 @@
+#ifndef UI_SCROLL_H
+#define UI_SCROLL_H
+
+#include "oled_display_list.h"
+
+// 티커 속도 (SSD1306 스크롤 간격 코드)
+#define UI_TICKER_SLOW    2   // 128프레임마다 1열
+#define UI_TICKER_NORMAL  0   // 5프레임마다 1열
+#define UI_TICKER_FAST    7   // 2프레임마다 1열
+
+// 한 줄(21자)을 넘지 않으면서 이 길이를 넘는 텍스트는 티커로 흘립니다
+#define UI_TICKER_MIN_LEN 16
+
+// 하드웨어 스크롤 티커: page 줄에 text를 그리고 컨트롤러가 계속 회전시킴
+int ui_ticker_start(int fd, oled_dl_t *dl, int page, const char *text, int speed);
+int ui_ticker_stop(int fd);
+int ui_ticker_active(void);
+
+// 시작 줄 오프셋으로 새 화면을 아래에서 굴려 올리는 페이지 전환
+// frame: 새 화면 전체 (8페이지 x 128열, 위젯 트리가 그린 ui_t.fb)
+int ui_transition_roll(int fd, oled_dl_t *dl, const uint8_t frame[8][128], int step_us);
+
+#endif // UI_SCROLL_H
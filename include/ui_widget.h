@@ -0,0 +1,141 @@
+#ifndef UI_WIDGET_H
+#define UI_WIDGET_H
+
+#include <stdint.h>
+#include "oled_display_list.h"
+#include "ui_font.h"
+
+// 유지형(retained) 위젯 트리 + 손상 영역 추적
+//
+// 화면은 한 번 만든 위젯 트리로 두고, 값이 바뀐 위젯만 스스로 DIRTY로
+// 표시합니다. 갱신 때는 DIRTY 위젯만 사용자 공간 프레임(패널과 같은
+// 8페이지 x 128열 형식)에 다시 그리고, 그린 부분을 페이지별 열 구간으로
+// 모아 OLED_OP_BLIT 명령으로 한 번에 제출합니다.
+//   - 값이 같으면 서식화/그리기/시스템 콜 모두 없음
+//   - 글자는 이전 문자열과 비교해 바뀐 글자 열만 손상으로 남김
+//   - 배치(위치/크기)는 보이기/숨기기나 트리 변경 때만 다시 계산하고,
+//     위치가 바뀐 위젯만 옛 자리를 지우고 새 자리에 그림
+//   - 글자는 글꼴 아틀라스(ui_font.h)의 열 바이트를 그대로 복사
+// 위젯은 호출자가 정적으로 잡고 ui_add()로 이어 붙입니다 (동적 할당 없음).
+
+#define UI_WIDTH        128
+#define UI_HEIGHT       64
+#define UI_PAGES        8
+#define UI_GLYPH_W      6       // 기본 글꼴 (6x8) 글자 폭
+#define UI_LINE_H       8
+#define UI_TEXT_MAX     21      // 한 줄 글자 수 (기본 글꼴 기준)
+#define UI_SPARK_MAX    64      // 스파크라인 점 수
+
+typedef enum {
+    UI_VBOX = 0,                // 자식을 위에서 아래로
+    UI_HBOX,                    // 자식을 왼쪽에서 오른쪽으로
+    UI_LABEL,                   // 문자열
+    UI_VALUE,                   // 고정소수점 값 + 서식 (fx_format)
+    UI_ICON,                    // 페이지 형식 비트맵
+    UI_BAR,                     // 가로 막대 (min~max)
+    UI_SPARKLINE                // 최근 값 추이
+} ui_kind_t;
+
+#define UI_F_DIRTY      0x01    // 자기 영역을 다시 그림
+#define UI_F_CHILD      0x02    // 자손 중에 DIRTY가 있음
+#define UI_F_LAYOUT     0x04    // 자손 배치를 다시 계산
+#define UI_F_HIDDEN     0x08    // 자리를 차지하지 않고 그리지 않음
+
+typedef struct {
+    int16_t x, y, w, h;
+} ui_rect_t;
+
+typedef struct ui_widget ui_widget_t;
+
+struct ui_widget {
+    uint8_t kind;               // ui_kind_t
+    uint8_t flags;              // UI_F_*
+    int16_t pref_w, pref_h;     // 원하는 크기 (0 = 남은 공간을 나눠 채움)
+    ui_rect_t rect;             // 배치 결과 (캐시)
+    ui_rect_t damage;           // DIRTY일 때 다시 보낼 부분 (rect 안)
+    ui_widget_t *parent;
+    ui_widget_t *first;         // 첫 자식 (상자만)
+    ui_widget_t *next;          // 다음 형제
+    union {
+        struct {
+            char text[UI_TEXT_MAX + 1];
+            uint8_t len;
+            uint8_t has_value;  // VALUE: value/fmt가 text를 설명함
+            const char *fmt;
+            int32_t value;
+            const ui_font_t *font;
+        } text;
+        struct {
+            const uint8_t *bits;
+            uint8_t w, h;
+        } icon;
+        struct {
+            int32_t value, min, max;
+        } bar;
+        struct {
+            int32_t points[UI_SPARK_MAX];
+            uint8_t head;       // 다음에 쓸 자리
+            uint8_t count;
+            int32_t min_span;   // 세로 축 최소 폭 (작은 흔들림이 꽉 차 보이지 않게)
+        } spark;
+    } u;
+};
+
+typedef struct {
+    uint32_t renders;           // ui_render 호출
+    uint32_t widgets_drawn;     // 다시 그린 위젯
+    uint32_t layouts;           // 배치 재계산
+    uint32_t flushes;           // 실제 제출 (ioctl)
+    uint32_t bytes;             // 제출한 비트맵 바이트
+} ui_stats_t;
+
+typedef struct {
+    uint8_t fb[UI_PAGES][UI_WIDTH];     // 그려 둔 화면 (패널과 같은 형식)
+    uint8_t span_lo[UI_PAGES];          // 페이지별 손상 열 구간 (lo > hi = 없음)
+    uint8_t span_hi[UI_PAGES];
+    ui_widget_t *root;
+    ui_stats_t stats;
+} ui_t;
+
+// 위젯 만들기 (pref 0 = 채움)
+void ui_box_init(ui_widget_t *w, ui_kind_t kind, int pref_w, int pref_h);
+void ui_label_init(ui_widget_t *w, int pref_w, const char *text);
+void ui_value_init(ui_widget_t *w, int pref_w, const char *fmt);
+void ui_icon_init(ui_widget_t *w, int pref_w, const uint8_t *bits, int bits_w, int bits_h);
+void ui_bar_init(ui_widget_t *w, int pref_w, int pref_h, int32_t min, int32_t max);
+void ui_sparkline_init(ui_widget_t *w, int pref_w, int pref_h, int32_t min_span);
+void ui_add(ui_widget_t *parent, ui_widget_t *child);
+
+// 값 바꾸기: 실제로 달라졌을 때만 DIRTY
+void ui_label_set(ui_widget_t *w, const char *text);
+void ui_value_set(ui_widget_t *w, const char *fmt, int32_t value);  // fmt의 %q 하나에 value
+void ui_icon_set(ui_widget_t *w, const uint8_t *bits);
+void ui_bar_set(ui_widget_t *w, int32_t value);
+void ui_sparkline_push(ui_widget_t *w, int32_t value);
+void ui_widget_set_visible(ui_widget_t *w, int visible);
+
+// 글자 위젯 글꼴 바꾸기 (기본 ui_font_6x8, 높이는 글꼴 높이로)
+void ui_widget_set_font(ui_widget_t *w, const ui_font_t *font);
+
+void ui_init(ui_t *ui);
+
+// 표시할 트리 교체 (화면 전체를 다시 그림)
+void ui_set_root(ui_t *ui, ui_widget_t *root);
+
+// 패널 내용을 알 수 없게 됐을 때 (지움/전환 실패 등) 다음 제출에 전체 전송
+void ui_invalidate(ui_t *ui);
+
+// 배치 + DIRTY 위젯 그리기. 반환: 손상된 페이지 수
+int ui_render(ui_t *ui);
+
+// 손상 구간을 BLIT 명령으로 (손상은 비움). 반환: 명령 수, 버퍼 부족 -1
+int ui_build_dl(ui_t *ui, oled_dl_t *dl);
+
+// 손상 구간 버리기 (다른 경로로 프레임 전체를 보냈을 때)
+void ui_damage_clear(ui_t *ui);
+
+// 그리기 + 제출. 바뀐 것이 없으면 시스템 콜 없음
+// 반환: 1 제출함, 0 변화 없음, -1 실패 (다음 호출에 전체 재전송)
+int ui_flush(ui_t *ui, int fd, oled_dl_t *dl);
+
+#endif // UI_WIDGET_H
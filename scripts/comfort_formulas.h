@@ -0,0 +1,40 @@
+#ifndef COMFORT_FORMULAS_H
+#define COMFORT_FORMULAS_H
+
+// 편의 지표 기준식 (double)
+// 룩업 테이블 생성기와 정확도 테스트에서만 사용합니다. 데몬은 테이블을 씁니다.
+
+#include <math.h>
+
+// 이슬점 (°C): Magnus 식, b = 17.62, c = 243.12 (Sonntag 1990)
+static inline double ref_dew_point(double t, double rh) {
+    double gamma = log(rh / 100.0) + 17.62 * t / (243.12 + t);
+    return 243.12 * gamma / (17.62 - gamma);
+}
+
+// 체감 온도 (°C): NWS 열지수 알고리즘 (Rothfusz 회귀식 + 보정)
+static inline double ref_heat_index(double t, double rh) {
+    double f = t * 9.0 / 5.0 + 32.0;
+    double hi = 0.5 * (f + 61.0 + (f - 68.0) * 1.2 + rh * 0.094);
+
+    if ((hi + f) / 2.0 >= 80.0) {
+        hi = -42.379 + 2.04901523 * f + 10.14333127 * rh
+             - 0.22475541 * f * rh - 0.00683783 * f * f
+             - 0.05481717 * rh * rh + 0.00122874 * f * f * rh
+             + 0.00085282 * f * rh * rh - 0.00000199 * f * f * rh * rh;
+        if (rh < 13.0 && f >= 80.0 && f <= 112.0) {
+            hi -= (13.0 - rh) / 4.0 * sqrt((17.0 - fabs(f - 95.0)) / 17.0);
+        } else if (rh > 85.0 && f >= 80.0 && f <= 87.0) {
+            hi += (rh - 85.0) / 10.0 * (87.0 - f) / 5.0;
+        }
+    }
+    return (hi - 32.0) * 5.0 / 9.0;
+}
+
+// 절대 습도 (g/m³): 포화 수증기압(Magnus) x 상대 습도 / (Rv x T)
+static inline double ref_abs_humidity(double t, double rh) {
+    double es = 6.112 * exp(17.67 * t / (t + 243.5));
+    return es * rh * 2.1674 / (273.15 + t);
+}
+
+#endif // COMFORT_FORMULAS_H
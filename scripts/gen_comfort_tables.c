@@ -0,0 +1,34 @@
+// 편의 지표 룩업 테이블 생성기 (빌드 호스트에서 실행)
+// 사용법: gen_comfort_tables > comfort_tables.h
+
+#include <stdio.h>
+#include <math.h>
+#include "comfort_formulas.h"
+#include "../include/comfort_metrics.h"
+
+typedef double (*formula_t)(double t, double rh);
+
+static void emit_table(const char *name, const char *unit, formula_t f) {
+    printf("// %s, [온도 %d점][습도 %d점]\n", unit, COMFORT_TEMP_POINTS, COMFORT_HUMI_POINTS);
+    printf("static const short %s[COMFORT_TEMP_POINTS][COMFORT_HUMI_POINTS] = {\n", name);
+    for (int i = 0; i < COMFORT_TEMP_POINTS; i++) {
+        double t = (COMFORT_TEMP_MIN_CENTI + i * COMFORT_TEMP_STEP_CENTI) / 100.0;
+        printf("    {");
+        for (int j = 0; j < COMFORT_HUMI_POINTS; j++) {
+            double rh = (COMFORT_HUMI_MIN_CENTI + j * COMFORT_HUMI_STEP_CENTI) / 100.0;
+            printf("%s%ld", j ? "," : "", lround(f(t, rh) * 100.0));
+        }
+        printf("},\n");
+    }
+    printf("};\n\n");
+}
+
+int main(void) {
+    printf("// 자동 생성 파일 - 직접 수정하지 마세요 (scripts/gen_comfort_tables.c)\n");
+    printf("#ifndef COMFORT_TABLES_H\n#define COMFORT_TABLES_H\n\n");
+    emit_table("comfort_dew_point_table", "이슬점 0.01°C", ref_dew_point);
+    emit_table("comfort_heat_index_table", "체감 온도 0.01°C", ref_heat_index);
+    emit_table("comfort_abs_humidity_table", "절대 습도 0.01 g/m³", ref_abs_humidity);
+    printf("#endif // COMFORT_TABLES_H\n");
+    return 0;
+}
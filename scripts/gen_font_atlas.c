@@ -0,0 +1,124 @@
+// 글꼴 아틀라스 생성기 (빌드 호스트에서 실행)
+// 사용법: gen_font_atlas > font_atlas.h
+//
+// 원본 비트맵은 include/font_data.h의 6x8 글꼴 하나입니다. 큰 글꼴은
+// Scale2x(EPX)로 두 배씩 키워 대각선 계단을 다듬습니다 (6x8 → 12x16 → 24x32).
+// 출력은 SSD1306 페이지 형식 그대로: 글자마다 [페이지][열] 바이트,
+// bit0 = 페이지 맨 윗줄. 화면에 그릴 때 열 바이트를 복사만 하면 됩니다.
+
+#include <stdio.h>
+#include <string.h>
+#include "../include/font_data.h"
+
+#define MAX_W 24
+#define MAX_H 32
+
+typedef struct {
+    int w, h;
+    unsigned char px[MAX_H][MAX_W];
+} bitmap_t;
+
+// ASCII 32~127 전체
+static const char *all_chars(void) {
+    static char chars[97];
+    for (int i = 0; i < 96; i++) chars[i] = (char)(32 + i);
+    chars[96] = '\0';
+    return chars;
+}
+
+// font6x8_basic은 행 우선, 열 j = bit (5 - j) (드라이버 ssd1306_glyph_columns와 같은 규칙)
+static void load_glyph(char c, bitmap_t *b) {
+    int idx = ((unsigned char)c < 32 || (unsigned char)c > 127) ? '?' - 32 : c - 32;
+
+    memset(b, 0, sizeof(*b));
+    b->w = 6;
+    b->h = 8;
+    for (int row = 0; row < 8; row++) {
+        for (int col = 0; col < 6; col++) {
+            b->px[row][col] = (font6x8_basic[idx][row] >> (5 - col)) & 1;
+        }
+    }
+}
+
+static int px_at(const bitmap_t *b, int x, int y) {
+    if (x < 0 || y < 0 || x >= b->w || y >= b->h) return 0;
+    return b->px[y][x];
+}
+
+// Scale2x: 이웃 네 점이 이루는 모서리 방향으로만 두 배 픽셀을 깎음
+static void scale2x(const bitmap_t *src, bitmap_t *dst) {
+    memset(dst, 0, sizeof(*dst));
+    dst->w = src->w * 2;
+    dst->h = src->h * 2;
+    for (int y = 0; y < src->h; y++) {
+        for (int x = 0; x < src->w; x++) {
+            int p = px_at(src, x, y);
+            int a = px_at(src, x, y - 1), b = px_at(src, x + 1, y);
+            int c = px_at(src, x - 1, y), d = px_at(src, x, y + 1);
+
+            dst->px[2 * y][2 * x]         = (c == a && c != d && a != b) ? a : p;
+            dst->px[2 * y][2 * x + 1]     = (a == b && a != c && b != d) ? b : p;
+            dst->px[2 * y + 1][2 * x]     = (d == c && d != b && c != a) ? c : p;
+            dst->px[2 * y + 1][2 * x + 1] = (b == d && b != a && d != c) ? d : p;
+        }
+    }
+}
+
+static void make_glyph(char c, int scale, bitmap_t *out) {
+    bitmap_t tmp;
+
+    load_glyph(c, out);
+    for (int s = 1; s < scale; s *= 2) {
+        scale2x(out, &tmp);
+        *out = tmp;
+    }
+}
+
+static void emit_font(const char *name, int scale, const char *chars) {
+    int n = (int)strlen(chars);
+    int w = 6 * scale, h = 8 * scale, pages = h / 8;
+    int fallback = -1;
+
+    printf("// %s: %dx%d, %d페이지 x %d열 = 글자당 %d바이트, %d글자\n",
+           name, w, h, pages, w, pages * w, n);
+    printf("static const unsigned char %s_atlas[%d][%d] = {\n", name, n, pages * w);
+    for (int i = 0; i < n; i++) {
+        bitmap_t g;
+
+        make_glyph(chars[i], scale, &g);
+        printf("    {");
+        for (int page = 0; page < pages; page++) {
+            for (int x = 0; x < w; x++) {
+                int bits = 0;
+                for (int r = 0; r < 8; r++) bits |= g.px[page * 8 + r][x] << r;
+                printf("%s0x%02X", (page || x) ? "," : "", bits);
+            }
+        }
+        if (chars[i] == 127) printf("},   // DEL\n");
+        else printf("},   // '%s%c'\n", chars[i] == '\'' || chars[i] == '\\' ? "\\" : "", chars[i]);
+    }
+    printf("};\n\n");
+
+    // ASCII 32~127 → 아틀라스 번호 (없는 글자는 '?', 그것도 없으면 ' ')
+    for (int i = 0; i < n && fallback < 0; i++) if (chars[i] == '?') fallback = i;
+    for (int i = 0; i < n && fallback < 0; i++) if (chars[i] == ' ') fallback = i;
+    if (fallback < 0) fallback = 0;
+
+    printf("static const unsigned char %s_index[96] = {\n    ", name);
+    for (int c = 32; c < 128; c++) {
+        const char *hit = memchr(chars, c, (size_t)n);
+        printf("%d%s", hit ? (int)(hit - chars) : fallback, c == 127 ? "\n" : (c % 16 == 15 ? ",\n    " : ","));
+    }
+    printf("};\n\n");
+}
+
+int main(void) {
+    printf("// 자동 생성 파일 - 직접 수정하지 마세요 (scripts/gen_font_atlas.c)\n");
+    printf("#ifndef FONT_ATLAS_H\n#define FONT_ATLAS_H\n\n");
+    emit_font("font_6x8", 1, all_chars());
+    emit_font("font_12x16", 2, all_chars());
+    // 큰 숫자 판독용 (온도/습도/시각)
+    emit_font("font_24x32", 4, " +-.0123456789:%C");
+    printf("#endif // FONT_ATLAS_H\n");
+    return 0;
+}
@@ -4,6 +4,7 @@
 #include <linux/string.h>
 #include <linux/errno.h>
 #include "../include/font_data.h"
+#include "../include/oled_ssd1306_commands.h"
 
 // SSD1306 명령어 정의
 #define SSD1306_DISPLAYOFF          0xAE
@@ -23,9 +24,17 @@
 #define SSD1306_SETVCOMDETECT       0xDB
 #define SSD1306_DISPLAYALLON_RESUME 0xA4
 #define SSD1306_NORMALDISPLAY       0xA6
+#define SSD1306_INVERTDISPLAY       0xA7
 #define SSD1306_DISPLAYON           0xAF
 #define SSD1306_SET_COLUMN_ADDR     0x21
 #define SSD1306_SET_PAGE_ADDR       0x22
+#define SSD1306_SCROLL_RIGHT        0x26
+#define SSD1306_SCROLL_LEFT         0x27
+#define SSD1306_SCROLL_DIAG_RIGHT   0x29
+#define SSD1306_SCROLL_DIAG_LEFT    0x2A
+#define SSD1306_DEACTIVATE_SCROLL   0x2E
+#define SSD1306_ACTIVATE_SCROLL     0x2F
+#define SSD1306_SET_VSCROLL_AREA    0xA3
 
 /**
  * ssd1306_init_display - OLED 디스플레이를 초기화합니다.
@@ -38,6 +47,7 @@ int ssd1306_init_display(struct i2c_client *client)
     // 명령어와 데이터를 한 번에 보내기 위해 재구성
     static const u8 init_sequence[] = {
         0x00, SSD1306_DISPLAYOFF,
+        0x00, SSD1306_DEACTIVATE_SCROLL,
         0x00, SSD1306_SETDISPLAYCLOCKDIV, 0x80,
         0x00, SSD1306_SETMULTIPLEX, 0x3F,
         0x00, SSD1306_SETDISPLAYOFFSET, 0x00,
@@ -67,29 +77,64 @@ int ssd1306_init_display(struct i2c_client *client)
     return 0;
 }
 
+/**
+ * ssd1306_write_window - 한 페이지의 [col, col+len) 구간에만 데이터를 씁니다.
+ * @client: I2C 클라이언트 포인터
+ * @page: 대상 페이지 (0~7)
+ * @col: 시작 열 (0~127)
+ * @data: 열 단위 데이터 (1바이트 = 세로 8픽셀)
+ * @len: 열 개수
+ *
+ * 수평 주소 모드에서 열/페이지 창(0x21/0x22)을 먼저 좁혀 두므로
+ * 바뀐 구간만 전송할 수 있습니다.
+ */
+int ssd1306_write_window(struct i2c_client *client,
+                         int page, int col,
+                         const u8 *data, int len)
+{
+    u8 window_cmds[] = {
+        0x00, SSD1306_SET_COLUMN_ADDR, 0, 0,
+        0x00, SSD1306_SET_PAGE_ADDR, 0, 0
+    };
+    u8 data_buffer[SSD1306_WIDTH + 1];
+    int ret;
+
+    if (page < 0 || page >= SSD1306_PAGES ||
+        col < 0 || len <= 0 || col + len > SSD1306_WIDTH)
+        return -EINVAL;
+
+    window_cmds[2] = col;
+    window_cmds[3] = col + len - 1;
+    window_cmds[6] = page;
+    window_cmds[7] = page;
+
+    ret = i2c_master_send(client, window_cmds, sizeof(window_cmds));
+    if (ret < 0) return ret;
+
+    data_buffer[0] = 0x40;
+    memcpy(&data_buffer[1], data, len);
+
+    ret = i2c_master_send(client, data_buffer, len + 1);
+    return ret < 0 ? ret : 0;
+}
+
 /**
  * ssd1306_clear_display - 화면 전체를 0으로 채워 지웁니다.
  */
 int ssd1306_clear_display(struct i2c_client *client)
 {
-    u8 page_buffer[129];
+    static const u8 blank[SSD1306_WIDTH];
     int ret, page;
 
-    // 데이터 버퍼의 첫 바이트는 데이터 전송을 의미하는 0x40
-    page_buffer[0] = 0x40;
-    memset(&page_buffer[1], 0x00, 128);
-
-    for (page = 0; page < 8; page++) {
-        u8 set_page_cmd[] = {0x00, 0xB0 | page};
-        i2c_master_send(client, set_page_cmd, sizeof(set_page_cmd));
-        ret = i2c_master_send(client, page_buffer, sizeof(page_buffer));
+    for (page = 0; page < SSD1306_PAGES; page++) {
+        ret = ssd1306_write_window(client, page, 0, blank, SSD1306_WIDTH);
         if (ret < 0) {
             pr_err("smart_env: 페이지 %d 클리어 실패\n", page);
             return ret;
         }
     }
 
-    pr_info("smart_env: OLED 화면 지우기 완료\n");
+    pr_debug("smart_env: OLED 화면 지우기 완료\n");
     return 0;
 }
 
@@ -121,74 +166,74 @@ int ssd1306_set_contrast(struct i2c_client *client, u8 contrast)
 }
 
 /**
- * ssd1306_render_text - 지정된 페이지(줄)에 텍스트를 수평으로 출력합니다.
- * @client: I2C 클라이언트 포인터
- * @text: 출력할 문자열
- * @page: 출력할 페이지 (0~7)
+ * ssd1306_glyph_columns - 6x8 글자 하나를 SSD1306 열 데이터 6바이트로 변환합니다.
+ * @c: 출력할 문자 (범위 밖이면 '?')
+ * @cols: 결과 열 데이터 (bit0 = 맨 윗줄)
  *
  * 폰트 회전 없이 가로로 텍스트를 그리는 표준 방식입니다.
  */
-
-int ssd1306_render_text(struct i2c_client *client,
-                        const char *text,
-                        int page)
+void ssd1306_glyph_columns(char c, u8 cols[SSD1306_GLYPH_WIDTH])
 {
-    int i, j, ret;
-    int text_len = strlen(text);
-    u8 page_buffer[129];
-    u8 set_pos_cmds[5];
-    
     // --- 추가: 좌우 반전된 폰트를 임시 저장할 버퍼 ---
     u8 flipped_char_buffer[8];
+    int row, j;
 
-    if (page < 0 || page > 7) {
-        pr_err("smart_env: 잘못된 페이지 번호: %d\n", page);
-        return -EINVAL;
+    if (c < 32 || c > 127) c = '?';
+
+    // --- 추가: 폰트 데이터를 먼저 좌우 반전시킵니다 ---
+    flip_font_6x8_horizontal(font6x8_basic[c - 32], flipped_char_buffer);
+
+    // 폰트의 8개 행(row) 데이터를 6개 열(column)에 맞게 재구성
+    for (j = 0; j < SSD1306_GLYPH_WIDTH; j++) {
+        u8 col_data = 0;
+        for (row = 0; row < 8; row++) {
+            if ((flipped_char_buffer[row] >> j) & 1)
+                col_data |= (1 << row);
+        }
+        cols[j] = col_data;
     }
+}
+
+/**
+ * ssd1306_draw_text_page - 한 페이지 분량(128열) 버퍼에 텍스트를 그립니다.
+ * @page_buf: 128바이트 열 버퍼 (먼저 0으로 채워짐)
+ * @text: 출력할 문자열
+ */
+void ssd1306_draw_text_page(u8 *page_buf, const char *text)
+{
+    int i;
+    int text_len = strlen(text);
 
-    page_buffer[0] = 0x40;
-    memset(&page_buffer[1], 0x00, 128);
+    memset(page_buf, 0x00, SSD1306_WIDTH);
 
     for (i = 0; i < text_len; i++) {
-        char c = text[i];
-        if (c < 32 || c > 127) c = '?';
-
-        int x_pos = i * 6;
-        if (x_pos + 6 > 128) break;
-
-        const u8 *original_font_char = font6x8_basic[c - 32];
-        
-        // --- 추가: 폰트 데이터를 먼저 좌우 반전시킵니다 ---
-        flip_font_6x8_horizontal(original_font_char, flipped_char_buffer);
-
-        // 폰트의 8개 행(row) 데이터를 6개 열(column)에 맞게 재구성
-        for (j = 0; j < 6; j++) {
-            u8 col_data = 0;
-            // --- 수정: 반전된 폰트(flipped_char_buffer)를 사용합니다 ---
-            if ((flipped_char_buffer[0] >> j) & 1) col_data |= (1 << 0);
-            if ((flipped_char_buffer[1] >> j) & 1) col_data |= (1 << 1);
-            if ((flipped_char_buffer[2] >> j) & 1) col_data |= (1 << 2);
-            if ((flipped_char_buffer[3] >> j) & 1) col_data |= (1 << 3);
-            if ((flipped_char_buffer[4] >> j) & 1) col_data |= (1 << 4);
-            if ((flipped_char_buffer[5] >> j) & 1) col_data |= (1 << 5);
-            if ((flipped_char_buffer[6] >> j) & 1) col_data |= (1 << 6);
-            if ((flipped_char_buffer[7] >> j) & 1) col_data |= (1 << 7);
-            page_buffer[1 + x_pos + j] = col_data;
-        }
+        int x_pos = i * SSD1306_GLYPH_WIDTH;
+        if (x_pos + SSD1306_GLYPH_WIDTH > SSD1306_WIDTH) break;
+
+        ssd1306_glyph_columns(text[i], &page_buf[x_pos]);
     }
+}
 
-    // OLED 커서 이동 및 데이터 전송 로직 (이하 동일)
-    set_pos_cmds[0] = 0x00;
-    set_pos_cmds[1] = 0xB0 | page;
-    set_pos_cmds[2] = 0x00;
-    set_pos_cmds[3] = 0x10;
+/**
+ * ssd1306_render_text - 지정된 페이지(줄)에 텍스트를 수평으로 출력합니다.
+ * @client: I2C 클라이언트 포인터
+ * @text: 출력할 문자열
+ * @page: 출력할 페이지 (0~7)
+ */
+int ssd1306_render_text(struct i2c_client *client,
+                        const char *text,
+                        int page)
+{
+    u8 page_buffer[SSD1306_WIDTH];
 
-    ret = i2c_master_send(client, set_pos_cmds, 4);
-    if (ret < 0) return ret;
+    if (page < 0 || page > 7) {
+        pr_err("smart_env: 잘못된 페이지 번호: %d\n", page);
+        return -EINVAL;
+    }
 
-    ret = i2c_master_send(client, page_buffer, sizeof(page_buffer));
+    ssd1306_draw_text_page(page_buffer, text);
 
-    return ret;
+    return ssd1306_write_window(client, page, 0, page_buffer, SSD1306_WIDTH);
 }
 
 /**
@@ -230,3 +275,233 @@ int ssd1306_render_auto_wrapped(struct i2c_client *client,
 
     return 0;
 }
+
+/**
+ * ssd1306_set_invert - 화면 반전(0xA7) / 정상 표시(0xA6)를 설정합니다.
+ */
+int ssd1306_set_invert(struct i2c_client *client, bool invert)
+{
+    u8 cmd[] = {0x00, invert ? SSD1306_INVERTDISPLAY : SSD1306_NORMALDISPLAY};
+    return i2c_master_send(client, cmd, sizeof(cmd));
+}
+
+/**
+ * ssd1306_start_scroll - 하드웨어 연속 스크롤을 설정하고 시작합니다.
+ * @client: I2C 클라이언트 포인터
+ * @opcode: 0x26/0x27 (수평 좌/우), 0x29/0x2A (수직+수평 대각)
+ * @start_page: 스크롤 시작 페이지 (0~7)
+ * @end_page: 스크롤 끝 페이지 (start_page 이상)
+ * @interval: 스텝 간격 코드 (0~7, 데이터시트 표 참고: 7 = 2프레임으로 가장 빠름)
+ * @vertical_offset: 대각 스크롤 시 스텝당 수직 이동 줄 수 (1~63)
+ *
+ * 한 번 설정하면 컨트롤러가 스스로 화면을 밀어 주므로 애니메이션 한
+ * 스텝당 I2C 전송이 필요 없습니다. 설정 전에 기존 스크롤을 먼저 멈춥니다.
+ */
+int ssd1306_start_scroll(struct i2c_client *client, u8 opcode,
+                         u8 start_page, u8 end_page,
+                         u8 interval, u8 vertical_offset)
+{
+    u8 cmds[] = {
+        0x00, SSD1306_DEACTIVATE_SCROLL,
+        0x00, opcode, 0x00, start_page, interval, end_page, 0x00, 0xFF,
+        0x00, SSD1306_ACTIVATE_SCROLL
+    };
+    int len = sizeof(cmds);
+    int ret;
+
+    if (start_page > 7 || end_page > 7 || end_page < start_page ||
+        interval > 7)
+        return -EINVAL;
+
+    switch (opcode) {
+    case SSD1306_SCROLL_RIGHT:
+    case SSD1306_SCROLL_LEFT:
+        break;
+    case SSD1306_SCROLL_DIAG_RIGHT:
+    case SSD1306_SCROLL_DIAG_LEFT:
+        // 대각 스크롤은 마지막 두 바이트 대신 수직 오프셋 1바이트
+        if (vertical_offset == 0 || vertical_offset > 63)
+            return -EINVAL;
+        cmds[8]  = vertical_offset;
+        cmds[9]  = 0x00;
+        cmds[10] = SSD1306_ACTIVATE_SCROLL;
+        len -= 1;
+        break;
+    default:
+        return -EINVAL;
+    }
+
+    ret = i2c_master_send(client, cmds, len);
+    return ret < 0 ? ret : 0;
+}
+
+/**
+ * ssd1306_stop_scroll - 하드웨어 스크롤을 멈춥니다.
+ *
+ * 멈춘 뒤 스크롤 영역의 GDDRAM은 밀린 상태이므로 다시 써야 합니다.
+ */
+int ssd1306_stop_scroll(struct i2c_client *client)
+{
+    u8 cmd[] = {0x00, SSD1306_DEACTIVATE_SCROLL};
+    int ret = i2c_master_send(client, cmd, sizeof(cmd));
+    return ret < 0 ? ret : 0;
+}
+
+/**
+ * ssd1306_set_vertical_area - 대각 스크롤의 수직 영역(0xA3)을 설정합니다.
+ * @fixed_rows: 위쪽 고정 줄 수
+ * @scroll_rows: 스크롤되는 줄 수 (fixed_rows + scroll_rows <= 64)
+ */
+int ssd1306_set_vertical_area(struct i2c_client *client,
+                              u8 fixed_rows, u8 scroll_rows)
+{
+    u8 cmd[] = {0x00, SSD1306_SET_VSCROLL_AREA, fixed_rows, scroll_rows};
+    int ret;
+
+    if (fixed_rows + scroll_rows > SSD1306_HEIGHT)
+        return -EINVAL;
+
+    ret = i2c_master_send(client, cmd, sizeof(cmd));
+    return ret < 0 ? ret : 0;
+}
+
+/**
+ * ssd1306_set_start_line - 표시 시작 줄(0x40 | line)을 바꿉니다.
+ * @line: 화면 맨 위에 보일 GDDRAM 줄 (0~63)
+ *
+ * 명령 1바이트로 화면 전체를 세로로 굴릴 수 있어 페이지 전환 효과에 씁니다.
+ */
+int ssd1306_set_start_line(struct i2c_client *client, u8 line)
+{
+    u8 cmd[] = {0x00, SSD1306_SETSTARTLINE | (line & 0x3F)};
+    int ret;
+
+    if (line >= SSD1306_HEIGHT)
+        return -EINVAL;
+
+    ret = i2c_master_send(client, cmd, sizeof(cmd));
+    return ret < 0 ? ret : 0;
+}
+
+/*
+ * 프레임 버퍼 그리기 함수
+ *
+ * 아래 함수들은 I2C 전송 없이 페이지 형식 프레임(8페이지 x 128열)에만
+ * 그립니다. 드라이버가 여러 그리기 명령을 모은 뒤 바뀐 구간만 한 번에
+ * 전송할 수 있도록 하기 위함입니다. 화면 밖 좌표는 잘라냅니다.
+ */
+
+/* (x, y)부터 세로 8픽셀 열 하나 중 mask에 해당하는 비트만 덮어씁니다 */
+static void ssd1306_fb_put_column(ssd1306_frame_t frame, int x, int y,
+                                  u8 bits, u8 mask)
+{
+    int page  = y >> 3;
+    int shift = y & 7;
+
+    if (x < 0 || x >= SSD1306_WIDTH || y < 0 || y >= SSD1306_HEIGHT)
+        return;
+
+    bits &= mask;
+    frame[page][x] = (frame[page][x] & (u8)~(mask << shift)) |
+                     (u8)(bits << shift);
+
+    if (shift && page + 1 < SSD1306_PAGES) {
+        frame[page + 1][x] = (frame[page + 1][x] &
+                              (u8)~(mask >> (8 - shift))) |
+                             (u8)(bits >> (8 - shift));
+    }
+}
+
+/**
+ * ssd1306_fb_fill_rect - 사각형 영역을 지우거나(on = 0) 채웁니다(on = 1).
+ */
+void ssd1306_fb_fill_rect(ssd1306_frame_t frame, int x, int y,
+                          int w, int h, int on)
+{
+    int col, row;
+
+    for (col = x; col < x + w; col++) {
+        for (row = y; row < y + h; row += 8) {
+            int rows = min(8, y + h - row);
+            u8 mask  = (u8)((1U << rows) - 1);
+
+            ssd1306_fb_put_column(frame, col, row, on ? 0xFF : 0x00, mask);
+        }
+    }
+}
+
+/**
+ * ssd1306_fb_draw_text - (x, y) 픽셀 위치에 6x8 텍스트를 그립니다.
+ * @len: 그릴 글자 수 (NUL 종료가 필요 없음)
+ *
+ * 글자 셀 배경까지 덮어쓰므로 기존 내용을 먼저 지울 필요가 없습니다.
+ */
+void ssd1306_fb_draw_text(ssd1306_frame_t frame, int x, int y,
+                          const char *text, int len)
+{
+    u8 cols[SSD1306_GLYPH_WIDTH];
+    int i, j;
+
+    for (i = 0; i < len; i++) {
+        int x_pos = x + i * SSD1306_GLYPH_WIDTH;
+        if (x_pos >= SSD1306_WIDTH) break;
+
+        ssd1306_glyph_columns(text[i], cols);
+        for (j = 0; j < SSD1306_GLYPH_WIDTH; j++)
+            ssd1306_fb_put_column(frame, x_pos + j, y, cols[j], 0xFF);
+    }
+}
+
+/**
+ * ssd1306_fb_blit - 페이지 형식 비트맵을 (x, y)에 복사합니다.
+ * @bits: w열 x ceil(h/8)행, 행 우선으로 나열된 열 데이터
+ */
+void ssd1306_fb_blit(ssd1306_frame_t frame, int x, int y,
+                     int w, int h, const u8 *bits)
+{
+    int rows = (h + 7) / 8;
+    int r, c;
+
+    for (r = 0; r < rows; r++) {
+        int height = min(8, h - r * 8);
+        u8 mask    = (u8)((1U << height) - 1);
+
+        for (c = 0; c < w; c++)
+            ssd1306_fb_put_column(frame, x + c, y + r * 8,
+                                  bits[r * w + c], mask);
+    }
+}
+
+/**
+ * ssd1306_text_layout - 텍스트를 21열 x 8줄 글자 셀로 자동 줄바꿈합니다.
+ * @text: 출력할 문자열 ('\n' 줄바꿈)
+ * @cells: 결과 셀, 빈 칸은 공백으로 채움
+ *
+ * ssd1306_render_auto_wrapped()와 같은 규칙(21열, 8줄, '\n' 줄바꿈)입니다.
+ */
+void ssd1306_text_layout(const char *text,
+                         char cells[SSD1306_PAGES][SSD1306_TEXT_COLS])
+{
+    const int max_cols  = SSD1306_TEXT_COLS;
+    const int max_lines = SSD1306_PAGES;
+    int text_len = strlen(text);
+    int idx = 0, line = 0;
+
+    memset(cells, ' ', SSD1306_PAGES * SSD1306_TEXT_COLS);
+
+    while (idx < text_len && line < max_lines) {
+        int copy_len = 0;
+
+        while (copy_len < max_cols &&
+               idx + copy_len < text_len &&
+               text[idx + copy_len] != '\n') {
+            copy_len++;
+        }
+
+        memcpy(cells[line], &text[idx], copy_len);
+
+        idx += copy_len;
+        if (idx < text_len && text[idx] == '\n') idx++;
+        line++;
+    }
+}
@@ -0,0 +1,90 @@
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include "oled_display_list.h"
+
+static i2c_stats_t i2c_stats;
+
+void oled_dl_reset(oled_dl_t *dl) {
+    dl->len = 0;
+    dl->overflow = 0;
+}
+
+// 헤더 + 페이로드를 버퍼 끝에 붙입니다
+static int oled_dl_append(oled_dl_t *dl, int opcode, int x, int y, int w, int h,
+                          int arg, const void *payload, size_t payload_len) {
+    struct oled_op op;
+
+    if (dl->overflow || payload_len > UINT16_MAX ||
+        dl->len + sizeof(op) + payload_len > sizeof(dl->buf)) {
+        dl->overflow = 1;
+        return -1;
+    }
+
+    op.opcode = opcode;
+    op.x = x;
+    op.y = y;
+    op.w = w;
+    op.h = h;
+    op.arg = arg;
+    op.len = payload_len;
+
+    memcpy(dl->buf + dl->len, &op, sizeof(op));
+    dl->len += sizeof(op);
+    if (payload_len) {
+        memcpy(dl->buf + dl->len, payload, payload_len);
+        dl->len += payload_len;
+    }
+    return 0;
+}
+
+int oled_dl_clear(oled_dl_t *dl, int x, int y, int w, int h, int on) {
+    return oled_dl_append(dl, OLED_OP_CLEAR, x, y, w, h, on ? 1 : 0, NULL, 0);
+}
+
+int oled_dl_text(oled_dl_t *dl, int x, int y, const char *text) {
+    return oled_dl_append(dl, OLED_OP_TEXT, x, y, 0, 0, 0, text, strlen(text));
+}
+
+int oled_dl_blit(oled_dl_t *dl, int x, int y, int w, int h, const uint8_t *bits) {
+    return oled_dl_append(dl, OLED_OP_BLIT, x, y, w, h, 0,
+                          bits, (size_t)w * ((h + 7) / 8));
+}
+
+int oled_dl_contrast(oled_dl_t *dl, int contrast) {
+    return oled_dl_append(dl, OLED_OP_CONTRAST, 0, 0, 0, 0, contrast, NULL, 0);
+}
+
+int oled_dl_invert(oled_dl_t *dl, int invert) {
+    return oled_dl_append(dl, OLED_OP_INVERT, 0, 0, 0, 0, invert ? 1 : 0, NULL, 0);
+}
+
+int oled_dl_submit(int fd, const oled_dl_t *dl) {
+    struct oled_display_list list;
+
+    if (dl->overflow || dl->len == 0) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    list.ops = (uint64_t)(uintptr_t)dl->buf;
+    list.len = dl->len;
+    list.reserved = 0;
+
+    uint64_t start = i2c_stats_now_ns();
+    int ret = ioctl(fd, OLED_IOC_SUBMIT, &list);
+    i2c_stats_record(&i2c_stats, start, dl->len, ret >= 0);
+    return ret;
+}
+
+int oled_write_text(int fd, const char *text, size_t len) {
+    uint64_t start = i2c_stats_now_ns();
+    ssize_t n = write(fd, text, len);
+    i2c_stats_record(&i2c_stats, start, len, n >= 0);
+    return n < 0 ? -1 : 0;
+}
+
+void oled_get_i2c_stats(i2c_stats_t *out) {
+    *out = i2c_stats;
+}
@@ -5,17 +5,37 @@
 #include <string.h>
 #include <time.h>
 #include <sys/ioctl.h>
+#include <termios.h>
 #include <gpiod.h>
 #include <signal.h>
 #include "smart_env_monitor.h"
 #include "dht11_sensor.h"
 #include "ds1307_rtc.h"
+#include "rtc_tick.h"
 #include "oled_ioctl.h"
+#include "oled_display_list.h"
+#include "ui_scroll.h"
+#include "ui_widget.h"
+#include "ui_screens.h"
 #include "environment_indicator.h"
+#include "state_store.h"
+#include "sensor_sample.h"
+#include "fixed_point.h"
+#include "comfort_metrics.h"
+#include "history_store.h"
+#include "history_archive.h"
+#include "history_rollup.h"
+#include "env_snapshot.h"
+#include "query_server.h"
+#include "node_uplink.h"
+#include "metrics_server.h"
+#include "sample_scheduler.h"
+#include "sample_filter.h"
+#include "alert_rules.h"
 
 // 디스플레이 모드 정의
 typedef enum {
-    DISPLAY_ROOM = 0,      // "LIVING ROOM" + 환경 지수
+    DISPLAY_ROOM = 0,      // 방 이름 + 환경 지수
     DISPLAY_SENSOR = 1,     // 온습도 값
     DISPLAY_TIME = 2,       // 현재 시간
     DISPLAY_MODE_COUNT = 3
@@ -31,6 +51,47 @@ static struct gpiod_line *sw_line = NULL;
 static int last_clk_state = 1;
 static volatile int running = 1;
 static env_status_t env_status = {0}; // 환경 상태 전역 변수
+static oled_dl_t screen_dl;             // 화면 한 장 분량의 디스플레이 리스트
+static int transition_pending = 0;      // 모드 전환 직후 첫 화면은 롤 전환으로 표시
+static ui_t screen_ui;                  // 위젯 트리 화면 (바뀐 구간만 BLIT)
+
+static ui_screens_t screens;            // 방/센서/시간 화면 위젯 트리
+static char room_name[NODE_ROOM_LEN] = "LIVING ROOM";  // SMART_ENV_ROOM으로 변경
+static rtc_tick_t rtc_tick;             // DS1307 1Hz SQW 소프트웨어 시계
+static int rtc_tick_enabled = 0;        // SQW 배선이 없으면 폴링으로 동작
+static env_state_t saved_state;         // DS1307 NVRAM에 보관하는 마지막 상태
+static int have_sample = 0;             // 마지막 정상 샘플(복원 포함) 존재 여부
+static history_store_t history;         // 센서 이력 링 파일
+static int history_enabled = 0;
+static history_archive_t archive;       // 압축 이력 (장기 보관)
+static int archive_enabled = 0;
+static history_rollup_t rollup;         // 1분/1시간/1일 요약 (추세 화면용)
+static int rollup_enabled = 0;
+static sensor_sample_t last_sample;     // 마지막 샘플 (스냅샷 게시용)
+static env_snapshot_publisher_t snapshot_pub;  // 공유 메모리 현재 상태
+static int snapshot_enabled = 0;
+static query_server_t query_server;     // 로컬 질의/구독 소켓
+static int query_enabled = 0;
+static node_uplink_t uplink;            // 집계 서버로 샘플 전송 (SMART_ENV_AGGREGATOR)
+static int uplink_enabled = 0;
+static metrics_server_t metrics_server; // /metrics 수집 엔드포인트 (별도 스레드)
+static int metrics_enabled = 0;
+static sample_sched_t sampler;          // DHT11 측정 주기 (변화율 기반)
+static int sensor_failing = 0;          // 마지막 읽기 시도 실패
+static sample_filter_t sensor_filter;   // 이상치 제거 + 평활 (화면/판정/이력 앞단)
+static alert_engine_t alert_engine;     // 사용자 경보 규칙 (필터 출력으로 평가)
+static int alerts_enabled = 0;
+static int alert_uart_fd = -1;          // 경보 문장 출력 시리얼 (SMART_ENV_ALERT_UART)
+static char active_alert[ALERT_NAME_LEN];   // 화면에 띄울 발생 중 경보 ("" = 없음)
+
+// SMART_ENV_ALERT_RULES 파일이 없을 때 기본 규칙
+static const char default_alert_rules[] =
+    "high_humidity: humi > 70 for 10m\n"
+    "cold:          temp < 18 for 30m\n"
+    "heating_fast:  temp rises 3 within 15m\n"
+    "door_open:     temp falls 2 within 5m\n";
+
+#define TRANSITION_STEP_US 2000         // 롤 전환 한 줄당 대기 (64줄 ≈ 130ms)
 
 // 함수 선언
 int init_oled_device(void);
@@ -43,6 +104,16 @@ int update_display(void);
 void handle_rotary_rotation(int direction);
 int read_rotary_switch(void);
 void signal_handler(int sig);
+void restore_state(void);
+void record_sample(int temp_centi, int humi_centi, uint16_t filter_flags);
+void save_state(void);
+void publish_snapshot(void);
+void load_node_config(void);
+void start_metrics_server(void);
+void load_alert_rules(void);
+void build_screens(void);
+void process_alerts(int temp_centi, int humi_centi);
+int acquire_sample(void);
 
 // 시그널 핸들러 (Ctrl+C 처리)
 void signal_handler(int sig) {
@@ -51,9 +122,313 @@ void signal_handler(int sig) {
     running = 0;
 }
 
+// NVRAM에서 마지막 상태 복원 (웜 스타트): 모드, 마지막 샘플, 센서 필터, 주의 타이머
+void restore_state(void) {
+    if (state_store_load(&saved_state) != 0) {
+        printf("ℹ️ 저장된 상태 없음 - 기본값으로 시작\n");
+        memset(&saved_state, 0, sizeof(saved_state));
+        return;
+    }
+
+    if (saved_state.display_mode < DISPLAY_MODE_COUNT) {
+        current_mode = (display_mode_t)saved_state.display_mode;
+    }
+
+    if (saved_state.sample_time != 0) {
+        have_sample = 1;
+        last_sample.time = saved_state.sample_time;
+        last_sample.temp_centi = saved_state.temp_centi;
+        last_sample.humi_centi = saved_state.humi_centi;
+        last_sample.flags = SAMPLE_FLAG_STALE | SAMPLE_FLAG_TIME_SYS;
+        dht11_set_last_valid(saved_state.filter_temp_centi,
+                             saved_state.filter_humi_centi,
+                             saved_state.filter_errors);
+        update_environment_status(&env_status, saved_state.temp_centi,
+                                  saved_state.humi_centi);
+    }
+
+    if (saved_state.warning_elapsed_s > 0) {
+        environment_restore_warning(&env_status, saved_state.warning_elapsed_s);
+    }
+
+    char line[96];
+    fx_format(line, sizeof(line), "✅ 저장된 상태 복원: 모드 %d, %.2q°C, %.2q%% (%u초 전)",
+              current_mode + 1, saved_state.temp_centi, saved_state.humi_centi,
+              have_sample ? (unsigned)(time(NULL) - saved_state.sample_time) : 0U);
+    puts(line);
+}
+
+// 정상 샘플을 마지막 값으로 기록 (filter_flags: SAMPLE_FLAG_FILTERED/SUSPECT)
+void record_sample(int temp_centi, int humi_centi, uint16_t filter_flags) {
+    saved_state.temp_centi = sample_clamp_temp(temp_centi);
+    saved_state.humi_centi = sample_clamp_humi(humi_centi);
+    saved_state.sample_time = (uint32_t)time(NULL);
+    have_sample = 1;
+
+    struct timespec now;
+    clock_gettime(CLOCK_REALTIME, &now);
+    sample_set_time(&last_sample, &now);
+    last_sample.temp_centi = saved_state.temp_centi;
+    last_sample.humi_centi = saved_state.humi_centi;
+    last_sample.flags = SAMPLE_FLAG_VALID | SAMPLE_FLAG_TIME_SYS | filter_flags;
+
+    // 이력에 추가 (mmap 복사만, 디스크 반영은 배치 커밋)
+    if (history_enabled) {
+        if (history_store_append(&history, &last_sample) != 0) {
+            fprintf(stderr, "⚠️ 이력 커밋 실패\n");
+        }
+        if (archive_enabled && history_archive_append(&archive, &last_sample) != 0) {
+            fprintf(stderr, "⚠️ 아카이브 블록 봉인 실패\n");
+        }
+        if (rollup_enabled) history_rollup_add(&rollup, &last_sample);
+    }
+    if (uplink_enabled) node_uplink_append(&uplink, &last_sample);
+}
+
+// 스케줄러가 정한 때에만 DHT11 읽기 (화면 모드와 무관)
+// 반환: 1 새 샘플, 0 읽을 때 아님, -1 읽기 실패
+int acquire_sample(void) {
+    dht11_data_t sensor_data = {0};
+    int ok;
+
+    if (!sample_sched_due(&sampler, environment_now_ms()) || !dht11_is_ready_to_read()) {
+        return 0;
+    }
+
+    ok = dht11_read_data(&sensor_data) == 0 && sensor_data.checksum_valid;
+
+    // 체크섬을 통과한 튐도 걸러지도록 표시/판정/이력에는 필터 출력만 씀
+    sensor_sample_t filtered = {
+        .temp_centi = sample_clamp_temp(sensor_data.temp_centi),
+        .humi_centi = sample_clamp_humi(sensor_data.humi_centi),
+        .flags = ok ? SAMPLE_FLAG_VALID : SAMPLE_FLAG_STALE,
+    };
+    sample_filter_update(&sensor_filter, &filtered, environment_now_ms());
+
+    if (ok) {
+        update_environment_status(&env_status, filtered.temp_centi, filtered.humi_centi);
+        record_sample(filtered.temp_centi, filtered.humi_centi,
+                      filtered.flags & (SAMPLE_FLAG_FILTERED | SAMPLE_FLAG_SUSPECT));
+        process_alerts(filtered.temp_centi, filtered.humi_centi);
+        ui_sparkline_push(&screens.temp_spark, filtered.temp_centi);
+    }
+    sensor_failing = !ok;
+
+    // 읽기 자체가 수 ms 걸리므로 끝난 시각 기준으로 다음 측정 예약.
+    // 변화 판단에는 원시 값: 중앙값이 실제 계단 변화를 이상치로 잠시 막는 동안에도
+    // 최소 간격으로 다시 읽어 확인해야 함 (튐이었다면 몇 번 더 읽고 다시 물러남)
+    sample_sched_update(&sampler, &env_status, ok, sample_clamp_temp(sensor_data.temp_centi),
+                        sample_clamp_humi(sensor_data.humi_centi), environment_now_ms());
+    return ok ? 1 : -1;
+}
+
+// 방 이름/집계 서버 설정 (환경 변수, 없으면 단독 동작)
+//   SMART_ENV_ROOM        화면과 집계 서버에 쓰는 방 이름
+//   SMART_ENV_AGGREGATOR  집계 서버 "호스트[:포트]"
+//   SMART_ENV_NODE_ID     노드 ID (없으면 호스트 이름에서 유도)
+void load_node_config(void) {
+    const char *room = getenv("SMART_ENV_ROOM");
+    const char *server = getenv("SMART_ENV_AGGREGATOR");
+    const char *id_str = getenv("SMART_ENV_NODE_ID");
+    char host[64];
+    uint16_t port = NODE_DEFAULT_PORT;
+    uint32_t node_id = 0;
+
+    if (room && room[0]) {
+        strncpy(room_name, room, sizeof(room_name) - 1);
+        room_name[sizeof(room_name) - 1] = '\0';
+    }
+    if (!server || !server[0]) return;
+
+    strncpy(host, server, sizeof(host) - 1);
+    host[sizeof(host) - 1] = '\0';
+    char *colon = strchr(host, ':');
+    if (colon) {
+        *colon = '\0';
+        port = (uint16_t)atoi(colon + 1);
+    }
+
+    if (id_str) {
+        node_id = (uint32_t)strtoul(id_str, NULL, 0);
+    } else {
+        // 보드마다 호스트 이름이 다르므로 FNV-1a 해시를 기본 ID로
+        char name[64] = "";
+        gethostname(name, sizeof(name) - 1);
+        node_id = 2166136261u;
+        for (const char *c = name; *c; c++) node_id = (node_id ^ (uint8_t)*c) * 16777619u;
+        if (node_id == 0) node_id = 1;
+    }
+
+    if (node_uplink_open(&uplink, host, port, node_id, room_name) == 0) {
+        uplink_enabled = 1;
+        printf("✅ 집계 서버 전송: %s:%u (노드 %u, %s)\n", host, port, node_id, room_name);
+    }
+}
+
+// Prometheus 수집 엔드포인트 (공유 메모리 스냅샷을 읽으므로 게시자가 열린 뒤에)
+//   SMART_ENV_METRICS_ADDR  수신 주소 (기본 127.0.0.1, 외부 수집기는 0.0.0.0)
+//   SMART_ENV_METRICS_PORT  포트 (기본 9464, 0 = 끔)
+void start_metrics_server(void) {
+    const char *addr = getenv("SMART_ENV_METRICS_ADDR");
+    const char *port_str = getenv("SMART_ENV_METRICS_PORT");
+    uint16_t port = METRICS_SERVER_DEFAULT_PORT;
+
+    if (!addr || !addr[0]) addr = METRICS_SERVER_DEFAULT_ADDR;
+    if (port_str && port_str[0]) port = (uint16_t)atoi(port_str);
+    if (port == 0) return;
+
+    if (metrics_server_start(&metrics_server, addr, port, ENV_SNAPSHOT_NAME, room_name) == 0) {
+        metrics_enabled = 1;
+        printf("✅ 메트릭 엔드포인트: http://%s:%u/metrics\n", addr, port);
+    }
+}
+
+// 경보 규칙과 출력 준비 (환경 변수)
+//   SMART_ENV_ALERT_RULES  규칙 파일 (없으면 기본 규칙)
+//   SMART_ENV_ALERT_UART   경보 문장을 한 줄씩 보낼 시리얼 장치 (115200 8N1)
+void load_alert_rules(void) {
+    const char *path = getenv("SMART_ENV_ALERT_RULES");
+    const char *uart = getenv("SMART_ENV_ALERT_UART");
+    int n;
+
+    alert_engine_init(&alert_engine);
+    n = (path && path[0]) ? alert_engine_load(&alert_engine, path)
+                          : alert_engine_compile(&alert_engine, default_alert_rules);
+    if (n <= 0 || alert_engine_finalize(&alert_engine, 0) != 0) {
+        printf("⚠️ 경보 규칙 비활성화\n");
+        alert_engine_free(&alert_engine);
+        return;
+    }
+    alerts_enabled = 1;
+    printf("✅ 경보 규칙 %d개 (%s)\n", alert_engine.count, (path && path[0]) ? path : "기본");
+
+    if (!uart || !uart[0]) return;
+
+    // 전송이 막혀도 측정 루프가 기다리지 않도록 논블로킹 (넘치면 버림)
+    alert_uart_fd = open(uart, O_WRONLY | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+    if (alert_uart_fd < 0) {
+        perror("⚠️ 경보 UART 열기 실패");
+        return;
+    }
+    struct termios tio;
+    if (tcgetattr(alert_uart_fd, &tio) == 0) {
+        tio.c_iflag = 0;
+        tio.c_oflag = 0;
+        tio.c_lflag = 0;
+        tio.c_cflag = CS8 | CREAD | CLOCAL;
+        cfsetispeed(&tio, B115200);
+        cfsetospeed(&tio, B115200);
+        tcsetattr(alert_uart_fd, TCSANOW, &tio);
+    }
+    printf("✅ 경보 UART: %s\n", uart);
+}
+
+// 필터를 거친 정상 샘플로 경보 평가, 상태가 바뀐 규칙을 콘솔/UART/구독자에게
+void process_alerts(int temp_centi, int humi_centi) {
+    alert_event_t events[16];
+    char line[64];
+    int n;
+
+    if (!alerts_enabled) return;
+
+    n = alert_engine_update(&alert_engine, environment_now_ms(), temp_centi, humi_centi,
+                            events, (int)(sizeof(events) / sizeof(events[0])));
+    for (int i = 0; i < n; i++) {
+        const alert_rule_t *rule = &alert_engine.rules[events[i].rule];
+        int len = alert_format_event(&alert_engine, &events[i], line, sizeof(line) - 1);
+
+        printf("%s %s\n", events[i].active ? "🚨" : "✅", line);
+        if (alert_uart_fd >= 0 && len > 0) {
+            line[len++] = '\n';
+            if (write(alert_uart_fd, line, (size_t)len) != len) {
+                fprintf(stderr, "⚠️ 경보 UART 전송 누락\n");
+            }
+        }
+        if (query_enabled) {
+            qs_alert_t qa;
+
+            memset(&qa, 0, sizeof(qa));
+            qa.time = (uint32_t)time(NULL);
+            qa.value = events[i].value;
+            qa.rule = events[i].rule;
+            qa.active = events[i].active;
+            strncpy(qa.name, rule->name, sizeof(qa.name) - 1);
+            query_server_alert(&query_server, &qa);
+        }
+    }
+    if (n == 0) return;
+
+    // 화면에는 발생 중인 첫 번째 규칙 (상태가 바뀐 때만 훑음)
+    active_alert[0] = '\0';
+    for (int i = 0; i < alert_engine.count; i++) {
+        if (alert_engine.rules[i].active) {
+            strncpy(active_alert, alert_engine.rules[i].name, sizeof(active_alert) - 1);
+            active_alert[sizeof(active_alert) - 1] = '\0';
+            break;
+        }
+    }
+}
+
+// 현재 상태를 저장소에 반영 (변경 시에만, 최소 간격 제한은 state_store가 담당)
+void save_state(void) {
+    int filter_temp, filter_humi, filter_errors;
+
+    dht11_get_last_valid(&filter_temp, &filter_humi, &filter_errors);
+
+    int elapsed = environment_warning_elapsed_s(&env_status);
+
+    saved_state.display_mode = (uint8_t)current_mode;
+    saved_state.env_level = (uint8_t)env_status.overall_level;
+    saved_state.warning_elapsed_s = elapsed > 0xFFFF ? 0xFFFF : (uint16_t)elapsed;
+    saved_state.filter_temp_centi = sample_clamp_temp(filter_temp);
+    saved_state.filter_humi_centi = sample_clamp_humi(filter_humi);
+    saved_state.filter_errors = filter_errors > 0xFF ? 0xFF : (uint8_t)filter_errors;
+
+    state_store_update(&saved_state);
+    state_store_flush(0);
+}
+
+// 현재 상태를 공유 메모리와 질의 서버에 게시 (바뀌었을 때만)
+void publish_snapshot(void) {
+    static env_snapshot_t published;
+    env_snapshot_t snap;
+    dht11_stats_t stats;
+    int filter_temp, filter_humi, filter_errors;
+
+    if ((!snapshot_enabled && !query_enabled) || !have_sample) return;
+
+    dht11_get_stats(&stats);
+    dht11_get_last_valid(&filter_temp, &filter_humi, &filter_errors);
+
+    memset(&snap, 0, sizeof(snap));
+    snap.sample = last_sample;
+    snap.temp_level = (uint8_t)env_status.temp_level;
+    snap.humi_level = (uint8_t)env_status.humi_level;
+    snap.overall_level = (uint8_t)env_status.overall_level;
+    snap.prolonged_warning = (uint8_t)env_status.prolonged_warning;
+    snap.warning_elapsed_s = (uint32_t)environment_warning_elapsed_s(&env_status);
+    snap.reads_ok = stats.reads_ok;
+    snap.reads_failed = stats.reads_failed;
+    snap.retries = stats.retries;
+    snap.timeout_errors = stats.timeout_errors;
+    snap.checksum_errors = stats.checksum_errors;
+    snap.range_errors = stats.range_errors;
+    snap.consecutive_errors = (uint32_t)filter_errors;
+    snap.display_mode = (uint32_t)current_mode;
+    snap.sample_interval_ms = sampler.stats.interval_ms;
+    snap.sample_avg_interval_ms = sampler.stats.avg_interval_ms;
+    ds1307_get_i2c_stats(&snap.rtc_i2c);
+    oled_get_i2c_stats(&snap.oled_i2c);
+
+    if (memcmp(&snap, &published, sizeof(snap)) == 0) return;
+    if (snapshot_enabled) env_snapshot_publish(&snapshot_pub, &snap);
+    if (query_enabled) query_server_update(&query_server, &snap);    // 새 샘플이면 구독자에게 PUSH
+    published = snap;
+}
+
 // OLED 디바이스 초기화
 int init_oled_device(void) {
-    oled_fd = open("/dev/oled_display", O_RDWR);
+    oled_fd = open(OLED_DEVICE_PATH, O_RDWR);
     if (oled_fd < 0) {
         perror("❌ OLED 디바이스 열기 실패");
         printf("💡 커널 모듈이 로드되었는지 확인: lsmod | grep oled\n");
@@ -129,11 +504,58 @@ void cleanup_resources(void) {
         chip = NULL;
     }
     if (oled_fd >= 0) {
+        ui_ticker_stop(oled_fd);
         close(oled_fd);
         oled_fd = -1;
     }
 
     // 센서 정리
+    if (rtc_tick_enabled) {
+        rtc_tick_cleanup(&rtc_tick);
+        rtc_tick_enabled = 0;
+    }
+    if (alert_uart_fd >= 0) {
+        close(alert_uart_fd);
+        alert_uart_fd = -1;
+    }
+    if (alerts_enabled) {
+        alert_engine_free(&alert_engine);
+        alerts_enabled = 0;
+    }
+    if (uplink_enabled) {
+        node_uplink_close(&uplink);
+        uplink_enabled = 0;
+    }
+    if (metrics_enabled) {
+        metrics_server_stop(&metrics_server);
+        metrics_enabled = 0;
+    }
+    if (query_enabled) {
+        query_server_close(&query_server);
+        query_enabled = 0;
+    }
+    if (snapshot_enabled) {
+        env_snapshot_publisher_close(&snapshot_pub);
+        snapshot_enabled = 0;
+    }
+    // 커밋 안 된 이력 반영
+    if (rollup_enabled) {
+        history_rollup_close(&rollup);
+        rollup_enabled = 0;
+    }
+    if (archive_enabled) {
+        history_archive_close(&archive);
+        archive_enabled = 0;
+    }
+    if (history_enabled) {
+        history_store_close(&history);
+        history_enabled = 0;
+    }
+
+    // 종료 직전 상태는 간격 제한 없이 NVRAM에 기록
+    if (state_store_flush(1) < 0) {
+        fprintf(stderr, "⚠️ 상태 저장 실패\n");
+    }
     dht11_cleanup();
     ds1307_cleanup();
     gpio_cleanup();
@@ -141,31 +563,65 @@ void cleanup_resources(void) {
     printf("✅ 리소스 정리 완료\n");
 }
 
+// 화면 위젯 트리 구성 (한 번만, 이후에는 값만 바꿈)
+void build_screens(void) {
+    ui_init(&screen_ui);
+    ui_screens_build(&screens, room_name);
+}
+
+// 위젯 트리 화면 표시
+// 평소에는 바뀐 위젯의 열 구간만 BLIT 한 번 (바뀐 것이 없으면 시스템 콜 없음)
+// 모드 전환 직후에는 새 화면 전체를 그려 롤 전환
+static int submit_screen(ui_widget_t *root) {
+    ui_set_root(&screen_ui, root);
+
+    if (transition_pending) {
+        transition_pending = 0;
+        ui_render(&screen_ui);
+        ui_damage_clear(&screen_ui);
+        if (ui_transition_roll(oled_fd, &screen_dl, screen_ui.fb, TRANSITION_STEP_US) < 0) {
+            ui_invalidate(&screen_ui);
+            return -1;
+        }
+        return 0;
+    }
+
+    return ui_flush(&screen_ui, oled_fd, &screen_dl) < 0 ? -1 : 0;
+}
+
 // 방 이름과 환경 지수 출력
 int display_room_name(void) {
-    char command_buffer[128];
+    int temp_centi, humi_centi;
+    comfort_metrics_t comfort;
     
-    // 최신 센서 데이터로 환경 상태 업데이트
-    dht11_data_t sensor_data;
-    if (dht11_is_ready_to_read() && dht11_read_data(&sensor_data) == 0 && sensor_data.checksum_valid) {
-        update_environment_status(&env_status, sensor_data.temperature, sensor_data.humidity);
+    // 마지막 샘플 (측정과 환경 상태 갱신은 acquire_sample이 담당, 재부팅 직후엔 NVRAM 복원값)
+    if (have_sample) {
+        temp_centi = saved_state.temp_centi;
+        humi_centi = saved_state.humi_centi;
     } else {
-        // 센서 오류 시 기본값
-        update_environment_status(&env_status, 22.0f, 50.0f);
+        // 샘플이 전혀 없으면 기본값
+        temp_centi = FX_CENTI_FROM_INT(22);
+        humi_centi = FX_CENTI_FROM_INT(50);
     }
 
-    // 방 이름과 환경 지수를 멀티라인으로 표시
-    snprintf(command_buffer, sizeof(command_buffer),
-            "LIVING ROOM\n%s %s",
-            get_level_icon(env_status.overall_level),
-            get_level_text(env_status.overall_level));
+    // 이슬점/체감 온도/절대 습도 (룩업 테이블 보간)
+    comfort_compute(temp_centi, humi_centi, &comfort);
+
+    // 값이 같은 위젯은 다시 그리지 않음 (경보가 있으면 체감 온도 자리에)
+    ui_screens_room(&screens, room_name, env_status.overall_level,
+                    get_level_text(env_status.overall_level), &comfort, active_alert);
 
-    // 명령어 전송
-    if (write(oled_fd, command_buffer, strlen(command_buffer)) < 0) {
+    // 화면 제출
+    if (submit_screen(&screens.room_screen) < 0) {
         perror("❌ 방 이름 출력 실패");
         return -1;
     }
 
+    // 긴 방 이름은 하드웨어 스크롤 티커로 흘림 (이후 갱신에 전송 없음)
+    if (strlen(room_name) > UI_TICKER_MIN_LEN && !ui_ticker_active()) {
+        ui_ticker_start(oled_fd, &screen_dl, 0, room_name, UI_TICKER_NORMAL);
+    }
+
     printf("📺 디스플레이 모드 1: 방 이름 + 환경지수 (%s %s)\n", 
            (env_status.overall_level == ENV_GOOD) ? "😊" : 
            (env_status.overall_level == ENV_WARNING) ? "😐" : "😞", 
@@ -175,35 +631,34 @@ int display_room_name(void) {
     if (env_status.prolonged_warning) {
         printf("⚠️  장기간 주의상태로 인한 위험 승격!\n");
     }
+    if (active_alert[0]) {
+        printf("🚨 경보 발생 중: %s\n", active_alert);
+    }
     
     return 0;
 }
 
 // 센서 데이터 출력 (멀티라인)
 int display_sensor_data(void) {
-    dht11_data_t sensor_data;
-    char command_buffer[128];
-
-    // DHT11 데이터 읽기
-    if (dht11_is_ready_to_read() && dht11_read_data(&sensor_data) == 0 && sensor_data.checksum_valid) {
-        // 환경 상태 업데이트
-        update_environment_status(&env_status, sensor_data.temperature, sensor_data.humidity);
-        
-        snprintf(command_buffer, sizeof(command_buffer),
-                "T & H\nTEMP: %.1f C\nHUM : %.1f%%",
-                sensor_data.temperature,
-                sensor_data.humidity);
-
-        printf("📺 디스플레이 모드 2: 센서 데이터 (%.1f°C, %.1f%%)\n",
-               sensor_data.temperature, sensor_data.humidity);
+    const char *temp_text = screens.temp_big.u.text.text;
+    const char *humi_text = screens.humi_value.u.text.text;
+    ui_sensor_state_t state;
+
+    if (!have_sample) state = UI_SENSOR_NONE;
+    else if (!sensor_failing && (last_sample.flags & SAMPLE_FLAG_VALID)) state = UI_SENSOR_LIVE;
+    else state = UI_SENSOR_STALE;     // 재부팅 직후엔 NVRAM 복원값
+    ui_screens_sensor(&screens, state, saved_state.temp_centi, saved_state.humi_centi);
+
+    if (state == UI_SENSOR_LIVE) {
+        printf("📺 디스플레이 모드 2: 센서 데이터 (%sC, %s)\n", temp_text, humi_text);
+    } else if (state == UI_SENSOR_STALE) {
+        printf("📺 디스플레이 모드 2: 마지막 값 (%sC, %s)\n", temp_text, humi_text);
     } else {
-        snprintf(command_buffer, sizeof(command_buffer), 
-                "T & H\nTEMP: ERROR\nHUM : ERROR");
         printf("📺 디스플레이 모드 2: 센서 오류\n");
     }
 
-    // 센서 명령어 전송
-    if (write(oled_fd, command_buffer, strlen(command_buffer)) < 0) {
+    // 화면 제출
+    if (submit_screen(&screens.sensor_screen) < 0) {
         perror("❌ 센서 데이터 출력 실패");
         return -1;
     }
@@ -214,25 +669,21 @@ int display_sensor_data(void) {
 // 현재 시간 출력 (멀티라인)
 int display_current_time(void) {
     struct tm current_time;
-    char command_buffer[128];
 
-    // RTC에서 시간 읽기 (실패 시 시스템 시간 사용)
-    if (ds1307_read_time(&current_time) != 0) {
+    // SQW 틱이 있으면 소프트웨어 시계 사용 (매초 RTC 읽기 없음)
+    // 없으면 RTC에서 시간 읽기 (실패 시 시스템 시간 사용)
+    if (rtc_tick_enabled) {
+        current_time = rtc_tick.now;
+    } else if (ds1307_read_time(&current_time) != 0) {
         time_t now = time(NULL);
         current_time = *localtime(&now);
     }
 
-    snprintf(command_buffer, sizeof(command_buffer),
-            "TIME\n%04d-%02d-%02d\n%02d:%02d:%02d",
-            current_time.tm_year + 1900,
-            current_time.tm_mon + 1,
-            current_time.tm_mday,
-            current_time.tm_hour,
-            current_time.tm_min,
-            current_time.tm_sec);
+    // 초만 바뀌면 작은 초 글자 열만 전송 (큰 시:분은 분마다 한 번)
+    ui_screens_time(&screens, &current_time);
 
-    // 시간 명령어 전송
-    if (write(oled_fd, command_buffer, strlen(command_buffer)) < 0) {
+    // 화면 제출
+    if (submit_screen(&screens.time_screen) < 0) {
         perror("❌ 시간 정보 출력 실패");
         return -1;
     }
@@ -269,7 +720,8 @@ void handle_rotary_rotation(int direction) {
         printf("🔄 반시계방향 회전: 모드 %d\n", current_mode + 1);
     }
 
-    // 디스플레이 업데이트
+    // 디스플레이 업데이트 (티커 정지 + 시작 줄 롤 전환)
+    transition_pending = 1;
     update_display();
 }
 
@@ -340,6 +792,64 @@ int main(void) {
         return 1;
     }
 
+    // NVRAM에 남은 마지막 상태로 웜 스타트
+    restore_state();
+    load_node_config();
+    sample_sched_init(&sampler, NULL, env_status.config, environment_now_ms());
+    sample_filter_init(&sensor_filter, NULL);
+    if (have_sample) {
+        // 저장된 샘플은 필터 출력이므로 필터를 거기서 이어 감 (첫 읽기도 변화율 제한)
+        int64_t age_ms = (int64_t)(time(NULL) - (time_t)saved_state.sample_time) * 1000;
+        sample_filter_seed(&sensor_filter, saved_state.temp_centi, saved_state.humi_centi,
+                           environment_now_ms() - (age_ms > 0 ? age_ms : 0));
+    }
+    load_alert_rules();
+    build_screens();
+
+    // 센서 이력 저장소 (선택 사항)
+    if (history_store_open(&history, HISTORY_STORE_DEFAULT_PATH, HISTORY_STORE_DEFAULT_CAPACITY) == 0) {
+        history_enabled = 1;
+        printf("✅ 센서 이력: %s (%u개 보관 중)\n", HISTORY_STORE_DEFAULT_PATH,
+               history_store_count(&history));
+        if (history_archive_open(&archive, HISTORY_ARCHIVE_DEFAULT_PATH,
+                                 HISTORY_ARCHIVE_DEFAULT_BLOCKS) == 0) {
+            archive_enabled = 1;
+            printf("✅ 압축 아카이브: %s (%u블록)\n", HISTORY_ARCHIVE_DEFAULT_PATH,
+                   history_archive_block_count(&archive));
+            // 비정상 종료로 잃은 봉인 전 블록을 원본 링에서 다시 채움
+            int refilled = history_archive_backfill(&archive, &history);
+            if (refilled > 0) printf("ℹ️ 아카이브에 샘플 %d개 다시 추가\n", refilled);
+            else if (refilled < 0) fprintf(stderr, "⚠️ 아카이브 블록 봉인 실패\n");
+        }
+        if (history_rollup_open(&rollup, HISTORY_ROLLUP_DEFAULT_PATH, &history) == 0) {
+            rollup_enabled = 1;
+            printf("✅ 다중 해상도 요약: %s (1분 구간 %u개)\n", HISTORY_ROLLUP_DEFAULT_PATH,
+                   history_rollup_count(&rollup, ROLLUP_MINUTE));
+        }
+    } else {
+        printf("⚠️ 센서 이력 저장 비활성화\n");
+    }
+
+    // 다른 로컬 프로세스용 현재 상태 공유 (선택 사항)
+    if (env_snapshot_publisher_open(&snapshot_pub, ENV_SNAPSHOT_NAME) == 0) {
+        snapshot_enabled = 1;
+        printf("✅ 현재 상태 공유: /dev/shm%s\n", ENV_SNAPSHOT_NAME);
+    }
+    if (query_server_open(&query_server, QUERY_SERVER_DEFAULT_PATH,
+                          history_enabled ? &history : NULL) == 0) {
+        query_enabled = 1;
+        printf("✅ 질의/구독 소켓: %s\n", QUERY_SERVER_DEFAULT_PATH);
+    }
+    if (snapshot_enabled) start_metrics_server();
+
+    // DS1307 1Hz SQW 틱 (선택 사항)
+    if (rtc_tick_init(&rtc_tick, GPIO_DS1307_SQW) == 0) {
+        rtc_tick_enabled = 1;
+        printf("✅ DS1307 SQW 1Hz 틱 사용 (GPIO %d)\n", GPIO_DS1307_SQW);
+    } else {
+        printf("⚠️ SQW 틱 사용 불가 - 50ms 폴링으로 시간 갱신\n");
+    }
+
     // OLED 디바이스 초기화
     if (init_oled_device() != 0) {
         cleanup_resources();
@@ -373,6 +883,7 @@ int main(void) {
     printf("   온도 적정: 20~26°C, 주의: 18~28°C\n");
     printf("   습도 적정: 40~60%%, 주의: 30~70%%\n");
     printf("   ⚠️ 주의상태 10초 이상 → 위험으로 승격\n");
+    printf("   📈 측정 주기: 변화/경계 근처 3초, 안정 시 최대 60초\n");
     printf("🛑 종료: Ctrl+C\n");
     printf("=====================================\n\n");
 
@@ -382,24 +893,44 @@ int main(void) {
         // 로터리 스위치 상태 확인
         read_rotary_switch();
 
+        // 대기: SQW 틱이 있으면 초 경계에서 바로 깨어남 (최대 50ms, 로터리 반응성)
+        int seconds = 0;
+        if (rtc_tick_enabled) {
+            seconds = rtc_tick_wait(&rtc_tick, 50);
+            if (seconds < 0) {
+                perror("⚠️ SQW 틱 대기 실패 - 폴링으로 전환");
+                rtc_tick_cleanup(&rtc_tick);
+                rtc_tick_enabled = 0;
+                seconds = 0;
+            }
+        } else {
+            usleep(50000);  // 50ms 대기 (반응성과 CPU 사용률 균형)
+        }
+
+        // 센서 측정: 변할 때는 3초, 안정되면 최대 60초 간격 (모든 모드에서)
+        int sampled = acquire_sample();
+
         // 주기적 업데이트
         time_t now = time(NULL);
-        
-        if (current_mode == DISPLAY_ROOM && now - last_update >= 3) {  
-            // 방 이름 모드: 3초마다 환경지수 업데이트
-            update_display();
-            last_update = now;
-        } else if (current_mode == DISPLAY_SENSOR && now - last_update >= 5) {  
-            // 센서 모드: 5초마다 업데이트
+
+        if ((current_mode == DISPLAY_ROOM || current_mode == DISPLAY_SENSOR) && sampled != 0) {
+            // 방 이름/센서 모드: 측정할 때마다 (실패면 마지막 값 표시)
             update_display();
             last_update = now;
-        } else if (current_mode == DISPLAY_TIME && now - last_update >= 1) {  
-            // 시간 모드: 1초마다 업데이트
+        } else if (current_mode == DISPLAY_TIME &&
+                   (rtc_tick_enabled ? seconds > 0 : now - last_update >= 1)) {
+            // 시간 모드: RTC 틱마다 (틱 없으면 1초마다) 업데이트
             update_display();
             last_update = now;
         }
 
-        usleep(50000);  // 50ms 대기 (반응성과 CPU 사용률 균형)
+        // 상태 보관 (변경 시 최소 10초 간격으로만 NVRAM 기록)
+        save_state();
+        publish_snapshot();
+
+        // 로컬 클라이언트 요청 처리 (기다리지 않음)
+        if (query_enabled) query_server_poll(&query_server, 0);
+        if (uplink_enabled) node_uplink_poll(&uplink);
     }
 
     cleanup_resources();
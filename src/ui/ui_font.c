@@ -0,0 +1,18 @@
+#include "ui_font.h"
+#include "font_atlas.h"         // 빌드 시 scripts/gen_font_atlas로 생성
+
+#define UI_FONT(name, w, h) {                   \
+    .width = (w),                               \
+    .pages = (h) / 8,                           \
+    .glyph_bytes = (w) * (h) / 8,               \
+    .index = name##_index,                      \
+    .atlas = &name##_atlas[0][0],               \
+}
+
+_Static_assert(sizeof(font_6x8_atlas[0]) == 6, "6x8 atlas layout");
+_Static_assert(sizeof(font_12x16_atlas[0]) == 24, "12x16 atlas layout");
+_Static_assert(sizeof(font_24x32_atlas[0]) == 96, "24x32 atlas layout");
+
+const ui_font_t ui_font_6x8 = UI_FONT(font_6x8, 6, 8);
+const ui_font_t ui_font_12x16 = UI_FONT(font_12x16, 12, 16);
+const ui_font_t ui_font_24x32 = UI_FONT(font_24x32, 24, 32);
@@ -0,0 +1,142 @@
+#include <string.h>
+#include "ui_screens.h"
+#include "fixed_point.h"
+
+// 환경 등급 얼굴 8x8 (페이지 형식 열 데이터, bit0 = 맨 윗줄)
+static const uint8_t level_icons[3][8] = {
+    { 0x7E, 0x81, 0x95, 0xA1, 0xA1, 0x95, 0x81, 0x7E },    // ENV_GOOD    :)
+    { 0x7E, 0x81, 0xA5, 0xA1, 0xA1, 0xA5, 0x81, 0x7E },    // ENV_WARNING :|
+    { 0x7E, 0x81, 0xA5, 0x91, 0x91, 0xA5, 0x81, 0x7E },    // ENV_DANGER  :(
+};
+
+// ui_value_set은 서식 포인터로 변화를 판단하므로 서식은 한 곳에서만
+static const char FMT_DEW[] = "DEW %qC";
+static const char FMT_AH[] = "AH %qg";
+static const char FMT_FEEL[] = "FEELS %qC";
+static const char FMT_TEMP[] = "%q";
+static const char FMT_HUMI[] = "%q%%";
+
+void ui_screens_build(ui_screens_t *s, const char *room_name) {
+    ui_box_init(&s->room_screen, UI_VBOX, 0, 0);
+    ui_label_init(&s->room_label, 0, room_name);
+    ui_box_init(&s->level_row, UI_HBOX, 0, UI_LINE_H);
+    ui_icon_init(&s->level_icon, 12, level_icons[0], 8, 8);
+    ui_label_init(&s->level_label, 0, "");
+    ui_box_init(&s->comfort_row, UI_HBOX, 0, UI_LINE_H);
+    ui_value_init(&s->dew_value, 11 * UI_GLYPH_W, FMT_DEW);
+    ui_value_init(&s->ah_value, 0, FMT_AH);
+    ui_value_init(&s->feel_value, 0, FMT_FEEL);
+    ui_label_init(&s->alert_label, 0, "");
+    ui_widget_set_visible(&s->alert_label, 0);
+    ui_add(&s->level_row, &s->level_icon);
+    ui_add(&s->level_row, &s->level_label);
+    ui_add(&s->comfort_row, &s->dew_value);
+    ui_add(&s->comfort_row, &s->ah_value);
+    ui_add(&s->room_screen, &s->room_label);
+    ui_add(&s->room_screen, &s->level_row);
+    ui_add(&s->room_screen, &s->comfort_row);
+    ui_add(&s->room_screen, &s->feel_value);
+    ui_add(&s->room_screen, &s->alert_label);
+
+    // 페이지 0~3: 24x32 온도 "-40.0"까지 + 작은 "C", 페이지 4~5: 12x16 습도 + 막대
+    // 남은 2페이지는 온도 추이 (측정마다 한 점, 2°C 폭 이하는 평평하게)
+    // 센서 오류/마지막 값 안내는 필요할 때만 추이 위에 한 줄
+    ui_box_init(&s->sensor_screen, UI_VBOX, 0, 0);
+    ui_box_init(&s->temp_row, UI_HBOX, 0, 32);
+    ui_value_init(&s->temp_big, 5 * 24, FMT_TEMP);
+    ui_widget_set_font(&s->temp_big, &ui_font_24x32);
+    ui_label_init(&s->temp_unit, 0, "C");
+    ui_add(&s->temp_row, &s->temp_big);
+    ui_add(&s->temp_row, &s->temp_unit);
+    ui_box_init(&s->humi_row, UI_HBOX, 0, 16);
+    ui_value_init(&s->humi_value, 6 * 12, FMT_HUMI);
+    ui_widget_set_font(&s->humi_value, &ui_font_12x16);
+    ui_bar_init(&s->humi_bar, 0, 12, 0, FX_CENTI_FROM_INT(100));
+    ui_add(&s->humi_row, &s->humi_value);
+    ui_add(&s->humi_row, &s->humi_bar);
+    ui_label_init(&s->sensor_note, 0, "");
+    ui_widget_set_visible(&s->sensor_note, 0);
+    ui_sparkline_init(&s->temp_spark, 0, 0, FX_CENTI_FROM_INT(2));
+    ui_add(&s->sensor_screen, &s->temp_row);
+    ui_add(&s->sensor_screen, &s->humi_row);
+    ui_add(&s->sensor_screen, &s->sensor_note);
+    ui_add(&s->sensor_screen, &s->temp_spark);
+
+    // 페이지 0: 제목 + 날짜, 페이지 1~4: 24x32 "HH:MM", 페이지 5~6: 12x16 ":SS"
+    ui_box_init(&s->time_screen, UI_VBOX, 0, 0);
+    ui_box_init(&s->time_head, UI_HBOX, 0, UI_LINE_H);
+    ui_label_init(&s->time_title, 36, "TIME");
+    ui_label_init(&s->date_label, 0, "");
+    ui_add(&s->time_head, &s->time_title);
+    ui_add(&s->time_head, &s->date_label);
+    ui_label_init(&s->time_label, 0, "");
+    ui_widget_set_font(&s->time_label, &ui_font_24x32);
+    ui_box_init(&s->sec_row, UI_HBOX, 0, 16);
+    ui_label_init(&s->sec_pad, 84, "");
+    ui_label_init(&s->sec_label, 0, "");
+    ui_widget_set_font(&s->sec_label, &ui_font_12x16);
+    ui_add(&s->sec_row, &s->sec_pad);
+    ui_add(&s->sec_row, &s->sec_label);
+    ui_add(&s->time_screen, &s->time_head);
+    ui_add(&s->time_screen, &s->time_label);
+    ui_add(&s->time_screen, &s->sec_row);
+}
+
+void ui_screens_room(ui_screens_t *s, const char *room_name, int level, const char *level_text,
+                     const comfort_metrics_t *comfort, const char *alert) {
+    char alert_line[UI_TEXT_MAX + 1];
+
+    // 값이 같은 위젯은 다시 그리지 않음
+    ui_label_set(&s->room_label, room_name);
+    ui_icon_set(&s->level_icon, level_icons[level < 0 ? 0 : level > 2 ? 2 : level]);
+    ui_label_set(&s->level_label, level_text);
+    ui_value_set(&s->dew_value, FMT_DEW, comfort->dew_point_centi);
+    ui_value_set(&s->ah_value, FMT_AH, comfort->abs_humidity_centi);
+    ui_value_set(&s->feel_value, FMT_FEEL, comfort->heat_index_centi);
+
+    // 발생 중인 경보가 있으면 체감 온도 자리에 규칙 이름 (배치만 바뀜)
+    ui_widget_set_visible(&s->feel_value, !alert[0]);
+    ui_widget_set_visible(&s->alert_label, alert[0] != '\0');
+    if (alert[0]) {
+        fx_format(alert_line, sizeof(alert_line), "! %s", alert);
+        ui_label_set(&s->alert_label, alert_line);
+    }
+}
+
+void ui_screens_sensor(ui_screens_t *s, ui_sensor_state_t state, int temp_centi, int humi_centi) {
+    switch (state) {
+    case UI_SENSOR_LIVE:
+    case UI_SENSOR_STALE:
+        ui_value_set(&s->temp_big, FMT_TEMP, temp_centi);
+        ui_value_set(&s->humi_value, FMT_HUMI, humi_centi);
+        ui_bar_set(&s->humi_bar, humi_centi);
+        // 센서 오류 시 마지막 샘플 표시 (재부팅 직후엔 NVRAM 복원값)
+        if (state == UI_SENSOR_STALE) ui_label_set(&s->sensor_note, "LAST VALUE");
+        ui_widget_set_visible(&s->sensor_note, state == UI_SENSOR_STALE);
+        break;
+    default:
+        // 큰 글꼴에는 숫자/기호만 있으므로 대시로 표시
+        ui_label_set(&s->temp_big, "--.-");
+        ui_label_set(&s->humi_value, "--%");
+        ui_bar_set(&s->humi_bar, 0);
+        ui_label_set(&s->sensor_note, "SENSOR ERROR");
+        ui_widget_set_visible(&s->sensor_note, 1);
+        break;
+    }
+}
+
+void ui_screens_time(ui_screens_t *s, const struct tm *tm) {
+    char date_line[16];
+    char time_line[16];
+    char sec_line[8];
+
+    fx_format(date_line, sizeof(date_line), "%04d-%02d-%02d",
+              tm->tm_year + 1900, tm->tm_mon + 1, tm->tm_mday);
+    fx_format(time_line, sizeof(time_line), "%02d:%02d", tm->tm_hour, tm->tm_min);
+    fx_format(sec_line, sizeof(sec_line), ":%02d", tm->tm_sec);
+
+    // 초만 바뀌면 작은 초 글자 열만 전송 (큰 시:분은 분마다 한 번)
+    ui_label_set(&s->date_label, date_line);
+    ui_label_set(&s->time_label, time_line);
+    ui_label_set(&s->sec_label, sec_line);
+}
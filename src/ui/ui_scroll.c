@@ -0,0 +1,94 @@
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <sys/ioctl.h>
+#include "ui_scroll.h"
+
+static int ticker_page = -1;   // 티커가 돌고 있는 페이지 (-1 = 없음)
+
+// 한 페이지를 지우고 텍스트 한 줄을 그려 제출
+static int submit_line(int fd, oled_dl_t *dl, int page, const char *text) {
+    oled_dl_reset(dl);
+    oled_dl_clear(dl, 0, page * 8, 128, 8, 0);
+    if (text && text[0]) {
+        oled_dl_text(dl, 0, page * 8, text);
+    }
+    return oled_dl_submit(fd, dl);
+}
+
+int ui_ticker_start(int fd, oled_dl_t *dl, int page, const char *text, int speed) {
+    struct oled_scroll sc;
+
+    if (page < 0 || page > 7) return -1;
+
+    if (submit_line(fd, dl, page, text) < 0) {
+        perror("❌ 티커 텍스트 출력 실패");
+        return -1;
+    }
+
+    // 수평 스크롤은 페이지 128열을 원형으로 돌리므로 이후 전송이 필요 없음
+    memset(&sc, 0, sizeof(sc));
+    sc.mode = OLED_SCROLL_LEFT;
+    sc.start_page = page;
+    sc.end_page = page;
+    sc.interval = speed;
+
+    if (ioctl(fd, OLED_IOC_SCROLL, &sc) < 0) {
+        perror("❌ 하드웨어 스크롤 시작 실패");
+        return -1;
+    }
+
+    ticker_page = page;
+    return 0;
+}
+
+int ui_ticker_stop(int fd) {
+    if (ticker_page < 0) return 0;
+
+    ticker_page = -1;
+    if (ioctl(fd, OLED_IOC_SCROLL_STOP, 0) < 0) {
+        perror("❌ 하드웨어 스크롤 정지 실패");
+        return -1;
+    }
+    return 0;
+}
+
+int ui_ticker_active(void) {
+    return ticker_page >= 0;
+}
+
+/*
+ * 시작 줄 롤 전환
+ *
+ * GDDRAM은 화면과 같은 64줄이라 시작 줄을 올리면 맨 위 줄이 맨 아래로
+ * 감겨 들어옵니다. 페이지 k가 맨 위에 있을 때(시작 줄 = 8k) 새 내용을
+ * 써 두고 8줄을 굴리면, 64줄을 다 굴렸을 때 새 화면이 제자리에 옵니다.
+ * 한 줄 이동에 명령 1바이트, 페이지마다 한 번의 부분 쓰기만 듭니다.
+ */
+int ui_transition_roll(int fd, oled_dl_t *dl, const uint8_t frame[8][128], int step_us) {
+    const struct timespec step = { step_us / 1000000, (step_us % 1000000) * 1000L };
+
+    if (ui_ticker_stop(fd) < 0) return -1;
+
+    for (int page = 0; page < 8; page++) {
+        oled_dl_reset(dl);
+        oled_dl_blit(dl, 0, page * 8, 128, 8, frame[page]);
+        if (oled_dl_submit(fd, dl) < 0) {
+            perror("❌ 전환 페이지 출력 실패");
+            ioctl(fd, OLED_IOC_START_LINE, 0);
+            return -1;
+        }
+
+        for (int row = 1; row <= 8; row++) {
+            int line = (page * 8 + row) % 64;
+            if (ioctl(fd, OLED_IOC_START_LINE, line) < 0) {
+                perror("❌ 시작 줄 설정 실패");
+                ioctl(fd, OLED_IOC_START_LINE, 0);
+                return -1;
+            }
+            nanosleep(&step, NULL);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,577 @@
+#include <string.h>
+#include <errno.h>
+#include "ui_widget.h"
+#include "fixed_point.h"
+/*
+ * 프레임 그리기 (패널과 같은 페이지 형식, clip 밖은 건드리지 않음)
+ */
+
+static int rect_empty(const ui_rect_t *r) {
+    return r->w <= 0 || r->h <= 0;
+}
+
+static int rect_equal(const ui_rect_t *a, const ui_rect_t *b) {
+    return a->x == b->x && a->y == b->y && a->w == b->w && a->h == b->h;
+}
+
+static ui_rect_t rect_union(ui_rect_t a, ui_rect_t b) {
+    ui_rect_t r;
+    int x1, y1;
+
+    if (rect_empty(&a)) return b;
+    if (rect_empty(&b)) return a;
+    r.x = a.x < b.x ? a.x : b.x;
+    r.y = a.y < b.y ? a.y : b.y;
+    x1 = (a.x + a.w > b.x + b.w) ? a.x + a.w : b.x + b.w;
+    y1 = (a.y + a.h > b.y + b.h) ? a.y + a.h : b.y + b.h;
+    r.w = (int16_t)(x1 - r.x);
+    r.h = (int16_t)(y1 - r.y);
+    return r;
+}
+
+// 페이지 page에서 [y0, y1) 줄에 해당하는 비트
+static uint8_t page_rows(int page, int y0, int y1) {
+    int lo = page * 8 > y0 ? page * 8 : y0;
+    int hi = page * 8 + 8 < y1 ? page * 8 + 8 : y1;
+
+    if (lo >= hi) return 0;
+    return (uint8_t)(((1u << (hi - lo)) - 1) << (lo - page * 8));
+}
+
+// 페이지 형식 비트맵(pages x w, [페이지][열])을 (x, y)에 복사 (clip 밖은 그대로)
+// 열 바이트 단위로만 다룸: y가 페이지 경계면 페이지마다 memcpy,
+// 아니면 바이트 하나를 시프트해 위아래 두 페이지에 나눠 씀
+static void blit(ui_t *ui, const ui_rect_t *clip, int x, int y,
+                 const uint8_t *bits, int w, int pages) {
+    int x0 = x > clip->x ? x : clip->x;
+    int x1 = x + w < clip->x + clip->w ? x + w : clip->x + clip->w;
+    int y0 = clip->y > 0 ? clip->y : 0;
+    int y1 = clip->y + clip->h < UI_HEIGHT ? clip->y + clip->h : UI_HEIGHT;
+    int shift = y & 7;
+
+    if (x0 < 0) x0 = 0;
+    if (x1 > UI_WIDTH) x1 = UI_WIDTH;
+    if (x0 >= x1 || y < 0) return;
+
+    for (int p = 0; p < pages; p++) {
+        const uint8_t *src = bits + p * w + (x0 - x);
+        int dst_page = (y >> 3) + p;
+
+        for (int half = 0; half < (shift ? 2 : 1); half++) {
+            int page = dst_page + half;
+            uint8_t mask;
+            uint8_t *dst;
+
+            if (page >= UI_PAGES) break;
+            mask = half ? (uint8_t)(0xFF >> (8 - shift)) : (uint8_t)(0xFF << shift);
+            mask &= page_rows(page, y0, y1);
+            if (!mask) continue;
+
+            dst = &ui->fb[page][x0];
+            if (mask == 0xFF) {
+                memcpy(dst, src, (size_t)(x1 - x0));
+                continue;
+            }
+            for (int i = 0; i < x1 - x0; i++) {
+                uint8_t v = half ? (uint8_t)(src[i] >> (8 - shift)) : (uint8_t)(src[i] << shift);
+                dst[i] = (uint8_t)((dst[i] & ~mask) | (v & mask));
+            }
+        }
+    }
+}
+
+static void fill_rect(ui_t *ui, const ui_rect_t *r, int on) {
+    int x0 = r->x < 0 ? 0 : r->x;
+    int x1 = r->x + r->w > UI_WIDTH ? UI_WIDTH : r->x + r->w;
+    int y0 = r->y < 0 ? 0 : r->y;
+    int y1 = r->y + r->h > UI_HEIGHT ? UI_HEIGHT : r->y + r->h;
+
+    for (int y = y0; y < y1; ) {
+        int page = y >> 3;
+        int end = (page + 1) * 8 < y1 ? (page + 1) * 8 : y1;
+        uint8_t mask = (uint8_t)(((1u << (end - y)) - 1) << (y & 7));
+
+        for (int x = x0; x < x1; x++) {
+            if (on) ui->fb[page][x] |= mask;
+            else ui->fb[page][x] &= (uint8_t)~mask;
+        }
+        y = end;
+    }
+}
+
+static void set_pixel(ui_t *ui, const ui_rect_t *clip, int x, int y) {
+    if (x < clip->x || x >= clip->x + clip->w || y < clip->y || y >= clip->y + clip->h) return;
+    if (x < 0 || x >= UI_WIDTH || y < 0 || y >= UI_HEIGHT) return;
+    ui->fb[y >> 3][x] |= (uint8_t)(1 << (y & 7));
+}
+
+static void draw_text(ui_t *ui, const ui_rect_t *clip, const ui_font_t *font,
+                      const char *text, int len) {
+    for (int i = 0; i < len; i++) {
+        int x = clip->x + i * font->width;
+
+        if (x >= clip->x + clip->w) break;
+        blit(ui, clip, x, clip->y, ui_font_glyph(font, text[i]), font->width, font->pages);
+    }
+}
+
+static void draw_bar(ui_t *ui, const ui_widget_t *w) {
+    const ui_rect_t *r = &w->rect;
+    int32_t span = w->u.bar.max - w->u.bar.min;
+    int32_t v = w->u.bar.value;
+    ui_rect_t inner;
+
+    if (r->w < 3 || r->h < 3) return;
+
+    // 테두리 + 안쪽을 비율만큼 채움
+    for (int x = r->x; x < r->x + r->w; x++) {
+        set_pixel(ui, r, x, r->y);
+        set_pixel(ui, r, x, r->y + r->h - 1);
+    }
+    for (int y = r->y; y < r->y + r->h; y++) {
+        set_pixel(ui, r, r->x, y);
+        set_pixel(ui, r, r->x + r->w - 1, y);
+    }
+
+    if (v < w->u.bar.min) v = w->u.bar.min;
+    if (v > w->u.bar.max) v = w->u.bar.max;
+    inner.x = (int16_t)(r->x + 1);
+    inner.y = (int16_t)(r->y + 1);
+    inner.w = span > 0 ? (int16_t)((int64_t)(v - w->u.bar.min) * (r->w - 2) / span) : 0;
+    inner.h = (int16_t)(r->h - 2);
+    fill_rect(ui, &inner, 1);
+}
+
+static void draw_sparkline(ui_t *ui, const ui_widget_t *w) {
+    const ui_rect_t *r = &w->rect;
+    int count = w->u.spark.count;
+    int step, first, prev_y = -1;
+    int32_t lo, hi;
+
+    if (count == 0 || r->w <= 0 || r->h <= 0) return;
+
+    // 세로 축: 창 안 최소~최대 (min_span보다 좁으면 가운데 기준으로 넓힘)
+    first = (w->u.spark.head - count + UI_SPARK_MAX) % UI_SPARK_MAX;
+    lo = hi = w->u.spark.points[first];
+    for (int i = 1; i < count; i++) {
+        int32_t v = w->u.spark.points[(first + i) % UI_SPARK_MAX];
+        if (v < lo) lo = v;
+        if (v > hi) hi = v;
+    }
+    if (hi - lo < w->u.spark.min_span) {
+        int32_t mid = lo + (hi - lo) / 2;
+        lo = mid - w->u.spark.min_span / 2;
+        hi = lo + w->u.spark.min_span;
+    }
+
+    // 최신 값이 오른쪽 끝, 점 사이는 세로선으로 이어 끊기지 않게
+    step = r->w / UI_SPARK_MAX;
+    if (step < 1) step = 1;
+    for (int i = 0; i < count; i++) {
+        int32_t v = w->u.spark.points[(first + i) % UI_SPARK_MAX];
+        int x = r->x + r->w - (count - i) * step;
+        int y = r->y + r->h - 1 - (int)((int64_t)(v - lo) * (r->h - 1) / (hi - lo ? hi - lo : 1));
+
+        if (x < r->x) continue;
+        for (int dx = 0; dx < step; dx++) set_pixel(ui, r, x + dx, y);
+        if (prev_y >= 0) {
+            int a = prev_y < y ? prev_y : y;
+            int b = prev_y < y ? y : prev_y;
+            for (int yy = a; yy <= b; yy++) set_pixel(ui, r, x, yy);
+        }
+        prev_y = y;
+    }
+}
+
+/*
+ * DIRTY 표시와 배치
+ */
+
+// damage를 위젯 영역에 합치고 조상에게 "자손이 DIRTY" 표시
+static void mark_dirty(ui_widget_t *w, const ui_rect_t *damage) {
+    w->damage = (w->flags & UI_F_DIRTY) ? rect_union(w->damage, *damage) : *damage;
+    w->flags |= UI_F_DIRTY;
+    for (ui_widget_t *p = w->parent; p; p = p->parent) p->flags |= UI_F_CHILD;
+}
+
+static void mark_layout(ui_widget_t *w) {
+    for (; w; w = w->parent) w->flags |= UI_F_LAYOUT;
+}
+
+static void widget_init(ui_widget_t *w, ui_kind_t kind, int pref_w, int pref_h) {
+    memset(w, 0, sizeof(*w));
+    w->kind = (uint8_t)kind;
+    w->pref_w = (int16_t)pref_w;
+    w->pref_h = (int16_t)pref_h;
+}
+
+static void damage_add(ui_t *ui, const ui_rect_t *r) {
+    int x0 = r->x < 0 ? 0 : r->x;
+    int x1 = r->x + r->w > UI_WIDTH ? UI_WIDTH - 1 : r->x + r->w - 1;
+    int y0 = r->y < 0 ? 0 : r->y;
+    int y1 = r->y + r->h > UI_HEIGHT ? UI_HEIGHT - 1 : r->y + r->h - 1;
+
+    if (x0 > x1 || y0 > y1) return;
+    for (int page = y0 >> 3; page <= (y1 >> 3); page++) {
+        if (ui->span_lo[page] > ui->span_hi[page]) {
+            ui->span_lo[page] = (uint8_t)x0;
+            ui->span_hi[page] = (uint8_t)x1;
+            continue;
+        }
+        if (x0 < ui->span_lo[page]) ui->span_lo[page] = (uint8_t)x0;
+        if (x1 > ui->span_hi[page]) ui->span_hi[page] = (uint8_t)x1;
+    }
+}
+
+static int is_box(const ui_widget_t *w) {
+    return w->kind == UI_VBOX || w->kind == UI_HBOX;
+}
+
+// 자손의 배치 캐시를 버림 (다음 배치에서 모두 "자리 바뀜"으로 다시 그림)
+static void forget_rects(ui_widget_t *w) {
+    for (ui_widget_t *c = w->first; c; c = c->next) {
+        memset(&c->rect, 0, sizeof(c->rect));
+        forget_rects(c);
+    }
+}
+
+// 위젯 배치. 자리가 바뀐 위젯은 옛 자리를 지우고 새 자리 전체를 DIRTY로
+// (상자가 바뀌면 옛 영역을 통째로 지웠으므로 자손도 모두 다시 그림)
+static void place(ui_t *ui, ui_widget_t *w, ui_rect_t r) {
+    if (!rect_equal(&w->rect, &r)) {
+        if (!rect_empty(&w->rect)) {
+            fill_rect(ui, &w->rect, 0);
+            damage_add(ui, &w->rect);
+        }
+        if (is_box(w)) forget_rects(w);
+        w->rect = r;
+        w->flags |= UI_F_LAYOUT;
+        if (!rect_empty(&r) && !is_box(w)) mark_dirty(w, &r);
+    }
+    if (!(w->flags & UI_F_LAYOUT)) return;
+    w->flags &= (uint8_t)~UI_F_LAYOUT;
+
+    if (!is_box(w)) return;
+
+    int vertical = w->kind == UI_VBOX;
+    int total = vertical ? r.h : r.w;
+    int fixed = 0, fills = 0, pos = vertical ? r.y : r.x;
+
+    for (ui_widget_t *c = w->first; c; c = c->next) {
+        int pref = vertical ? c->pref_h : c->pref_w;
+        if (c->flags & UI_F_HIDDEN) continue;
+        if (pref > 0) fixed += pref;
+        else fills++;
+    }
+
+    for (ui_widget_t *c = w->first; c; c = c->next) {
+        ui_rect_t cr = {0, 0, 0, 0};
+        int pref = vertical ? c->pref_h : c->pref_w;
+        int size;
+
+        if (!(c->flags & UI_F_HIDDEN)) {
+            size = pref > 0 ? pref : (total > fixed ? (total - fixed) / fills : 0);
+            if (pos + size > (vertical ? r.y + r.h : r.x + r.w)) {
+                size = (vertical ? r.y + r.h : r.x + r.w) - pos;
+            }
+            if (size < 0) size = 0;
+            if (vertical) {
+                cr.x = r.x;
+                cr.y = (int16_t)pos;
+                cr.w = (c->pref_w > 0 && c->pref_w < r.w) ? c->pref_w : r.w;
+                cr.h = (int16_t)size;
+            } else {
+                cr.x = (int16_t)pos;
+                cr.y = r.y;
+                cr.w = (int16_t)size;
+                cr.h = (c->pref_h > 0 && c->pref_h < r.h) ? c->pref_h : r.h;
+            }
+            pos += size;
+        }
+        place(ui, c, cr);
+    }
+}
+
+/*
+ * 위젯 API
+ */
+
+void ui_box_init(ui_widget_t *w, ui_kind_t kind, int pref_w, int pref_h) {
+    widget_init(w, kind, pref_w, pref_h);
+}
+
+void ui_label_init(ui_widget_t *w, int pref_w, const char *text) {
+    widget_init(w, UI_LABEL, pref_w, UI_LINE_H);
+    w->u.text.font = &ui_font_6x8;
+    if (text) {
+        strncpy(w->u.text.text, text, UI_TEXT_MAX);
+        w->u.text.len = (uint8_t)strlen(w->u.text.text);
+    }
+}
+
+void ui_value_init(ui_widget_t *w, int pref_w, const char *fmt) {
+    widget_init(w, UI_VALUE, pref_w, UI_LINE_H);
+    w->u.text.font = &ui_font_6x8;
+    w->u.text.fmt = fmt;
+}
+
+void ui_icon_init(ui_widget_t *w, int pref_w, const uint8_t *bits, int bits_w, int bits_h) {
+    widget_init(w, UI_ICON, pref_w > 0 ? pref_w : bits_w, bits_h);
+    w->u.icon.bits = bits;
+    w->u.icon.w = (uint8_t)bits_w;
+    w->u.icon.h = (uint8_t)bits_h;
+}
+
+void ui_bar_init(ui_widget_t *w, int pref_w, int pref_h, int32_t min, int32_t max) {
+    widget_init(w, UI_BAR, pref_w, pref_h);
+    w->u.bar.min = min;
+    w->u.bar.max = max;
+    w->u.bar.value = min;
+}
+
+void ui_sparkline_init(ui_widget_t *w, int pref_w, int pref_h, int32_t min_span) {
+    widget_init(w, UI_SPARKLINE, pref_w, pref_h);
+    w->u.spark.min_span = min_span > 0 ? min_span : 1;
+}
+
+void ui_add(ui_widget_t *parent, ui_widget_t *child) {
+    ui_widget_t **tail = &parent->first;
+
+    while (*tail) tail = &(*tail)->next;
+    *tail = child;
+    child->parent = parent;
+    child->next = NULL;
+    mark_layout(parent);
+}
+
+// 새 문자열과 비교해 바뀐 글자 열만 손상으로 (뒤쪽이 짧아지면 지워질 칸까지)
+static void text_update(ui_widget_t *w, const char *text) {
+    int glyph_w = w->u.text.font->width;
+    char *cur = w->u.text.text;
+    int len = (int)strnlen(text, UI_TEXT_MAX);
+    int old = w->u.text.len;
+    int n = len > old ? len : old;
+    int first = -1, last = -1;
+    ui_rect_t damage;
+
+    for (int i = 0; i < n; i++) {
+        char a = i < old ? cur[i] : ' ';
+        char b = i < len ? text[i] : ' ';
+        if (a != b) {
+            if (first < 0) first = i;
+            last = i;
+        }
+    }
+    memcpy(cur, text, (size_t)len);
+    cur[len] = '\0';
+    w->u.text.len = (uint8_t)len;
+    if (first < 0) return;
+
+    damage.x = (int16_t)(w->rect.x + first * glyph_w);
+    damage.y = w->rect.y;
+    damage.w = (int16_t)((last - first + 1) * glyph_w);
+    damage.h = w->rect.h;
+    if (damage.x + damage.w > w->rect.x + w->rect.w) damage.w = (int16_t)(w->rect.x + w->rect.w - damage.x);
+    if (damage.w > 0) mark_dirty(w, &damage);
+}
+
+void ui_label_set(ui_widget_t *w, const char *text) {
+    w->u.text.has_value = 0;
+    text_update(w, text);
+}
+
+void ui_value_set(ui_widget_t *w, const char *fmt, int32_t value) {
+    char buf[UI_TEXT_MAX + 1];
+
+    // 같은 값/서식이면 서식화도 하지 않음
+    if (w->u.text.has_value && w->u.text.fmt == fmt && w->u.text.value == value) return;
+
+    fx_format(buf, sizeof(buf), fmt, (int)value);
+    w->u.text.fmt = fmt;
+    w->u.text.value = value;
+    w->u.text.has_value = 1;
+    text_update(w, buf);
+}
+
+void ui_icon_set(ui_widget_t *w, const uint8_t *bits) {
+    if (w->u.icon.bits == bits) return;
+    w->u.icon.bits = bits;
+    mark_dirty(w, &w->rect);
+}
+
+void ui_bar_set(ui_widget_t *w, int32_t value) {
+    int32_t span = w->u.bar.max - w->u.bar.min;
+    int inner = w->rect.w - 2;
+
+    if (value == w->u.bar.value) return;
+    // 채운 폭(픽셀)이 같으면 화면은 그대로
+    if (span > 0 && inner > 0) {
+        int32_t a = value < w->u.bar.min ? w->u.bar.min : value > w->u.bar.max ? w->u.bar.max : value;
+        int32_t b = w->u.bar.value;
+        if ((int64_t)(a - w->u.bar.min) * inner / span == (int64_t)(b - w->u.bar.min) * inner / span) {
+            w->u.bar.value = value;
+            return;
+        }
+    }
+    w->u.bar.value = value;
+    mark_dirty(w, &w->rect);
+}
+
+void ui_sparkline_push(ui_widget_t *w, int32_t value) {
+    w->u.spark.points[w->u.spark.head] = value;
+    w->u.spark.head = (uint8_t)((w->u.spark.head + 1) % UI_SPARK_MAX);
+    if (w->u.spark.count < UI_SPARK_MAX) w->u.spark.count++;
+    mark_dirty(w, &w->rect);
+}
+
+void ui_widget_set_visible(ui_widget_t *w, int visible) {
+    int hidden = !visible;
+
+    if (!!(w->flags & UI_F_HIDDEN) == hidden) return;
+    if (hidden) w->flags |= UI_F_HIDDEN;
+    else w->flags &= (uint8_t)~UI_F_HIDDEN;
+    mark_layout(w->parent ? w->parent : w);
+}
+
+void ui_widget_set_font(ui_widget_t *w, const ui_font_t *font) {
+    if (w->u.text.font == font) return;
+    w->u.text.font = font;
+    w->pref_h = (int16_t)(font->pages * 8);
+    mark_layout(w->parent ? w->parent : w);
+    mark_dirty(w, &w->rect);
+}
+
+/*
+ * 화면
+ */
+
+void ui_init(ui_t *ui) {
+    memset(ui, 0, sizeof(*ui));
+    ui_damage_clear(ui);
+}
+
+void ui_damage_clear(ui_t *ui) {
+    memset(ui->span_lo, 0xFF, sizeof(ui->span_lo));
+    memset(ui->span_hi, 0, sizeof(ui->span_hi));
+}
+
+void ui_invalidate(ui_t *ui) {
+    const ui_rect_t all = {0, 0, UI_WIDTH, UI_HEIGHT};
+    damage_add(ui, &all);
+}
+
+void ui_set_root(ui_t *ui, ui_widget_t *root) {
+    const ui_rect_t all = {0, 0, UI_WIDTH, UI_HEIGHT};
+
+    if (ui->root == root) return;
+    ui->root = root;
+    fill_rect(ui, &all, 0);
+    ui_invalidate(ui);
+
+    // 프레임을 지웠으므로 캐시된 배치를 버리고 전부 다시 그림
+    memset(&root->rect, 0, sizeof(root->rect));
+    mark_layout(root);
+}
+
+static void draw_widget(ui_t *ui, ui_widget_t *w) {
+    const ui_rect_t *r = &w->rect;
+
+    fill_rect(ui, r, 0);    // 상자는 DIRTY가 되지 않으므로 여기 오는 것은 잎 위젯
+    switch (w->kind) {
+    case UI_LABEL:
+    case UI_VALUE:
+        draw_text(ui, r, w->u.text.font, w->u.text.text, w->u.text.len);
+        break;
+    case UI_ICON: {
+        // 비트맵 높이가 8의 배수가 아니면 남는 줄은 자름
+        ui_rect_t clip = *r;
+        if (clip.h > w->u.icon.h) clip.h = w->u.icon.h;
+        if (w->u.icon.bits) {
+            blit(ui, &clip, r->x, r->y, w->u.icon.bits, w->u.icon.w, (w->u.icon.h + 7) / 8);
+        }
+        break;
+    }
+    case UI_BAR:
+        draw_bar(ui, w);
+        break;
+    case UI_SPARKLINE:
+        draw_sparkline(ui, w);
+        break;
+    default:
+        break;
+    }
+    ui->stats.widgets_drawn++;
+}
+
+static void render_node(ui_t *ui, ui_widget_t *w) {
+    if (w->flags & UI_F_HIDDEN) {
+        w->flags &= (uint8_t)~(UI_F_DIRTY | UI_F_CHILD);
+        return;
+    }
+    if (w->flags & UI_F_DIRTY) {
+        w->flags &= (uint8_t)~UI_F_DIRTY;
+        if (!rect_empty(&w->rect)) {
+            draw_widget(ui, w);
+            damage_add(ui, &w->damage);
+        }
+    }
+    if (w->flags & UI_F_CHILD) {
+        w->flags &= (uint8_t)~UI_F_CHILD;
+        for (ui_widget_t *c = w->first; c; c = c->next) {
+            if (c->flags & (UI_F_DIRTY | UI_F_CHILD)) render_node(ui, c);
+        }
+    }
+}
+
+int ui_render(ui_t *ui) {
+    const ui_rect_t all = {0, 0, UI_WIDTH, UI_HEIGHT};
+    int pages = 0;
+
+    if (!ui->root) return 0;
+    ui->stats.renders++;
+
+    if (ui->root->flags & UI_F_LAYOUT) {
+        ui->stats.layouts++;
+        place(ui, ui->root, all);
+    }
+    render_node(ui, ui->root);
+
+    for (int page = 0; page < UI_PAGES; page++) {
+        if (ui->span_lo[page] <= ui->span_hi[page]) pages++;
+    }
+    return pages;
+}
+
+int ui_build_dl(ui_t *ui, oled_dl_t *dl) {
+    int ops = 0;
+
+    oled_dl_reset(dl);
+    for (int page = 0; page < UI_PAGES; page++) {
+        int lo = ui->span_lo[page];
+        int hi = ui->span_hi[page];
+
+        if (lo > hi) continue;
+        if (oled_dl_blit(dl, lo, page * 8, hi - lo + 1, 8, &ui->fb[page][lo]) < 0) return -1;
+        ui->stats.bytes += (uint32_t)(hi - lo + 1);
+        ops++;
+    }
+    ui_damage_clear(ui);
+    return ops;
+}
+
+int ui_flush(ui_t *ui, int fd, oled_dl_t *dl) {
+    int ops;
+
+    if (ui_render(ui) == 0) return 0;
+
+    ops = ui_build_dl(ui, dl);
+    if (ops < 0 || oled_dl_submit(fd, dl) < 0) {
+        // 패널이 어디까지 받았는지 모르므로 다음에 전체를 다시 보냄
+        int saved = errno;
+        ui_invalidate(ui);
+        errno = ops < 0 ? ENOSPC : saved;
+        return -1;
+    }
+    ui->stats.flushes++;
+    return 1;
+}
@@ -0,0 +1,69 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "sensor_collector.h"
+#include "fixed_point.h"
+#include "smart_env_monitor.h"  // GPIO_DHT11_DATA 정의용
+
+// 사용법: ./sensor_array_test [GPIO핀 ...]   (기본: GPIO_DHT11_DATA 하나)
+int main(int argc, char *argv[]) {
+    sensor_zone_config_t zones[SENSOR_ARRAY_MAX];
+    char names[SENSOR_ARRAY_MAX][SENSOR_ZONE_NAME_LEN];
+    static sensor_array_t arr;
+    sensor_reading_t readings[SENSOR_ARRAY_READINGS];
+    int count = 0;
+    int done = 0;
+    clock_t cpu_start;
+
+    for (int i = 1; i < argc && count < SENSOR_ARRAY_MAX; i++) {
+        snprintf(names[count], sizeof(names[count]), "구역%d", count + 1);
+        zones[count].pin = atoi(argv[i]);
+        zones[count].name = names[count];
+        count++;
+    }
+    if (count == 0) {
+        zones[0].pin = GPIO_DHT11_DATA;
+        zones[0].name = "구역1";
+        count = 1;
+    }
+
+    if (sensor_collector_open_zones(&arr, zones, count) != 0) {
+        fprintf(stderr, "❌ 센서 배열 초기화 실패\n");
+        return 1;
+    }
+    printf("🌡️ DHT11 %d개 측정 (구역마다 10회)\n", count);
+
+    cpu_start = clock();
+    while (done < count * 10) {
+        int n = collect_zone_samples(&arr, 1000, readings, SENSOR_ARRAY_READINGS);
+        if (n < 0) break;
+
+        for (int i = 0; i < n; i++) {
+            const sensor_zone_t *z = &arr.zones[readings[i].zone];
+            const sensor_sample_t *s = &readings[i].sample;
+            char line[96];
+
+            if (!(s->flags & (SAMPLE_FLAG_VALID | SAMPLE_FLAG_STALE))) {
+                fprintf(stderr, "❌ %s(GPIO%d) 읽기 실패\n", z->name, z->pin);
+            } else {
+                fx_format(line, sizeof(line), "%s %s(GPIO%d): %q°C, %q%% (다음 %us 뒤)",
+                          (s->flags & SAMPLE_FLAG_VALID) ? "📦" : "⚠️",
+                          z->name, z->pin, s->temp_centi, s->humi_centi,
+                          (unsigned)(z->sched.stats.interval_ms / 1000));
+                puts(line);
+            }
+            done++;
+        }
+    }
+
+    printf("📊 캡처 %llu회, 에지 %llu개, 깨어남 %llu회, 엇갈림 %llu회, CPU %.1fms\n",
+           (unsigned long long)arr.stats.captures,
+           (unsigned long long)arr.stats.edges,
+           (unsigned long long)arr.stats.wakeups,
+           (unsigned long long)arr.stats.staggered,
+           (double)(clock() - cpu_start) * 1000.0 / CLOCKS_PER_SEC);
+
+    sensor_array_close(&arr);
+    gpio_cleanup();
+    return 0;
+}
@@ -1,19 +1,26 @@
 #include <stdio.h>
 #include <unistd.h>
 #include "sensor_collector.h"
+#include "fixed_point.h"
 
 int main(void) {
     sensor_collector_init();
 
     for (int i = 0; i < 10; i++) {
-        sensor_data_t data;
+        sensor_sample_t data;
+        struct tm tm;
         if (collect_sensor_data(&data)) {
-            printf("📦 수집: %.1f°C, %.1f%% | %02d:%02d:%02d\n",
-                   data.temperature,
-                   data.humidity,
-                   data.timestamp.tm_hour,
-                   data.timestamp.tm_min,
-                   data.timestamp.tm_sec);
+            sample_to_localtime(&data, &tm);
+            char line[80];
+            fx_format(line, sizeof(line), "📦 수집: %q°C, %q%% | %02d:%02d:%02d.%03u (%u바이트)",
+                      data.temp_centi,
+                      data.humi_centi,
+                      tm.tm_hour,
+                      tm.tm_min,
+                      tm.tm_sec,
+                      data.time_ms,
+                      (unsigned)sizeof(data));
+            puts(line);
         } else {
             fprintf(stderr, "⚠️ 센서 데이터 오류\n");
         }
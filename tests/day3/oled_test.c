@@ -14,13 +14,13 @@ int main(int argc, char *argv[])
     printf("=== OLED 테스트 프로그램 ===\n");
     
     // 디바이스 파일 열기
-    fd = open("/dev/oled_display", O_RDWR);
+    fd = open(OLED_DEVICE_PATH, O_RDWR);
     if (fd < 0) {
         perror("❌ 디바이스 열기 실패");
         printf("💡 드라이버가 로드되었는지 확인하세요: lsmod | grep oled\n");
         return -1;
     }
-    printf("✅ /dev/oled_display 열기 성공\n");
+    printf("✅ %s 열기 성공\n", OLED_DEVICE_PATH);
     
     // OLED 초기화
     printf("🔄 OLED 초기화 중...\n");
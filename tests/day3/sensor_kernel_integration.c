@@ -10,6 +10,7 @@
 #include "../../include/ds1307_rtc.h"
 #include "../../include/gpio_driver.h"
 #include "../../include/smart_env_monitor.h"
+#include "../../include/fixed_point.h"
 
 // 메모리 사용량 체크 함수
 void check_memory_usage() {
@@ -59,7 +60,7 @@ int sensor_to_oled_pipeline(int cycle) {
     printf("\n=== 파이프라인 사이클 %d ===\n", cycle);
     
     // 1. OLED 커널 드라이버 열기
-    oled_fd = open("/dev/oled_display", O_RDWR);
+    oled_fd = open(OLED_DEVICE_PATH, O_RDWR);
     if (oled_fd < 0) {
         printf("❌ OLED 디바이스 열기 실패\n");
         return -1;
@@ -77,12 +78,11 @@ int sensor_to_oled_pipeline(int cycle) {
     
     if (dht11_read_data(&dht_data) != 0 || !dht_data.checksum_valid) {
         printf("⚠️ DHT11 데이터 오류 - 기본값 사용\n");
-        dht_data.temperature = 25.0f;
-        dht_data.humidity = 50.0f;
+        dht_data.temp_centi = FX_CENTI_FROM_INT(25);
+        dht_data.humi_centi = FX_CENTI_FROM_INT(50);
         error_count++;
     } else {
-        printf("🌡️ 온도: %.1f°C, 💧 습도: %.1f%%\n", 
-               dht_data.temperature, dht_data.humidity);
+        dht11_print_data(&dht_data);
     }
     
     // DS1307 시간 데이터
@@ -97,9 +97,9 @@ int sensor_to_oled_pipeline(int cycle) {
     }
     
     // 3. 데이터 포맷팅
-    snprintf(display_text, sizeof(display_text), 
-             "T:%.1fC H:%.1f%% %02d:%02d:%02d", 
-             dht_data.temperature, dht_data.humidity,
+    fx_format(display_text, sizeof(display_text), 
+             "T:%qC H:%q%% %02d:%02d:%02d", 
+             dht_data.temp_centi, dht_data.humi_centi,
              rtc_time.tm_hour, rtc_time.tm_min, rtc_time.tm_sec);
     
     printf("📝 전송 데이터: %s\n", display_text);
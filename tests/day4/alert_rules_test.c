@@ -0,0 +1,347 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "alert_rules.h"
+#include "history_store.h"
+#include "test_check.h"
+
+#define TRACE_MS        3000
+#define DAY_SAMPLES     (86400000 / TRACE_MS)
+#define MAX_TRACE       (DAY_SAMPLES * 7)
+#define CHECK_SAMPLES   6000            // 전수 비교 구간
+#define CHECK_RULES     300
+#define BENCH_RULES     5000
+#define MAX_EVENTS      BENCH_RULES
+
+static uint32_t rng = 0x9E3779B9u;
+
+static uint32_t next_rand(void) {
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+}
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void test_compile(void) {
+    alert_engine_t eng;
+
+    printf("🧪 규칙 컴파일\n");
+    alert_engine_init(&eng);
+    CHECK(alert_engine_compile(&eng,
+          "# 기본 규칙\n"
+          "high_humidity: humi > 70 for 10m\n"
+          "\n"
+          "heating_fast: temp rises 3 within 15m   # 난방\n"
+          "door_open: temp falls 2.5 within 15m\n"
+          "humi avg >= 65% over 1h\n"
+          "cold: temp <= -2.25 for 90s\n") == 5, "규칙 5개 (주석/빈 줄 무시)");
+    CHECK(strcmp(eng.rules[3].name, "rule4") == 0 && eng.rules[3].kind == ALERT_KIND_AVG &&
+          eng.rules[3].threshold == 6500 && eng.rules[3].span_ms == 3600000, "이름 없는 평균 규칙");
+    CHECK(eng.rules[4].threshold == -225 && eng.rules[4].span_ms == 90000 &&
+          eng.rules[4].cmp == ALERT_CMP_LE, "음수 소수 둘째 자리, 초 단위");
+    CHECK(eng.window_count == 2 && eng.rules[1].window == eng.rules[2].window &&
+          eng.windows[eng.rules[1].window].needs == (ALERT_WIN_MIN | ALERT_WIN_MAX),
+          "같은 채널/기간 창 공유 (최소/최대 덱)");
+    CHECK(alert_engine_finalize(&eng, 0) == 0 && eng.windows[0].min_dq.cap == 302, "창 용량 = 15분 / 3초 + 2");
+
+    printf("  (아래 오류 메시지는 의도한 것)\n");
+    CHECK(alert_engine_compile(&eng, "pressure > 3 for 1m\n") == -1, "알 수 없는 채널");
+    CHECK(alert_engine_compile(&eng, "temp > 3 for 1d\n") == -1, "알 수 없는 기간 단위");
+    CHECK(alert_engine_compile(&eng, "humi > 70 for 10\n") == -1, "기간 단위 없음");
+    CHECK(alert_engine_compile(&eng, "temp rises -3 within 1m\n") == -1, "음수 변화폭");
+    CHECK(alert_engine_compile(&eng, "temp > 3.125 for 1m\n") == -1, "소수 셋째 자리");
+    CHECK(alert_engine_compile(&eng, "temp > 3 during 1m\n") == -1, "문법 오류");
+    CHECK(eng.count == 5, "오류 규칙은 추가 안 됨");
+    alert_engine_free(&eng);
+}
+
+static void test_semantics(void) {
+    alert_engine_t eng;
+    alert_event_t ev[8];
+    int64_t t = 0;
+    int n, fired_at = -1;
+    char line[64];
+
+    printf("🧪 규칙 의미\n");
+    alert_engine_init(&eng);
+    alert_engine_compile(&eng,
+        "high_humidity: humi > 70 for 10m\n"
+        "heating_fast: temp rises 3 within 15m\n"
+        "damp_hour: humi avg > 65 over 1h\n");
+    alert_engine_finalize(&eng, 0);
+
+    // 습도 71%가 10분 유지되면 발생, 떨어지면 해제
+    for (int i = 0; i <= 200 && fired_at < 0; i++, t += TRACE_MS) {
+        n = alert_engine_update(&eng, t, 2000, 7100, ev, 8);
+        for (int k = 0; k < n; k++) {
+            if (ev[k].rule == 0 && ev[k].active) fired_at = i;
+        }
+    }
+    CHECK(fired_at == 200, "humi > 70 for 10m: 정확히 10분째 샘플에서 발생");
+    alert_format_event(&eng, &ev[0], line, sizeof(line));
+    CHECK(strcmp(line, "ALERT high_humidity humi 71.0") == 0, "이벤트 문장");
+
+    n = alert_engine_update(&eng, t, 2000, 6900, ev, 8);
+    CHECK(n == 1 && ev[0].rule == 0 && !ev[0].active, "조건이 깨지면 해제 이벤트");
+    t += TRACE_MS;
+
+    // 20분 동안 20°C → 24°C 선형 상승 (3초마다 0.01°C씩)
+    fired_at = -1;
+    for (int i = 0; i <= 400; i++, t += TRACE_MS) {
+        n = alert_engine_update(&eng, t, 2000 + i, 6000, ev, 8);
+        for (int k = 0; k < n; k++) {
+            if (ev[k].rule == 1 && ev[k].active && fired_at < 0) fired_at = i;
+        }
+    }
+    CHECK(fired_at == 300, "temp rises 3 within 15m: 상승 시작 15분 뒤 발생");
+    CHECK(eng.rules[1].active, "상승 유지 중에는 발생 상태 유지");
+
+    // 평균: 1시간이 다 차기 전에는 발생 안 함 (시작부터 습도 71/69% 섞임)
+    CHECK(!eng.rules[2].active, "평균 규칙: 1시간 전에는 발생 안 함");
+    fired_at = -1;
+    for (int i = 0; i < 1200; i++, t += TRACE_MS) {
+        n = alert_engine_update(&eng, t, 2400, 7000, ev, 8);
+        for (int k = 0; k < n; k++) {
+            if (ev[k].rule == 2 && ev[k].active && fired_at < 0) fired_at = i;
+        }
+    }
+    CHECK(fired_at >= 0 && eng.rules[2].active, "평균 규칙: 1시간 뒤 평균 65% 초과로 발생");
+
+    // 출력 배열이 모자라면 버린 수를 셈 (상태는 그대로 진행)
+    n = alert_engine_update(&eng, t, 2800, 7000, ev, 0);
+    CHECK(n == 0 && eng.events_dropped == 1 && eng.rules[1].active, "출력 배열 부족 → events_dropped");
+    alert_engine_free(&eng);
+}
+
+// ---- 전수 비교 (기록 전체를 다시 훑는 단순 구현) ----
+
+typedef struct {
+    int64_t t;
+    int32_t v[2];
+} trace_point_t;
+
+static int cmp_ok(uint8_t cmp, int32_t v, int32_t th) {
+    switch (cmp) {
+    case ALERT_CMP_GT: return v > th;
+    case ALERT_CMP_GE: return v >= th;
+    case ALERT_CMP_LT: return v < th;
+    default:           return v <= th;
+    }
+}
+
+static int naive_fire(const alert_rule_t *r, const trace_point_t *tr, int i) {
+    int64_t now = tr[i].t;
+    int32_t v = tr[i].v[r->channel];
+    int32_t lo = v, hi = v;
+    int64_t sum = 0;
+    int cnt = 0, j;
+
+    switch (r->kind) {
+    case ALERT_KIND_FOR:
+        if (!cmp_ok(r->cmp, v, r->threshold)) return 0;
+        for (j = i; j > 0 && cmp_ok(r->cmp, tr[j - 1].v[r->channel], r->threshold); j--) {}
+        return now - tr[j].t >= r->span_ms;
+    default:
+        for (j = i; j >= 0 && tr[j].t >= now - r->span_ms; j--) {
+            int32_t x = tr[j].v[r->channel];
+            if (x < lo) lo = x;
+            if (x > hi) hi = x;
+            sum += x;
+            cnt++;
+        }
+        if (r->kind == ALERT_KIND_RISES) return v - lo >= r->threshold;
+        if (r->kind == ALERT_KIND_FALLS) return hi - v >= r->threshold;
+        return now - tr[0].t >= r->span_ms && cmp_ok(r->cmp, (int32_t)(sum / cnt), r->threshold);
+    }
+}
+
+// 무작위 규칙 문장 하나
+static void random_rule(char *buf, size_t size, int idx) {
+    static const char *cmps[] = { ">", ">=", "<", "<=" };
+    const char *ch = (next_rand() & 1) ? "temp" : "humi";
+    int base = ch[0] == 't' ? 2200 : 5000;
+    int span = 1 + (int)(next_rand() % 60);
+    int th = base + (int)(next_rand() % 800) - 400;
+
+    switch (next_rand() % 4) {
+    case 0:
+        snprintf(buf, size, "r%d: %s %s %d.%02d for %dm", idx, ch, cmps[next_rand() % 4],
+                 th / 100, th % 100, span);
+        break;
+    case 1:
+        snprintf(buf, size, "r%d: %s rises %d.%d within %dm", idx, ch,
+                 1 + (int)(next_rand() % 4), (int)(next_rand() % 10), span);
+        break;
+    case 2:
+        snprintf(buf, size, "r%d: %s falls %d.%d within %dm", idx, ch,
+                 1 + (int)(next_rand() % 4), (int)(next_rand() % 10), span);
+        break;
+    default:
+        snprintf(buf, size, "r%d: %s avg %s %d.%02d over %dm", idx, ch, cmps[next_rand() % 4],
+                 th / 100, th % 100, span);
+        break;
+    }
+}
+
+// 적응형 스케줄러처럼 3~60초 불규칙 간격, 느린 무작위 변화 + 가끔 계단
+static void gen_walk(trace_point_t *tr, int n) {
+    int64_t t = 1000;
+    int32_t temp = 2200, humi = 5000;
+
+    for (int i = 0; i < n; i++) {
+        uint32_t r = next_rand();
+        t += TRACE_MS * (1 + (int64_t)(r % 20 == 0 ? (r >> 24) % 20 : 0));
+        temp += (int32_t)(r >> 8) % 61 - 30;
+        humi += (int32_t)(r >> 16) % 101 - 50;
+        if (r % 500 == 0) temp += (r & 1) ? 400 : -400;
+        if (temp < 1600) temp = 1600;
+        if (temp > 2800) temp = 2800;
+        if (humi < 3000) humi = 3000;
+        if (humi > 8000) humi = 8000;
+        tr[i].t = t;
+        tr[i].v[0] = temp;
+        tr[i].v[1] = humi;
+    }
+}
+
+static void test_against_naive(void) {
+    static trace_point_t tr[CHECK_SAMPLES];
+    static alert_event_t ev[CHECK_RULES];
+    alert_engine_t eng;
+    char line[96];
+    int mismatches = 0, fired = 0;
+
+    printf("🧪 전체 재계산과 비교 (규칙 %d개 × 불규칙 샘플 %d개)\n", CHECK_RULES, CHECK_SAMPLES);
+    gen_walk(tr, CHECK_SAMPLES);
+
+    alert_engine_init(&eng);
+    for (int r = 0; r < CHECK_RULES; r++) {
+        random_rule(line, sizeof(line), r);
+        if (alert_engine_compile(&eng, line) != 1) {
+            printf("  규칙 오류: %s\n", line);
+            failures++;
+        }
+    }
+    alert_engine_finalize(&eng, 0);
+
+    for (int i = 0; i < CHECK_SAMPLES; i++) {
+        alert_engine_update(&eng, tr[i].t, tr[i].v[0], tr[i].v[1], ev, CHECK_RULES);
+        for (int r = 0; r < eng.count; r++) {
+            if (eng.rules[r].active != naive_fire(&eng.rules[r], tr, i)) mismatches++;
+            fired += eng.rules[r].active;
+        }
+    }
+    printf("     (창 %d개, 발생 상태 %d회, 이벤트 %llu개)\n", eng.window_count, fired,
+           (unsigned long long)eng.events);
+    CHECK(mismatches == 0, "모든 샘플/규칙에서 상태 일치");
+    CHECK(fired > 0 && eng.events > 0, "비교가 실제 발생을 포함");
+    alert_engine_free(&eng);
+}
+
+// ---- 벤치마크 ----
+
+static void bench_replay(const char *name, const trace_point_t *tr, int n) {
+    static alert_event_t ev[MAX_EVENTS];
+    alert_engine_t eng;
+    char line[96];
+    double start, dt;
+    uint64_t events = 0;
+    size_t pool = 0;
+
+    alert_engine_init(&eng);
+    rng = 12345;
+    for (int r = 0; r < BENCH_RULES; r++) {
+        random_rule(line, sizeof(line), r);
+        alert_engine_compile(&eng, line);
+    }
+    alert_engine_finalize(&eng, 0);
+    for (int w = 0; w < eng.window_count; w++) {
+        pool += eng.windows[w].min_dq.cap * !!(eng.windows[w].needs & ALERT_WIN_MIN) +
+                eng.windows[w].max_dq.cap * !!(eng.windows[w].needs & ALERT_WIN_MAX) +
+                eng.windows[w].samples.cap * !!(eng.windows[w].needs & ALERT_WIN_SUM);
+    }
+
+    start = now_sec();
+    for (int i = 0; i < n; i++) {
+        events += (uint64_t)alert_engine_update(&eng, tr[i].t, tr[i].v[0], tr[i].v[1], ev, MAX_EVENTS);
+    }
+    dt = now_sec() - start;
+
+    printf("  %s: 샘플 %d개, 규칙 %d개, 공유 창 %d개 (창 메모리 %zu KB)\n",
+           name, n, eng.count, eng.window_count, pool * sizeof(alert_point_t) / 1024);
+    printf("    ⏱️ %.1f µs/샘플 (규칙당 %.1f ns), 이벤트 %llu개\n",
+           dt * 1e6 / n, dt * 1e9 / n / eng.count, (unsigned long long)events);
+    alert_engine_free(&eng);
+}
+
+static void bench_naive(const trace_point_t *tr, int n) {
+    alert_engine_t eng;
+    char line[96];
+    volatile int sink = 0;
+    double start, dt;
+    const int rules = 100;
+
+    alert_engine_init(&eng);
+    rng = 12345;
+    for (int r = 0; r < rules; r++) {
+        random_rule(line, sizeof(line), r);
+        alert_engine_compile(&eng, line);
+    }
+
+    start = now_sec();
+    for (int i = 0; i < n; i++) {
+        for (int r = 0; r < eng.count; r++) sink += naive_fire(&eng.rules[r], tr, i);
+    }
+    dt = now_sec() - start;
+    (void)sink;
+
+    printf("    (비교: 샘플마다 창 전체를 다시 훑으면 규칙당 %.1f ns)\n", dt * 1e9 / n / eng.count);
+    alert_engine_free(&eng);
+}
+
+int main(int argc, char **argv) {
+    test_compile();
+    test_semantics();
+    test_against_naive();
+
+    if (argc > 1 && strcmp(argv[1], "--bench") == 0) {
+        static trace_point_t tr[MAX_TRACE];
+
+        printf("📊 경보 규칙 벤치마크\n");
+        rng = 777;
+        gen_walk(tr, MAX_TRACE);
+        bench_replay("합성 기록 (3~60초, 1주)", tr, MAX_TRACE);
+        bench_naive(tr, DAY_SAMPLES);
+
+        // 실제 장비에서 가져온 이력 링 파일이 있으면 그것도 재생
+        if (argc > 2) {
+            static sensor_sample_t samples[MAX_TRACE];
+            history_store_t store;
+            if (history_store_open(&store, argv[2], 0) == 0) {
+                size_t n = history_store_query(&store, 0, INT64_MAX, samples, MAX_TRACE);
+                history_store_close(&store);
+                for (size_t i = 0; i < n; i++) {
+                    tr[i].t = sample_time_ms(&samples[i]);
+                    tr[i].v[0] = samples[i].temp_centi;
+                    tr[i].v[1] = samples[i].humi_centi;
+                }
+                if (n > 0) bench_replay(argv[2], tr, (int)n);
+            }
+        }
+    }
+
+    if (failures) {
+        printf("❌ 실패 %d건\n", failures);
+        return 1;
+    }
+    printf("🎉 모든 경보 규칙 테스트 통과\n");
+    return 0;
+}
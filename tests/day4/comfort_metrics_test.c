@@ -0,0 +1,154 @@
+#include <stdio.h>
+#include <math.h>
+#include <time.h>
+#include "comfort_metrics.h"
+#include "../../scripts/comfort_formulas.h"
+#include "test_check.h"
+
+// 허용 오차 (0.01 단위): 표시 해상도 0.1 기준
+#define DEW_POINT_TOL       10      // 0.10°C
+#define HEAT_INDEX_TOL      80      // 0.80°C: NWS 식 분기(80°F, RH 85%)의 불연속을
+                                    // 보간이 매끄럽게 잇는 칸에서만 커짐
+#define ABS_HUMIDITY_TOL    5       // 0.05 g/m³
+
+#define SPEED_ROUNDS        200
+
+typedef int (*lut_fn_t)(int t, int h);
+typedef double (*ref_fn_t)(double t, double rh);
+
+static volatile long sink;
+static volatile double dsink;
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// 0.1°C x 0.5% 간격 전 구간에서 기준식과 비교
+static void check_accuracy(const char *name, lut_fn_t lut, ref_fn_t ref, int tol) {
+    int max_err = 0, worst_t = 0, worst_h = 0;
+    long sum_err = 0, count = 0;
+    char msg[128];
+
+    for (int t = COMFORT_TEMP_MIN_CENTI; t <= COMFORT_TEMP_MAX_CENTI; t += 10) {
+        for (int h = COMFORT_HUMI_MIN_CENTI; h <= COMFORT_HUMI_MAX_CENTI; h += 50) {
+            int expect = (int)lround(ref(t / 100.0, h / 100.0) * 100.0);
+            int err = lut(t, h) - expect;
+            if (err < 0) err = -err;
+            if (err > max_err) {
+                max_err = err;
+                worst_t = t;
+                worst_h = h;
+            }
+            sum_err += err;
+            count++;
+        }
+    }
+
+    snprintf(msg, sizeof(msg), "%-12s 최대 오차 %d.%02d (%d.%d°C, %d%%) 평균 %.3f",
+             name, max_err / 100, max_err % 100, worst_t / 100, (worst_t % 100) / 10,
+             worst_h / 100, (double)sum_err / count / 100.0);
+    CHECK(max_err <= tol, msg);
+}
+
+// 실제 DHT11 입력 범위 전체를 돌며 테이블 vs 기준식 속도 비교
+static void compare_speed(const char *name, lut_fn_t lut, ref_fn_t ref) {
+    double start, lut_s, ref_s;
+    long points = 0, acc = 0;
+    double dacc = 0;
+
+    start = now_sec();
+    for (int r = 0; r < SPEED_ROUNDS; r++) {
+        for (int t = 0; t <= 5000; t += 10) {
+            for (int h = 2000; h <= 9000; h += 100) {
+                acc += lut(t + r, h);
+                points++;
+            }
+        }
+    }
+    lut_s = now_sec() - start;
+    sink = acc;
+
+    start = now_sec();
+    for (int r = 0; r < SPEED_ROUNDS; r++) {
+        for (int t = 0; t <= 5000; t += 10) {
+            for (int h = 2000; h <= 9000; h += 100) {
+                dacc += ref((t + r) / 100.0, h / 100.0);
+            }
+        }
+    }
+    ref_s = now_sec() - start;
+    dsink = dacc;
+
+    printf("  ⏱️ %-12s 테이블 %6.1f ns | 기준식 %6.1f ns | %.1f배\n", name,
+           lut_s * 1e9 / points, ref_s * 1e9 / points, ref_s / lut_s);
+}
+
+// 화면 갱신 실사용 형태: 세 지표를 한 번에
+static void compare_speed_all(void) {
+    double start, lut_s, ref_s;
+    long points = 0, acc = 0;
+    double dacc = 0;
+    comfort_metrics_t m;
+
+    start = now_sec();
+    for (int r = 0; r < SPEED_ROUNDS; r++) {
+        for (int t = 0; t <= 5000; t += 10) {
+            for (int h = 2000; h <= 9000; h += 100) {
+                comfort_compute(t + r, h, &m);
+                acc += m.dew_point_centi + m.heat_index_centi + m.abs_humidity_centi;
+                points++;
+            }
+        }
+    }
+    lut_s = now_sec() - start;
+    sink = acc;
+
+    start = now_sec();
+    for (int r = 0; r < SPEED_ROUNDS; r++) {
+        for (int t = 0; t <= 5000; t += 10) {
+            for (int h = 2000; h <= 9000; h += 100) {
+                double tc = (t + r) / 100.0, rh = h / 100.0;
+                dacc += ref_dew_point(tc, rh) + ref_heat_index(tc, rh) + ref_abs_humidity(tc, rh);
+            }
+        }
+    }
+    ref_s = now_sec() - start;
+    dsink = dacc;
+
+    printf("  ⏱️ %-12s 테이블 %6.1f ns | 기준식 %6.1f ns | %.1f배\n", "세 지표 일괄",
+           lut_s * 1e9 / points, ref_s * 1e9 / points, ref_s / lut_s);
+}
+
+int main(void) {
+    comfort_metrics_t m;
+
+    printf("🧪 편의 지표 정확도 (기준식 대비)\n");
+    check_accuracy("이슬점", comfort_dew_point, ref_dew_point, DEW_POINT_TOL);
+    check_accuracy("체감 온도", comfort_heat_index, ref_heat_index, HEAT_INDEX_TOL);
+    check_accuracy("절대 습도", comfort_abs_humidity, ref_abs_humidity, ABS_HUMIDITY_TOL);
+
+    printf("🧪 일괄 계산/경계 처리\n");
+    comfort_compute(2500, 5000, &m);
+    CHECK(m.dew_point_centi == comfort_dew_point(2500, 5000) &&
+          m.heat_index_centi == comfort_heat_index(2500, 5000) &&
+          m.abs_humidity_centi == comfort_abs_humidity(2500, 5000),
+          "comfort_compute = 개별 함수");
+    CHECK(comfort_dew_point(-500, 1000) == comfort_dew_point(0, 2000) &&
+          comfort_dew_point(6000, 9900) == comfort_dew_point(5000, 9000),
+          "정의역 밖 입력은 경계값으로 포화");
+
+    printf("📊 속도 (호출당)\n");
+    compare_speed("이슬점", comfort_dew_point, ref_dew_point);
+    compare_speed("체감 온도", comfort_heat_index, ref_heat_index);
+    compare_speed("절대 습도", comfort_abs_humidity, ref_abs_humidity);
+    compare_speed_all();
+
+    if (failures) {
+        printf("❌ 실패 %d건\n", failures);
+        return 1;
+    }
+    printf("🎉 모든 편의 지표 테스트 통과\n");
+    return 0;
+}
@@ -0,0 +1,209 @@
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "dht11_capture.h"
+#include "test_check.h"
+
+#define BENCH_FRAMES    1000000
+#define WINDOW_NS       ((uint64_t)DHT11_CAPTURE_US * 1000ULL)
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void push(dht11_edge_t *edges, int *n, uint64_t *t, uint32_t after_us, int rising) {
+    *t += (uint64_t)after_us * 1000ULL;
+    edges[*n].ns = *t;
+    edges[*n].rising = (uint8_t)rising;
+    (*n)++;
+}
+
+// 센서 응답 + 40비트 + 유휴 복귀 에지 (jitter: 비트마다 HIGH 폭 흔들림 µs)
+static int make_frame(dht11_edge_t *edges, const uint8_t data[5], int jitter) {
+    uint64_t t = 1000000000ULL;
+    int n = 0;
+
+    push(edges, &n, &t, 30, 0);             // 센서가 LOW로 응답
+    push(edges, &n, &t, 80, 1);             // 80µs 뒤 HIGH
+    push(edges, &n, &t, 80, 0);             // 80µs 뒤 첫 비트 LOW
+    for (int b = 0; b < 40; b++) {
+        int one = (data[b / 8] >> (7 - b % 8)) & 1;
+        int j = (b % 2) ? jitter : -jitter;
+        push(edges, &n, &t, 50, 1);
+        push(edges, &n, &t, (uint32_t)((one ? 70 : 27) + j), 0);
+    }
+    push(edges, &n, &t, 50, 1);             // 마지막 LOW 뒤 풀업으로 복귀
+    return n;
+}
+
+static void make_data(uint8_t data[5], int humi, int humi_dec, int temp, int temp_dec) {
+    data[0] = (uint8_t)humi;
+    data[1] = (uint8_t)humi_dec;
+    data[2] = (uint8_t)temp;
+    data[3] = (uint8_t)temp_dec;
+    data[4] = (uint8_t)(data[0] + data[1] + data[2] + data[3]);
+}
+
+static void test_decode(void) {
+    dht11_edge_t edges[DHT11_MAX_EDGES];
+    uint8_t data[5], out[5];
+    int n;
+
+    printf("🧪 에지 해독\n");
+    make_data(data, 45, 0, 23, 4);
+    n = make_frame(edges, data, 0);
+    CHECK(n == 84 && dht11_count_highs(edges, n) == 41, "응답 + 40비트 = HIGH 41개");
+    CHECK(dht11_decode_edges(edges, n, out) == 0 && memcmp(out, data, 5) == 0, "정상 프레임");
+
+    n = make_frame(edges, data, 8);
+    CHECK(dht11_decode_edges(edges, n, out) == 0 && memcmp(out, data, 5) == 0, "HIGH 폭 ±8µs 흔들림");
+
+    // 에지 요청이 늦어 응답 에지를 놓친 경우
+    n = make_frame(edges, data, 0);
+    CHECK(dht11_decode_edges(edges + 3, n - 3, out) == 0 && memcmp(out, data, 5) == 0,
+          "앞쪽 응답 에지 누락");
+
+    CHECK(dht11_decode_edges(edges, 40, out) == -1, "비트 부족");
+
+    // 중간 하강 에지를 놓치면 상승 에지가 연달아 옴 (그대로 두면 비트가 밀림)
+    n = make_frame(edges, data, 0);
+    memmove(&edges[20], &edges[21], (size_t)(n - 21) * sizeof(edges[0]));
+    CHECK(dht11_decode_edges(edges, n - 1, out) == -1, "중간 에지 누락은 오류");
+
+    // 짧은 잡음 펄스
+    n = make_frame(edges, data, 0);
+    edges[30].ns = edges[29].ns + 3000;
+    CHECK(dht11_decode_edges(edges, n, out) == -1, "잡음 펄스는 오류");
+}
+
+static void test_frame_check(void) {
+    dht11_state_t st;
+    uint8_t data[5];
+    int t = 0, h = 0;
+
+    printf("🧪 프레임 검증\n");
+    dht11_state_init(&st);
+
+    make_data(data, 45, 0, 23, 4);
+    CHECK(dht11_frame_check(&st, data, &t, &h) == 0 && t == 2340 && h == 4500, "23.4°C, 45%");
+
+    make_data(data, 60, 0, 5, 0x80 | 3);
+    CHECK(dht11_frame_check(&st, data, &t, &h) == 0 && t == -530, "영하 -5.3°C");
+
+    make_data(data, 45, 0, 23, 4);
+    data[4] ^= 1;
+    CHECK(dht11_frame_check(&st, data, &t, &h) == -1 && st.stats.checksum_errors == 1, "체크섬 오류");
+
+    make_data(data, 99, 0, 23, 0);
+    CHECK(dht11_frame_check(&st, data, &t, &h) == -1 && st.stats.range_errors == 1, "습도 범위 밖");
+
+    make_data(data, 45, 0, 70, 0);
+    CHECK(dht11_frame_check(&st, data, &t, &h) == -1 && st.stats.range_errors == 2, "온도 범위 밖");
+}
+
+static void test_filter(void) {
+    dht11_state_t a, b;
+    int t = 0, h = 0;
+
+    printf("🧪 센서별 필터 상태\n");
+    dht11_state_init(&a);
+    dht11_state_init(&b);
+    CHECK(a.last_valid_temp == 2500 && a.last_valid_humi == 5000, "기본 25°C/50%");
+
+    dht11_state_accept(&a, 2100, 4000);
+    dht11_state_accept(&b, 2900, 7000);
+    CHECK(dht11_state_reject(&a, &t, &h) == 1 && t == 2100 && h == 4000, "실패 1회: 마지막 값");
+    CHECK(dht11_state_reject(&a, &t, &h) == 1, "실패 2회: 마지막 값");
+    CHECK(dht11_state_reject(&a, &t, &h) == 0 && a.stats.reads_failed == 3, "실패 3회: 값 없음");
+    CHECK(b.consecutive_errors == 0 && b.last_valid_temp == 2900, "다른 센서 상태와 독립");
+
+    dht11_state_accept(&a, 2200, 4100);
+    CHECK(a.consecutive_errors == 0 && a.stats.reads_ok == 2, "성공하면 연속 오류 초기화");
+}
+
+static int windows_disjoint(const uint64_t *r, int n) {
+    for (int i = 0; i < n; i++) {
+        for (int j = i + 1; j < n; j++) {
+            if (r[i] + WINDOW_NS > r[j] && r[j] + WINDOW_NS > r[i]) return 0;
+        }
+    }
+    return 1;
+}
+
+static void test_stagger(void) {
+    uint64_t reserved[16] = {0};
+    uint64_t want = 5000000000ULL;
+    uint64_t last = 0;
+    unsigned seed = 12345;
+    int ok = 1;
+
+    printf("🧪 캡처 구간 엇갈림\n");
+
+    // 16개가 같은 시각을 원하면 8ms 간격으로 차례
+    for (int i = 0; i < 16; i++) {
+        reserved[i] = dht11_stagger(reserved, 16, want, WINDOW_NS);
+        if (reserved[i] > last) last = reserved[i];
+    }
+    CHECK(windows_disjoint(reserved, 16), "16개 동시 요청: 겹침 없음");
+    CHECK(last - want == 15 * WINDOW_NS, "16개 동시 요청: 마지막은 15구간 뒤");
+
+    CHECK(dht11_stagger(reserved, 16, want + 200 * WINDOW_NS, WINDOW_NS) == want + 200 * WINDOW_NS,
+          "빈 시각은 그대로");
+
+    // 구역 하나씩 무작위 시각으로 다시 예약 (실행 중 재예약과 같음)
+    for (int round = 0; round < 10000; round++) {
+        int z;
+        seed = seed * 1103515245u + 12345u;
+        z = (int)((seed >> 16) % 16);
+        seed = seed * 1103515245u + 12345u;
+        reserved[z] = 0;
+        reserved[z] = dht11_stagger(reserved, 16, want + (uint64_t)((seed >> 8) % 200000) * 1000ULL,
+                                    WINDOW_NS);
+        if (!windows_disjoint(reserved, 16)) ok = 0;
+    }
+    CHECK(ok, "무작위 재예약 1만 회: 항상 겹침 없음");
+}
+
+static void bench(void) {
+    dht11_edge_t edges[DHT11_MAX_EDGES];
+    uint8_t data[5], out[5];
+    volatile unsigned sink = 0;
+    double t0, dt;
+    int n;
+
+    make_data(data, 45, 0, 23, 4);
+    n = make_frame(edges, data, 5);
+
+    t0 = now_sec();
+    for (int i = 0; i < BENCH_FRAMES; i++) {
+        dht11_decode_edges(edges, n, out);
+        sink += out[4];
+    }
+    dt = now_sec() - t0;
+    (void)sink;
+
+    printf("📊 해독: %.0f ns/프레임 (에지 %d개)\n", dt * 1e9 / BENCH_FRAMES, n);
+    printf("📊 바쁜 대기 읽기 CPU: 약 %d µs/회 (시작 신호 %dms + 프레임)\n",
+           DHT11_START_LOW_US + 5000, DHT11_START_LOW_US / 1000);
+    printf("📊 센서 16개 × 3초 주기 CPU 점유: 바쁜 대기 %.1f%%, 에지 해독 %.4f%%\n",
+           16.0 * (DHT11_START_LOW_US + 5000) / 3e6 * 100.0,
+           16.0 * dt / BENCH_FRAMES / 3.0 * 100.0);
+}
+
+int main(int argc, char *argv[]) {
+    test_decode();
+    test_frame_check();
+    test_filter();
+    test_stagger();
+
+    if (argc > 1 && strcmp(argv[1], "--bench") == 0) bench();
+
+    if (failures) {
+        printf("❌ 실패 %d건\n", failures);
+        return 1;
+    }
+    printf("🎉 모든 DHT11 캡처 테스트 통과\n");
+    return 0;
+}
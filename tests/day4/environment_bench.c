@@ -0,0 +1,110 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include "environment_indicator.h"
+
+// 합성 스트림으로 환경 지수 갱신 처리량과 등급 변화 횟수를 측정
+#define SAMPLES     (1 << 20)
+#define ROUNDS      8
+
+typedef struct {
+    const char *name;
+    int temp[SAMPLES];
+    int humi[SAMPLES];
+} stream_t;
+
+static uint32_t rng_state = 12345;
+
+static int rng_range(int span) {
+    rng_state = rng_state * 1103515245u + 12345u;
+    return (int)((rng_state >> 8) % (uint32_t)(2 * span + 1)) - span;
+}
+
+// 적정/주의 경계(26°C) 근처에서 ±0.3°C 흔들리는 센서 노이즈
+static void gen_boundary(stream_t *s) {
+    s->name = "경계 노이즈";
+    for (int i = 0; i < SAMPLES; i++) {
+        s->temp[i] = 2600 + rng_range(30);
+        s->humi[i] = 5000 + rng_range(100);
+    }
+}
+
+// 하루 주기 온도 변화를 흉내 낸 랜덤 워크
+static void gen_walk(stream_t *s) {
+    int t = 2300, h = 5000;
+    s->name = "랜덤 워크";
+    for (int i = 0; i < SAMPLES; i++) {
+        t += rng_range(10);
+        h += rng_range(20);
+        if (t < 1500) t = 1500;
+        if (t > 3100) t = 3100;
+        if (h < 2000) h = 2000;
+        if (h > 8000) h = 8000;
+        s->temp[i] = t;
+        s->humi[i] = h;
+    }
+}
+
+// 완전 무작위 (분기 예측 최악)
+static void gen_random(stream_t *s) {
+    s->name = "무작위";
+    for (int i = 0; i < SAMPLES; i++) {
+        s->temp[i] = 2300 + rng_range(800);
+        s->humi[i] = 5000 + rng_range(3000);
+    }
+}
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void run(stream_t *s, int hysteresis) {
+    env_config_t config = ENV_CONFIG_DEFAULT;
+    env_status_t st = {0};
+    long changes = 0;
+    env_level_t prev;
+    double start, elapsed;
+
+    if (!hysteresis) {
+        config.temp.hysteresis = 0;
+        config.humi.hysteresis = 0;
+    }
+    environment_set_config(&st, &config);
+
+    update_environment_status_at(&st, s->temp[0], s->humi[0], 0);
+    prev = st.overall_level;
+
+    start = now_sec();
+    for (int r = 0; r < ROUNDS; r++) {
+        for (int i = 0; i < SAMPLES; i++) {
+            // 샘플 간격 3초 (DHT11 최소 주기)
+            update_environment_status_at(&st, s->temp[i], s->humi[i],
+                                         ((int64_t)r * SAMPLES + i) * 3000);
+            changes += (st.overall_level != prev);
+            prev = st.overall_level;
+        }
+    }
+    elapsed = now_sec() - start;
+
+    printf("  %-12s 히스테리시스 %-3s | %6.1f M샘플/s | %5.1f ns/샘플 | 등급 변화 %ld회\n",
+           s->name, hysteresis ? "ON" : "OFF",
+           (double)SAMPLES * ROUNDS / elapsed / 1e6,
+           elapsed * 1e9 / ((double)SAMPLES * ROUNDS),
+           changes);
+}
+
+int main(void) {
+    static stream_t stream;
+    void (*generators[])(stream_t *) = { gen_boundary, gen_walk, gen_random };
+
+    printf("📊 환경 지수 갱신 벤치마크 (%d샘플 x %d회)\n", SAMPLES, ROUNDS);
+    for (size_t g = 0; g < sizeof(generators) / sizeof(generators[0]); g++) {
+        generators[g](&stream);
+        run(&stream, 1);
+        run(&stream, 0);
+    }
+    return 0;
+}
@@ -0,0 +1,124 @@
+#include <stdio.h>
+#include "environment_indicator.h"
+#include "test_check.h"
+
+static void test_bands(void) {
+    env_status_t st = {0};
+
+    printf("🧪 기본 구간 판정\n");
+    update_environment_status_at(&st, 2300, 5000, 0);
+    CHECK(st.overall_level == ENV_GOOD, "23°C/50% → 적정");
+
+    st = (env_status_t){0};
+    update_environment_status_at(&st, 2700, 5000, 0);
+    CHECK(st.overall_level == ENV_WARNING, "27°C/50% → 주의");
+
+    st = (env_status_t){0};
+    update_environment_status_at(&st, 2300, 7500, 0);
+    CHECK(st.overall_level == ENV_DANGER, "23°C/75% → 위험");
+
+    st = (env_status_t){0};
+    update_environment_status_at(&st, 2000, 4000, 0);
+    CHECK(st.overall_level == ENV_GOOD, "경계값 20°C/40% → 적정");
+
+    st = (env_status_t){0};
+    update_environment_status_at(&st, 1799, 5000, 0);
+    CHECK(st.overall_level == ENV_DANGER, "17.99°C → 위험");
+}
+
+static void test_hysteresis(void) {
+    env_status_t st = {0};
+
+    printf("🧪 히스테리시스\n");
+    update_environment_status_at(&st, 2650, 5000, 0);
+    CHECK(st.temp_level == ENV_WARNING, "26.5°C → 주의");
+
+    update_environment_status_at(&st, 2590, 5000, 100);
+    CHECK(st.temp_level == ENV_WARNING, "25.9°C (여유 0.5°C 안) → 주의 유지");
+
+    update_environment_status_at(&st, 2610, 5000, 200);
+    CHECK(st.temp_level == ENV_WARNING, "26.1°C → 주의 유지");
+
+    update_environment_status_at(&st, 2549, 5000, 300);
+    CHECK(st.temp_level == ENV_GOOD, "25.49°C → 적정 복귀");
+
+    update_environment_status_at(&st, 2601, 5000, 400);
+    CHECK(st.temp_level == ENV_WARNING, "26.01°C → 악화는 즉시");
+
+    st = (env_status_t){0};
+    update_environment_status_at(&st, 2300, 7200, 0);
+    CHECK(st.humi_level == ENV_DANGER, "72% → 위험");
+    update_environment_status_at(&st, 2300, 6900, 100);
+    CHECK(st.humi_level == ENV_DANGER, "69% (여유 2% 안) → 위험 유지");
+    update_environment_status_at(&st, 2300, 5500, 200);
+    CHECK(st.humi_level == ENV_GOOD, "55% → 두 단계 개선도 한 번에");
+}
+
+static void test_escalation(void) {
+    env_status_t st = {0};
+
+    printf("🧪 주의 지속 → 위험 승격\n");
+    update_environment_status_at(&st, 2700, 5000, 1000);
+    CHECK(st.overall_level == ENV_WARNING && !st.prolonged_warning, "주의 시작");
+
+    update_environment_status_at(&st, 2700, 5000, 10999);
+    CHECK(st.overall_level == ENV_WARNING, "9.999초 → 주의");
+
+    update_environment_status_at(&st, 2700, 5000, 11000);
+    CHECK(st.overall_level == ENV_DANGER && st.prolonged_warning, "10초 → 위험 승격");
+
+    update_environment_status_at(&st, 2580, 5000, 12000);
+    CHECK(st.overall_level == ENV_DANGER, "25.8°C (여유 안) → 주의 유지, 승격도 유지");
+
+    update_environment_status_at(&st, 2200, 5000, 13000);
+    CHECK(st.overall_level == ENV_GOOD && !st.prolonged_warning, "적정 복귀 시 승격 해제");
+
+    update_environment_status_at(&st, 2700, 5000, 14000);
+    update_environment_status_at(&st, 2700, 5000, 20000);
+    CHECK(st.overall_level == ENV_WARNING, "새 주의 구간은 타이머 재시작");
+
+    update_environment_status_at(&st, 2900, 5000, 21000);
+    update_environment_status_at(&st, 2700, 5000, 22000);
+    update_environment_status_at(&st, 2700, 5000, 31000);
+    CHECK(st.overall_level == ENV_WARNING, "위험을 거치면 타이머 재시작");
+}
+
+static void test_config(void) {
+    static const env_config_t strict = {
+        .temp = { 2100, 2400, 1900, 2600, 0 },
+        .humi = { 4500, 5500, 3500, 6500, 0 },
+        .escalation_ms = 2000,
+    };
+    env_status_t st = {0};
+
+    printf("🧪 사용자 기준\n");
+    environment_set_config(&st, &strict);
+    update_environment_status_at(&st, 2500, 5000, 0);
+    CHECK(st.overall_level == ENV_WARNING, "25°C → 주의 (엄격 기준)");
+    update_environment_status_at(&st, 2500, 5000, 2000);
+    CHECK(st.overall_level == ENV_DANGER, "2초 → 위험 승격");
+    update_environment_status_at(&st, 2390, 5000, 2100);
+    CHECK(st.overall_level == ENV_GOOD, "히스테리시스 0 → 즉시 복귀");
+}
+
+static void test_text(void) {
+    printf("🧪 표시 문자열\n");
+    CHECK(get_level_text(ENV_GOOD)[0] == 'G', "GOOD");
+    CHECK(get_level_text(ENV_DANGER)[0] == 'D', "DANGER");
+    CHECK(get_level_icon(ENV_WARNING)[1] == '|', ":|");
+}
+
+int main(void) {
+    test_bands();
+    test_hysteresis();
+    test_escalation();
+    test_config();
+    test_text();
+
+    if (failures) {
+        printf("❌ 실패 %d건\n", failures);
+        return 1;
+    }
+    printf("🎉 모든 환경 지수 테스트 통과\n");
+    return 0;
+}
@@ -0,0 +1,127 @@
+#include <stdio.h>
+#include <string.h>
+#include <limits.h>
+#include "fixed_point.h"
+#include "test_check.h"
+
+// 정수 인자 하나를 받는 서식의 기대 출력
+typedef struct {
+    const char *fmt;
+    int value;
+    const char *expect;
+} fx_case_t;
+
+static const fx_case_t int_cases[] = {
+    // %q 기본 1자리, 반올림은 0에서 먼 쪽
+    { "%q",      2345,      "23.5" },
+    { "%q",      2344,      "23.4" },
+    { "%q",      0,         "0.0" },
+    { "%.0q",    2350,      "24" },
+    { "%.2q",    2345,      "23.45" },
+    { "%.5q",    2345,      "23.45" },         // 최대 2자리
+    // -1.00 ~ 0 사이 음수: 정수부가 0이어도 부호 유지, 0으로 반올림되면 부호 없음
+    { "%.2q",    -5,        "-0.05" },
+    { "%q",      -5,        "-0.1" },
+    { "%q",      -4,        "0.0" },
+    { "%.0q",    -50,       "-1" },
+    { "%.0q",    -49,       "0" },
+    { "%.2q",    -99,       "-0.99" },
+    { "%q",      -100,      "-1.0" },
+    // 범위 끝
+    { "%.2q",    INT_MIN,   "-21474836.48" },
+    { "%q",      INT_MIN,   "-21474836.5" },
+    { "%.0q",    INT_MIN,   "-21474836" },
+    { "%.2q",    INT_MAX,   "21474836.47" },
+    { "%q",      INT_MAX,   "21474836.5" },
+    { "%d",      INT_MIN,   "-2147483648" },
+    // 폭/0 채움/왼쪽 정렬과 %q
+    { "%6q",     -2345,     " -23.5" },
+    { "%06q",    -2345,     "-023.5" },
+    { "%-7q|",   -2345,     "-23.5  |" },
+    { "%07.2q",  -5,        "-000.05" },
+    { "%3q",     12345,     "123.5" },         // 폭보다 길면 그대로
+    { "%05d",    -42,       "-0042" },
+    { "%-4d|",   7,         "7   |" },
+    // %% 와 앞뒤 문자
+    { "%q%%",    4550,      "45.5%" },
+    { "%%%d%%",  3,         "%3%" },
+    { "T %.1qC", -1000,     "T -10.0C" },
+};
+
+static void test_table(void) {
+    char buf[32];
+
+    printf("🧪 서식 표 (%zu건)\n", sizeof(int_cases) / sizeof(int_cases[0]));
+    for (size_t i = 0; i < sizeof(int_cases) / sizeof(int_cases[0]); i++) {
+        const fx_case_t *c = &int_cases[i];
+        char name[64];
+        int len = fx_format(buf, sizeof(buf), c->fmt, c->value);
+
+        snprintf(name, sizeof(name), "\"%s\" %d → \"%s\"", c->fmt, c->value, c->expect);
+        CHECK(strcmp(buf, c->expect) == 0 && len == (int)strlen(c->expect), name);
+        if (strcmp(buf, c->expect) != 0) printf("     실제: \"%s\"\n", buf);
+    }
+}
+
+static void test_other_conversions(void) {
+    char buf[32];
+
+    printf("🧪 문자열/문자/기타 변환\n");
+    fx_format(buf, sizeof(buf), "[%-5s][%5s][%.2s]", "ab", "cd", "efgh");
+    CHECK(strcmp(buf, "[ab   ][   cd][ef]") == 0, "%s 폭/정밀도");
+    fx_format(buf, sizeof(buf), "%c%3c%-3c|", 'a', 'b', 'c');
+    CHECK(strcmp(buf, "a  bc  |") == 0, "%c 폭");
+    fx_format(buf, sizeof(buf), "%u %s", 4000000000u, (const char *)NULL);
+    CHECK(strcmp(buf, "4000000000 (null)") == 0, "%u, NULL 문자열");
+    fx_format(buf, sizeof(buf), "%x 100%");
+    CHECK(strcmp(buf, "%x 100") == 0, "모르는 변환은 그대로, 끝의 %는 무시");
+}
+
+static void test_truncation(void) {
+    char buf[8];
+    int len;
+
+    printf("🧪 잘림/NUL 종료\n");
+    memset(buf, '#', sizeof(buf));
+    len = fx_format(buf, 5, "%.2q", 123456);
+    CHECK(len == 7, "잘리지 않았을 때 길이 반환");
+    CHECK(memcmp(buf, "1234\0###", 8) == 0, "size-1자 + NUL, 그 뒤는 건드리지 않음");
+
+    memset(buf, '#', sizeof(buf));
+    len = fx_format(buf, 8, "%s", "1234567");
+    CHECK(len == 7 && memcmp(buf, "1234567\0", 8) == 0, "딱 맞는 길이");
+
+    memset(buf, '#', sizeof(buf));
+    len = fx_format(buf, 1, "%d", 42);
+    CHECK(len == 2 && buf[0] == '\0' && buf[1] == '#', "size 1 → 빈 문자열");
+
+    memset(buf, '#', sizeof(buf));
+    len = fx_format(buf, 0, "%q%%", 4550);
+    CHECK(len == 5 && buf[0] == '#', "size 0 → 아무것도 쓰지 않고 길이만");
+
+    memset(buf, '#', sizeof(buf));
+    len = fx_format(buf, 6, "%q%%", -4550);
+    CHECK(len == 6 && memcmp(buf, "-45.5\0", 6) == 0, "%% 자리에서 잘림");
+}
+
+static void test_round(void) {
+    printf("🧪 반올림\n");
+    CHECK(fx_round_centi(2345, 1) == 2350 && fx_round_centi(-2345, 1) == -2350, "0.5는 0에서 먼 쪽");
+    CHECK(fx_round_centi(-4, 1) == 0 && fx_round_centi(-5, 1) == -10, "-1.00 ~ 0 사이");
+    CHECK(fx_round_centi(INT_MIN, 0) == -21474836 * 100, "INT_MIN은 int 안에서 0 쪽으로");
+    CHECK(fx_round_centi(INT_MAX, 1) == 2147483640, "INT_MAX는 int 안에서 0 쪽으로");
+}
+
+int main(void) {
+    test_table();
+    test_other_conversions();
+    test_truncation();
+    test_round();
+
+    if (failures) {
+        printf("❌ 실패 %d건\n", failures);
+        return 1;
+    }
+    printf("🎉 모든 고정소수점 서식 테스트 통과\n");
+    return 0;
+}
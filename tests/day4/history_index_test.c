@@ -0,0 +1,260 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "history_index.h"
+#include "test_check.h"
+
+#define TEST_PATH       "/tmp/history_index_test.ring"
+#define TEST_CAPACITY   1000    // 블록 크기의 배수가 아님 (마지막 블록 잘림)
+#define SIX_HOURS       7200    // 3초 간격 6시간 샘플 수
+
+static uint32_t rng_state = 12345;
+
+static uint32_t rng(void) {
+    rng_state = rng_state * 1103515245u + 12345u;
+    return rng_state >> 8;
+}
+
+// 3초 간격 합성 샘플 (가끔 무효)
+static sensor_sample_t make_sample(uint32_t i) {
+    sensor_sample_t s;
+    s.time = 1700000000u + i * 3;
+    s.time_ms = 0;
+    s.temp_centi = (int16_t)(2000 + (int)(i * 7919 % 1500) - 700);
+    s.humi_centi = (uint16_t)(5000 + (int)(i * 104729 % 3001) - 1500);
+    s.flags = (i % 17 == 3) ? SAMPLE_FLAG_STALE : SAMPLE_FLAG_VALID | SAMPLE_FLAG_TIME_RTC;
+    return s;
+}
+
+// 기준: 논리 구간 [first, last) 단순 순회
+static history_agg_t naive_range(const history_store_t *store, uint32_t first, uint32_t last) {
+    history_agg_t a = { 0, 0, 0, INT16_MAX, INT16_MIN, UINT16_MAX, 0, 0 };
+
+    for (uint32_t i = first; i < last; i++) {
+        const sensor_sample_t *s = history_store_get(store, i);
+        if (!(s->flags & SAMPLE_FLAG_VALID)) continue;
+        a.temp_sum += s->temp_centi;
+        a.humi_sum += s->humi_centi;
+        a.count++;
+        if (s->temp_centi < a.temp_min) a.temp_min = s->temp_centi;
+        if (s->temp_centi > a.temp_max) a.temp_max = s->temp_centi;
+        if (s->humi_centi < a.humi_min) a.humi_min = s->humi_centi;
+        if (s->humi_centi > a.humi_max) a.humi_max = s->humi_centi;
+    }
+    return a;
+}
+
+static int same_agg(const history_agg_t *a, const history_agg_t *b) {
+    if (a->count != b->count) return 0;
+    if (a->count == 0) return 1;
+    return a->temp_sum == b->temp_sum && a->humi_sum == b->humi_sum &&
+           a->temp_min == b->temp_min && a->temp_max == b->temp_max &&
+           a->humi_min == b->humi_min && a->humi_max == b->humi_max;
+}
+
+static int random_ranges_match(const history_index_t *idx, const history_store_t *store, int n) {
+    uint32_t count = history_store_count(store);
+
+    for (int q = 0; q < n; q++) {
+        uint32_t a = rng() % (count + 1);
+        uint32_t b = rng() % (count + 1);
+        history_agg_t got, expect;
+
+        if (a > b) { uint32_t t = a; a = b; b = t; }
+        history_index_range(idx, store, a, b, &got);
+        expect = naive_range(store, a, b);
+        if (!same_agg(&got, &expect)) {
+            printf("    [%u, %u) count %u vs %u\n", a, b, got.count, expect.count);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static void test_ranges(void) {
+    history_store_t store;
+    history_index_t idx;
+    history_agg_t agg, expect;
+    int ok = 1;
+
+    printf("🧪 구간 집계 = 단순 순회 (순환 포함)\n");
+    unlink(TEST_PATH);
+    history_store_open(&store, TEST_PATH, TEST_CAPACITY);
+    CHECK(history_index_init(&idx, &store) == 0, "빈 링 색인 구성");
+    CHECK(history_index_range(&idx, &store, 0, 10, &agg) == 0, "빈 링 → 0개");
+
+    // 한 바퀴 채우는 동안 샘플마다 반영
+    for (uint32_t i = 0; i < 700; i++) {
+        sensor_sample_t s = make_sample(i);
+        history_store_append(&store, &s);
+        history_index_sync(&idx, &store);
+    }
+    CHECK(random_ranges_match(&idx, &store, 2000), "순환 전 무작위 구간 2000개");
+
+    // 링이 여러 번 도는 동안 샘플마다 / 묶어서 반영
+    for (uint32_t i = 700; i < 2600; i++) {
+        sensor_sample_t s = make_sample(i);
+        history_store_append(&store, &s);
+        if (i < 1800 || i % 250 == 0) {
+            history_index_sync(&idx, &store);
+            if (i % 50 == 0) ok &= random_ranges_match(&idx, &store, 50);
+        }
+    }
+    history_index_sync(&idx, &store);
+    CHECK(ok, "순환 중 주기적 검사");
+    CHECK(random_ranges_match(&idx, &store, 5000), "순환 후 무작위 구간 5000개");
+
+    // 전체 구간과 시각 질의
+    history_index_range(&idx, &store, 0, TEST_CAPACITY, &agg);
+    expect = naive_range(&store, 0, TEST_CAPACITY);
+    CHECK(same_agg(&agg, &expect), "전체 구간");
+
+    sensor_sample_t from = make_sample(2000), to = make_sample(2300);
+    history_index_query(&idx, &store, sample_time_ms(&from), sample_time_ms(&to), &agg);
+    expect = naive_range(&store, 2000 - 1600, 2300 - 1600);
+    CHECK(same_agg(&agg, &expect) && agg.count > 0, "시각 구간 [2000, 2300)번");
+    CHECK(history_agg_temp_mean(&agg) == (int)((expect.temp_sum * 2 + expect.count) /
+                                               (2 * (int64_t)expect.count)),
+          "평균 반올림");
+
+    // 반영 없이 한 바퀴 넘게 추가 (head만 보면 조금 추가된 것처럼 보임)
+    for (uint32_t i = 2600; i < 2600 + TEST_CAPACITY + 100; i++) {
+        sensor_sample_t s = make_sample(i);
+        history_store_append(&store, &s);
+    }
+    history_index_sync(&idx, &store);
+    CHECK(random_ranges_match(&idx, &store, 2000), "한 바퀴 넘게 밀린 뒤 반영");
+
+    // 링을 비우고 다시 열면 색인도 다시 구성
+    history_index_free(&idx);
+    history_store_close(&store);
+    unlink(TEST_PATH);
+    history_store_open(&store, TEST_PATH, TEST_CAPACITY);
+    history_index_init(&idx, &store);
+    for (uint32_t i = 0; i < 40; i++) {
+        sensor_sample_t s = make_sample(i);
+        history_store_append(&store, &s);
+    }
+    history_index_sync(&idx, &store);
+    CHECK(random_ranges_match(&idx, &store, 500), "새 링 일괄 반영");
+
+    history_index_free(&idx);
+    history_store_close(&store);
+    unlink(TEST_PATH);
+}
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// 커밋(msync) 비용 없이 링을 직접 채움 - 색인/순회 비용만 재기 위함
+static void fill_direct(history_store_t *store, uint32_t from, uint32_t n) {
+    for (uint32_t i = from; i < from + n; i++) {
+        store->records[store->hdr.head] = make_sample(i);
+        store->hdr.head = (store->hdr.head + 1) % store->hdr.capacity;
+        if (store->hdr.count < store->hdr.capacity) store->hdr.count++;
+    }
+}
+
+static void bench_size(uint32_t n) {
+    history_store_t store;
+    history_index_t idx;
+    history_agg_t agg;
+    volatile int64_t sink = 0;
+    double t0, build_s, sync_s, naive6_s, idx6_s, naive_s, idx_s;
+    int queries = n >= 10000000 ? 20 : 200;
+    uint32_t appends = 100000;
+
+    unlink(TEST_PATH);
+    if (history_store_open(&store, TEST_PATH, n) != 0) {
+        failures++;
+        return;
+    }
+    fill_direct(&store, 0, n + n / 3);      // 한 바퀴 넘게 돈 상태
+
+    t0 = now_sec();
+    history_index_init(&idx, &store);
+    build_s = now_sec() - t0;
+
+    t0 = now_sec();
+    for (uint32_t i = 0; i < appends; i++) {
+        fill_direct(&store, n + n / 3 + i, 1);
+        history_index_sync(&idx, &store);
+    }
+    sync_s = now_sec() - t0;
+
+    // 최근 6시간 (끝에 붙은 구간)
+    t0 = now_sec();
+    for (int q = 0; q < queries; q++) {
+        agg = naive_range(&store, n - SIX_HOURS - (uint32_t)q, n - (uint32_t)q);
+        sink += agg.humi_max;
+    }
+    naive6_s = (now_sec() - t0) / queries;
+    t0 = now_sec();
+    for (int q = 0; q < 100000; q++) {
+        history_index_range(&idx, &store, n - SIX_HOURS - (uint32_t)(q % 1000),
+                            n - (uint32_t)(q % 1000), &agg);
+        sink += agg.humi_max;
+    }
+    idx6_s = (now_sec() - t0) / 100000;
+
+    // 무작위 구간 (평균 n/3)
+    rng_state = 777;
+    t0 = now_sec();
+    for (int q = 0; q < queries; q++) {
+        uint32_t a = rng() % n, b = rng() % n;
+        if (a > b) { uint32_t t = a; a = b; b = t; }
+        agg = naive_range(&store, a, b);
+        sink += agg.temp_max;
+    }
+    naive_s = (now_sec() - t0) / queries;
+    rng_state = 777;
+    t0 = now_sec();
+    for (int q = 0; q < 100000; q++) {
+        uint32_t a = rng() % n, b = rng() % n;
+        if (a > b) { uint32_t t = a; a = b; b = t; }
+        history_index_range(&idx, &store, a, b, &agg);
+        sink += agg.temp_max;
+    }
+    idx_s = (now_sec() - t0) / 100000;
+    (void)sink;
+
+    printf("  n=%-9u 구성 %7.1f ms | 추가+반영 %5.0f ns/샘플 | 6시간 %9.1f µs → %5.2f µs"
+           " | 무작위 %10.1f µs → %5.2f µs (x%.0f)\n",
+           n, build_s * 1e3, sync_s * 1e9 / appends, naive6_s * 1e6, idx6_s * 1e6,
+           naive_s * 1e6, idx_s * 1e6, naive_s / idx_s);
+
+    rng_state = 4242;
+    if (!random_ranges_match(&idx, &store, 20)) {
+        printf("  ❌ n=%u 결과 불일치\n", n);
+        failures++;
+    }
+
+    history_index_free(&idx);
+    history_store_close(&store);
+    unlink(TEST_PATH);
+}
+
+static void bench_index(void) {
+    printf("📊 구간 집계: 단순 순회 → 색인 (블록 %d샘플)\n", HISTORY_INDEX_BLOCK);
+    bench_size(100000);
+    bench_size(1000000);
+    bench_size(10000000);
+}
+
+int main(int argc, char **argv) {
+    test_ranges();
+    if (argc > 1 && strcmp(argv[1], "--bench") == 0) {
+        bench_index();
+    }
+
+    if (failures) {
+        printf("❌ 실패 %d건\n", failures);
+        return 1;
+    }
+    printf("🎉 모든 이력 색인 테스트 통과\n");
+    return 0;
+}
@@ -0,0 +1,245 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include "history_rollup.h"
+#include "test_check.h"
+
+#define RAW_PATH        "/tmp/history_rollup_test.ring"
+#define ROLLUP_PATH     "/tmp/history_rollup_test.rollup"
+#define BASE_TIME       1700006400u     // 자정 (UTC) 정렬
+#define TEST_DAYS       3
+#define TEST_SAMPLES    (TEST_DAYS * 86400 / 3)
+#define RAW_CAPACITY    100000
+#define BENCH_SAMPLES   2000000
+
+// 3초 간격 합성 샘플: 하루 주기 온도 + 잡음 섞인 습도, 가끔 무효 샘플
+static sensor_sample_t make_sample(uint32_t i) {
+    sensor_sample_t s;
+    uint32_t t = i * 3;
+    int phase = (int)(t % 86400) - 43200;
+
+    s.time = BASE_TIME + t;
+    s.time_ms = 0;
+    s.temp_centi = (int16_t)(2200 + (phase < 0 ? -phase : phase) / 20 - 1080 + (int)(i * 7 % 31));
+    s.humi_centi = (uint16_t)(5000 + (int)(i * 13 % 997) - 498);
+    s.flags = (i % 101 == 50) ? SAMPLE_FLAG_STALE : SAMPLE_FLAG_VALID | SAMPLE_FLAG_TIME_RTC;
+    return s;
+}
+
+// [from, to) 유효 샘플의 기준 요약 (전수 계산)
+static rollup_bucket_t brute(uint32_t from, uint32_t to) {
+    rollup_bucket_t b;
+    memset(&b, 0, sizeof(b));
+    b.start = from;
+    for (uint32_t i = 0; i < TEST_SAMPLES; i++) {
+        sensor_sample_t s = make_sample(i);
+        if (s.time < from || s.time >= to || !(s.flags & SAMPLE_FLAG_VALID)) continue;
+        if (b.count == 0 || s.temp_centi < b.temp_min) b.temp_min = s.temp_centi;
+        if (b.count == 0 || s.temp_centi > b.temp_max) b.temp_max = s.temp_centi;
+        if (b.count == 0 || s.humi_centi < b.humi_min) b.humi_min = s.humi_centi;
+        if (b.count == 0 || s.humi_centi > b.humi_max) b.humi_max = s.humi_centi;
+        b.temp_sum += s.temp_centi;
+        b.humi_sum += s.humi_centi;
+        b.count++;
+    }
+    return b;
+}
+
+static int same_bucket(const rollup_bucket_t *a, const rollup_bucket_t *b) {
+    return a->start == b->start && a->count == b->count &&
+           a->temp_sum == b->temp_sum && a->humi_sum == b->humi_sum &&
+           a->temp_min == b->temp_min && a->temp_max == b->temp_max &&
+           a->humi_min == b->humi_min && a->humi_max == b->humi_max;
+}
+
+// 단계 전체가 전수 계산과 같은지
+static int level_matches(const history_rollup_t *rollup, rollup_level_t level) {
+    uint32_t sec = history_rollup_seconds(level);
+    uint32_t n = history_rollup_count(rollup, level);
+
+    if (n != TEST_DAYS * 86400 / sec) return 0;
+    for (uint32_t i = 0; i < n; i++) {
+        rollup_bucket_t expect = brute(BASE_TIME + i * sec, BASE_TIME + (i + 1) * sec);
+        if (!same_bucket(history_rollup_get(rollup, level, i), &expect)) return 0;
+    }
+    return 1;
+}
+
+static void fill(history_store_t *raw, history_rollup_t *rollup) {
+    for (uint32_t i = 0; i < TEST_SAMPLES; i++) {
+        sensor_sample_t s = make_sample(i);
+        history_store_append(raw, &s);
+        history_rollup_add(rollup, &s);
+    }
+}
+
+static void test_incremental(history_store_t *raw) {
+    history_rollup_t rollup;
+
+    printf("🧪 증분 요약 = 전수 계산\n");
+    unlink(ROLLUP_PATH);
+    CHECK(history_rollup_open(&rollup, ROLLUP_PATH, NULL) == 0, "새 요약 파일 생성");
+    fill(raw, &rollup);
+
+    CHECK(level_matches(&rollup, ROLLUP_DAY), "1일 구간 3개 일치");
+    CHECK(level_matches(&rollup, ROLLUP_HOUR), "1시간 구간 72개 일치");
+    CHECK(history_rollup_count(&rollup, ROLLUP_MINUTE) == TEST_DAYS * 1440, "1분 구간 4320개");
+    rollup_bucket_t expect = brute(BASE_TIME + 60 * 777, BASE_TIME + 60 * 778);
+    CHECK(same_bucket(history_rollup_get(&rollup, ROLLUP_MINUTE, 777), &expect),
+          "1분 구간 표본 일치");
+
+    // 시각 역행 샘플은 현재 구간에 합쳐짐
+    sensor_sample_t back = make_sample(10);
+    uint32_t before = history_rollup_get(&rollup, ROLLUP_MINUTE, TEST_DAYS * 1440 - 1)->count;
+    history_rollup_add(&rollup, &back);
+    CHECK(history_rollup_count(&rollup, ROLLUP_MINUTE) == TEST_DAYS * 1440 &&
+          history_rollup_get(&rollup, ROLLUP_MINUTE, TEST_DAYS * 1440 - 1)->count == before + 1,
+          "역행 샘플 → 마지막 구간에 합침");
+
+    history_rollup_close(&rollup);
+
+    CHECK(history_rollup_open(&rollup, ROLLUP_PATH, raw) == 0 &&
+          history_rollup_count(&rollup, ROLLUP_HOUR) == TEST_DAYS * 24 &&
+          history_rollup_get(&rollup, ROLLUP_MINUTE, TEST_DAYS * 1440 - 1)->count == before + 1,
+          "정상 종료 후 재열기 → 재구성 없이 그대로");
+    history_rollup_close(&rollup);
+}
+
+static void test_query(const history_store_t *raw) {
+    history_rollup_t rollup;
+    rollup_point_t out[128];
+    uint32_t end = BASE_TIME + TEST_DAYS * 86400;
+    int ok = 1;
+
+    printf("🧪 해상도 선택 / 열 요약\n");
+    unlink(ROLLUP_PATH);
+    history_rollup_open(&rollup, ROLLUP_PATH, raw);     // 새 파일 → raw에서 구성
+
+    CHECK(history_rollup_query(&rollup, raw, end - 3600, end, out, 128) == 0,
+          "1시간 / 128px → 원본 (열 28초)");
+    CHECK(history_rollup_query(&rollup, raw, end - 86400, end, out, 128) == 60,
+          "24시간 / 128px → 1분 (열 675초)");
+    CHECK(history_rollup_query(&rollup, NULL, end - 3600, end, out, 128) == 60,
+          "원본 없이 1시간 → 1분");
+    CHECK(history_rollup_query(&rollup, raw, end - 30 * 86400, end, out, 128) == 3600,
+          "30일 / 128px → 1시간");
+    CHECK(history_rollup_query(&rollup, raw, end - 365 * 86400, end, out, 128) == 86400,
+          "1년 / 128px → 1일");
+    CHECK(history_rollup_query(&rollup, raw, end, end, out, 128) == -1, "빈 구간 → -1");
+
+    // 열 폭 720초 = 1분 구간 12개: 열마다 전수 계산과 비교
+    history_rollup_query(&rollup, raw, end - 86400, end, out, 120);
+    for (unsigned c = 0; c < 120 && ok; c++) {
+        rollup_bucket_t e = brute(out[c].start, out[c].start + 720);
+        int mean_t = (int)((e.temp_sum + (int)e.count / 2) / (int)e.count);
+        int mean_h = (int)((e.humi_sum + e.count / 2) / e.count);
+        ok = out[c].count == e.count && out[c].temp_min == e.temp_min &&
+             out[c].temp_max == e.temp_max && out[c].humi_min == e.humi_min &&
+             out[c].humi_max == e.humi_max && out[c].temp_mean == mean_t &&
+             out[c].humi_mean == mean_h;
+    }
+    CHECK(ok, "24시간 120열 min/max/평균 일치");
+
+    // 원본 요약도 같은 열 정의를 따름
+    history_rollup_query(&rollup, raw, end - 3600, end, out, 120);
+    rollup_bucket_t e = brute(out[7].start, out[7].start + 30);
+    CHECK(out[7].count == e.count && out[7].temp_max == e.temp_max, "1시간 원본 열 일치");
+
+    // 데이터 이전 구간은 빈 열
+    history_rollup_query(&rollup, raw, BASE_TIME - 86400, BASE_TIME + 86400, out, 128);
+    CHECK(out[0].count == 0 && out[127].count > 0, "데이터 없는 열은 count 0");
+
+    history_rollup_close(&rollup);
+}
+
+static void test_crash_rebuild(history_store_t *raw) {
+    history_rollup_t rollup;
+
+    printf("🧪 비정상 종료 후 원본에서 재구성\n");
+    unlink(ROLLUP_PATH);
+    history_rollup_open(&rollup, ROLLUP_PATH, NULL);
+    for (uint32_t i = 0; i < TEST_SAMPLES; i++) {
+        sensor_sample_t s = make_sample(i);
+        history_rollup_add(&rollup, &s);
+    }
+
+    // 최근 구간을 망가뜨리고 정상 종료 표시 없이 닫음 (전원 차단 흉내)
+    memset(rollup.buckets[ROLLUP_MINUTE] + 4000, 0x55, 320 * sizeof(rollup_bucket_t));
+    rollup.buckets[ROLLUP_HOUR][71].count = 1;
+    munmap(rollup.map, rollup.map_size);
+    close(rollup.fd);
+
+    CHECK(history_rollup_open(&rollup, ROLLUP_PATH, raw) == 0, "재열기");
+    CHECK(level_matches(&rollup, ROLLUP_HOUR), "1시간 구간 복구");
+    CHECK(level_matches(&rollup, ROLLUP_DAY), "1일 구간 유지/복구");
+    rollup_bucket_t expect = brute(BASE_TIME + 60 * 4100, BASE_TIME + 60 * 4101);
+    CHECK(history_rollup_count(&rollup, ROLLUP_MINUTE) == TEST_DAYS * 1440 &&
+          same_bucket(history_rollup_get(&rollup, ROLLUP_MINUTE, 4100), &expect),
+          "1분 구간 복구");
+    history_rollup_close(&rollup);
+}
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void bench_rollup(void) {
+    history_rollup_t rollup;
+    rollup_point_t out[128];
+    uint32_t end = BASE_TIME + (BENCH_SAMPLES - 1) * 3;
+    double start, elapsed, qelapsed;
+
+    printf("📊 요약 갱신/조회 속도 (%d샘플)\n", BENCH_SAMPLES);
+    unlink(ROLLUP_PATH);
+    if (history_rollup_open(&rollup, ROLLUP_PATH, NULL) != 0) {
+        failures++;
+        return;
+    }
+
+    start = now_sec();
+    for (uint32_t i = 0; i < BENCH_SAMPLES; i++) {
+        sensor_sample_t s = make_sample(i);
+        history_rollup_add(&rollup, &s);
+    }
+    elapsed = now_sec() - start;
+
+    start = now_sec();
+    for (int i = 0; i < 1000; i++) {
+        history_rollup_query(&rollup, NULL, end - 86400, end, out, 128);
+    }
+    qelapsed = now_sec() - start;
+
+    printf("  ⏱️ 갱신 %.1f ns/샘플 (3단계)\n", elapsed * 1e9 / BENCH_SAMPLES);
+    printf("  ⏱️ 24시간 추세 128열 조회 %.1f µs/회 (1분 구간 1440개)\n", qelapsed * 1e6 / 1000);
+
+    history_rollup_close(&rollup);
+}
+
+int main(int argc, char **argv) {
+    history_store_t raw;
+
+    unlink(RAW_PATH);
+    if (history_store_open(&raw, RAW_PATH, RAW_CAPACITY) != 0) return 1;
+
+    test_incremental(&raw);
+    test_query(&raw);
+    test_crash_rebuild(&raw);
+    if (argc > 1 && strcmp(argv[1], "--bench") == 0) {
+        bench_rollup();
+    }
+
+    history_store_close(&raw);
+    unlink(RAW_PATH);
+    unlink(ROLLUP_PATH);
+
+    if (failures) {
+        printf("❌ 실패 %d건\n", failures);
+        return 1;
+    }
+    printf("🎉 모든 다중 해상도 요약 테스트 통과\n");
+    return 0;
+}
@@ -0,0 +1,249 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "history_store.h"
+#include "test_check.h"
+#include "test_samples.h"
+
+#define TEST_PATH       "/tmp/history_store_test.ring"
+#define TEST_CAPACITY   1000
+#define BENCH_SAMPLES   2000000
+#define BENCH_CAPACITY  201600
+
+static int64_t sample_ms(uint32_t i) {
+    sensor_sample_t s = make_sample(i);
+    return sample_time_ms(&s);
+}
+
+static void test_append_and_wrap(void) {
+    history_store_t store;
+    sensor_sample_t out[64];
+
+    printf("🧪 추가/순환/범위 조회\n");
+    unlink(TEST_PATH);
+    CHECK(history_store_open(&store, TEST_PATH, TEST_CAPACITY) == 0, "새 링 파일 생성");
+
+    for (uint32_t i = 0; i < 2500; i++) {
+        sensor_sample_t s = make_sample(i);
+        history_store_append(&store, &s);
+    }
+    CHECK(history_store_count(&store) == TEST_CAPACITY, "용량만큼만 보관");
+    CHECK(history_store_get(&store, 0)->time == make_sample(1500).time, "가장 오래된 샘플 = 1500번");
+    CHECK(history_store_get(&store, TEST_CAPACITY - 1)->time == make_sample(2499).time,
+          "가장 최근 샘플 = 2499번");
+
+    CHECK(history_store_lower_bound(&store, sample_ms(2000)) == 500, "이분 탐색 위치");
+    CHECK(history_store_lower_bound(&store, 0) == 0, "과거 시각 → 0");
+    CHECK(history_store_lower_bound(&store, sample_ms(9999)) == TEST_CAPACITY, "미래 시각 → count");
+
+    size_t n = history_store_query(&store, sample_ms(2000), sample_ms(2010), out, 64);
+    CHECK(n == 10 && out[0].time == make_sample(2000).time && out[9].time == make_sample(2009).time,
+          "[2000, 2010) 구간 10개");
+    n = history_store_query(&store, sample_ms(2490), sample_ms(9999), out, 4);
+    CHECK(n == 4, "max 개수 제한");
+
+    // 시각 역행 샘플은 직전 시각으로 맞춤
+    sensor_sample_t back = make_sample(10);
+    history_store_append(&store, &back);
+    CHECK(history_store_get(&store, TEST_CAPACITY - 1)->time == make_sample(2499).time,
+          "역행 시각 보정");
+
+    history_store_close(&store);
+}
+
+static void test_reopen(void) {
+    history_store_t store;
+
+    printf("🧪 다시 열기\n");
+    CHECK(history_store_open(&store, TEST_PATH, 0) == 0, "기존 파일 열기");
+    CHECK(store.hdr.capacity == TEST_CAPACITY, "기존 용량 유지");
+    CHECK(history_store_count(&store) == TEST_CAPACITY, "샘플 수 유지");
+    CHECK(history_store_get(&store, 0)->time == make_sample(1501).time, "순서 유지");
+    history_store_close(&store);
+}
+
+static void test_crash_recovery(void) {
+    history_store_t store;
+    pid_t pid;
+    int status;
+
+    printf("🧪 커밋 전 비정상 종료 복구\n");
+    unlink(TEST_PATH);
+
+    pid = fork();
+    if (pid == 0) {
+        // 자식: 150개 추가 (100개에서 자동 커밋, 50개는 미커밋) 후 정리 없이 종료
+        if (history_store_open(&store, TEST_PATH, TEST_CAPACITY) != 0) _exit(1);
+        for (uint32_t i = 0; i < 150; i++) {
+            sensor_sample_t s = make_sample(i);
+            history_store_append(&store, &s);
+        }
+        _exit(0);
+    }
+    waitpid(pid, &status, 0);
+    CHECK(WIFEXITED(status) && WEXITSTATUS(status) == 0, "자식 프로세스 종료");
+
+    CHECK(history_store_open(&store, TEST_PATH, 0) == 0, "다시 열기");
+    CHECK(history_store_count(&store) == 150, "미커밋 50개 포함 150개 복구");
+    CHECK(history_store_get(&store, 149)->time == make_sample(149).time, "마지막 샘플 일치");
+    history_store_close(&store);
+}
+
+static void test_corrupt_header(void) {
+    history_store_t store;
+    FILE *f;
+    long newest;
+
+    printf("🧪 헤더 손상 시 이전 슬롯 사용\n");
+    CHECK(history_store_open(&store, TEST_PATH, 0) == 0, "열기");
+    for (uint32_t i = 150; i < 160; i++) {
+        sensor_sample_t s = make_sample(i);
+        history_store_append(&store, &s);
+    }
+    history_store_commit(&store);
+    newest = (long)((store.next_slot + 1) % 2) * sysconf(_SC_PAGESIZE);
+    history_store_close(&store);
+
+    // 최신 헤더 슬롯의 head 필드를 망가뜨림 → CRC 불일치
+    f = fopen(TEST_PATH, "r+b");
+    fseek(f, newest + 12, SEEK_SET);
+    fputc(0x5A, f);
+    fclose(f);
+
+    CHECK(history_store_open(&store, TEST_PATH, 0) == 0, "손상 후 열기");
+    CHECK(history_store_count(&store) == 160, "이전 슬롯 + 복구로 160개");
+    history_store_close(&store);
+    unlink(TEST_PATH);
+}
+
+static void test_torn_record(void) {
+    history_store_t store;
+    pid_t pid;
+    int status;
+    FILE *f;
+
+    printf("🧪 쓰다 끊긴 미커밋 샘플에서 복구 중단\n");
+    unlink(TEST_PATH);
+
+    pid = fork();
+    if (pid == 0) {
+        if (history_store_open(&store, TEST_PATH, TEST_CAPACITY) != 0) _exit(1);
+        for (uint32_t i = 0; i < 150; i++) {
+            sensor_sample_t s = make_sample(i);
+            history_store_append(&store, &s);
+        }
+        _exit(0);
+    }
+    waitpid(pid, &status, 0);
+    CHECK(WIFEXITED(status) && WEXITSTATUS(status) == 0, "자식 프로세스 종료");
+
+    // 120번 샘플의 온도만 바뀐 채 남음 (헤더 필드/시각 순서는 그럴듯함)
+    f = fopen(TEST_PATH, "r+b");
+    fseek(f, 2 * sysconf(_SC_PAGESIZE) + 120 * (long)sizeof(sensor_sample_t) +
+             (long)offsetof(sensor_sample_t, temp_centi), SEEK_SET);
+    fputc(0x5A, f);
+    fclose(f);
+
+    CHECK(history_store_open(&store, TEST_PATH, 0) == 0, "다시 열기");
+    CHECK(history_store_count(&store) == 120, "CRC 불일치 샘플 앞까지만 복구");
+    CHECK(history_store_get(&store, 119)->time == make_sample(119).time, "마지막 샘플 = 119번");
+
+    // 잘린 자리부터 새 샘플이 이어짐
+    sensor_sample_t s = make_sample(200);
+    history_store_append(&store, &s);
+    history_store_close(&store);
+    CHECK(history_store_open(&store, TEST_PATH, 0) == 0, "추가 후 다시 열기");
+    CHECK(history_store_count(&store) == 121 &&
+          history_store_get(&store, 120)->time == make_sample(200).time, "잘린 뒤 이어 쓰기");
+    history_store_close(&store);
+    unlink(TEST_PATH);
+}
+
+static void test_truncated_file(void) {
+    history_store_t store;
+    FILE *f;
+
+    printf("🧪 잘린 파일 다시 만들기\n");
+    unlink(TEST_PATH);
+    CHECK(history_store_open(&store, TEST_PATH, TEST_CAPACITY) == 0, "새 링 파일 생성");
+    history_store_close(&store);
+
+    // 헤더 슬롯 A 중간까지만 남김 (매핑하면 슬롯 B/샘플이 파일 밖)
+    CHECK(truncate(TEST_PATH, 100) == 0, "파일 자르기");
+    CHECK(history_store_open(&store, TEST_PATH, TEST_CAPACITY) == 0, "잘린 파일 열기");
+    CHECK(store.hdr.capacity == TEST_CAPACITY && history_store_count(&store) == 0, "빈 링으로 다시 생성");
+    sensor_sample_t s = make_sample(0);
+    history_store_append(&store, &s);
+    history_store_close(&store);
+
+    // 헤더 두 페이지는 있지만 샘플 자리가 없음
+    f = fopen(TEST_PATH, "r+b");
+    CHECK(f && ftruncate(fileno(f), 2 * sysconf(_SC_PAGESIZE)) == 0, "샘플 영역 자르기");
+    if (f) fclose(f);
+    CHECK(history_store_open(&store, TEST_PATH, TEST_CAPACITY) == 0, "샘플 없는 파일 열기");
+    CHECK(store.hdr.capacity == TEST_CAPACITY && history_store_count(&store) == 0, "빈 링으로 다시 생성");
+    history_store_close(&store);
+    unlink(TEST_PATH);
+}
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void bench_append(void) {
+    history_store_t store;
+    double start, elapsed, qstart, qelapsed;
+    volatile uint32_t sink = 0;
+
+    printf("📊 추가/조회 속도 (%d샘플, 용량 %d)\n", BENCH_SAMPLES, BENCH_CAPACITY);
+    unlink(TEST_PATH);
+    if (history_store_open(&store, TEST_PATH, BENCH_CAPACITY) != 0) {
+        failures++;
+        return;
+    }
+
+    start = now_sec();
+    for (uint32_t i = 0; i < BENCH_SAMPLES; i++) {
+        sensor_sample_t s = make_sample(i);
+        history_store_append(&store, &s);
+    }
+    elapsed = now_sec() - start;
+
+    qstart = now_sec();
+    for (uint32_t i = 0; i < 100000; i++) {
+        sink += history_store_lower_bound(&store, sample_ms(BENCH_SAMPLES - 1 - (i * 7919) % BENCH_CAPACITY));
+    }
+    qelapsed = now_sec() - qstart;
+    (void)sink;
+
+    printf("  ⏱️ 추가 %.2f µs/샘플 (%d개마다 커밋 포함)\n",
+           elapsed * 1e6 / BENCH_SAMPLES, HISTORY_STORE_BATCH_SAMPLES);
+    printf("  ⏱️ 시각 탐색 %.0f ns/회\n", qelapsed * 1e9 / 100000);
+
+    history_store_close(&store);
+    unlink(TEST_PATH);
+}
+
+int main(int argc, char **argv) {
+    test_append_and_wrap();
+    test_reopen();
+    test_crash_recovery();
+    test_corrupt_header();
+    test_torn_record();
+    test_truncated_file();
+    if (argc > 1 && strcmp(argv[1], "--bench") == 0) {
+        bench_append();
+    }
+
+    if (failures) {
+        printf("❌ 실패 %d건\n", failures);
+        return 1;
+    }
+    printf("🎉 모든 이력 저장소 테스트 통과\n");
+    return 0;
+}
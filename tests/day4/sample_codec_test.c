@@ -0,0 +1,274 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/wait.h>
+#include "sample_codec.h"
+#include "history_archive.h"
+#include "history_store.h"
+#include "test_check.h"
+
+#define TEST_PATH       "/tmp/sample_codec_test.archive"
+#define DAY_SAMPLES     28800       // 3초 간격 하루
+#define MAX_TRACE       (DAY_SAMPLES * 8)
+
+static sensor_sample_t trace[MAX_TRACE];
+static sensor_sample_t decoded[MAX_TRACE];
+
+static uint32_t rng_state = 2024;
+
+static int rng_range(int span) {
+    rng_state = rng_state * 1103515245u + 12345u;
+    return (int)((rng_state >> 8) % (uint32_t)(2 * span + 1)) - span;
+}
+
+// DHT11 실측과 비슷한 합성 기록: 3초 ± 스케줄링 지터, 1°C/1% 단위 값,
+// 하루 주기 온도 변화, 가끔 센서 오류(STALE) 플래그
+static size_t gen_trace(size_t n) {
+    int64_t ms = 1700000000000LL;
+    for (size_t i = 0; i < n; i++) {
+        int minute = (int)(i / 20);
+        int temp = 2300 + ((minute % 1440) < 720 ? minute % 720 : 720 - minute % 720) / 2;
+        int humi = 5000 - (temp - 2300) + rng_range(1) * 100;
+        ms += 3000 + rng_range(3);
+        trace[i].time = (uint32_t)(ms / 1000);
+        trace[i].time_ms = (uint16_t)(ms % 1000);
+        trace[i].temp_centi = (int16_t)(temp / 100 * 100);
+        trace[i].humi_centi = (uint16_t)(humi / 100 * 100);
+        trace[i].flags = SAMPLE_FLAG_VALID | SAMPLE_FLAG_TIME_RTC;
+        if (rng_range(500) == 0) trace[i].flags = SAMPLE_FLAG_STALE | SAMPLE_FLAG_TIME_RTC;
+    }
+    return n;
+}
+
+// 블록 단위로 인코딩/디코딩해 원본과 비교 (반환: 인코딩 바이트 수)
+static size_t roundtrip(const sensor_sample_t *in, size_t n, size_t block_size, int *ok) {
+    static uint8_t buf[MAX_TRACE * 12];
+    sample_encoder_t enc;
+    sample_decoder_t dec;
+    size_t total = 0, i = 0, out = 0;
+
+    *ok = 1;
+    while (i < n) {
+        size_t start = i;
+        sample_encoder_init(&enc, buf + total, block_size);
+        while (i < n && sample_encoder_add(&enc, &in[i]) == 0) i++;
+        size_t len = sample_encoder_finish(&enc);
+
+        sample_decoder_init(&dec, buf + total, len, enc.count);
+        while (sample_decoder_next(&dec, &decoded[out]) == 1) out++;
+        if (out != i || memcmp(&decoded[start], &in[start], (i - start) * sizeof(*in)) != 0) {
+            *ok = 0;
+        }
+        total += len;
+    }
+    return total;
+}
+
+static void test_roundtrip(void) {
+    int ok;
+    size_t n;
+
+    printf("🧪 인코딩/디코딩 왕복\n");
+    n = gen_trace(DAY_SAMPLES);
+    roundtrip(trace, n, HISTORY_ARCHIVE_PAYLOAD, &ok);
+    CHECK(ok, "합성 하루 기록 무손실");
+
+    // 극단값: 값 급변, 영하, 큰 시각 공백, 같은 시각, 플래그 변화
+    static const int16_t temps[] = { 2300, -1000, 6000, -32768, 32767, 0, 2301 };
+    for (size_t i = 0; i < 700; i++) {
+        trace[i].time = 1700000000u + (uint32_t)(i * (i % 50 == 0 ? 86400 : 1));
+        trace[i].time_ms = (uint16_t)((i * 37) % 1000);
+        trace[i].temp_centi = temps[i % 7];
+        trace[i].humi_centi = (uint16_t)(i % 3 ? 65535 : 0);
+        trace[i].flags = (uint16_t)(i % 5 ? 1 : 0xFFFF);
+    }
+    roundtrip(trace, 700, HISTORY_ARCHIVE_PAYLOAD, &ok);
+    CHECK(ok, "극단값/시각 공백 무손실");
+
+    roundtrip(trace, 700, 24, &ok);
+    CHECK(ok, "아주 작은 블록 (샘플 1~2개씩)");
+}
+
+static void test_archive(void) {
+    history_archive_t archive;
+    size_t n, expect;
+    int64_t from, to;
+
+    printf("🧪 압축 아카이브\n");
+    unlink(TEST_PATH);
+    gen_trace(DAY_SAMPLES * 2);
+
+    CHECK(history_archive_open(&archive, TEST_PATH, 128) == 0, "새 아카이브 (128블록)");
+    for (size_t i = 0; i < DAY_SAMPLES; i++) history_archive_append(&archive, &trace[i]);
+
+    from = sample_time_ms(&trace[1000]);
+    to = sample_time_ms(&trace[1500]);
+    n = history_archive_query(&archive, from, to, decoded, MAX_TRACE);
+    CHECK(n == 500 && memcmp(decoded, &trace[1000], 500 * sizeof(*decoded)) == 0,
+          "봉인 블록 구간 조회 500개");
+
+    static uint8_t before[HISTORY_ARCHIVE_PAYLOAD];
+    memcpy(before, archive.open_block, sizeof(before));
+    from = sample_time_ms(&trace[DAY_SAMPLES - 3]);
+    n = history_archive_query(&archive, from, INT64_MAX, decoded, MAX_TRACE);
+    CHECK(n == 3 && memcmp(decoded, &trace[DAY_SAMPLES - 3], 3 * sizeof(*decoded)) == 0,
+          "봉인 전 블록까지 조회");
+    CHECK(memcmp(before, archive.open_block, sizeof(before)) == 0, "조회가 봉인 전 블록을 건드리지 않음");
+    history_archive_close(&archive);
+
+    CHECK(history_archive_open(&archive, TEST_PATH, 0) == 0, "다시 열기");
+    uint32_t blocks = history_archive_block_count(&archive);
+    n = history_archive_query(&archive, 0, INT64_MAX, decoded, MAX_TRACE);
+    CHECK(n > 0 && memcmp(&decoded[n - 1], &trace[DAY_SAMPLES - 1], sizeof(*decoded)) == 0,
+          "닫을 때 봉인한 마지막 샘플 유지");
+
+    // 용량을 넘겨 순환 → 오래된 블록부터 사라짐
+    for (size_t i = DAY_SAMPLES; i < DAY_SAMPLES * 2; i++) history_archive_append(&archive, &trace[i]);
+    CHECK(history_archive_block_count(&archive) == 128, "128블록에서 순환");
+    n = history_archive_query(&archive, 0, INT64_MAX, decoded, MAX_TRACE);
+    expect = DAY_SAMPLES * 2 - (size_t)(decoded[0].time - trace[0].time) / 3;
+    CHECK(n > 0 && n + 1000 >= expect && n <= expect + 1000, "남은 블록은 연속된 최신 구간");
+    printf("     (하루 %u블록 → 샘플당 %.2f바이트)\n", blocks,
+           (double)blocks * HISTORY_ARCHIVE_BLOCK_SIZE / DAY_SAMPLES);
+
+    // 가장 최근 봉인 블록을 손상 → 그 블록만 빠지고 다음 봉인이 그 자리를 씀
+    history_archive_seal(&archive);
+    uint64_t newest = archive.next_seq - 1;
+    archive_block_header_t *blk = (archive_block_header_t *)
+        (archive.map + ((newest - 1) % archive.blocks) * HISTORY_ARCHIVE_BLOCK_SIZE);
+    ((uint8_t *)blk)[sizeof(*blk) + 5] ^= 0xFF;
+    history_archive_close(&archive);
+
+    CHECK(history_archive_open(&archive, TEST_PATH, 0) == 0, "손상 후 열기");
+    CHECK(archive.next_seq == newest, "손상된 블록 제외");
+    history_archive_close(&archive);
+    unlink(TEST_PATH);
+}
+
+#define BACKFILL_RING    "/tmp/sample_codec_test.ring"
+#define BACKFILL_SAMPLES 5000
+
+static void test_backfill(void) {
+    history_store_t store;
+    history_archive_t archive;
+    pid_t pid;
+    int status;
+    size_t n;
+
+    printf("🧪 비정상 종료 후 봉인 전 블록 다시 채우기\n");
+    unlink(TEST_PATH);
+    unlink(BACKFILL_RING);
+    gen_trace(BACKFILL_SAMPLES);
+
+    pid = fork();
+    if (pid == 0) {
+        // 자식: 원본 링과 아카이브에 같이 추가한 뒤 봉인/정리 없이 종료
+        if (history_store_open(&store, BACKFILL_RING, 10000) != 0 ||
+            history_archive_open(&archive, TEST_PATH, 64) != 0) {
+            _exit(1);
+        }
+        for (size_t i = 0; i < BACKFILL_SAMPLES; i++) {
+            history_store_append(&store, &trace[i]);
+            history_archive_append(&archive, &trace[i]);
+        }
+        _exit(0);
+    }
+    waitpid(pid, &status, 0);
+    CHECK(WIFEXITED(status) && WEXITSTATUS(status) == 0, "자식 프로세스 종료");
+
+    CHECK(history_store_open(&store, BACKFILL_RING, 0) == 0, "원본 링 다시 열기");
+    CHECK(history_archive_open(&archive, TEST_PATH, 0) == 0, "아카이브 다시 열기");
+    n = history_archive_query(&archive, 0, INT64_MAX, decoded, MAX_TRACE);
+    CHECK(n > 0 && n < BACKFILL_SAMPLES, "봉인 전 블록은 사라짐");
+
+    int added = history_archive_backfill(&archive, &store);
+    CHECK(added > 0 && (size_t)added == BACKFILL_SAMPLES - n, "사라진 샘플만 다시 추가");
+    n = history_archive_query(&archive, 0, INT64_MAX, decoded, MAX_TRACE);
+    CHECK(n == BACKFILL_SAMPLES && memcmp(decoded, trace, n * sizeof(*decoded)) == 0,
+          "원본과 같은 샘플 전체");
+    CHECK(history_archive_backfill(&archive, &store) == 0, "이미 채웠으면 추가 없음");
+
+    history_archive_close(&archive);
+    history_store_close(&store);
+    unlink(TEST_PATH);
+    unlink(BACKFILL_RING);
+}
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// 기록 하나에 대해 압축률과 디코딩 속도 측정
+static void bench_trace(const char *name, const sensor_sample_t *in, size_t n) {
+    static uint8_t blocks[MAX_TRACE * 12];
+    static size_t lens[MAX_TRACE];
+    static uint16_t counts[MAX_TRACE];
+    sample_encoder_t enc;
+    sample_decoder_t dec;
+    sensor_sample_t s;
+    size_t nblocks = 0, i = 0, total = 0;
+    double start, enc_s, dec_s;
+    const int rounds = 50;
+    volatile int64_t sink = 0;
+
+    start = now_sec();
+    while (i < n) {
+        sample_encoder_init(&enc, blocks + nblocks * HISTORY_ARCHIVE_PAYLOAD, HISTORY_ARCHIVE_PAYLOAD);
+        while (i < n && sample_encoder_add(&enc, &in[i]) == 0) i++;
+        lens[nblocks] = sample_encoder_finish(&enc);
+        counts[nblocks] = enc.count;
+        total += lens[nblocks];
+        nblocks++;
+    }
+    enc_s = now_sec() - start;
+
+    start = now_sec();
+    for (int r = 0; r < rounds; r++) {
+        for (size_t b = 0; b < nblocks; b++) {
+            sample_decoder_init(&dec, blocks + b * HISTORY_ARCHIVE_PAYLOAD, lens[b], counts[b]);
+            while (sample_decoder_next(&dec, &s) == 1) sink += s.temp_centi;
+        }
+    }
+    dec_s = (now_sec() - start) / rounds;
+    (void)sink;
+
+    printf("  %s: %zu샘플, %zu블록\n", name, n, nblocks);
+    printf("    📦 %.2f 바이트/샘플 (원본 12, 블록 헤더 포함 %.2f) → %.1f배\n",
+           (double)total / n,
+           (double)nblocks * HISTORY_ARCHIVE_BLOCK_SIZE / n,
+           12.0 * n / total);
+    printf("    ⏱️ 인코딩 %.1f ns/샘플, 디코딩 %.1f ns/샘플 → 하루(%d샘플) %.0f µs\n",
+           enc_s * 1e9 / n, dec_s * 1e9 / n, DAY_SAMPLES, dec_s * 1e6 / n * DAY_SAMPLES);
+}
+
+int main(int argc, char **argv) {
+    test_roundtrip();
+    test_archive();
+    test_backfill();
+
+    if (argc > 1 && strcmp(argv[1], "--bench") == 0) {
+        printf("📊 압축 벤치마크\n");
+        bench_trace("합성 기록 (3초, DHT11 해상도)", trace, gen_trace(DAY_SAMPLES * 7));
+
+        // 실제 장비에서 가져온 이력 링 파일이 있으면 그것도 측정
+        if (argc > 2) {
+            history_store_t store;
+            if (history_store_open(&store, argv[2], 0) == 0) {
+                size_t n = history_store_query(&store, 0, INT64_MAX, trace, MAX_TRACE);
+                history_store_close(&store);
+                if (n > 0) bench_trace(argv[2], trace, n);
+            }
+        }
+    }
+
+    if (failures) {
+        printf("❌ 실패 %d건\n", failures);
+        return 1;
+    }
+    printf("🎉 모든 압축 테스트 통과\n");
+    return 0;
+}
@@ -0,0 +1,303 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include "sample_filter.h"
+#include "history_store.h"
+#include "test_check.h"
+
+#define TRACE_MS        3000            // 기존 고정 측정 간격
+#define DAY_SAMPLES     (86400000 / TRACE_MS)
+#define MAX_TRACE       (DAY_SAMPLES * 7)
+#define SPIKE_PERMILLE  5               // 체크섬을 통과한 튐 (0.5%)
+
+static uint32_t rng = 0x2545F491u;
+
+static uint32_t next_rand(void) {
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+}
+
+static sensor_sample_t make_sample(int temp, int humi) {
+    sensor_sample_t s;
+    memset(&s, 0, sizeof(s));
+    s.temp_centi = (int16_t)temp;
+    s.humi_centi = (uint16_t)humi;
+    s.flags = SAMPLE_FLAG_VALID;
+    return s;
+}
+
+static void test_median(void) {
+    static const int windows[] = {3, 5, 9};
+    int ok = 1;
+
+    printf("🧪 이동 중앙값\n");
+    for (size_t w = 0; w < sizeof(windows) / sizeof(windows[0]); w++) {
+        sample_filter_config_t cfg = SAMPLE_FILTER_CONFIG_DEFAULT;
+        sample_filter_t f;
+        int32_t hist[20000];
+
+        cfg.window = windows[w];
+        sample_filter_init(&f, &cfg);
+        for (int i = 0; i < 20000; i++) {
+            sensor_sample_t s = make_sample((int)(next_rand() % 50) * 100, 5000);
+            int32_t sorted[SAMPLE_FILTER_MAX_WINDOW];
+            int n = i + 1 < cfg.window ? i + 1 : cfg.window;
+
+            hist[i] = s.temp_centi;
+            sample_filter_update(&f, &s, (int64_t)i * TRACE_MS);
+
+            // 비교: 마지막 n개를 정렬한 중앙값 (값이 겹쳐도 같아야 함)
+            memcpy(sorted, &hist[i + 1 - n], (size_t)n * sizeof(int32_t));
+            for (int a = 1; a < n; a++) {
+                for (int b = a; b > 0 && sorted[b - 1] > sorted[b]; b--) {
+                    int32_t t = sorted[b]; sorted[b] = sorted[b - 1]; sorted[b - 1] = t;
+                }
+            }
+            if (sample_filter_median(&f.temp) != sorted[n / 2]) ok = 0;
+        }
+    }
+    CHECK(ok, "창 3/5/9, 2만 샘플: 정렬 기준과 일치");
+}
+
+static void test_outlier(void) {
+    sample_filter_t f;
+    sensor_sample_t s;
+    sample_quality_t q;
+    int64_t t = 0;
+
+    printf("🧪 이상치 제거\n");
+    sample_filter_init(&f, NULL);
+    for (int i = 0; i < 5; i++, t += TRACE_MS) {
+        s = make_sample(2300, 5000);
+        q = sample_filter_update(&f, &s, t);
+    }
+    CHECK(q == SAMPLE_QUALITY_GOOD && s.temp_centi == 2300 &&
+          s.flags == (SAMPLE_FLAG_VALID | SAMPLE_FLAG_FILTERED), "안정 구간: 그대로, GOOD");
+
+    s = make_sample(4000, 5000);
+    q = sample_filter_update(&f, &s, t);
+    t += TRACE_MS;
+    CHECK(q == SAMPLE_QUALITY_SUSPECT && s.temp_centi == 2300 && (s.flags & SAMPLE_FLAG_SUSPECT) &&
+          f.stats.outliers == 1, "40°C 튐 → 중앙값 23°C, SUSPECT");
+
+    s = make_sample(2300, 9000);
+    sample_filter_update(&f, &s, t);
+    t += TRACE_MS;
+    CHECK(s.humi_centi == 5000 && s.temp_centi == 2300, "습도 튐도 채널별로 제거");
+
+    // 실제 계단 변화 (이상치 임계 3°C를 넘는 6°C): 창 절반이 차면 통과
+    for (int i = 0; i < 3; i++, t += TRACE_MS) {
+        s = make_sample(2900, 5000);
+        sample_filter_update(&f, &s, t);
+    }
+    CHECK(s.temp_centi > 2300, "계단 변화: 3번째 샘플부터 반영");
+    for (int i = 0; i < 20; i++, t += TRACE_MS) {
+        s = make_sample(2900, 5000);
+        q = sample_filter_update(&f, &s, t);
+    }
+    CHECK(s.temp_centi >= 2890 && q == SAMPLE_QUALITY_GOOD, "계단 변화: 1분 안에 따라잡음");
+}
+
+static void test_smoothing(void) {
+    sample_filter_config_t cfg = SAMPLE_FILTER_CONFIG_DEFAULT;
+    sample_filter_t f;
+    sensor_sample_t s;
+
+    printf("🧪 지수 평활/변화율 제한\n");
+    cfg.window = 1;
+    cfg.slew_temp_centi_min = 0;
+    sample_filter_init(&f, &cfg);
+
+    s = make_sample(2000, 5000);
+    sample_filter_update(&f, &s, 0);
+    s = make_sample(2200, 5000);
+    sample_filter_update(&f, &s, cfg.tau_ms);
+    CHECK(s.temp_centi == 2100, "dt = tau → α = 1/2");
+
+    s = make_sample(2200, 5000);
+    sample_filter_update(&f, &s, cfg.tau_ms + 60 * cfg.tau_ms);
+    CHECK(s.temp_centi >= 2195 && s.temp_centi <= 2200, "긴 공백 뒤 → 새 값에 거의 붙음");
+
+    // 변화율 제한: 3°C/분이면 3초에 0.15°C
+    cfg.tau_ms = 0;
+    cfg.slew_temp_centi_min = 300;
+    sample_filter_init(&f, &cfg);
+    s = make_sample(2000, 5000);
+    sample_filter_update(&f, &s, 0);
+    s = make_sample(2500, 5000);
+    CHECK(sample_filter_update(&f, &s, TRACE_MS) == SAMPLE_QUALITY_SUSPECT && s.temp_centi == 2015,
+          "3초에 최대 0.15°C");
+}
+
+static void test_bad_input(void) {
+    sample_filter_t f;
+    sensor_sample_t s;
+
+    printf("🧪 센서 오류 입력\n");
+    sample_filter_init(&f, NULL);
+    s = make_sample(0, 0);
+    s.flags = SAMPLE_FLAG_STALE;
+    CHECK(sample_filter_update(&f, &s, 0) == SAMPLE_QUALITY_BAD && !(s.flags & SAMPLE_FLAG_FILTERED),
+          "첫 정상값 전: BAD, 값 그대로");
+
+    s = make_sample(2400, 5500);
+    sample_filter_update(&f, &s, 0);
+    s = make_sample(2500, 1000);
+    s.flags = SAMPLE_FLAG_STALE;
+    CHECK(sample_filter_update(&f, &s, TRACE_MS) == SAMPLE_QUALITY_BAD && s.temp_centi == 2400 &&
+          s.humi_centi == 5500 && (s.flags & SAMPLE_FLAG_STALE) && f.temp.count == 1,
+          "오류 입력은 창에 넣지 않고 마지막 출력 유지");
+}
+
+static void test_seed(void) {
+    sample_filter_t f;
+    sensor_sample_t s;
+
+    printf("🧪 웜 스타트 (복원한 마지막 출력)\n");
+    sample_filter_init(&f, NULL);
+    sample_filter_seed(&f, 2000, 5000, -TRACE_MS);
+    s = make_sample(3000, 5000);
+    CHECK(sample_filter_update(&f, &s, 0) == SAMPLE_QUALITY_SUSPECT && s.temp_centi == 2050,
+          "재부팅 직후 첫 값도 변화율 제한 (3초에 0.5°C)");
+    CHECK(f.temp.count == 1, "중앙값 창은 새 값부터");
+
+    // 오래 꺼져 있었으면 그만큼 허용
+    sample_filter_init(&f, NULL);
+    sample_filter_seed(&f, 2000, 5000, -3600000);
+    s = make_sample(3000, 5000);
+    sample_filter_update(&f, &s, 0);
+    CHECK(s.temp_centi >= 2995, "1시간 공백 뒤 → 새 값에 거의 붙음");
+}
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// 합성 기록: 하루 주기 ±3°C 변화 + 난방 계단 + DHT11 1°C/1% 양자화 + ±1 흔들림 + 튐
+static size_t gen_trace(sensor_sample_t *raw, int32_t *truth_t, int32_t *truth_h, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        double hours = (double)i * TRACE_MS / 3600000.0;
+        int heating = (size_t)hours % 24 >= 7 && (size_t)hours % 24 < 9;
+        double t = 2200 + 300 * sin(hours * 2 * M_PI / 24) + (heating ? 150 : 0);
+        double h = 5000 + 1000 * sin(hours * 2 * M_PI / 24 + 1.0);
+        int qt = (int)lround(t / 100) * 100;
+        int qh = (int)lround(h / 100) * 100;
+        uint32_t r = next_rand();
+
+        if (r % 4 == 0) qt += (r & 4) ? 100 : -100;
+        if (r % 4 == 1) qh += (r & 4) ? 100 : -100;
+        if (r % 1000 < SPIKE_PERMILLE) {
+            if (r & 8) qt += (r & 16) ? 1000 : -800;
+            else qh += (r & 16) ? 3000 : -2500;
+        }
+
+        truth_t[i] = (int32_t)lround(t);
+        truth_h[i] = (int32_t)lround(h);
+        raw[i] = make_sample(qt, qh);
+        raw[i].time = (uint32_t)(1700000000 + i * TRACE_MS / 1000);
+    }
+    return n;
+}
+
+typedef struct {
+    double rms;                 // 참값 대비 (참값이 있을 때)
+    double max_err;
+    double roughness;           // 연속 출력 차이 평균 (흔들림)
+    size_t spikes;              // 참값에서 2°C/5% 넘게 벗어난 출력
+} trace_score_t;
+
+static void score(const sensor_sample_t *s, const int32_t *truth, size_t n, int humi, int spike_at,
+                  trace_score_t *out) {
+    double sq = 0, rough = 0;
+
+    memset(out, 0, sizeof(*out));
+    for (size_t i = 0; i < n; i++) {
+        int v = humi ? s[i].humi_centi : s[i].temp_centi;
+        if (truth) {
+            double e = fabs((double)v - truth[i]);
+            sq += e * e;
+            if (e > out->max_err) out->max_err = e;
+            if (e > spike_at) out->spikes++;
+        }
+        if (i > 0) rough += abs(v - (humi ? s[i - 1].humi_centi : s[i - 1].temp_centi));
+    }
+    out->rms = sqrt(sq / n);
+    out->roughness = rough / (n > 1 ? n - 1 : 1);
+}
+
+static void bench_trace(const char *name, const sensor_sample_t *raw, const int32_t *truth_t,
+                        const int32_t *truth_h, size_t n) {
+    static sensor_sample_t filtered[MAX_TRACE];
+    sample_filter_t f;
+    trace_score_t rt, ft, rh, fh;
+    double start, dt;
+    const int rounds = 10;
+
+    start = now_sec();
+    for (int r = 0; r < rounds; r++) {
+        sample_filter_init(&f, NULL);
+        for (size_t i = 0; i < n; i++) {
+            filtered[i] = raw[i];
+            sample_filter_update(&f, &filtered[i], sample_time_ms(&raw[i]));
+        }
+    }
+    dt = (now_sec() - start) / rounds;
+
+    score(raw, truth_t, n, 0, 200, &rt);
+    score(filtered, truth_t, n, 0, 200, &ft);
+    score(raw, truth_h, n, 1, 500, &rh);
+    score(filtered, truth_h, n, 1, 500, &fh);
+
+    printf("  %s: %zu샘플\n", name, n);
+    if (truth_t) {
+        printf("    🌡️ RMS 오차 %.2f → %.2f°C, 최대 %.2f → %.2f°C, 튐 %zu → %zu개\n",
+               rt.rms / 100, ft.rms / 100, rt.max_err / 100, ft.max_err / 100, rt.spikes, ft.spikes);
+        printf("    💧 RMS 오차 %.2f → %.2f%%, 최대 %.2f → %.2f%%, 튐 %zu → %zu개\n",
+               rh.rms / 100, fh.rms / 100, rh.max_err / 100, fh.max_err / 100, rh.spikes, fh.spikes);
+    }
+    printf("    〰️ 연속 차이 평균: 온도 %.3f → %.3f°C, 습도 %.3f → %.3f%%\n",
+           rt.roughness / 100, ft.roughness / 100, rh.roughness / 100, fh.roughness / 100);
+    printf("    🚫 이상치 대체 %u, 변화율 제한 %u\n", f.stats.outliers, f.stats.slew_limited);
+    printf("    ⏱️ %.1f ns/샘플\n", dt * 1e9 / n);
+}
+
+int main(int argc, char **argv) {
+    test_median();
+    test_outlier();
+    test_smoothing();
+    test_bad_input();
+    test_seed();
+
+    if (argc > 1 && strcmp(argv[1], "--bench") == 0) {
+        static sensor_sample_t raw[MAX_TRACE];
+        static int32_t truth_t[MAX_TRACE], truth_h[MAX_TRACE];
+
+        printf("📊 필터 벤치마크\n");
+        bench_trace("합성 기록 (3초, 1주, 튐 0.5%)", raw, truth_t, truth_h,
+                    gen_trace(raw, truth_t, truth_h, MAX_TRACE));
+
+        // 실제 장비에서 가져온 이력 링 파일이 있으면 그것도 (참값 없이 흔들림/대체 수만)
+        if (argc > 2) {
+            history_store_t store;
+            if (history_store_open(&store, argv[2], 0) == 0) {
+                size_t n = history_store_query(&store, 0, INT64_MAX, raw, MAX_TRACE);
+                history_store_close(&store);
+                if (n > 0) bench_trace(argv[2], raw, NULL, NULL, n);
+            }
+        }
+    }
+
+    if (failures) {
+        printf("❌ 실패 %d건\n", failures);
+        return 1;
+    }
+    printf("🎉 모든 필터 테스트 통과\n");
+    return 0;
+}
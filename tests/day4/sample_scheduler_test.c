@@ -0,0 +1,206 @@
+#include <stdio.h>
+#include <stdint.h>
+#include "sample_scheduler.h"
+#include "test_check.h"
+
+#define SIM_HOURS       24
+#define FIXED_MS        3000            // 기존 고정 간격
+#define DHT11_READ_MS   5               // 읽기 한 번 바쁜 대기 (응답 + 40비트, 대략)
+#define MAX_EVENTS      64
+
+static void test_backoff(void) {
+    sample_sched_t s;
+    env_status_t st = {0};
+    int64_t t = 1000;
+    uint32_t seen[20];
+
+    printf("🧪 안정 시 물러남\n");
+    sample_sched_init(&s, NULL, NULL, t);
+    CHECK(sample_sched_due(&s, t), "첫 측정은 바로");
+
+    for (int i = 0; i < 20; i++) {
+        update_environment_status_at(&st, 2300, 5000, t);
+        sample_sched_update(&s, &st, 1, 2300, 5000, t);
+        seen[i] = s.stats.interval_ms;
+        t = s.next_due_ms;
+    }
+    CHECK(seen[0] == 3000 && seen[2] == 3000 && seen[3] == 6000 && seen[6] == 12000,
+          "안정 3회마다 두 배");
+    CHECK(seen[15] == 60000 && seen[19] == 60000, "최대 60초");
+    CHECK(!sample_sched_due(&s, t - 1) && sample_sched_due(&s, t) &&
+          sample_sched_wait_ms(&s, t - 500) == 500, "다음 시각 전에는 대기");
+
+    sample_sched_update(&s, &st, 1, 2400, 5000, t);
+    CHECK(s.stats.interval_ms == 60000, "DHT11 한 단계(1°C) 흔들림은 무시");
+    sample_sched_update(&s, &st, 1, 2500, 5000, t);
+    CHECK(s.stats.interval_ms == 3000, "기준 대비 2°C 변화 → 최소 간격");
+
+    sample_sched_update(&s, &st, 0, 0, 0, t);
+    CHECK(s.stats.interval_ms == 3000 && s.stats.failures == 1, "실패 → 최소 간격 재시도");
+}
+
+static void test_boundary(void) {
+    sample_sched_t s;
+    env_status_t st = {0};
+    const env_band_t band = { 2000, 2600, 1800, 2800, 50 };
+    int64_t t = 0;
+
+    printf("🧪 경계 근처\n");
+    CHECK(sample_sched_boundary_distance(&band, 2300) == 250, "23°C: 복귀선 25.5°C까지 2.5°C");
+    CHECK(sample_sched_boundary_distance(&band, 2700) == 50, "27°C: 복귀선 27.5°C까지 0.5°C");
+
+    // 25.5°C = 복귀선 위 (거리 0) → 안정이어도 최소 간격
+    sample_sched_init(&s, NULL, NULL, t);
+    for (int i = 0; i < 10; i++) {
+        sample_sched_update(&s, NULL, 1, 2550, 5000, t);
+        t = s.next_due_ms;
+    }
+    CHECK(s.stats.interval_ms == 3000, "경계 위: 계속 최소 간격");
+
+    // 25.25°C = 복귀선 0.25°C → 1°C/분 가정이면 15초
+    sample_sched_init(&s, NULL, NULL, t);
+    for (int i = 0; i < 20; i++) {
+        sample_sched_update(&s, NULL, 1, 2525, 5000, t);
+        t = s.next_due_ms;
+    }
+    CHECK(s.stats.interval_ms == 15000, "경계 0.25°C → 15초 상한");
+
+    // 습도 66% (주의 복귀선 68%까지 2%, 5%/분 → 24초)
+    sample_sched_init(&s, NULL, NULL, t);
+    for (int i = 0; i < 20; i++) {
+        sample_sched_update(&s, NULL, 1, 2300, 6600, t);
+        t = s.next_due_ms;
+    }
+    CHECK(s.stats.interval_ms == 24000, "습도 경계 2% → 24초 상한");
+
+    // 주의 타이머 중에는 최소 간격 (경계에서 멀어도)
+    sample_sched_init(&s, NULL, NULL, t);
+    st = (env_status_t){0};
+    for (int i = 0; i < 10; i++) {
+        update_environment_status_at(&st, 2300, 6400, t);
+        sample_sched_update(&s, &st, 1, 2300, 6400, t);
+        t = s.next_due_ms;
+    }
+    CHECK(st.overall_level == ENV_DANGER && s.stats.interval_ms > 3000,
+          "승격 후에는 다시 물러남");
+    CHECK(s.stats.fast_samples >= 4, "승격 전까지는 최소 간격");
+}
+
+// ---- 24시간 모의 실험: 고정 3초 vs 적응형 ----
+
+// 실제 온습도 (0.01 단위, t: ms)
+static void true_env(int64_t t, int *temp, int *humi) {
+    int64_t min = t / 60000;
+
+    *temp = 2240;
+    *humi = 4800;
+    if (min >= 360 && min < 380) {
+        *temp += (int)((t - 360 * 60000) / 1200);       // 난방: 0.5°C/분, 10°C 상승
+    } else if (min >= 380 && min < 500) {
+        *temp += 1000 - (int)((t - 380 * 60000) / 7200); // 서서히 식음
+        if (*temp < 2240) *temp = 2240;
+    }
+    if (min >= 720 && min < 730) {
+        *humi += (int)((t - 720 * 60000) / 15);          // 샤워: 4%/분
+    } else if (min >= 730 && min < 790) {
+        *humi += 4000 - (int)((t - 730 * 60000) / 90);
+        if (*humi < 4800) *humi = 4800;
+    }
+    // 느린 일교차 ±0.6°C (30분에 0.1°C 꼴)
+    *temp += (int)((min % 1440 < 720 ? min % 720 : 720 - min % 720) / 12) - 30;
+}
+
+// DHT11은 1°C/1% 단위 (결정적 ±1 흔들림 포함)
+static int dht11_quantize(int v, int64_t t) {
+    int jitter = ((t / 7000) % 5 == 0) ? 60 : 0;
+    return ((v + jitter + 50) / 100) * 100;
+}
+
+typedef struct {
+    int64_t at[MAX_EVENTS];
+    int level[MAX_EVENTS];
+    int count;
+    uint32_t reads;
+} trace_t;
+
+static void note_level(trace_t *tr, const env_status_t *st, int *prev, int64_t t) {
+    if ((int)st->overall_level != *prev && tr->count < MAX_EVENTS) {
+        tr->at[tr->count] = t;
+        tr->level[tr->count] = st->overall_level;
+        tr->count++;
+    }
+    *prev = st->overall_level;
+}
+
+static void run_fixed(trace_t *tr) {
+    env_status_t st = {0};
+    int prev = -1;
+
+    for (int64_t t = 0; t < (int64_t)SIM_HOURS * 3600000; t += FIXED_MS) {
+        int temp, humi;
+        true_env(t, &temp, &humi);
+        update_environment_status_at(&st, dht11_quantize(temp, t), dht11_quantize(humi, t), t);
+        note_level(tr, &st, &prev, t);
+        tr->reads++;
+    }
+}
+
+static void run_adaptive(trace_t *tr, sample_sched_t *s) {
+    env_status_t st = {0};
+    int prev = -1;
+
+    sample_sched_init(s, NULL, NULL, 0);
+    for (int64_t t = 0; t < (int64_t)SIM_HOURS * 3600000; t += 50) {  // UI 루프 50ms
+        int temp, humi;
+        if (!sample_sched_due(s, t)) continue;
+        true_env(t, &temp, &humi);
+        temp = dht11_quantize(temp, t);
+        humi = dht11_quantize(humi, t);
+        update_environment_status_at(&st, temp, humi, t);
+        sample_sched_update(s, &st, 1, temp, humi, t);
+        note_level(tr, &st, &prev, t);
+        tr->reads++;
+    }
+}
+
+static void test_simulation(void) {
+    static trace_t fixed, adaptive;
+    sample_sched_t s;
+    int64_t worst = 0;
+    int matched = 1;
+
+    printf("🧪 24시간 모의 실험 (난방 램프, 샤워, 일교차, DHT11 양자화/흔들림)\n");
+    run_fixed(&fixed);
+    run_adaptive(&adaptive, &s);
+
+    if (fixed.count != adaptive.count) matched = 0;
+    for (int i = 0; matched && i < fixed.count; i++) {
+        int64_t lag = adaptive.at[i] - fixed.at[i];
+        if (adaptive.level[i] != fixed.level[i]) matched = 0;
+        if (lag > worst) worst = lag;
+    }
+
+    printf("  ℹ️ 읽기: 고정 3초 %u회, 적응형 %u회 (%.1f%%), 실효 간격 %.1f초\n",
+           fixed.reads, adaptive.reads, 100.0 * adaptive.reads / fixed.reads,
+           (double)SIM_HOURS * 3600.0 / adaptive.reads);
+    printf("  ℹ️ 비트뱅잉 바쁜 대기: %.0f s → %.0f s/일, 등급 전환 %d회, 최악 지연 %.1f s\n",
+           fixed.reads * DHT11_READ_MS / 1000.0, adaptive.reads * DHT11_READ_MS / 1000.0,
+           fixed.count, worst / 1000.0);
+    CHECK(matched, "등급 전환 순서가 고정 3초와 같음 (놓친 경보 없음)");
+    CHECK(worst <= FIXED_MS, "전환 감지 지연 ≤ 최소 간격 3초");
+    CHECK(adaptive.reads * 4 < fixed.reads, "읽기 횟수 1/4 미만");
+    CHECK(s.stats.attempts == adaptive.reads, "시도 횟수 기록");
+}
+
+int main(void) {
+    test_backoff();
+    test_boundary();
+    test_simulation();
+
+    if (failures) {
+        printf("❌ 실패 %d건\n", failures);
+        return 1;
+    }
+    printf("🎉 모든 측정 주기 스케줄러 테스트 통과\n");
+    return 0;
+}
@@ -0,0 +1,489 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include "ui_widget.h"
+#include "ui_screens.h"
+#include "environment_indicator.h"
+#include "fixed_point.h"
+#include "test_check.h"
+
+static ui_t ui;
+static oled_dl_t dl;
+static ui_screens_t scr;                // smart_env_ui.c와 같은 화면 (ui_screens)
+static ui_widget_t shifted, shift_pad, shift_label;
+
+static const comfort_metrics_t comfort = { 1234, 2450, 1150 };     // 이슬점, 체감, 절대 습도
+
+static struct tm make_tm(int year, int mon, int mday, int hour, int min, int sec) {
+    struct tm tm;
+    memset(&tm, 0, sizeof(tm));
+    tm.tm_year = year - 1900;
+    tm.tm_mon = mon - 1;
+    tm.tm_mday = mday;
+    tm.tm_hour = hour;
+    tm.tm_min = min;
+    tm.tm_sec = sec;
+    return tm;
+}
+
+static void build_screens(void) {
+    struct tm tm = make_tm(2024, 1, 1, 12, 0, 0);
+
+    ui_screens_build(&scr, "LIVING ROOM");
+    ui_screens_time(&scr, &tm);
+
+    // 페이지 경계가 아닌 y (4줄 아래)에 12x16 글자
+    ui_box_init(&shifted, UI_VBOX, 0, 0);
+    ui_label_init(&shift_pad, 0, "");
+    shift_pad.pref_h = 4;
+    ui_label_init(&shift_label, 0, "8");
+    ui_widget_set_font(&shift_label, &ui_font_12x16);
+    ui_add(&shifted, &shift_pad);
+    ui_add(&shifted, &shift_label);
+}
+
+// 디스플레이 리스트의 BLIT 명령 해석
+static int dl_ops(struct oled_op *ops, int max) {
+    size_t pos = 0;
+    int n = 0;
+
+    while (pos + sizeof(struct oled_op) <= dl.len && n < max) {
+        memcpy(&ops[n], dl.buf + pos, sizeof(struct oled_op));
+        pos += sizeof(struct oled_op) + ops[n].len;
+        n++;
+    }
+    return n;
+}
+
+static int page_blank(int page, int x0, int x1) {
+    for (int x = x0; x <= x1; x++) {
+        if (ui.fb[page][x]) return 0;
+    }
+    return 1;
+}
+
+static void show(ui_widget_t *root) {
+    ui_set_root(&ui, root);
+    ui_render(&ui);
+    ui_build_dl(&ui, &dl);
+}
+
+// 보이는 위젯이 모두 화면 안에, 원하는 크기 그대로, 글자가 폭 안에 들어가는지
+static int fits(const ui_widget_t *w, const char **bad) {
+    const ui_rect_t *r = &w->rect;
+
+    if (w->flags & UI_F_HIDDEN) return 1;
+    if (r->x < 0 || r->y < 0 || r->x + r->w > UI_WIDTH || r->y + r->h > UI_HEIGHT ||
+        r->w <= 0 || r->h <= 0) {
+        *bad = "화면 밖/빈 영역";
+        return 0;
+    }
+    if (w->kind == UI_VBOX || w->kind == UI_HBOX) {
+        for (const ui_widget_t *c = w->first; c; c = c->next) {
+            if (!fits(c, bad)) return 0;
+        }
+        return 1;
+    }
+    if (r->h < w->pref_h || r->w < w->pref_w) {
+        *bad = w->kind == UI_LABEL || w->kind == UI_VALUE ? w->u.text.text : "줄 높이/폭 모자람";
+        return 0;
+    }
+    if ((w->kind == UI_LABEL || w->kind == UI_VALUE) &&
+        w->u.text.len * w->u.text.font->width > r->w) {
+        *bad = w->u.text.text;
+        return 0;
+    }
+    return 1;
+}
+
+static int screen_fits(ui_widget_t *root, const char *what) {
+    const char *bad = NULL;
+
+    show(root);
+    if (fits(root, &bad)) return 1;
+    printf("  ℹ️ %s: 넘침 - %s\n", what, bad);
+    return 0;
+}
+
+// 실제 화면 배치: 가능한 모든 상태/극단값에서 줄 높이 합 64 이하, 글자 128열 이내
+static void test_layout(void) {
+    struct tm tm = make_tm(2099, 12, 31, 23, 59, 59);
+    const comfort_metrics_t worst = { -4000, 10000, 29000 };
+    const int temps[] = { -4000, 0, 2350, 8000 };
+    const int humis[] = { 0, 4550, 10000 };
+    int ok = 1;
+
+    printf("🧪 실제 화면 배치\n");
+    for (int level = ENV_GOOD; level <= ENV_DANGER; level++) {
+        ui_screens_room(&scr, "ABCDEFGHIJKLMNOPQRSTU", level, get_level_text(level), &worst, "");
+        ok = ok && screen_fits(&scr.room_screen, "방 화면");
+        ui_screens_room(&scr, "LIVING ROOM", level, get_level_text(level), &worst,
+                        "a_very_long_alert_name");
+        ok = ok && screen_fits(&scr.room_screen, "방 화면 (경보)");
+    }
+    CHECK(ok, "방 화면: 21자 방 이름, 모든 등급, 경보 줄");
+    CHECK(scr.alert_label.rect.y == scr.feel_value.rect.y || scr.feel_value.rect.h == 0,
+          "경보 줄이 체감 온도 자리에");
+
+    ok = 1;
+    for (int t = 0; t < 4; t++) {
+        for (int h = 0; h < 3; h++) {
+            ui_screens_sensor(&scr, UI_SENSOR_LIVE, temps[t], humis[h]);
+            ok = ok && screen_fits(&scr.sensor_screen, "센서 화면");
+            ui_screens_sensor(&scr, UI_SENSOR_STALE, temps[t], humis[h]);
+            ok = ok && screen_fits(&scr.sensor_screen, "센서 화면 (마지막 값)");
+        }
+    }
+    ui_screens_sensor(&scr, UI_SENSOR_NONE, 0, 0);
+    ok = ok && screen_fits(&scr.sensor_screen, "센서 화면 (오류)");
+    CHECK(ok, "센서 화면: -40.0~80.0°C, 0~100%, 정상/마지막 값/오류");
+    CHECK(scr.temp_spark.rect.h >= UI_LINE_H, "안내 줄이 떠도 추이 한 페이지 이상");
+
+    ui_screens_time(&scr, &tm);
+    CHECK(screen_fits(&scr.time_screen, "시간 화면") &&
+          strcmp(scr.time_label.u.text.text, "23:59") == 0 &&
+          strcmp(scr.sec_label.u.text.text, ":59") == 0, "시간 화면: 2099-12-31 23:59:59");
+
+    // 이후 테스트가 쓰는 기본 상태로
+    tm = make_tm(2024, 1, 1, 12, 0, 0);
+    ui_screens_time(&scr, &tm);
+    ui_screens_room(&scr, "LIVING ROOM", ENV_GOOD, get_level_text(ENV_GOOD), &comfort, "");
+}
+
+static void test_first_frame(void) {
+    struct oled_op ops[8];
+    int ok = 1;
+
+    printf("🧪 첫 화면\n");
+    ui.root = NULL;
+    ui_set_root(&ui, &scr.time_screen);
+    CHECK(ui_render(&ui) == UI_PAGES, "첫 그리기 → 8페이지 전체 손상");
+    CHECK(ui_build_dl(&ui, &dl) == UI_PAGES && dl_ops(ops, 8) == 8, "BLIT 8개");
+    for (int i = 0; i < 8; i++) {
+        ok = ok && ops[i].opcode == OLED_OP_BLIT && ops[i].x == 0 && ops[i].w == UI_WIDTH &&
+             ops[i].y == i * 8 && ops[i].h == 8;
+    }
+    CHECK(ok, "페이지마다 128열 BLIT");
+    CHECK(scr.date_label.rect.x == 36 && scr.time_label.rect.y == 8 && scr.sec_label.rect.y == 40,
+          "세로/가로 상자 배치 (제목+날짜, 시:분, 초)");
+    CHECK(!page_blank(1, 0, 119) && page_blank(1, 120, 127) && page_blank(7, 0, 127),
+          "시:분 5글자 = 120열, 마지막 페이지 빔");
+
+    CHECK(ui_render(&ui) == 0 && ui_build_dl(&ui, &dl) == 0, "변화 없으면 손상/명령 없음");
+}
+
+static void test_glyph_diff(void) {
+    struct oled_op ops[8];
+    uint32_t drawn = ui.stats.widgets_drawn;
+    struct tm tm = make_tm(2024, 1, 1, 12, 0, 1);
+
+    printf("🧪 글자 단위 손상\n");
+    ui_screens_time(&scr, &tm);
+    CHECK(ui_render(&ui) == 2 && ui_build_dl(&ui, &dl) == 2, "초 한 자리 → 12x16 2페이지");
+    dl_ops(ops, 8);
+    CHECK(ops[0].y == 40 && ops[0].x == 84 + 24 && ops[0].w == 12, "바뀐 초 글자 12열만 BLIT");
+    CHECK(ui.stats.widgets_drawn - drawn == 1, "다시 그린 위젯 1개");
+
+    ui_screens_time(&scr, &tm);
+    CHECK(ui_render(&ui) == 0, "같은 시각 → 손상 없음");
+
+    tm = make_tm(2024, 1, 1, 12, 1, 0);
+    ui_screens_time(&scr, &tm);
+    CHECK(ui_render(&ui) == 6 && ui_build_dl(&ui, &dl) == 6, "분 + 초 → 4 + 2페이지");
+    dl_ops(ops, 8);
+    CHECK(ops[0].y == 8 && ops[0].x == 96 && ops[0].w == 24, "바뀐 큰 글자 24열만 BLIT");
+
+    ui_label_set(&scr.date_label, "2024-1");
+    ui_render(&ui);
+    ui_build_dl(&ui, &dl);
+    dl_ops(ops, 8);
+    CHECK(ops[0].x == 36 + 5 * 6 && ops[0].w == 5 * 6 && page_blank(0, 36 + 36, 127),
+          "짧아지면 남은 칸까지 지움");
+
+    ui_label_set(&scr.time_title, "TIME");
+    CHECK(ui_render(&ui) == 0, "초기 문자열과 같으면 손상 없음");
+}
+
+static void test_values_and_layout(void) {
+    struct oled_op ops[8];
+    uint8_t feel_page[UI_WIDTH];
+    comfort_metrics_t c = comfort;
+    uint32_t drawn;
+
+    printf("🧪 값/배치\n");
+    show(&scr.room_screen);
+    CHECK(scr.level_icon.rect.w == 12 && scr.level_label.rect.x == 12 && scr.level_label.rect.w == 116,
+          "가로 상자: 아이콘 12열 + 나머지 채움");
+    CHECK(scr.ah_value.rect.x == 66 && scr.ah_value.rect.y == 16, "편의 지표 줄 두 값 배치");
+    CHECK(memcmp(&ui.fb[1][0], scr.level_icon.u.icon.bits, 8) == 0, "아이콘 비트맵 그대로");
+    CHECK(strcmp(scr.dew_value.u.text.text, "DEW 12.3C") == 0, "값 서식 (fx_format)");
+
+    drawn = ui.stats.widgets_drawn;
+    ui_screens_room(&scr, "LIVING ROOM", ENV_GOOD, get_level_text(ENV_GOOD), &c, "");
+    CHECK(ui_render(&ui) == 0 && ui.stats.widgets_drawn == drawn, "같은 값 → 서식화/그리기 없음");
+
+    c.abs_humidity_centi = 1160;
+    ui_screens_room(&scr, "LIVING ROOM", ENV_GOOD, get_level_text(ENV_GOOD), &c, "");
+    ui_render(&ui);
+    ui_build_dl(&ui, &dl);
+    dl_ops(ops, 8);
+    CHECK(ops[0].y == 16 && ops[0].x == 66 + 6 * 6 && ops[0].w == 6, "AH 11.5 → 11.6: 한 글자만");
+
+    // 경보가 뜨면 체감 온도 자리를 경보 줄이 차지 (배치 재계산은 이때만)
+    uint32_t layouts = ui.stats.layouts;
+    memcpy(feel_page, ui.fb[3], sizeof(feel_page));
+    ui_screens_room(&scr, "LIVING ROOM", ENV_GOOD, get_level_text(ENV_GOOD), &c, "high_humidity");
+    CHECK(ui_render(&ui) == 1 && ui.stats.layouts == layouts + 1, "보이기/숨기기 → 배치 1회, 그 줄만 손상");
+    ui_build_dl(&ui, &dl);
+    CHECK(scr.alert_label.rect.y == 24 && memcmp(feel_page, ui.fb[3], sizeof(feel_page)) != 0 &&
+          page_blank(4, 0, 127), "경보 줄이 같은 자리에");
+
+    ui_screens_room(&scr, "LIVING ROOM", ENV_GOOD, get_level_text(ENV_GOOD), &c, "");
+    ui_render(&ui);
+    ui_build_dl(&ui, &dl);
+    CHECK(memcmp(feel_page, ui.fb[3], sizeof(feel_page)) == 0, "되돌리면 체감 온도 줄 그대로");
+    CHECK(ui_render(&ui) == 0 && ui.stats.layouts == layouts + 2, "이후에는 배치 재계산 없음");
+}
+
+static void test_bar_sparkline(void) {
+    int bottom = 0, ok = 1;
+
+    printf("🧪 막대/추이\n");
+    ui_screens_sensor(&scr, UI_SENSOR_LIVE, 2300, 5000);
+    for (int i = 0; i < 10; i++) ui_sparkline_push(&scr.temp_spark, 2300);
+    show(&scr.sensor_screen);
+
+    // 막대: 습도 값 옆 72~127열, 32~43줄 (페이지 4 전체 + 페이지 5의 0~3비트), 안쪽 54열 중 절반
+    CHECK(scr.humi_bar.rect.x == 72 && scr.humi_bar.rect.y == 32 && scr.humi_bar.rect.h == 12,
+          "막대 배치");
+    CHECK(ui.fb[4][73] == 0xFF && ui.fb[5][73] == 0x0F && ui.fb[4][99] == 0xFF &&
+          ui.fb[4][100] == 0x01 && ui.fb[5][100] == 0x08 && ui.fb[5][127] == 0x0F,
+          "습도 50% → 안쪽 27열 채움");
+
+    ui_bar_set(&scr.humi_bar, 5010);
+    CHECK(ui_render(&ui) == 0, "채운 폭이 같으면 다시 그리지 않음");
+    ui_bar_set(&scr.humi_bar, 5400);
+    CHECK(ui_render(&ui) == 2, "채운 폭이 바뀌면 막대 페이지만");
+    ui_build_dl(&ui, &dl);
+
+    // 추이: 같은 값은 가운데 가로선 (min_span 2°C), 오른쪽 끝이 최신
+    int y0 = scr.temp_spark.rect.y, h = scr.temp_spark.rect.h;
+    int mid = y0 + h - 1 - (h - 1) / 2;
+    for (int x = 128 - 20; x < 128; x++) {
+        ok = ok && (ui.fb[mid >> 3][x] & (1 << (mid & 7)));
+    }
+    CHECK(y0 == 48 && h == 16, "추이가 남은 2페이지를 채움");
+    CHECK(ok && page_blank(mid >> 3, 0, 127 - 20), "같은 값 10개 → 가운데 줄 20열");
+
+    ui_sparkline_push(&scr.temp_spark, 2500);
+    ui_render(&ui);
+    for (int y = y0; y < y0 + h && !bottom; y++) {
+        bottom = (ui.fb[y >> 3][127] >> (y & 7)) & 1 ? y : 0;
+    }
+    CHECK(bottom == y0, "큰 값 → 맨 위 (자동 눈금)");
+    ui_build_dl(&ui, &dl);
+
+    // 센서 오류: 안내 줄이 추이 위에 끼어듦 (배치만 바뀜)
+    ui_screens_sensor(&scr, UI_SENSOR_STALE, 2300, 5400);
+    ui_render(&ui);
+    ui_build_dl(&ui, &dl);
+    CHECK(scr.sensor_note.rect.y == 48 && scr.temp_spark.rect.y == 56 &&
+          strcmp(scr.sensor_note.u.text.text, "LAST VALUE") == 0, "마지막 값 안내 줄");
+    ui_screens_sensor(&scr, UI_SENSOR_NONE, 0, 0);
+    ui_render(&ui);
+    ui_build_dl(&ui, &dl);
+    CHECK(strcmp(scr.temp_big.u.text.text, "--.-") == 0 &&
+          strcmp(scr.sensor_note.u.text.text, "SENSOR ERROR") == 0, "값 없음 → 대시 + 오류 안내");
+    ui_screens_sensor(&scr, UI_SENSOR_LIVE, 2300, 5400);
+    ui_render(&ui);
+    ui_build_dl(&ui, &dl);
+    CHECK(scr.temp_spark.rect.y == 48 && strcmp(scr.temp_big.u.text.text, "23.0") == 0,
+          "정상으로 돌아오면 안내 줄 숨김");
+}
+
+static void test_screen_switch(void) {
+    uint8_t saved[UI_PAGES][UI_WIDTH];
+
+    printf("🧪 화면 전환\n");
+    show(&scr.time_screen);
+    memcpy(saved, ui.fb, sizeof(saved));
+
+    ui_set_root(&ui, &scr.room_screen);
+    CHECK(ui_render(&ui) == UI_PAGES, "다른 화면 → 전체 다시 그림");
+    ui_build_dl(&ui, &dl);
+
+    ui_set_root(&ui, &scr.time_screen);
+    CHECK(ui_render(&ui) == UI_PAGES && memcmp(saved, ui.fb, sizeof(saved)) == 0,
+          "돌아오면 캐시된 배치로 같은 화면");
+    ui_build_dl(&ui, &dl);
+
+    ui_invalidate(&ui);
+    CHECK(ui_render(&ui) == UI_PAGES && ui_build_dl(&ui, &dl) == UI_PAGES, "invalidate → 전체 재전송");
+}
+
+// 글꼴 f의 글자 c, 열 x의 세로 비트 (bit0 = 맨 윗줄)
+static uint32_t glyph_column(const ui_font_t *f, char c, int x) {
+    const uint8_t *g = ui_font_glyph(f, c);
+    uint32_t bits = 0;
+
+    for (int p = 0; p < f->pages; p++) bits |= (uint32_t)g[p * f->width + x] << (p * 8);
+    return bits;
+}
+
+static void test_fonts(void) {
+    struct oled_op ops[8];
+    int ok = 1;
+
+    printf("🧪 글꼴 아틀라스\n");
+    CHECK(ui_font_12x16.width == 12 && ui_font_12x16.pages == 2 && ui_font_12x16.glyph_bytes == 24 &&
+          ui_font_24x32.width == 24 && ui_font_24x32.pages == 4 && ui_font_24x32.glyph_bytes == 96,
+          "글꼴 크기/페이지 수");
+    CHECK(ui_font_glyph(&ui_font_6x8, (char)200) == ui_font_glyph(&ui_font_6x8, '?'), "범위 밖 → '?'");
+    CHECK(ui_font_glyph(&ui_font_24x32, 'A') == ui_font_glyph(&ui_font_24x32, ' ') &&
+          ui_font_glyph(&ui_font_24x32, '7') != ui_font_glyph(&ui_font_24x32, ' '),
+          "24x32는 숫자/기호만, 나머지는 공백");
+
+    // 대각선이 없는 '-'는 Scale2x 한 번이면 정확히 두 배 (두 번째에는 끝이 둥글어짐)
+    for (int x = 0; x < 12; x++) {
+        uint32_t small = glyph_column(&ui_font_6x8, '-', x / 2), big = 0;
+        for (int y = 0; y < 8; y++) if (small >> y & 1) big |= 0x3u << (y * 2);
+        ok = ok && glyph_column(&ui_font_12x16, '-', x) == big;
+    }
+    CHECK(ok && glyph_column(&ui_font_24x32, '-', 0) == 0x060000 && glyph_column(&ui_font_24x32, '-', 12) == 0x0F0000,
+          "'-' 12x16 = 6x8 두 배, 24x32는 끝만 둥글게");
+    CHECK(scr.time_label.pref_h == 32 && scr.sec_label.pref_h == 16, "글꼴에 맞춘 위젯 높이");
+
+    // 페이지 경계: 아틀라스 바이트가 그대로 프레임에
+    ui_screens_sensor(&scr, UI_SENSOR_LIVE, 2350, 4500);
+    show(&scr.sensor_screen);
+    ok = strcmp(scr.temp_big.u.text.text, "23.5") == 0;
+    for (int p = 0; p < 4; p++) {
+        ok = ok && memcmp(&ui.fb[p][24], ui_font_glyph(&ui_font_24x32, '3') + p * 24, 24) == 0;
+    }
+    CHECK(ok, "24x32 '3' = 아틀라스 4페이지 x 24열 복사");
+    CHECK(scr.humi_value.rect.y == 32 &&
+          memcmp(&ui.fb[4][0], ui_font_glyph(&ui_font_12x16, '4'), 12) == 0, "12x16 습도 페이지 4~5");
+
+    ui_screens_sensor(&scr, UI_SENSOR_LIVE, 2360, 4500);
+    CHECK(ui_render(&ui) == 4 && ui_build_dl(&ui, &dl) == 4, "큰 글자 하나 → 4페이지");
+    dl_ops(ops, 8);
+    CHECK(ops[0].x == 72 && ops[0].w == 24 && ops[3].y == 24, "바뀐 큰 글자 24열만 BLIT");
+
+    // 페이지 경계가 아님: 열 바이트를 시프트해 두 페이지에 나눠 씀
+    ok = 1;
+    show(&shifted);
+    for (int x = 0; x < 12; x++) {
+        uint32_t col = ui.fb[0][x] | (uint32_t)ui.fb[1][x] << 8 | (uint32_t)ui.fb[2][x] << 16;
+        ok = ok && (col & 0xF) == 0 && col >> 4 == glyph_column(&ui_font_12x16, '8', x);
+    }
+    CHECK(shift_label.rect.y == 4 && ok, "y 4에 12x16 '8' (3페이지에 걸침)");
+}
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// 기존 방식: 매번 모든 줄을 6x8로 서식화하고 화면 전체를 그려 보냄
+static size_t full_redraw(const char *date_line, const char *time_line) {
+    static ui_widget_t screen, lines[3];
+    const char *text[3] = { "TIME", date_line, time_line };
+
+    ui_box_init(&screen, UI_VBOX, 0, 0);
+    for (int i = 0; i < 3; i++) {
+        ui_label_init(&lines[i], 0, text[i]);
+        ui_add(&screen, &lines[i]);
+    }
+    ui.root = NULL;
+    ui_set_root(&ui, &screen);
+    ui_render(&ui);
+    ui_build_dl(&ui, &dl);
+    return dl.len;
+}
+
+static void bench(void) {
+    const int ticks = 86400;
+    char date_line[16], time_line[16];
+    double t0, t_full, t_widget;
+    uint64_t bytes_full = 0, bytes_widget = 0;
+    int submits = 0;
+
+    printf("📊 시간 화면 하루치 (1초마다 %d회)\n", ticks);
+
+    t0 = now_sec();
+    for (int s = 0; s < ticks; s++) {
+        fx_format(date_line, sizeof(date_line), "2024-01-%02d", 1 + s / 86400);
+        fx_format(time_line, sizeof(time_line), "%02d:%02d:%02d", s / 3600, s / 60 % 60, s % 60);
+        bytes_full += full_redraw(date_line, time_line);
+    }
+    t_full = now_sec() - t0;
+
+    ui.root = NULL;
+    show(&scr.time_screen);
+    t0 = now_sec();
+    for (int s = 0; s < ticks; s++) {
+        struct tm tm = make_tm(2024, 1, 2, s / 3600, s / 60 % 60, s % 60);
+        ui_screens_time(&scr, &tm);
+        if (ui_render(&ui) && ui_build_dl(&ui, &dl) > 0) {
+            bytes_widget += dl.len;
+            submits++;
+        }
+    }
+    t_widget = now_sec() - t0;
+
+    printf("  ⏱️ 6x8 전체 다시 그리기:    %.2f µs/갱신, %.0f바이트/갱신\n",
+           t_full * 1e6 / ticks, (double)bytes_full / ticks);
+    printf("  ⏱️ 위젯 트리 (큰 글씨):     %.2f µs/갱신, %.1f바이트/갱신 (제출 %d회)\n",
+           t_widget * 1e6 / ticks, (double)bytes_widget / ticks, submits);
+
+    // 방 화면: 3초마다 측정, 값은 대부분 그대로 (DHT11 1°C/1% 단위)
+    uint32_t flushes = 0, drawn = ui.stats.widgets_drawn;
+    show(&scr.room_screen);
+    for (int s = 0; s < 28800; s++) {
+        int t = 2300 + (s / 1200) % 3 * 100;
+        comfort_metrics_t c = { t - 1000, t + 50, 1150 };
+        ui_screens_room(&scr, "LIVING ROOM", ENV_GOOD, get_level_text(ENV_GOOD), &c, "");
+        if (ui_render(&ui) && ui_build_dl(&ui, &dl) > 0) flushes++;
+    }
+    printf("  ℹ️ 방 화면 하루 28800회 갱신 → 제출 %u회, 다시 그린 위젯 %u개\n",
+           flushes, ui.stats.widgets_drawn - drawn);
+
+    // 글자 그리기만: 화면 전체 다시 그리기 (6x8 3줄 vs 24x32/12x16)
+    const int frames = 100000;
+    double t_small, t_big;
+    t0 = now_sec();
+    for (int i = 0; i < frames; i++) full_redraw("2024-01-01", "12:00:00");
+    t_small = now_sec() - t0;
+    t0 = now_sec();
+    for (int i = 0; i < frames; i++) {
+        ui.root = NULL;
+        show(&scr.time_screen);
+    }
+    t_big = now_sec() - t0;
+    printf("  ⏱️ 전체 그리기+명령: 6x8 시간 화면 %.2f µs, 큰 글씨 시간 화면 %.2f µs\n",
+           t_small * 1e6 / frames, t_big * 1e6 / frames);
+}
+
+int main(int argc, char **argv) {
+    ui_init(&ui);
+    build_screens();
+
+    test_layout();
+    test_first_frame();
+    test_glyph_diff();
+    test_values_and_layout();
+    test_bar_sparkline();
+    test_screen_switch();
+    test_fonts();
+
+    if (argc > 1 && strcmp(argv[1], "--bench") == 0) bench();
+
+    if (failures) {
+        printf("❌ 실패 %d건\n", failures);
+        return 1;
+    }
+    printf("🎉 모든 위젯 트리 테스트 통과\n");
+    return 0;
+}
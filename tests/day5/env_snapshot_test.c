@@ -0,0 +1,253 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include "env_snapshot.h"
+#include "test_check.h"
+
+#define TEST_NAME       "/smart_env_snapshot_test"
+#define TORTURE_WRITES  2000000
+#define TORTURE_READERS 3
+#define BENCH_READS     10000000
+
+// k번째 스냅샷: 모든 필드를 k에서 유도해 읽는 쪽이 찢어진 복사를 알아챌 수 있게 함
+static void make_snapshot(uint32_t k, env_snapshot_t *snap) {
+    memset(snap, 0, sizeof(*snap));
+    snap->sample.time = 1700000000u + k;
+    snap->sample.temp_centi = (int16_t)(k & 0x7FFF);
+    snap->sample.humi_centi = (uint16_t)(k * 3);
+    snap->sample.time_ms = (uint16_t)(k % 1000);
+    snap->sample.flags = SAMPLE_FLAG_VALID;
+    snap->overall_level = (uint8_t)(k % 3);
+    snap->warning_elapsed_s = k * 7;
+    snap->reads_ok = k;
+    snap->reads_failed = ~k;
+    snap->consecutive_errors = k ^ 0x5A5A5A5Au;
+    snap->display_mode = k % 3;
+}
+
+static int snapshot_consistent(const env_snapshot_t *s) {
+    uint32_t k = s->reads_ok;
+    return s->sample.time == 1700000000u + k &&
+           s->sample.temp_centi == (int16_t)(k & 0x7FFF) &&
+           s->sample.humi_centi == (uint16_t)(k * 3) &&
+           s->sample.time_ms == (uint16_t)(k % 1000) &&
+           s->overall_level == k % 3 &&
+           s->warning_elapsed_s == k * 7 &&
+           s->reads_failed == ~k &&
+           s->consecutive_errors == (k ^ 0x5A5A5A5Au) &&
+           s->display_mode == k % 3;
+}
+
+static void test_basic(void) {
+    env_snapshot_publisher_t pub;
+    env_snapshot_reader_t reader;
+    env_snapshot_t snap, got;
+
+    printf("🧪 게시/읽기 기본 동작\n");
+    shm_unlink(TEST_NAME);
+    fprintf(stderr, "(다음 오류 메시지는 예상된 것)\n");
+    CHECK(env_snapshot_reader_open(&reader, TEST_NAME) != 0, "게시자 없으면 열기 실패");
+
+    CHECK(env_snapshot_publisher_open(&pub, TEST_NAME) == 0, "세그먼트 생성");
+    CHECK(env_snapshot_reader_open(&reader, TEST_NAME) == 0, "읽기 전용 매핑");
+    CHECK(env_snapshot_read(&reader, &got) != 0 && errno == ENODATA, "게시 전 → ENODATA");
+    CHECK(env_snapshot_publisher_pid(&reader) == (uint32_t)getpid(), "게시자 pid");
+
+    make_snapshot(42, &snap);
+    env_snapshot_publish(&pub, &snap);
+    CHECK(env_snapshot_read(&reader, &got) == 0 && snapshot_consistent(&got) &&
+          got.reads_ok == 42 && got.publish_count == 1 && got.publish_mono_ns > 0,
+          "게시한 내용 그대로 읽음");
+
+    // 다른 프로세스에서 읽기
+    pid_t child = fork();
+    if (child == 0) {
+        env_snapshot_reader_t r;
+        env_snapshot_t c;
+        int ok = env_snapshot_reader_open(&r, TEST_NAME) == 0 &&
+                 env_snapshot_read(&r, &c) == 0 && c.reads_ok == 42;
+        _exit(ok ? 0 : 1);
+    }
+    int status = 0;
+    waitpid(child, &status, 0);
+    CHECK(WIFEXITED(status) && WEXITSTATUS(status) == 0, "다른 프로세스에서 읽기");
+
+    // 재시작한 게시자는 순번을 이어감
+    env_snapshot_publisher_close(&pub);
+    CHECK(env_snapshot_publisher_pid(&reader) == 0, "게시자 종료 표시");
+    CHECK(env_snapshot_read(&reader, &got) == 0 && got.reads_ok == 42,
+          "종료 후에도 마지막 상태 유지");
+    env_snapshot_publisher_open(&pub, TEST_NAME);
+    make_snapshot(43, &snap);
+    env_snapshot_publish(&pub, &snap);
+    CHECK(env_snapshot_read(&reader, &got) == 0 && got.publish_count == 2,
+          "재시작 후 게시 순번 이어감");
+
+    env_snapshot_reader_close(&reader);
+    env_snapshot_publisher_close(&pub);
+    shm_unlink(TEST_NAME);
+}
+
+typedef struct {
+    env_snapshot_reader_t reader;
+    volatile int *stop;
+    uint64_t reads;
+    uint64_t torn;
+    uint64_t busy;
+    uint64_t backwards;
+} reader_ctx_t;
+
+static void *reader_thread(void *arg) {
+    reader_ctx_t *ctx = arg;
+    env_snapshot_t got;
+    uint64_t last = 0;
+
+    while (!*ctx->stop) {
+        if (env_snapshot_read(&ctx->reader, &got) != 0) {
+            if (errno == EAGAIN) ctx->busy++;
+            continue;
+        }
+        ctx->reads++;
+        if (!snapshot_consistent(&got)) ctx->torn++;
+        if (got.publish_count < last) ctx->backwards++;
+        last = got.publish_count;
+    }
+    return NULL;
+}
+
+static void test_torture(void) {
+    env_snapshot_publisher_t pub;
+    reader_ctx_t ctx[TORTURE_READERS];
+    pthread_t threads[TORTURE_READERS];
+    volatile int stop = 0;
+    uint64_t reads = 0, torn = 0, busy = 0, backwards = 0;
+    env_snapshot_t snap;
+
+    printf("🧪 쓰기 %d회 동안 읽기 스레드 %d개 (찢어진 복사 검사)\n",
+           TORTURE_WRITES, TORTURE_READERS);
+    shm_unlink(TEST_NAME);
+    env_snapshot_publisher_open(&pub, TEST_NAME);
+    make_snapshot(0, &snap);
+    env_snapshot_publish(&pub, &snap);
+
+    for (int i = 0; i < TORTURE_READERS; i++) {
+        memset(&ctx[i], 0, sizeof(ctx[i]));
+        ctx[i].stop = &stop;
+        env_snapshot_reader_open(&ctx[i].reader, TEST_NAME);
+        pthread_create(&threads[i], NULL, reader_thread, &ctx[i]);
+    }
+
+    for (uint32_t k = 1; k <= TORTURE_WRITES; k++) {
+        make_snapshot(k, &snap);
+        env_snapshot_publish(&pub, &snap);
+    }
+    stop = 1;
+
+    for (int i = 0; i < TORTURE_READERS; i++) {
+        pthread_join(threads[i], NULL);
+        reads += ctx[i].reads;
+        torn += ctx[i].torn;
+        busy += ctx[i].busy;
+        backwards += ctx[i].backwards;
+        env_snapshot_reader_close(&ctx[i].reader);
+    }
+
+    printf("  ℹ️ 읽기 %llu회, 재시도 한도 초과 %llu회\n",
+           (unsigned long long)reads, (unsigned long long)busy);
+    CHECK(reads > 0, "읽기 진행");
+    CHECK(torn == 0, "찢어진 스냅샷 없음");
+    CHECK(backwards == 0, "게시 순번 역행 없음");
+
+    env_snapshot_publisher_close(&pub);
+    shm_unlink(TEST_NAME);
+}
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// 실제 게시 주기(수 초)보다 훨씬 잦은 1ms 간격 게시자
+static void *slow_writer(void *arg) {
+    env_snapshot_publisher_t *pub = arg;
+    env_snapshot_t snap;
+    struct timespec ms = { 0, 1000000 };
+
+    for (uint32_t k = 1; k <= 200; k++) {
+        make_snapshot(k, &snap);
+        env_snapshot_publish(pub, &snap);
+        nanosleep(&ms, NULL);
+    }
+    return NULL;
+}
+
+static void bench_snapshot(void) {
+    env_snapshot_publisher_t pub;
+    env_snapshot_reader_t reader;
+    env_snapshot_t snap, got;
+    pthread_t writer;
+    double t0, idle_s, busy_s, pub_s;
+    volatile uint32_t sink = 0;
+    int reads_during = 0;
+
+    printf("📊 스냅샷 읽기/게시 속도\n");
+    shm_unlink(TEST_NAME);
+    env_snapshot_publisher_open(&pub, TEST_NAME);
+    env_snapshot_reader_open(&reader, TEST_NAME);
+
+    t0 = now_sec();
+    for (uint32_t k = 1; k <= 1000000; k++) {
+        make_snapshot(k, &snap);
+        env_snapshot_publish(&pub, &snap);
+    }
+    pub_s = now_sec() - t0;
+
+    t0 = now_sec();
+    for (int i = 0; i < BENCH_READS; i++) {
+        env_snapshot_read(&reader, &got);
+        sink += got.reads_ok;
+    }
+    idle_s = now_sec() - t0;
+
+    pthread_create(&writer, NULL, slow_writer, &pub);
+    t0 = now_sec();
+    while (now_sec() - t0 < 0.15) {
+        for (int i = 0; i < 1000; i++) {
+            env_snapshot_read(&reader, &got);
+            sink += got.reads_ok;
+        }
+        reads_during += 1000;
+    }
+    busy_s = now_sec() - t0;
+    pthread_join(writer, NULL);
+    (void)sink;
+
+    printf("  ⏱️ 게시 %.1f ns/회 (make_snapshot 포함)\n", pub_s * 1e9 / 1000000);
+    printf("  ⏱️ 읽기 %.1f ns/회 (게시 없음)\n", idle_s * 1e9 / BENCH_READS);
+    printf("  ⏱️ 읽기 %.1f ns/회 (1ms마다 게시 중)\n", busy_s * 1e9 / reads_during);
+
+    env_snapshot_reader_close(&reader);
+    env_snapshot_publisher_close(&pub);
+    shm_unlink(TEST_NAME);
+}
+
+int main(int argc, char **argv) {
+    test_basic();
+    test_torture();
+    if (argc > 1 && strcmp(argv[1], "--bench") == 0) {
+        bench_snapshot();
+    }
+
+    if (failures) {
+        printf("❌ 실패 %d건\n", failures);
+        return 1;
+    }
+    printf("🎉 모든 공유 메모리 스냅샷 테스트 통과\n");
+    return 0;
+}
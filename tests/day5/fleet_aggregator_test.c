@@ -0,0 +1,331 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include "fleet_aggregator.h"
+#include "node_uplink.h"
+#include "test_check.h"
+
+#define TEST_PORT       17170
+#define DEAD_PORT       17171           // 아무도 듣지 않는 포트
+#define BASE_TIME       1700000000u
+#define BULK_SAMPLES    700000          // 노드 블록 한도를 넘겨 오래된 블록 재사용
+
+static fleet_aggregator_t agg;
+static node_uplink_t up1, up2;
+
+static sensor_sample_t make_sample(uint32_t i, int temp_base) {
+    sensor_sample_t s;
+    s.time = BASE_TIME + i * 3;
+    s.time_ms = (uint16_t)(i % 1000);
+    s.temp_centi = (int16_t)(temp_base + (int)(i % 300));
+    s.humi_centi = (uint16_t)(4000 + i % 2000);
+    s.flags = (i % 50 == 49) ? SAMPLE_FLAG_STALE : SAMPLE_FLAG_VALID | SAMPLE_FLAG_TIME_RTC;
+    return s;
+}
+
+static int same_sample(const sensor_sample_t *a, const sensor_sample_t *b) {
+    return memcmp(a, b, sizeof(*a)) == 0;
+}
+
+static int pumped;
+
+// 같은 스레드에서 서버와 (열려 있는) 업링크를 함께 돌리며 조건을 기다림 (2초 넘으면 실패)
+#define PUMP_UNTIL(cond) do { \
+    pumped = 0; \
+    for (int spins_ = 0; spins_ < 2000 && !pumped; spins_++) { \
+        if (up1.hello.node_id) node_uplink_poll(&up1); \
+        if (up2.hello.node_id) node_uplink_poll(&up2); \
+        fleet_aggregator_poll(&agg, 1); \
+        pumped = (cond); \
+    } \
+} while (0)
+
+static void stop_uplink(node_uplink_t *u) {
+    node_uplink_close(u);
+    memset(u, 0, sizeof(*u));
+    u->fd = -1;
+}
+
+static int connect_client(void) {
+    struct sockaddr_in addr;
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(TEST_PORT);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (fd < 0 || connect(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+        if (fd >= 0) close(fd);
+        return -1;
+    }
+    fleet_aggregator_poll(&agg, 10);        // accept
+    return fd;
+}
+
+// 서버를 돌리며 n바이트 수신 (반환: 0 성공, -1 닫힘/시간 초과)
+static int recv_exact(int fd, void *buf, size_t n) {
+    size_t got = 0;
+    for (int spins = 0; got < n && spins < 2000; spins++) {
+        fleet_aggregator_poll(&agg, 1);
+        ssize_t r = recv(fd, (uint8_t *)buf + got, n - got, MSG_DONTWAIT);
+        if (r > 0) got += (size_t)r;
+        if (r == 0) return -1;
+    }
+    return got == n ? 0 : -1;
+}
+
+// 질의 하나 (반환: 응답 페이로드 길이, -1 실패). status는 응답 상태
+static int query(int fd, uint8_t type, const void *req, uint32_t len,
+                 void *out, uint32_t max, uint8_t *status) {
+    uint8_t msg[64];
+    node_frame_t hdr = { NODE_PROTOCOL_MAGIC, type, NODE_OK, len };
+
+    memcpy(msg, &hdr, sizeof(hdr));
+    if (len) memcpy(msg + sizeof(hdr), req, len);
+    if (write(fd, msg, sizeof(hdr) + len) != (ssize_t)(sizeof(hdr) + len)) return -1;
+    if (recv_exact(fd, &hdr, sizeof(hdr)) != 0 || hdr.magic != NODE_PROTOCOL_MAGIC ||
+        hdr.type != type || hdr.len > max) {
+        return -1;
+    }
+    if (status) *status = hdr.status;
+    if (recv_exact(fd, out, hdr.len) != 0) return -1;
+    return (int)hdr.len;
+}
+
+static void test_uplink(void) {
+    static sensor_sample_t got[2000];
+    const fleet_node_t *n;
+    fleet_stats_t st;
+    int ok = 1;
+
+    printf("🧪 업링크 → 집계 서버 수집\n");
+    CHECK(node_uplink_open(&up1, "127.0.0.1", TEST_PORT, 7, "KITCHEN") == 0, "업링크 준비");
+    for (uint32_t i = 0; i < 1000; i++) {
+        sensor_sample_t s = make_sample(i, 2000);
+        node_uplink_append(&up1, &s);
+    }
+    PUMP_UNTIL(agg.stats.samples == 1000);
+    CHECK(pumped, "샘플 1000개 수집");
+    CHECK(up1.state == NODE_UPLINK_UP && up1.count == 0 && up1.samples_sent == 1000,
+          "업링크 큐 비움");
+
+    n = fleet_aggregator_find(&agg, 7);
+    CHECK(n && strcmp(n->room, "KITCHEN") == 0 && n->conn >= 0, "노드 등록 (방 이름, 연결)");
+    CHECK(n && n->stored == 1000 && n->block_count > 0, "블록 봉인 후 보관");
+
+    // 구간 [100, 900) 번째 샘플
+    size_t cnt = fleet_aggregator_range(&agg, 7, (int64_t)(BASE_TIME + 300) * 1000,
+                                        (int64_t)(BASE_TIME + 2700) * 1000, got, 2000);
+    for (uint32_t i = 0; i < cnt; i++) {
+        sensor_sample_t want = make_sample(100 + i, 2000);
+        if (!same_sample(&got[i], &want)) ok = 0;
+    }
+    CHECK(cnt == 800 && ok, "구간 복원이 원본과 같음 (봉인 + 채우는 중 블록)");
+
+    // 재접속: 이전에 보낸 것과 겹치는 샘플은 버림
+    stop_uplink(&up1);
+    PUMP_UNTIL(agg.stats.nodes_connected == 0);
+    CHECK(pumped, "끊김 감지");
+    node_uplink_open(&up1, "127.0.0.1", TEST_PORT, 7, "KITCHEN");
+    for (uint32_t i = 990; i < 1100; i++) {
+        sensor_sample_t s = make_sample(i, 2000);
+        node_uplink_append(&up1, &s);
+    }
+    PUMP_UNTIL(agg.stats.samples + agg.stats.samples_dropped == 1110);
+    CHECK(pumped, "재전송 수신");
+    fleet_aggregator_stats(&agg, &st);
+    CHECK(st.samples == 1100 && st.samples_dropped == 10 && n->stored == 1100,
+          "겹친 샘플 10개 중복 제거");
+
+    // 같은 노드 ID가 새로 접속하면 이전 연결을 정리
+    node_uplink_open(&up2, "127.0.0.1", TEST_PORT, 7, "KITCHEN 2");
+    PUMP_UNTIL(strcmp(n->room, "KITCHEN 2") == 0 && up1.state == NODE_UPLINK_DOWN);
+    CHECK(pumped, "재접속한 노드가 이전 연결 대체");
+    CHECK(agg.stats.nodes_connected == 1 && agg.node_count == 1, "노드는 하나로 유지");
+    stop_uplink(&up2);
+    stop_uplink(&up1);
+}
+
+static void test_queries(void) {
+    static uint8_t buf[65536];
+    fleet_node_info_t info[4];
+    fleet_range_req_t rreq;
+    fleet_summary_req_t sreq;
+    fleet_summary_t sum;
+    fleet_stats_t st;
+    uint8_t status = 0xFF;
+    int fd, len;
+
+    printf("🧪 전체 노드 질의 (LIST / RANGE / SUMMARY / STATS)\n");
+    // 두 번째 노드는 더 따뜻한 방
+    node_uplink_open(&up1, "127.0.0.1", TEST_PORT, 8, "BEDROOM");
+    for (uint32_t i = 0; i < 500; i++) {
+        sensor_sample_t s = make_sample(i, 2600);
+        node_uplink_append(&up1, &s);
+    }
+    PUMP_UNTIL(fleet_aggregator_find(&agg, 8) && fleet_aggregator_find(&agg, 8)->stored == 500);
+    CHECK(pumped, "두 번째 노드 수집");
+
+    fd = connect_client();
+    CHECK(fd >= 0, "질의 연결");
+
+    len = query(fd, FLEET_MSG_LIST, NULL, 0, info, sizeof(info), &status);
+    CHECK(len == 2 * (int)sizeof(fleet_node_info_t) && status == NODE_OK, "LIST: 노드 2개");
+    CHECK(info[0].node_id == 7 && info[0].connected == 0 && info[0].sample_count == 1100 &&
+          info[1].node_id == 8 && strcmp(info[1].room, "BEDROOM") == 0 && info[1].connected == 1,
+          "LIST: 방 이름/연결/샘플 수");
+    sensor_sample_t last = make_sample(499, 2600);
+    CHECK(same_sample(&info[1].latest, &last), "LIST: 최신 샘플");
+
+    rreq.node_id = 8;
+    rreq.from = BASE_TIME + 30;
+    rreq.to = BASE_TIME + 60;
+    rreq.max = 0;
+    len = query(fd, FLEET_MSG_RANGE, &rreq, sizeof(rreq), buf, sizeof(buf), &status);
+    sensor_sample_t first = make_sample(10, 2600);
+    CHECK(len == 10 * (int)sizeof(sensor_sample_t) && same_sample((sensor_sample_t *)buf, &first),
+          "RANGE: 10개, 첫 샘플 일치");
+    rreq.max = 3;
+    rreq.to = UINT32_MAX;
+    len = query(fd, FLEET_MSG_RANGE, &rreq, sizeof(rreq), buf, sizeof(buf), &status);
+    CHECK(len == 3 * (int)sizeof(sensor_sample_t), "RANGE: 최대 개수 제한");
+    rreq.node_id = 99;
+    len = query(fd, FLEET_MSG_RANGE, &rreq, sizeof(rreq), buf, sizeof(buf), &status);
+    CHECK(len == 0 && status == NODE_ERR_NO_NODE, "RANGE: 없는 노드 → NO_NODE");
+
+    // 요약을 직접 계산한 값과 비교 (구간 양끝이 블록 중간에 걸치게)
+    sreq.from = BASE_TIME + 301;
+    sreq.to = BASE_TIME + 1201;
+    len = query(fd, FLEET_MSG_SUMMARY, &sreq, sizeof(sreq), &sum, sizeof(sum), &status);
+    history_agg_t want, got_agg = sum.agg;
+    history_agg_reset(&want);
+    for (uint32_t i = 101; i <= 400; i++) {
+        sensor_sample_t a = make_sample(i, 2000), b = make_sample(i, 2600);
+        history_agg_add(&want, &a);
+        history_agg_add(&want, &b);
+    }
+    CHECK(len == sizeof(sum) && sum.nodes == 2 && sum.nodes_reporting == 2 &&
+          sum.nodes_connected == 1, "SUMMARY: 노드 수");
+    CHECK(memcmp(&got_agg, &want, sizeof(want)) == 0, "SUMMARY: 합계/최소/최대가 직접 계산과 같음");
+    CHECK(sum.warmest_node == 8 && sum.coldest_node == 7, "SUMMARY: 가장 따뜻한/추운 방");
+
+    len = query(fd, FLEET_MSG_STATS, NULL, 0, &st, sizeof(st), &status);
+    CHECK(len == sizeof(st) && st.nodes == 2 && st.samples == 1600 && st.store_bytes > 0,
+          "STATS");
+
+    len = query(fd, 77, NULL, 0, buf, sizeof(buf), &status);
+    CHECK(len == 0 && status == NODE_ERR_BAD_REQUEST, "모르는 메시지 → BAD_REQUEST");
+
+    // 깨진 프레임은 연결을 끊음
+    uint8_t junk[8] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    if (write(fd, junk, sizeof(junk)) != sizeof(junk)) perror("write");
+    CHECK(recv_exact(fd, buf, 1) != 0, "잘못된 magic → 연결 끊김");
+    close(fd);
+
+    // HELLO 없이 SAMPLES를 보내도 끊김
+    fd = connect_client();
+    node_frame_t hdr = { NODE_PROTOCOL_MAGIC, NODE_MSG_SAMPLES, NODE_OK, sizeof(sensor_sample_t) };
+    uint8_t msg[sizeof(hdr) + sizeof(sensor_sample_t)];
+    memcpy(msg, &hdr, sizeof(hdr));
+    memcpy(msg + sizeof(hdr), &first, sizeof(first));
+    if (write(fd, msg, sizeof(msg)) != sizeof(msg)) perror("write");
+    CHECK(recv_exact(fd, buf, 1) != 0 && agg.stats.samples == 1600, "HELLO 없는 SAMPLES 거부");
+    close(fd);
+    stop_uplink(&up1);
+}
+
+static void test_offline_queue(void) {
+    static node_uplink_t u;
+
+    printf("🧪 서버가 없을 때 업링크 큐\n");
+    node_uplink_open(&u, "127.0.0.1", DEAD_PORT, 9, "GARAGE");
+    for (uint32_t i = 0; i < NODE_UPLINK_QUEUE + 100; i++) {
+        sensor_sample_t s = make_sample(i, 1500);
+        node_uplink_append(&u, &s);
+        node_uplink_poll(&u);
+    }
+    CHECK(u.state != NODE_UPLINK_UP, "연결 안 됨");
+    CHECK(u.count == NODE_UPLINK_QUEUE && u.samples_dropped == 100, "큐가 차면 오래된 것부터 버림");
+    CHECK(u.queue[u.head].time == make_sample(100, 1500).time, "남은 가장 오래된 샘플");
+    CHECK(u.retry_ms > NODE_UPLINK_RETRY_MIN_MS, "재접속 대기 증가");
+    node_uplink_close(&u);
+    fprintf(stderr, "(다음 오류 메시지는 예상된 것)\n");
+    CHECK(node_uplink_open(&u, "127.0.0.1", DEAD_PORT, 0, "X") != 0, "노드 ID 0 거부");
+}
+
+// 블록 한도를 넘게 보내 가장 오래된 블록이 재사용되는지
+static void test_eviction(void) {
+    static uint8_t frame[sizeof(node_frame_t) + NODE_MAX_BATCH * sizeof(sensor_sample_t)];
+    static sensor_sample_t got[64];
+    node_hello_t hello;
+    node_frame_t hdr = { NODE_PROTOCOL_MAGIC, NODE_MSG_HELLO, NODE_OK, sizeof(hello) };
+    uint64_t before = agg.stats.samples;
+    uint32_t sent = 0;
+    int fd = connect_client();
+
+    printf("🧪 블록 한도 초과 (%d개 샘플)\n", BULK_SAMPLES);
+    memset(&hello, 0, sizeof(hello));
+    hello.node_id = 10;
+    strcpy(hello.room, "HALL");
+    memcpy(frame, &hdr, sizeof(hdr));
+    memcpy(frame + sizeof(hdr), &hello, sizeof(hello));
+    if (write(fd, frame, sizeof(hdr) + sizeof(hello)) < 0) perror("write");
+
+    while (sent < BULK_SAMPLES) {
+        uint32_t n = BULK_SAMPLES - sent < NODE_MAX_BATCH ? BULK_SAMPLES - sent : NODE_MAX_BATCH;
+        size_t len, off = 0;
+
+        hdr.type = NODE_MSG_SAMPLES;
+        hdr.len = n * (uint32_t)sizeof(sensor_sample_t);
+        memcpy(frame, &hdr, sizeof(hdr));
+        for (uint32_t i = 0; i < n; i++) {
+            sensor_sample_t s = make_sample(sent + i, 2200);
+            memcpy(frame + sizeof(hdr) + i * sizeof(s), &s, sizeof(s));
+        }
+        len = sizeof(hdr) + hdr.len;
+        while (off < len) {
+            ssize_t w = send(fd, frame + off, len - off, MSG_DONTWAIT);
+            if (w > 0) off += (size_t)w;
+            fleet_aggregator_poll(&agg, 0);
+        }
+        sent += n;
+    }
+    PUMP_UNTIL(agg.stats.samples - before == BULK_SAMPLES);
+    CHECK(pumped, "모두 수집");
+
+    const fleet_node_t *n = fleet_aggregator_find(&agg, 10);
+    CHECK(n && n->block_count == FLEET_NODE_MAX_BLOCKS && n->stored < BULK_SAMPLES,
+          "블록 수 한도 유지");
+    printf("  ℹ️ 보관 %u개, 블록 %u개, 전체 시계열 메모리 %.1f KB\n",
+           n->stored, n->block_count, agg.stats.store_bytes / 1024.0);
+
+    // 가장 오래된 보관 샘플 = 전체 - 보관 수
+    uint32_t oldest = BULK_SAMPLES - n->stored;
+    size_t cnt = fleet_aggregator_range(&agg, 10, 0, INT64_MAX, got, 64);
+    sensor_sample_t want = make_sample(oldest, 2200);
+    CHECK(cnt == 64 && same_sample(&got[0], &want), "재사용 후 가장 오래된 샘플부터 복원");
+    close(fd);
+}
+
+int main(void) {
+    if (fleet_aggregator_open(&agg, "127.0.0.1", TEST_PORT, 64) != 0) return 1;
+
+    test_uplink();
+    test_queries();
+    test_offline_queue();
+    test_eviction();
+
+    fleet_aggregator_close(&agg);
+
+    if (failures) {
+        printf("❌ 실패 %d건\n", failures);
+        return 1;
+    }
+    printf("🎉 모든 집계 서버 테스트 통과\n");
+    return 0;
+}
@@ -0,0 +1,346 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include "metrics_server.h"
+#include "test_check.h"
+
+#define SNAP_NAME       "/metrics_server_test"
+#define TEST_PORT       19464
+#define QUICK_SCRAPES   2000
+#define BENCH_SCRAPES   50000
+
+static metrics_server_t ms;             // 연결 버퍼 포함 약 150KB
+static env_snapshot_publisher_t pub;
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void make_snapshot(env_snapshot_t *snap) {
+    memset(snap, 0, sizeof(*snap));
+    snap->sample.time = 1700000000u;
+    snap->sample.time_ms = 250;
+    snap->sample.temp_centi = -505;
+    snap->sample.humi_centi = 4550;
+    snap->sample.flags = SAMPLE_FLAG_VALID | SAMPLE_FLAG_TIME_RTC;
+    snap->temp_level = 2;
+    snap->humi_level = 0;
+    snap->overall_level = 2;
+    snap->reads_ok = 1234;
+    snap->reads_failed = 7;
+    snap->retries = 9;
+    snap->timeout_errors = 4;
+    snap->checksum_errors = 2;
+    snap->range_errors = 1;
+    snap->sample_interval_ms = 60000;
+    snap->sample_avg_interval_ms = 36250;
+
+    // DS1307: 0.2ms 2개, 3ms 1개 / OLED: 20ms 1개, 200ms 1개(+Inf)
+    snap->rtc_i2c.transactions = 3;
+    snap->rtc_i2c.bytes = 24;
+    snap->rtc_i2c.buckets[1] = 2;
+    snap->rtc_i2c.buckets[5] = 1;
+    snap->rtc_i2c.latency_sum_ns = 3400000;
+    snap->oled_i2c.transactions = 2;
+    snap->oled_i2c.errors = 1;
+    snap->oled_i2c.bytes = 1024;
+    snap->oled_i2c.buckets[7] = 1;
+    snap->oled_i2c.buckets[I2C_HIST_BUCKETS] = 1;
+    snap->oled_i2c.latency_sum_ns = 220000000;
+}
+
+static int connect_client(void) {
+    struct sockaddr_in addr;
+    struct timeval tv = { 2, 0 };
+    int one = 1;
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(TEST_PORT);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (fd < 0 || connect(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+        if (fd >= 0) close(fd);
+        return -1;
+    }
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    return fd;
+}
+
+static int send_all(int fd, const char *s) {
+    size_t len = strlen(s);
+    return write(fd, s, len) == (ssize_t)len ? 0 : -1;
+}
+
+// 응답 하나 수신 (헤더 + Content-Length 본문). 반환: 상태 코드, -1 = 실패/끊김
+static char rbuf[65536];
+static size_t rlen;
+
+static int read_response(int fd, char *body, size_t cap, char *headers, size_t hcap) {
+    char *end;
+    size_t hlen, blen;
+    const char *cl;
+    int status;
+
+    for (;;) {
+        rbuf[rlen] = '\0';
+        end = strstr(rbuf, "\r\n\r\n");
+        if (end) break;
+        ssize_t n = read(fd, rbuf + rlen, sizeof(rbuf) - 1 - rlen);
+        if (n <= 0) return -1;
+        rlen += (size_t)n;
+    }
+    hlen = (size_t)(end - rbuf) + 4;
+    cl = strstr(rbuf, "Content-Length: ");
+    if (!cl || cl > end || sscanf(rbuf, "HTTP/1.1 %d", &status) != 1) return -1;
+    blen = strtoul(cl + 16, NULL, 10);
+    if (blen >= cap) return -1;
+    if (headers) {
+        size_t n = hlen < hcap ? hlen : hcap - 1;
+        memcpy(headers, rbuf, n);
+        headers[n] = '\0';
+    }
+
+    while (rlen < hlen + blen) {
+        ssize_t n = read(fd, rbuf + rlen, sizeof(rbuf) - 1 - rlen);
+        if (n <= 0) return -1;
+        rlen += (size_t)n;
+    }
+    memcpy(body, rbuf + hlen, blen);
+    body[blen] = '\0';
+    memmove(rbuf, rbuf + hlen + blen, rlen - hlen - blen);
+    rlen -= hlen + blen;
+    return status;
+}
+
+static int scrape(int fd, char *body, size_t cap) {
+    if (send_all(fd, "GET /metrics HTTP/1.1\r\nHost: localhost\r\n\r\n") != 0) return -1;
+    return read_response(fd, body, cap, NULL, 0);
+}
+
+// 본문에 "<series> <value>\n" 줄이 있는지
+static int has_line(const char *body, const char *line) {
+    char want[256];
+    snprintf(want, sizeof(want), "%s\n", line);
+    return strstr(body, want) != NULL;
+}
+
+static void test_render(void) {
+    static char buf[METRICS_RESPONSE_BUF];
+    env_snapshot_t snap;
+    size_t len, small;
+
+    printf("🧪 렌더링\n");
+    make_snapshot(&snap);
+    len = metrics_render(buf, sizeof(buf) - 1, &snap, "lab", 5);
+    buf[len] = '\0';                   // 렌더링은 NUL을 붙이지 않음
+    CHECK(len > 0, "렌더링 성공");
+    CHECK(has_line(buf, "smart_env_up{room=\"lab\"} 1"), "up = 1");
+    CHECK(has_line(buf, "smart_env_temperature_celsius{room=\"lab\"} -5.05"), "음수 온도 -5.05");
+    CHECK(has_line(buf, "smart_env_humidity_percent{room=\"lab\"} 45.5"), "습도 45.5 (끝자리 0 제거)");
+    CHECK(has_line(buf, "smart_env_sample_timestamp_seconds{room=\"lab\"} 1700000000.25"),
+          "샘플 시각 ms 포함");
+    CHECK(has_line(buf, "smart_env_level{room=\"lab\",kind=\"overall\"} 2"), "종합 등급");
+    CHECK(has_line(buf, "smart_env_sample_interval_seconds{room=\"lab\"} 60") &&
+          has_line(buf, "smart_env_sample_effective_interval_seconds{room=\"lab\"} 36.25"),
+          "측정 간격 (현재/실효)");
+    CHECK(has_line(buf, "smart_env_sensor_reads_total{room=\"lab\",result=\"failed\"} 7"),
+          "읽기 실패 카운터");
+    CHECK(has_line(buf, "smart_env_sensor_errors_total{room=\"lab\",kind=\"timeout\"} 4"),
+          "오류 종류별 카운터");
+    CHECK(has_line(buf, "smart_env_sensor_retries_total{room=\"lab\"} 9"), "재시도 카운터");
+    CHECK(strstr(buf, "# TYPE smart_env_sensor_retries counter\n") != NULL,
+          "카운터 TYPE은 _total 없는 이름");
+    CHECK(has_line(buf, "smart_env_i2c_errors_total{room=\"lab\",device=\"oled\"} 1"),
+          "I2C 오류 (OLED)");
+
+    // 누적 버킷: 0.00025 이하 2, 0.005 이하 3, 이후 유지
+    CHECK(has_line(buf, "smart_env_i2c_latency_seconds_bucket{room=\"lab\",device=\"ds1307\",le=\"0.0001\"} 0") &&
+          has_line(buf, "smart_env_i2c_latency_seconds_bucket{room=\"lab\",device=\"ds1307\",le=\"0.00025\"} 2") &&
+          has_line(buf, "smart_env_i2c_latency_seconds_bucket{room=\"lab\",device=\"ds1307\",le=\"0.005\"} 3") &&
+          has_line(buf, "smart_env_i2c_latency_seconds_bucket{room=\"lab\",device=\"ds1307\",le=\"+Inf\"} 3"),
+          "DS1307 히스토그램 누적");
+    CHECK(has_line(buf, "smart_env_i2c_latency_seconds_bucket{room=\"lab\",device=\"oled\",le=\"0.1\"} 1") &&
+          has_line(buf, "smart_env_i2c_latency_seconds_bucket{room=\"lab\",device=\"oled\",le=\"+Inf\"} 2") &&
+          has_line(buf, "smart_env_i2c_latency_seconds_count{room=\"lab\",device=\"oled\"} 2"),
+          "OLED +Inf 버킷 = count");
+    CHECK(has_line(buf, "smart_env_i2c_latency_seconds_sum{room=\"lab\",device=\"ds1307\"} 0.0034"),
+          "지연 합계 (초)");
+    CHECK(has_line(buf, "smart_env_exporter_scrapes_total{room=\"lab\"} 5"), "수집 횟수");
+    CHECK(len >= 6 && strcmp(buf + len - 6, "# EOF\n") == 0, "# EOF로 끝남");
+
+    len = metrics_render(buf, sizeof(buf) - 1, NULL, "lab", 0);
+    buf[len] = '\0';
+    CHECK(has_line(buf, "smart_env_up{room=\"lab\"} 0") &&
+          strstr(buf, "temperature") == NULL, "게시 전: up = 0, 측정값 없음");
+
+    // 버퍼가 모자라면 0 (잘린 본문을 내보내지 않음). 게시 전 본문은 길이가 고정
+    small = metrics_render(buf, len - 1, NULL, "lab", 0);
+    CHECK(small == 0, "버퍼 부족 시 0");
+    CHECK(metrics_render(buf, len, NULL, "lab", 0) == len, "딱 맞는 버퍼");
+    printf("  ℹ️ 본문 %zu바이트 (게시 후)\n", metrics_render(buf, sizeof(buf), &snap, "lab", 5));
+}
+
+static void test_http(void) {
+    static char body[METRICS_RESPONSE_BUF];
+    char headers[512];
+    env_snapshot_t snap;
+    int fd, status;
+
+    printf("🧪 HTTP\n");
+    fd = connect_client();
+    CHECK(fd >= 0, "접속");
+
+    rlen = 0;
+    status = scrape(fd, body, sizeof(body));
+    CHECK(status == 200 && has_line(body, "smart_env_up{room=\"lab \\\"A\\\"\\\\\"} 0"),
+          "게시 전 수집: up = 0, room 레이블 이스케이프");
+
+    make_snapshot(&snap);
+    env_snapshot_publish(&pub, &snap);
+    send_all(fd, "GET /metrics HTTP/1.1\r\nHost: localhost\r\n\r\n");
+    status = read_response(fd, body, sizeof(body), headers, sizeof(headers));
+    CHECK(status == 200, "같은 연결로 두 번째 수집 (keep-alive)");
+    CHECK(strstr(headers, "Content-Type: application/openmetrics-text; version=1.0.0; charset=utf-8\r\n")
+          != NULL, "OpenMetrics Content-Type");
+    CHECK(strstr(body, "smart_env_up{room=\"lab \\\"A\\\"\\\\\"} 1") != NULL, "게시 후 up = 1");
+    CHECK(strstr(body, "smart_env_snapshot_publishes_total{room=\"lab \\\"A\\\"\\\\\"} 1\n") != NULL,
+          "게시 순번");
+
+    // 파이프라이닝: 요청 셋을 한 번에
+    send_all(fd, "GET /metrics?x=1 HTTP/1.1\r\n\r\nGET /nope HTTP/1.1\r\n\r\n"
+                 "POST /metrics HTTP/1.1\r\nContent-Length: 0\r\n\r\n");
+    status = read_response(fd, body, sizeof(body), NULL, 0);
+    CHECK(status == 200, "쿼리 문자열 허용");
+    status = read_response(fd, body, sizeof(body), NULL, 0);
+    CHECK(status == 404, "다른 경로는 404");
+    status = read_response(fd, body, sizeof(body), NULL, 0);
+    CHECK(status == 405, "GET 외에는 405");
+
+    send_all(fd, "GET /metrics HTTP/1.1\r\nconnection: Close\r\n\r\n");
+    status = read_response(fd, body, sizeof(body), headers, sizeof(headers));
+    CHECK(status == 200 && strstr(headers, "Connection: close\r\n") != NULL,
+          "Connection: close 응답");
+    CHECK(read(fd, body, 1) == 0, "응답 후 서버가 닫음");
+    close(fd);
+
+    // 조각난 요청 + 쓰기 닫기 (curl -0 같은 HTTP/1.0)
+    fd = connect_client();
+    rlen = 0;
+    send_all(fd, "GET /metr");
+    usleep(10000);
+    send_all(fd, "ics HTTP/1.0\r\n\r\n");
+    shutdown(fd, SHUT_WR);
+    status = read_response(fd, body, sizeof(body), NULL, 0);
+    CHECK(status == 200, "나눠 온 HTTP/1.0 요청");
+    CHECK(read(fd, body, 1) == 0, "HTTP/1.0은 응답 후 닫음");
+    close(fd);
+
+    // 슬롯보다 많은 연결: 넘친 연결은 끊기고 기존 연결은 계속 동작
+    int fds[METRICS_SERVER_MAX_CLIENTS + 2];
+    int served = 0;
+    for (int i = 0; i < METRICS_SERVER_MAX_CLIENTS + 2; i++) fds[i] = connect_client();
+    for (int i = 0; i < METRICS_SERVER_MAX_CLIENTS + 2; i++) {
+        rlen = 0;
+        if (fds[i] >= 0 && scrape(fds[i], body, sizeof(body)) == 200) served++;
+    }
+    for (int i = 0; i < METRICS_SERVER_MAX_CLIENTS + 2; i++) {
+        if (fds[i] >= 0) close(fds[i]);
+    }
+    CHECK(served == METRICS_SERVER_MAX_CLIENTS, "동시 연결은 슬롯 수까지");
+    usleep(20000);                      // 서버가 닫힌 연결 정리
+}
+
+// 수집 중에도 게시는 기다리지 않아야 함
+typedef struct {
+    volatile int stop;
+    uint64_t count;
+    double worst_s;
+} publisher_load_t;
+
+static void *publisher_thread(void *arg) {
+    publisher_load_t *load = arg;
+    env_snapshot_t snap;
+    struct timespec pause = { 0, 100000 };
+
+    make_snapshot(&snap);
+    while (!load->stop) {
+        double t0 = now_sec();
+        snap.reads_ok++;
+        env_snapshot_publish(&pub, &snap);
+        double dt = now_sec() - t0;
+        if (dt > load->worst_s) load->worst_s = dt;
+        load->count++;
+        nanosleep(&pause, NULL);
+    }
+    return NULL;
+}
+
+static void bench_scrape(int scrapes) {
+    static char body[METRICS_RESPONSE_BUF];
+    publisher_load_t load = { 0, 0, 0 };
+    pthread_t writer;
+    double t0, elapsed, worst = 0;
+    int fd, ok = 0;
+
+    printf("📊 루프백 수집 %d회 (keep-alive, 0.1ms마다 게시 중)\n", scrapes);
+    fd = connect_client();
+    rlen = 0;
+    pthread_create(&writer, NULL, publisher_thread, &load);
+
+    t0 = now_sec();
+    for (int i = 0; i < scrapes; i++) {
+        double s0 = now_sec();
+        if (scrape(fd, body, sizeof(body)) == 200) ok++;
+        double dt = now_sec() - s0;
+        if (dt > worst) worst = dt;
+    }
+    elapsed = now_sec() - t0;
+
+    load.stop = 1;
+    pthread_join(writer, NULL);
+    close(fd);
+
+    printf("  ⏱️ %.1f µs/수집 (%.0f회/s), 최악 %.0f µs\n",
+           elapsed * 1e6 / scrapes, scrapes / elapsed, worst * 1e6);
+    printf("  ⏱️ 그동안 게시 %llu회, 게시 최악 %.1f µs\n",
+           (unsigned long long)load.count, load.worst_s * 1e6);
+    CHECK(ok == scrapes, "모든 수집 성공");
+    CHECK(ms.scrape_errors == 0, "렌더 버퍼 부족 없음");
+}
+
+int main(int argc, char **argv) {
+    int bench = argc > 1 && strcmp(argv[1], "--bench") == 0;
+
+    test_render();
+
+    shm_unlink(SNAP_NAME);
+    if (env_snapshot_publisher_open(&pub, SNAP_NAME) != 0) return 1;
+    if (metrics_server_start(&ms, "127.0.0.1", TEST_PORT, SNAP_NAME, "lab \"A\"\\") != 0) return 1;
+
+    test_http();
+    bench_scrape(bench ? BENCH_SCRAPES : QUICK_SCRAPES);
+
+    metrics_server_stop(&ms);
+    env_snapshot_publisher_close(&pub);
+    shm_unlink(SNAP_NAME);
+
+    if (failures) {
+        printf("❌ 실패 %d건\n", failures);
+        return 1;
+    }
+    printf("🎉 모든 메트릭 서버 테스트 통과\n");
+    return 0;
+}
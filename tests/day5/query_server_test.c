@@ -0,0 +1,479 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/epoll.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "query_server.h"
+#include "test_check.h"
+#include "test_samples.h"
+
+#define SOCK_PATH       "/tmp/query_server_test.sock"
+#define RING_PATH       "/tmp/query_server_test.ring"
+#define RING_CAPACITY   100000
+#define RING_SAMPLES    130000          // 한 바퀴 넘게 채움
+#define LOAD_CLIENTS    400
+#define LOAD_UPDATES    1000
+
+static query_server_t srv;              // 연결 버퍼 포함 약 300KB
+static history_store_t ring;
+
+static void make_snapshot(uint32_t i, env_snapshot_t *snap) {
+    memset(snap, 0, sizeof(*snap));
+    snap->sample = make_sample(i);
+    snap->overall_level = (uint8_t)(i % 3);
+    snap->reads_ok = i;
+}
+
+static int connect_client(void) {
+    struct sockaddr_un addr;
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, SOCK_PATH);
+    if (fd < 0 || connect(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0) {
+        if (fd >= 0) close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static void send_request(int fd, uint8_t op, uint32_t a0, uint32_t a1, uint32_t a2) {
+    qs_request_t req;
+    memset(&req, 0, sizeof(req));
+    req.op = op;
+    req.arg0 = a0;
+    req.arg1 = a1;
+    req.arg2 = a2;
+    if (write(fd, &req, sizeof(req)) != sizeof(req)) perror("write");
+}
+
+// 같은 스레드에서 서버를 돌리며 n바이트 수신 (1초 넘으면 실패)
+static int recv_exact(int fd, void *buf, size_t n) {
+    size_t got = 0;
+    for (int spins = 0; got < n && spins < 1000; spins++) {
+        query_server_poll(&srv, 1);
+        ssize_t r = recv(fd, (uint8_t *)buf + got, n - got, MSG_DONTWAIT);
+        if (r > 0) got += (size_t)r;
+        else if (r == 0) break;
+    }
+    return got == n ? 0 : -1;
+}
+
+static int recv_response(int fd, qs_response_t *hdr, void *payload, size_t max) {
+    if (recv_exact(fd, hdr, sizeof(*hdr)) != 0 || hdr->payload_len > max) return -1;
+    return recv_exact(fd, payload, hdr->payload_len);
+}
+
+static sensor_sample_t range_buf[RING_CAPACITY];
+
+static void test_requests(void) {
+    qs_response_t hdr;
+    sensor_sample_t sample;
+    qs_status_t st;
+    env_snapshot_t snap;
+    int fd, ok;
+
+    printf("🧪 요청/응답\n");
+    fd = connect_client();
+    CHECK(fd >= 0, "연결");
+
+    send_request(fd, QS_OP_LATEST, 0, 0, 0);
+    CHECK(recv_response(fd, &hdr, &sample, sizeof(sample)) == 0 && hdr.status == QS_ERR_NO_DATA,
+          "게시 전 LATEST → NO_DATA");
+
+    make_snapshot(RING_SAMPLES - 1, &snap);
+    query_server_update(&srv, &snap);
+    send_request(fd, QS_OP_LATEST, 0, 0, 0);
+    CHECK(recv_response(fd, &hdr, &sample, sizeof(sample)) == 0 && hdr.status == QS_OK &&
+          memcmp(&sample, &snap.sample, sizeof(sample)) == 0, "LATEST → 최신 샘플");
+
+    // 링 전체 (끝을 넘는 구간 → writev 두 구간)
+    sensor_sample_t first = make_sample(RING_SAMPLES - RING_CAPACITY);
+    send_request(fd, QS_OP_RANGE, first.time, make_sample(RING_SAMPLES).time, 0);
+    ok = recv_response(fd, &hdr, range_buf, sizeof(range_buf)) == 0 &&
+         hdr.status == QS_OK && hdr.count == RING_CAPACITY;
+    for (uint32_t i = 0; ok && i < RING_CAPACITY; i++) {
+        ok = memcmp(&range_buf[i], history_store_get(&ring, i), sizeof(sensor_sample_t)) == 0;
+    }
+    CHECK(ok, "RANGE 링 전체 10만 개 (순환 경계 포함)");
+
+    send_request(fd, QS_OP_RANGE, make_sample(120000).time, make_sample(121000).time, 10);
+    CHECK(recv_response(fd, &hdr, range_buf, sizeof(range_buf)) == 0 && hdr.count == 10 &&
+          range_buf[0].time == make_sample(120000).time, "RANGE 최대 개수 제한");
+
+    send_request(fd, QS_OP_RANGE, 100, 50, 0);
+    CHECK(recv_response(fd, &hdr, range_buf, sizeof(range_buf)) == 0 &&
+          hdr.status == QS_ERR_BAD_REQUEST, "뒤집힌 구간 → BAD_REQUEST");
+
+    send_request(fd, 99, 0, 0, 0);
+    CHECK(recv_response(fd, &hdr, range_buf, sizeof(range_buf)) == 0 &&
+          hdr.status == QS_ERR_BAD_REQUEST, "모르는 op → BAD_REQUEST");
+
+    // 파이프라이닝: 한 번에 세 요청
+    send_request(fd, QS_OP_STATUS, 0, 0, 0);
+    send_request(fd, QS_OP_LATEST, 0, 0, 0);
+    send_request(fd, QS_OP_STATUS, 0, 0, 0);
+    ok = recv_response(fd, &hdr, &st, sizeof(st)) == 0 && hdr.op == QS_OP_STATUS &&
+         st.clients == 1 && st.history_count == RING_CAPACITY && st.reads_ok == snap.reads_ok;
+    ok = ok && recv_response(fd, &hdr, &sample, sizeof(sample)) == 0 && hdr.op == QS_OP_LATEST;
+    ok = ok && recv_response(fd, &hdr, &st, sizeof(st)) == 0 && hdr.op == QS_OP_STATUS;
+    CHECK(ok, "요청 3개 파이프라이닝 → 순서대로 응답");
+
+    // 구독: 3개마다 1개
+    send_request(fd, QS_OP_SUBSCRIBE, 3, 0, 0);
+    CHECK(recv_response(fd, &hdr, NULL, 0) == 0 && hdr.op == QS_OP_SUBSCRIBE, "SUBSCRIBE 확인");
+    for (uint32_t i = 0; i < 9; i++) {
+        make_snapshot(RING_SAMPLES + i, &snap);
+        query_server_update(&srv, &snap);
+    }
+    ok = 1;
+    for (uint32_t i = 0; i < 3 && ok; i++) {
+        ok = recv_response(fd, &hdr, &sample, sizeof(sample)) == 0 && hdr.op == QS_OP_PUSH &&
+             sample.time == make_sample(RING_SAMPLES + 2 + i * 3).time;
+    }
+    CHECK(ok, "9개 갱신 → PUSH 3개 (3, 6, 9번째)");
+
+    // 구독 중 큰 범위를 요청하고 읽지 않음 → 그동안의 PUSH는 최신 하나로 합쳐짐
+    uint64_t coalesced = srv.pushes_coalesced;
+    send_request(fd, QS_OP_SUBSCRIBE, 1, 0, 0);
+    recv_response(fd, &hdr, NULL, 0);
+    send_request(fd, QS_OP_RANGE, 0, UINT32_MAX, 0);
+    for (int i = 0; i < 20; i++) query_server_poll(&srv, 1);     // 소켓 버퍼가 찰 때까지
+    for (uint32_t i = 0; i < 50; i++) {
+        make_snapshot(RING_SAMPLES + 100 + i, &snap);
+        query_server_update(&srv, &snap);
+    }
+    ok = recv_response(fd, &hdr, range_buf, sizeof(range_buf)) == 0 &&
+         hdr.op == QS_OP_RANGE && hdr.count == RING_CAPACITY &&
+         memcmp(&range_buf[RING_CAPACITY - 1], history_store_get(&ring, RING_CAPACITY - 1),
+                sizeof(sensor_sample_t)) == 0;
+    CHECK(ok, "느린 클라이언트에게도 범위 응답 온전히 전달");
+    ok = recv_response(fd, &hdr, &sample, sizeof(sample)) == 0 && hdr.op == QS_OP_PUSH &&
+         sample.time == make_sample(RING_SAMPLES + 149).time;
+    CHECK(ok && srv.pushes_coalesced - coalesced == 49, "밀린 PUSH 50개 → 최신 1개로 합침");
+
+    close(fd);
+    for (int i = 0; i < 5; i++) query_server_poll(&srv, 1);
+    CHECK(srv.clients == 0 && srv.subscribers == 0, "연결 종료 정리");
+}
+
+static qs_alert_t make_alert(uint32_t i) {
+    qs_alert_t a;
+    memset(&a, 0, sizeof(a));
+    a.time = 1700000000u + i;
+    a.value = (int32_t)(7000 + i);
+    a.rule = (uint16_t)(i % 3);
+    a.active = (uint8_t)(i & 1);
+    snprintf(a.name, sizeof(a.name), "rule%u", i);
+    return a;
+}
+
+// 구간 집계 기대값 (링을 직접 훑음)
+static void scan_summary(uint32_t from, uint32_t to, qs_summary_t *out) {
+    int64_t temp_sum = 0, humi_sum = 0;
+
+    memset(out, 0, sizeof(*out));
+    out->temp_min = INT16_MAX;
+    out->humi_min = UINT16_MAX;
+    for (uint32_t i = 0; i < history_store_count(&ring); i++) {
+        const sensor_sample_t *s = history_store_get(&ring, i);
+        if (s->time < from || s->time >= to || !(s->flags & SAMPLE_FLAG_VALID)) continue;
+        out->count++;
+        temp_sum += s->temp_centi;
+        humi_sum += s->humi_centi;
+        if (s->temp_centi < out->temp_min) out->temp_min = s->temp_centi;
+        if (s->temp_centi > out->temp_max) out->temp_max = s->temp_centi;
+        if (s->humi_centi < out->humi_min) out->humi_min = s->humi_centi;
+        if (s->humi_centi > out->humi_max) out->humi_max = s->humi_centi;
+    }
+    if (out->count) {
+        out->temp_mean = (int16_t)((temp_sum + out->count / 2) / out->count);
+        out->humi_mean = (uint16_t)((humi_sum + out->count / 2) / out->count);
+    }
+}
+
+static void test_summary(void) {
+    qs_response_t hdr;
+    qs_summary_t sum, expect;
+    uint32_t from = make_sample(95000).time, to = make_sample(105000).time;
+    int fd;
+
+    printf("🧪 구간 집계 (SUMMARY)\n");
+    fd = connect_client();
+
+    // 물리 링 끝을 넘는 구간
+    scan_summary(from, to, &expect);
+    send_request(fd, QS_OP_SUMMARY, from, to, 0);
+    CHECK(recv_response(fd, &hdr, &sum, sizeof(sum)) == 0 && hdr.status == QS_OK &&
+          expect.count == 10000 && memcmp(&sum, &expect, sizeof(sum)) == 0,
+          "순환 경계를 넘는 1만 개 구간 = 직접 훑은 값");
+
+    // 새 샘플은 다음 질의 직전에 색인에 반영
+    for (uint32_t i = RING_SAMPLES; i < RING_SAMPLES + 500; i++) {
+        sensor_sample_t s = make_sample(i);
+        history_store_append(&ring, &s);
+    }
+    from = make_sample(RING_SAMPLES - 100).time;
+    to = make_sample(RING_SAMPLES + 500).time;
+    scan_summary(from, to, &expect);
+    send_request(fd, QS_OP_SUMMARY, from, to, 0);
+    CHECK(recv_response(fd, &hdr, &sum, sizeof(sum)) == 0 && sum.count == 600 &&
+          memcmp(&sum, &expect, sizeof(sum)) == 0, "추가된 샘플 반영");
+
+    send_request(fd, QS_OP_SUMMARY, 0, 1000, 0);
+    CHECK(recv_response(fd, &hdr, &sum, sizeof(sum)) == 0 && hdr.status == QS_OK && sum.count == 0,
+          "빈 구간 → count 0");
+    send_request(fd, QS_OP_SUMMARY, 100, 50, 0);
+    CHECK(recv_response(fd, &hdr, &sum, sizeof(sum)) == 0 && hdr.status == QS_ERR_BAD_REQUEST,
+          "뒤집힌 구간 → BAD_REQUEST");
+    close(fd);
+    for (int i = 0; i < 5; i++) query_server_poll(&srv, 1);
+}
+
+static void test_alerts(void) {
+    qs_response_t hdr;
+    qs_alert_t alert, a;
+    int fd, idle, ok;
+
+    printf("🧪 경보 전달\n");
+    fd = connect_client();
+    idle = connect_client();
+    CHECK(fd >= 0 && idle >= 0, "연결 2개 (구독 1, 비구독 1)");
+
+    // 구독 전 경보는 보내지 않음
+    a = make_alert(0);
+    query_server_alert(&srv, &a);
+    send_request(fd, QS_OP_SUBSCRIBE, UINT32_MAX, 0, 0);     // 샘플 PUSH는 사실상 끔
+    CHECK(recv_response(fd, &hdr, NULL, 0) == 0 && hdr.op == QS_OP_SUBSCRIBE, "SUBSCRIBE 확인");
+
+    for (uint32_t i = 1; i <= 3; i++) {
+        a = make_alert(i);
+        query_server_alert(&srv, &a);
+    }
+    ok = 1;
+    for (uint32_t i = 1; i <= 3 && ok; i++) {
+        a = make_alert(i);
+        ok = recv_response(fd, &hdr, &alert, sizeof(alert)) == 0 && hdr.op == QS_OP_ALERT &&
+             hdr.count == 1 && memcmp(&alert, &a, sizeof(a)) == 0;
+    }
+    CHECK(ok, "경보 3개 → 합치지 않고 순서대로 3개");
+
+    // 큰 범위를 읽지 않는 동안 링보다 많은 경보 → 범위 뒤에 최근 링 크기만큼
+    uint64_t skipped = srv.alerts_skipped;
+    send_request(fd, QS_OP_RANGE, 0, UINT32_MAX, 0);
+    for (int i = 0; i < 20; i++) query_server_poll(&srv, 1);
+    for (uint32_t i = 0; i < QUERY_SERVER_ALERT_RING + 4; i++) {
+        a = make_alert(100 + i);
+        query_server_alert(&srv, &a);
+    }
+    ok = recv_response(fd, &hdr, range_buf, sizeof(range_buf)) == 0 &&
+         hdr.op == QS_OP_RANGE && hdr.count == RING_CAPACITY;
+    CHECK(ok, "범위 응답 사이에 경보가 끼지 않음");
+    ok = 1;
+    for (uint32_t i = 4; i < QUERY_SERVER_ALERT_RING + 4 && ok; i++) {
+        a = make_alert(100 + i);
+        ok = recv_response(fd, &hdr, &alert, sizeof(alert)) == 0 && hdr.op == QS_OP_ALERT &&
+             memcmp(&alert, &a, sizeof(a)) == 0;
+    }
+    CHECK(ok && srv.alerts_skipped - skipped == 4, "링보다 밀린 경보 4개 건너뛰고 최근 16개");
+
+    CHECK(recv(idle, &hdr, sizeof(hdr), MSG_DONTWAIT) < 0, "비구독 연결에는 경보 없음");
+
+    close(fd);
+    close(idle);
+    for (int i = 0; i < 5; i++) query_server_poll(&srv, 1);
+    CHECK(srv.clients == 0 && srv.subscribers == 0, "연결 종료 정리");
+}
+
+// 부하 시험: 구독자 LOAD_CLIENTS개를 별도 스레드의 epoll로 받음
+typedef struct {
+    int fds[LOAD_CLIENTS];
+    uint32_t pushes[LOAD_CLIENTS];
+    uint32_t last_time[LOAD_CLIENTS];
+    uint8_t buf[LOAD_CLIENTS][64];
+    uint32_t len[LOAD_CLIENTS];
+    volatile int connected;
+    volatile int done;
+    double finished_at;
+} load_ctx_t;
+
+static load_ctx_t load;
+
+static double now_sec(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void *load_clients(void *arg) {
+    struct epoll_event events[64];
+    uint32_t complete = 0;
+    int ep = epoll_create1(0);
+    double deadline;
+
+    (void)arg;
+    for (int i = 0; i < LOAD_CLIENTS; i++) {
+        struct epoll_event ev;
+        load.fds[i] = connect_client();
+        if (load.fds[i] < 0) {
+            perror("connect");
+            load.done = 1;
+            return NULL;
+        }
+        send_request(load.fds[i], QS_OP_SUBSCRIBE, 1, 0, 0);
+        ev.events = EPOLLIN;
+        ev.data.u32 = (uint32_t)i;
+        epoll_ctl(ep, EPOLL_CTL_ADD, load.fds[i], &ev);
+    }
+    load.connected = 1;
+
+    deadline = now_sec() + 20;
+    while (complete < LOAD_CLIENTS && now_sec() < deadline) {
+        int n = epoll_wait(ep, events, 64, 100);
+        for (int e = 0; e < n; e++) {
+            uint32_t i = events[e].data.u32;
+            ssize_t r = recv(load.fds[i], load.buf[i] + load.len[i],
+                             sizeof(load.buf[i]) - load.len[i], MSG_DONTWAIT);
+            if (r <= 0) continue;
+            load.len[i] += (uint32_t)r;
+
+            // 12바이트 응답 헤더 + (PUSH면) 12바이트 샘플 단위로 소비
+            uint32_t off = 0;
+            while (load.len[i] - off >= sizeof(qs_response_t)) {
+                qs_response_t hdr;
+                memcpy(&hdr, load.buf[i] + off, sizeof(hdr));
+                if (load.len[i] - off < sizeof(hdr) + hdr.payload_len) break;
+                if (hdr.op == QS_OP_PUSH) {
+                    sensor_sample_t s;
+                    memcpy(&s, load.buf[i] + off + sizeof(hdr), sizeof(s));
+                    load.last_time[i] = s.time;
+                    load.pushes[i]++;
+                    if (s.time == make_sample(200000 + LOAD_UPDATES - 1).time) complete++;
+                }
+                off += sizeof(hdr) + hdr.payload_len;
+            }
+            memmove(load.buf[i], load.buf[i] + off, load.len[i] - off);
+            load.len[i] -= off;
+        }
+    }
+    load.finished_at = now_sec();
+    load.done = 1;
+    close(ep);
+    return NULL;
+}
+
+static void test_load(void) {
+    pthread_t thread;
+    struct rlimit rl;
+    env_snapshot_t snap;
+    double start, fanout = 0, end;
+    uint64_t total = 0;
+    int all_latest = 1;
+
+    printf("🧪 부하 시험: 구독자 %d명 x 갱신 %d회\n", LOAD_CLIENTS, LOAD_UPDATES);
+
+    // 클라이언트 + 서버 쪽 소켓이 한 프로세스에 있으므로 fd 한도를 올림
+    getrlimit(RLIMIT_NOFILE, &rl);
+    if (rl.rlim_cur < 4 * LOAD_CLIENTS) {
+        rl.rlim_cur = rl.rlim_max < 4 * LOAD_CLIENTS ? rl.rlim_max : 4 * LOAD_CLIENTS;
+        setrlimit(RLIMIT_NOFILE, &rl);
+    }
+
+    uint64_t coalesced_before = srv.pushes_coalesced;
+    memset(&load, 0, sizeof(load));
+    pthread_create(&thread, NULL, load_clients, NULL);
+    while (!load.done && (!load.connected || srv.subscribers < LOAD_CLIENTS)) {
+        query_server_poll(&srv, 1);
+    }
+    CHECK(srv.subscribers == LOAD_CLIENTS, "구독자 모두 연결");
+
+    start = now_sec();
+    for (uint32_t u = 0; u < LOAD_UPDATES; u++) {
+        double t0 = now_sec();
+        make_snapshot(200000 + u, &snap);
+        query_server_update(&srv, &snap);
+        fanout += now_sec() - t0;
+        query_server_poll(&srv, 0);
+    }
+    while (!load.done) query_server_poll(&srv, 1);
+    end = load.finished_at;
+    pthread_join(thread, NULL);
+
+    for (int i = 0; i < LOAD_CLIENTS; i++) {
+        total += load.pushes[i];
+        if (load.last_time[i] != make_sample(200000 + LOAD_UPDATES - 1).time) all_latest = 0;
+        close(load.fds[i]);
+    }
+    for (int i = 0; i < 10; i++) query_server_poll(&srv, 1);
+
+    printf("  ℹ️ PUSH %llu개 (합침 %llu개), %.0f ms, %.2f µs/PUSH (갱신 1회 fan-out %.0f µs)\n",
+           (unsigned long long)total,
+           (unsigned long long)(srv.pushes_coalesced - coalesced_before),
+           (end - start) * 1e3, fanout * 1e6 / (double)(LOAD_CLIENTS * LOAD_UPDATES),
+           fanout * 1e6 / LOAD_UPDATES);
+    CHECK(all_latest, "모든 구독자가 마지막 샘플까지 수신");
+    CHECK(total + srv.pushes_coalesced - coalesced_before == (uint64_t)LOAD_CLIENTS * LOAD_UPDATES,
+          "PUSH 수 = 전달 + 합침");
+    CHECK(srv.clients == 0, "연결 모두 정리");
+}
+
+// 느린 클라이언트가 범위를 받는 동안 링이 한 바퀴 넘게 덮어써짐 → 섞인 샘플 대신 연결 종료
+static void test_range_overwrite(void) {
+    uint64_t aborted = srv.ranges_aborted;
+    uint8_t buf[4096];
+    size_t got = 0;
+    int fd, closed = 0;
+
+    printf("🧪 범위 전송 중 덮어쓰기\n");
+    fd = connect_client();
+    send_request(fd, QS_OP_RANGE, 0, UINT32_MAX, 0);
+    for (int i = 0; i < 20; i++) query_server_poll(&srv, 1);     // 소켓 버퍼가 찰 때까지
+    for (uint32_t i = 0; i < RING_CAPACITY / 2; i++) {
+        sensor_sample_t s = make_sample(RING_SAMPLES + 1000 + i);
+        history_store_append(&ring, &s);
+    }
+    for (int spins = 0; spins < 1000 && !closed; spins++) {
+        query_server_poll(&srv, 1);
+        ssize_t r = recv(fd, buf, sizeof(buf), MSG_DONTWAIT);
+        if (r > 0) got += (size_t)r;
+        else if (r == 0) closed = 1;
+    }
+    CHECK(closed && got < sizeof(qs_response_t) + RING_CAPACITY * sizeof(sensor_sample_t),
+          "덮어쓴 샘플을 보내기 전에 연결 종료 (짧은 응답)");
+    CHECK(srv.ranges_aborted == aborted + 1 && srv.clients == 0, "중단 횟수 기록, 연결 정리");
+    close(fd);
+}
+
+int main(void) {
+    unlink(RING_PATH);
+    if (history_store_open(&ring, RING_PATH, RING_CAPACITY) != 0) return 1;
+    for (uint32_t i = 0; i < RING_SAMPLES; i++) {
+        sensor_sample_t s = make_sample(i);
+        history_store_append(&ring, &s);
+    }
+
+    if (query_server_open(&srv, SOCK_PATH, &ring) != 0) return 1;
+
+    test_requests();
+    test_summary();
+    test_alerts();
+    test_load();
+    test_range_overwrite();
+
+    query_server_close(&srv);
+    history_store_close(&ring);
+    unlink(RING_PATH);
+
+    if (failures) {
+        printf("❌ 실패 %d건\n", failures);
+        return 1;
+    }
+    printf("🎉 모든 질의 서버 테스트 통과\n");
+    return 0;
+}
@@ -0,0 +1,20 @@
+#ifndef TEST_CHECK_H
+#define TEST_CHECK_H
+
+#include <stdio.h>
+
+// day4/day5 단위 테스트 공용 검사 매크로
+// 실패해도 멈추지 않고 세어 두었다가 main 끝에서 failures로 결과를 냄
+
+static int failures = 0;
+
+#define CHECK(cond, msg) do { \
+    if (cond) { \
+        printf("  ✅ %s\n", msg); \
+    } else { \
+        printf("  ❌ %s (%s:%d)\n", msg, __FILE__, __LINE__); \
+        failures++; \
+    } \
+} while (0)
+
+#endif // TEST_CHECK_H
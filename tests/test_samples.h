@@ -0,0 +1,20 @@
+#ifndef TEST_SAMPLES_H
+#define TEST_SAMPLES_H
+
+#include <stdint.h>
+#include "sensor_sample.h"
+
+// 이력 링/질의 서버 테스트 공용 합성 샘플
+// 3초 간격 i번째 샘플, 값은 i로 정해져 기대값을 다시 계산할 수 있음
+
+static sensor_sample_t make_sample(uint32_t i) {
+    sensor_sample_t s;
+    s.time = 1700000000u + i * 3;
+    s.time_ms = (uint16_t)(i % 1000);
+    s.temp_centi = (int16_t)(2000 + i % 700);
+    s.humi_centi = (uint16_t)(4000 + i % 2000);
+    s.flags = SAMPLE_FLAG_VALID | SAMPLE_FLAG_TIME_RTC;
+    return s;
+}
+
+#endif // TEST_SAMPLES_H